@@ -0,0 +1,123 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Cycle-accurate benchmark of the popcount algorithms on the LPC1769.
+ *
+ * Every algorithm of the popcount module is timed with the DWT cycle counter on inputs of
+ * 0, 1, 4, 8, 16, 24 and 32 bits set. The worst cycle count of each algorithm and density is
+ * stored in `benchCycles`, to be read with the debugger once `benchDone` is set. Results are
+ * checked against the SWAR algorithm; `benchErrors` counts the mismatches.
+ */
+
+#include "LPC17xx.h"
+#include "popcount.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1 << (x))
+
+/** Debug Exception and Monitor Control Register. */
+#define DEMCR      (*(volatile uint32_t*)0xE000EDFC)
+/** DWT control register. */
+#define DWT_CTRL   (*(volatile uint32_t*)0xE0001000)
+/** DWT cycle counter. */
+#define DWT_CYCCNT (*(volatile uint32_t*)0xE0001004)
+
+/** DEMCR: enables the DWT and ITM units. */
+#define DEMCR_TRCENA    BIT_MASK(24)
+/** DWT_CTRL: enables the cycle counter. */
+#define DWT_CYCCNTENA   BIT_MASK(0)
+
+/** Number of algorithms. */
+#define NUM_METHODS   (sizeof(methods) / sizeof(methods[0]))
+/** Number of input densities. */
+#define NUM_DENSITIES (sizeof(densities) / sizeof(densities[0]))
+/** Inputs timed per algorithm and density. */
+#define SAMPLES       (64)
+
+/** Popcount function. */
+typedef uint32_t (*Method)(uint32_t value);
+
+/**
+ * @brief Enables the DWT cycle counter.
+ */
+void configCycleCounter(void);
+
+/**
+ * @brief Returns a pseudo-random value with exactly `bits` bits set.
+ *
+ * @param bits Number of bits set (0-32).
+ */
+uint32_t randomValue(uint32_t bits);
+
+/**
+ * @brief Returns the next value of a 32-bit xorshift generator.
+ */
+uint32_t xorshift(void);
+
+/** Algorithms, in the order of POPCOUNT_METHOD_LOOP ... POPCOUNT_METHOD_SPARSE. */
+const Method methods[] = {POPCOUNT_Loop, POPCOUNT_NibbleLUT, POPCOUNT_ByteLUT, POPCOUNT_SWAR, POPCOUNT_Sparse};
+/** Bits set in the inputs. */
+const uint8_t densities[] = {0, 1, 4, 8, 16, 24, 32};
+
+/** Worst cycles of each algorithm and density, call and counter reads excluded. */
+volatile uint32_t benchCycles[NUM_METHODS][NUM_DENSITIES];
+/** Results that differ from the SWAR algorithm. */
+volatile uint32_t benchErrors = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+/** State of the xorshift generator. */
+uint32_t seed = 0x2545F491;
+
+int main(void) {
+    uint32_t start, overhead;
+
+    configCycleCounter();
+
+    start    = DWT_CYCCNT;
+    overhead = DWT_CYCCNT - start;    // Cost of reading the counter.
+
+    for (uint32_t d = 0; d < NUM_DENSITIES; d++) {
+        for (uint32_t s = 0; s < SAMPLES; s++) {
+            const uint32_t value    = randomValue(densities[d]);
+            const uint32_t expected = POPCOUNT_SWAR(value);
+
+            for (uint32_t m = 0; m < NUM_METHODS; m++) {
+                start                = DWT_CYCCNT;
+                const uint32_t count = methods[m](value);
+                const uint32_t spent = DWT_CYCCNT - start - overhead;
+
+                if (spent > benchCycles[m][d])
+                    benchCycles[m][d] = spent;
+                if (count != expected)
+                    benchErrors++;
+            }
+        }
+    }
+    benchDone = 1;
+
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void configCycleCounter(void) {
+    DEMCR |= DEMCR_TRCENA;    // Enable the DWT unit.
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CYCCNTENA;    // Start counting core cycles.
+}
+
+uint32_t randomValue(uint32_t bits) {
+    uint32_t value = 0;
+
+    while (POPCOUNT_SWAR(value) < bits)
+        value |= BIT_MASK(xorshift() & 0x1F);    // Set random bits until there are enough.
+    return value;
+}
+
+uint32_t xorshift(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
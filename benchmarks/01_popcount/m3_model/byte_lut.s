@@ -0,0 +1,13 @@
+@ POPCOUNT_ByteLUT: whole function body, no branches.
+    ldr r2, =0x100
+    uxtb r1, r0
+    ubfx r3, r0, #8, #8
+    ldrb r1, [r2, r1]
+    ldrb r3, [r2, r3]
+    add r1, r1, r3
+    ubfx r3, r0, #16, #8
+    lsrs r0, r0, #24
+    ldrb r3, [r2, r3]
+    ldrb r0, [r2, r0]
+    add r1, r1, r3
+    add r0, r0, r1
@@ -0,0 +1,6 @@
+@ POPCOUNT_Loop: one iteration (32 per call) + bne taken (not modelled).
+    lsr.w r3, r0, r2
+    and r3, r3, #1
+    adds r2, #1
+    add r1, r1, r3
+    cmp r2, #32
@@ -0,0 +1,34 @@
+@ POPCOUNT_NibbleLUT: loop fully unrolled, no branches.
+    ldr r2, =0x100
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
+    and r3, r0, #15
+    ldrb r3, [r2, r3]
+    lsrs r0, r0, #4
+    add r1, r1, r3
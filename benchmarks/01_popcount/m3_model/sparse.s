@@ -0,0 +1,5 @@
+@ POPCOUNT_Sparse: one iteration (one per bit set) + bne taken (not modelled).
+    clz r2, r0
+    lsr.w r2, r3, r2
+    bics r0, r0, r2
+    add r1, r1, #1
@@ -0,0 +1,13 @@
+@ POPCOUNT_SWAR: whole function body, no branches.
+    lsrs r1, r0, #1
+    and r1, r1, #0x55555555
+    subs r0, r0, r1
+    and r1, r0, #0x33333333
+    lsrs r0, r0, #2
+    and r0, r0, #0x33333333
+    add r0, r0, r1
+    add r0, r0, r0, lsr #4
+    and r0, r0, #0x0F0F0F0F
+    mov r1, #0x01010101
+    muls r0, r1, r0
+    lsrs r0, r0, #24
@@ -0,0 +1,170 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Cycle-accurate benchmark of the streaming filters on the LPC1769.
+ *
+ * Each filter of the filter module processes SAMPLES random samples on NUM_CHANNELS channels,
+ * timed call by call with the DWT cycle counter. The worst cycles per call of each filter are
+ * stored in `benchCycles`, to be read with the debugger once `benchDone` is set. A call over
+ * the budget of its filter (FILTER_CALL_CYCLES plus the per-channel budget of filter.h for each
+ * channel) increments `benchOverBudget`.
+ */
+
+#include "LPC17xx.h"
+#include "filter.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1 << (x))
+
+/** Debug Exception and Monitor Control Register. */
+#define DEMCR      (*(volatile uint32_t*)0xE000EDFC)
+/** DWT control register. */
+#define DWT_CTRL   (*(volatile uint32_t*)0xE0001000)
+/** DWT cycle counter. */
+#define DWT_CYCCNT (*(volatile uint32_t*)0xE0001004)
+
+/** DEMCR: enables the DWT and ITM units. */
+#define DEMCR_TRCENA    BIT_MASK(24)
+/** DWT_CTRL: enables the cycle counter. */
+#define DWT_CYCCNTENA   BIT_MASK(0)
+
+/** Channels filtered per call. */
+#define NUM_CHANNELS  (8)
+/** Samples filtered per channel. */
+#define SAMPLES       (1024)
+/** Moving average window: 2^MA_LOG2_WINDOW samples. */
+#define MA_LOG2_WINDOW (3)
+/** EMA smoothing shift. */
+#define EMA_SHIFT     (4)
+/** CIC order. */
+#define CIC_ORDER     (3)
+/** CIC decimation rate: 2^CIC_LOG2_RATE. */
+#define CIC_LOG2_RATE (4)
+/** Median window. */
+#define MEDIAN_WINDOW (7)
+
+/** Filters, in the order of `benchCycles`. */
+enum { BENCH_MA, BENCH_EMA, BENCH_CIC, BENCH_MEDIAN, NUM_FILTERS };
+
+/**
+ * @brief Enables the DWT cycle counter.
+ */
+void configCycleCounter(void);
+
+/**
+ * @brief Initializes every filter.
+ */
+void configFilters(void);
+
+/**
+ * @brief Records the cycles of one call and checks them against its budget.
+ *
+ * @param filter Filter index (BENCH_MA ... BENCH_MEDIAN).
+ * @param spent  Cycles of the call.
+ * @param budget Cycle budget of the call.
+ */
+void record(uint32_t filter, uint32_t spent, uint32_t budget);
+
+/**
+ * @brief Returns the next value of a 32-bit xorshift generator.
+ */
+uint32_t xorshift(void);
+
+/** Worst cycles per call of each filter, counter reads excluded. */
+volatile uint32_t benchCycles[NUM_FILTERS];
+/** Calls over the budget of their filter. */
+volatile uint32_t benchOverBudget = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+/** State of the xorshift generator. */
+uint32_t seed = 0x2545F491;
+
+FILTER_MA_Type ma;
+uint16_t maSamples[FILTER_MA_SIZE(NUM_CHANNELS, MA_LOG2_WINDOW)];
+uint32_t maSums[NUM_CHANNELS];
+
+FILTER_EMA_Type ema;
+int32_t emaState[NUM_CHANNELS];
+
+FILTER_CIC_Type cic;
+uint32_t cicState[FILTER_CIC_SIZE(NUM_CHANNELS, CIC_ORDER)];
+
+FILTER_MEDIAN_Type median;
+uint16_t medianRing[FILTER_MEDIAN_SIZE(NUM_CHANNELS, MEDIAN_WINDOW)];
+uint16_t medianSorted[FILTER_MEDIAN_SIZE(NUM_CHANNELS, MEDIAN_WINDOW)];
+
+int main(void) {
+    uint16_t in[NUM_CHANNELS];
+    uint16_t out[NUM_CHANNELS];
+    uint32_t start, overhead, spent;
+    uint32_t cicCycles = 0;
+
+    configCycleCounter();
+    configFilters();
+
+    start    = DWT_CYCCNT;
+    overhead = DWT_CYCCNT - start;    // Cost of reading the counter.
+
+    for (uint32_t s = 0; s < SAMPLES; s++) {
+        for (uint32_t ch = 0; ch < NUM_CHANNELS; ch++)
+            in[ch] = (uint16_t)xorshift() & 0x0FFF;    // 12-bit samples, as from the ADC.
+
+        start = DWT_CYCCNT;
+        FILTER_MA_Update(&ma, in, out);
+        spent = DWT_CYCCNT - start - overhead;
+        record(BENCH_MA, spent, FILTER_CALL_CYCLES + NUM_CHANNELS * FILTER_MA_CYCLES);
+
+        start = DWT_CYCCNT;
+        FILTER_EMA_Update(&ema, in, out);
+        spent = DWT_CYCCNT - start - overhead;
+        record(BENCH_EMA, spent, FILTER_CALL_CYCLES + NUM_CHANNELS * FILTER_EMA_CYCLES);
+
+        start = DWT_CYCCNT;
+        FILTER_MEDIAN_Update(&median, in, out);
+        spent = DWT_CYCCNT - start - overhead;
+        record(BENCH_MEDIAN, spent, FILTER_CALL_CYCLES + NUM_CHANNELS * FILTER_MEDIAN_CYCLES(MEDIAN_WINDOW));
+
+        // The CIC budget is an average: check the cycles of each whole decimation period.
+        start = DWT_CYCCNT;
+        const uint8_t ready = FILTER_CIC_Update(&cic, in, out);
+        cicCycles += DWT_CYCCNT - start - overhead;
+        if (ready) {
+            record(BENCH_CIC, cicCycles,
+                   (FILTER_CALL_CYCLES + NUM_CHANNELS * FILTER_CIC_CYCLES(CIC_ORDER)) << CIC_LOG2_RATE);
+            cicCycles = 0;
+        }
+    }
+    benchDone = 1;
+
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void configCycleCounter(void) {
+    DEMCR |= DEMCR_TRCENA;    // Enable the DWT unit.
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CYCCNTENA;    // Start counting core cycles.
+}
+
+void configFilters(void) {
+    FILTER_MA_Init(&ma, maSamples, maSums, NUM_CHANNELS, MA_LOG2_WINDOW);
+    FILTER_EMA_Init(&ema, emaState, NUM_CHANNELS, EMA_SHIFT);
+    FILTER_CIC_Init(&cic, cicState, NUM_CHANNELS, CIC_ORDER, CIC_LOG2_RATE);
+    FILTER_MEDIAN_Init(&median, medianRing, medianSorted, NUM_CHANNELS, MEDIAN_WINDOW);
+}
+
+void record(uint32_t filter, uint32_t spent, uint32_t budget) {
+    if (spent > benchCycles[filter])
+        benchCycles[filter] = spent;
+    if (spent > budget)
+        benchOverBudget++;
+}
+
+uint32_t xorshift(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
@@ -0,0 +1,6 @@
+@ FILTER_CIC_Update: one comb stage (r1 delays, r4 acc, r12 count), once per 2^log2Rate inputs
+@ + bne taken (not modelled).
+    ldr r5, [r1]
+    str r4, [r1], #4
+    subs r4, r4, r5
+    subs r12, r12, #1
@@ -0,0 +1,6 @@
+@ FILTER_CIC_Update: one integrator stage (r1 integrators, r4 acc, r12 count), every input
+@ + bne taken (not modelled).
+    ldr r5, [r1]
+    add r4, r4, r5
+    str r4, [r1], #4
+    subs r12, r12, #1
@@ -0,0 +1,12 @@
+@ FILTER_EMA_Update: one channel (r0 in, r2 state, r3 out, r12 shift, lr count)
+@ + bne taken (not modelled).
+    ldrh r4, [r0], #2
+    ldr r5, [r2]
+    rsb r6, r5, r4, lsl #8
+    asr.w r6, r6, r12
+    add r5, r5, r6
+    str r5, [r2], #4
+    add r6, r5, #128
+    lsrs r6, r6, #8
+    strh r6, [r3], #2
+    subs lr, lr, #1
@@ -0,0 +1,7 @@
+@ FILTER_MEDIAN_Update: one step of the search or of the slide (r1 sorted, r4 bound, r6 key)
+@ + bne taken (not modelled).
+    ldrh r5, [r1, #2]
+    cmp r5, r6
+    it lo
+    strhlo r5, [r1], #2
+    subs r4, r4, #1
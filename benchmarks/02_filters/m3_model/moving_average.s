@@ -0,0 +1,12 @@
+@ FILTER_MA_Update: one channel (r0 in, r1 slot, r2 sums, r3 out, r12 log2Window, lr count)
+@ + bne taken (not modelled).
+    ldrh r4, [r0], #2
+    ldr r5, [r2]
+    ldrh r6, [r1]
+    subs r5, r5, r6
+    add r5, r5, r4
+    strh r4, [r1], #2
+    str r5, [r2], #4
+    lsr.w r5, r5, r12
+    strh r5, [r3], #2
+    subs lr, lr, #1
@@ -0,0 +1,60 @@
+#!/bin/sh
+# Runs the scenario of every exercise on its register and CMSIS driver versions, writes the
+# merged profiles to results.tsv and prints the summary table of README.md.
+#
+#   benchmarks/03_registers_vs_cmsis/run.sh [results.tsv]
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+OUT=${1:-$HERE/results.tsv}
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" all bench > /dev/null
+
+printf 'exercise\tvariant\tkind\tname\tcalls\tcycles\treads\twrites\tbytes\n' > "$TMP/results"
+
+grep -v '^#' "$HERE/scenarios" | while read -r exercise args; do
+    for variant in registers CMSIS_drivers; do
+        # Figures come from the instrumented build, sizes from the normal one.
+        "$SIM/build/bench/$exercise/LPC1769_$variant" $args -q -p "$TMP/profile"
+        nm -S -C -t d --defined-only "$SIM/build/$exercise/LPC1769_$variant" |
+            awk 'NF >= 4 && $3 ~ /^[tT]$/ { name = $4; for (i = 5; i <= NF; i++) name = name " " $i;
+                                              sub(/\(.*/, "", name); print name "\t" $2 + 0 }' > "$TMP/sizes"
+        # A function without a symbol of its own was inlined everywhere: its size is "-".
+        awk -F '\t' -v OFS='\t' -v exercise="$exercise" -v variant="$variant" '
+            FNR == NR { size[$1] = $2; next }
+            FNR == 1  { next }
+            { print exercise, variant, $0, ($1 == "func" ? ($2 in size ? size[$2] : "-") : "-") }
+        ' "$TMP/sizes" "$TMP/profile" >> "$TMP/results"
+    done
+done
+
+mv "$TMP/results" "$OUT"
+
+# Summary, registers / CMSIS: accesses of the config*() functions, bus cycles of the whole run,
+# worst ISR-to-output latency and bytes of the functions that ran.
+awk -F '\t' '
+    NR == 1 { next }
+    {
+        v = $2 == "registers" ? 0 : 1
+        if (!($1 in seen)) { seen[$1] = 1; order[n++] = $1 }
+        if ($3 == "func" && $4 ~ /^config/) cfg[$1, v] += $7 + $8
+        if ($3 == "func" && $9 != "-")      size[$1, v] += $9
+        if ($3 == "bus")                    bus[$1, v] += $6
+        if ($3 == "isr" && $6 != "-" && $6 > lat[$1, v] + 0) lat[$1, v] = $6
+    }
+    END {
+        print "| Exercise | Config accesses | Bus cycles | ISR to output (cycles) | Code bytes |"
+        print "|----------|-----------------|------------|------------------------|------------|"
+        for (i = 0; i < n; i++) {
+            e = order[i]
+            l = (e, 0) in lat ? lat[e, 0] " / " lat[e, 1] : "-"
+            printf "| `%s` | %d / %d | %d / %d | %s | %d / %d |\n", e, cfg[e, 0], cfg[e, 1], bus[e, 0], bus[e, 1], l,
+                   size[e, 0], size[e, 1]
+        }
+    }
+' "$OUT"
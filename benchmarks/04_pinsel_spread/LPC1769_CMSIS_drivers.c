@@ -0,0 +1,121 @@
+/**
+ * @file LPC1769_CMSIS_drivers.c
+ * @brief Benchmark of PINSEL_ConfigMultiplePinsSpread(): mask spreading against the per-pin loop.
+ *
+ * Every pin mask of CASES is configured on port 1 twice, from the same start state: once with
+ * PINSEL_ConfigMultiplePins() of the driver, which configures the pins one by one, and once with
+ * PINSEL_ConfigMultiplePinsSpread() of lib/pinselspread. Each case runs in its own function,
+ * loop_<case>() and spread_<case>(), so the profile of the host simulator gives the cycles and
+ * register accesses of every case (see run.sh).
+ *
+ * The PINSEL, PINMODE and PINMODE_OD registers left by both are compared; `benchErrors` counts
+ * the mismatches and `benchDone` is set once every case ran ITERATIONS times.
+ */
+
+#include "lpc17xx_pinsel.h"
+#include "pinselspread.h"
+
+/** Times every case runs. */
+#define ITERATIONS (10)
+
+/**
+ * @brief Pin masks of port 1, sparse to dense: `CASE(name, mask)`.
+ */
+#define CASES(CASE)                      \
+    CASE(sparse1, 0x00000400)            \
+    CASE(sparse3, 0x00100401)            \
+    CASE(dense8, 0x000000FF)             \
+    CASE(dense16, 0x0000FFFF)            \
+    CASE(dense32, 0xFFFFFFFF)
+
+/**
+ * @brief Configuration registers of port 1.
+ */
+typedef struct {
+    uint32_t sel[2];     /*!< PINSEL2, PINSEL3. */
+    uint32_t mode[2];    /*!< PINMODE2, PINMODE3. */
+    uint32_t od;         /*!< PINMODE_OD1. */
+} PortConfig;
+
+/**
+ * @brief Writes the start state of every case: GPIO, pull-up, push-pull.
+ */
+void resetPort(void);
+
+/**
+ * @brief Reads the configuration registers of port 1.
+ *
+ * @param config Filled with the registers.
+ */
+void readPort(PortConfig* config);
+
+/**
+ * @brief Runs one case with both implementations and compares the results.
+ *
+ * @param loop   Per-pin version of the case.
+ * @param spread Mask-spreading version of the case.
+ */
+void runCase(void (*loop)(void), void (*spread)(void));
+
+/** Configuration applied by every case: every field changes from the start state. */
+const PINSEL_CFG_Type pinCfg = {PINSEL_PORT_1, 0, PINSEL_FUNC_1, PINSEL_PULLDOWN, PINSEL_OD_OPENDRAIN};
+
+/** Defines loop_<name>() and spread_<name>(). */
+#define DEFINE_CASE(name, mask)                                                  \
+    void loop_##name(void) { PINSEL_ConfigMultiplePins(&pinCfg, mask); }         \
+    void spread_##name(void) { PINSEL_ConfigMultiplePinsSpread(&pinCfg, mask); }
+
+CASES(DEFINE_CASE)
+
+/** Runs both versions of a case. */
+#define RUN_CASE(name, mask) runCase(loop_##name, spread_##name);
+
+/** Cases whose implementations left different registers. */
+volatile uint32_t benchErrors = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+int main(void) {
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        CASES(RUN_CASE)
+    }
+    benchDone = 1;
+
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void resetPort(void) {
+    LPC_PINCON->PINSEL2     = 0;
+    LPC_PINCON->PINSEL3     = 0;
+    LPC_PINCON->PINMODE2    = 0;
+    LPC_PINCON->PINMODE3    = 0;
+    LPC_PINCON->PINMODE_OD1 = 0;
+}
+
+void readPort(PortConfig* config) {
+    config->sel[0]  = LPC_PINCON->PINSEL2;
+    config->sel[1]  = LPC_PINCON->PINSEL3;
+    config->mode[0] = LPC_PINCON->PINMODE2;
+    config->mode[1] = LPC_PINCON->PINMODE3;
+    config->od      = LPC_PINCON->PINMODE_OD1;
+}
+
+void runCase(void (*loop)(void), void (*spread)(void)) {
+    PortConfig expected, actual;
+
+    resetPort();
+    loop();
+    readPort(&expected);
+
+    resetPort();
+    spread();
+    readPort(&actual);
+
+    if (expected.sel[0] != actual.sel[0] || expected.sel[1] != actual.sel[1] ||
+        expected.mode[0] != actual.mode[0] || expected.mode[1] != actual.mode[1] || expected.od != actual.od)
+        benchErrors++;
+    resetPort();
+}
@@ -0,0 +1,17 @@
+@ Per-pin loop: one iteration, pin set, register index and field shift of setPinFunc(),
+@ setResistorMode() and setOpenDrainMode() (calls inlined). r0 = pins, r1 = pin, r2 = port.
+@ The loop and pin test branches add 2 cycles each when taken.
+    lsr r3, r0, r1
+    tst r3, #1
+    lsr r4, r1, #4
+    add r4, r4, r2, lsl #1
+    and r5, r1, #15
+    lsl r5, r5, #1
+    mov r6, #3
+    lsl r6, r6, r5
+    lsl r7, r8, r5
+    lsl r9, r10, r5
+    mov r11, #1
+    lsl r11, r11, r1
+    adds r1, r1, #1
+    cmp r1, #32
@@ -0,0 +1,17 @@
+@ spreadPins() and the field values of one half-port: r0 = pins, r1 = funcNum, r2 = pinMode.
+@ No branches; the register accesses are timed by the host simulator.
+    uxth r0, r0
+    orr r0, r0, r0, lsl #8
+    and r0, r0, #0x00FF00FF
+    orr r0, r0, r0, lsl #4
+    and r0, r0, #0x0F0F0F0F
+    orr r0, r0, r0, lsl #2
+    and r0, r0, #0x33333333
+    orr r0, r0, r0, lsl #1
+    and r0, r0, #0x55555555
+    add r0, r0, r0, lsl #1
+    mov r3, #0x55555555
+    mul r1, r3, r1
+    mul r2, r3, r2
+    and r1, r1, r0
+    and r2, r2, r0
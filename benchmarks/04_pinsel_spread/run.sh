@@ -0,0 +1,39 @@
+#!/bin/sh
+# Builds the benchmark for the host simulator, instrumented, and prints the table of README.md
+# from its profile: simulated cycles and register accesses per call of every case.
+#
+#   benchmarks/04_pinsel_spread/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+SRC=benchmarks/04_pinsel_spread/LPC1769_CMSIS_drivers.c
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" bench SRC=$SRC > /dev/null
+"$SIM/build/bench/${SRC%.c}" -q -t 10ms -p "$TMP/profile"
+
+# Cases in the order of CASES, pins set in their mask.
+awk -F '\t' '
+    BEGIN {
+        n = split("sparse1 sparse3 dense8 dense16 dense32", order, " ")
+        split("1 3 8 16 32", pins, " ")
+    }
+    $1 == "func" && $2 ~ /^(loop|spread)_/ {
+        split($2, part, "_")
+        cycles[part[1], part[2]]   = $4 / $3
+        accesses[part[1], part[2]] = ($5 + $6) / $3
+    }
+    END {
+        print "| Case | Pins | Per-pin loop (cycles / accesses) | Mask spreading (cycles / accesses) |"
+        print "|------|------|----------------------------------|------------------------------------|"
+        for (i = 1; i <= n; i++) {
+            c = order[i]
+            printf "| `%s` | %d | %d / %d | %d / %d |\n", c, pins[i], cycles["loop", c], accesses["loop", c],
+                   cycles["spread", c], accesses["spread", c]
+        }
+    }
+' "$TMP/profile"
@@ -0,0 +1,146 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Benchmark of the 4-bit ALU: flash lookup table against the computed operations.
+ *
+ * Both versions run one pass of the loop of
+ * [09_alu_4bit](../../module1_gpio_pinsel/09_alu_4bit/README.md) on every one of the 2048 input
+ * words (A, B and the operation on P0.0-P0.10):
+ *
+ * - computedALU(): reads A, B and the operation from FIOPIN, branches on the operation and
+ *   writes the result (FIOCLR, FIOSET) and the overflow LED (FIOSET or FIOCLR), as the exercise
+ *   did with add() and subtract(), extended to every operation of alu4.h.
+ * - tableALU(): one FIOPIN read, one load from the ALU4_TABLE and one FIOPIN write.
+ *
+ * The input pins are outputs here, so FIOPIN reads back the input word written by the benchmark.
+ * The LEDs (P2.0-P2.4) left by both are compared; `benchErrors` counts the mismatches and
+ * `benchDone` is set once every input ran ITERATIONS times. The profile of the host simulator
+ * gives the cycles and register accesses per call of each version (see run.sh).
+ */
+
+#include "LPC17xx.h"
+#include "alu4.h"
+
+/** Times every input word runs. */
+#define ITERATIONS (4)
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x)     (0x1 << (x))
+/** Generic n-bit mask macro. */
+#define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
+
+/** Bit mask for the A operand (P0.0-P0.3). */
+#define A_MASK   BITS_MASK(4, 0)
+/** Bit mask for the B operand (P0.4-P0.7). */
+#define B_MASK   BITS_MASK(4, 4)
+/** Bit mask for the operation selectors (P0.8-P0.10). */
+#define OP_MASK  BITS_MASK(3, 8)
+/** Bit mask for the result display (P2.0-P2.3). */
+#define LED_MASK BITS_MASK(4, 0)
+/** Bit mask for the overflow indicator (P2.4). */
+#define OVF_LED  BIT_MASK(4)
+
+/** Output word (P2.0-P2.4) of every input word (P0.0-P0.10). */
+static const uint8_t aluTable[ALU4_ENTRIES] = ALU4_TABLE;
+
+/**
+ * @brief One pass of the computed ALU: reads the inputs, computes and writes the LEDs.
+ */
+void computedALU(void);
+
+/**
+ * @brief One pass of the table-driven ALU: reads the inputs and writes the LEDs from the table.
+ */
+void tableALU(void);
+
+/**
+ * @brief Sets the overflow LED if `flag` is set and clears it otherwise.
+ *
+ * @param flag Overflow, negative or shifted-out condition.
+ */
+void setOverflow(uint8_t flag);
+
+/** Input words whose versions left different LEDs. */
+volatile uint32_t benchErrors = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+int main(void) {
+    LPC_GPIO0->FIODIR |= A_MASK | B_MASK | OP_MASK;    // Inputs driven by the benchmark.
+    LPC_GPIO2->FIODIR |= LED_MASK | OVF_LED;
+    LPC_GPIO0->FIOMASK = ~(A_MASK | B_MASK | OP_MASK);
+    LPC_GPIO2->FIOMASK = ~(LED_MASK | OVF_LED);
+
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        for (uint32_t inputs = 0; inputs < ALU4_ENTRIES; inputs++) {
+            LPC_GPIO0->FIOPIN = inputs;
+
+            LPC_GPIO2->FIOPIN = 0;
+            computedALU();
+            const uint32_t expected = LPC_GPIO2->FIOPIN;
+
+            LPC_GPIO2->FIOPIN = 0;
+            tableALU();
+            if (LPC_GPIO2->FIOPIN != expected)
+                benchErrors++;
+        }
+    }
+    benchDone = 1;
+
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void computedALU(void) {
+    const uint8_t A  = LPC_GPIO0->FIOPIN & A_MASK;             // Read P0.0-P0.3
+    const uint8_t B  = (LPC_GPIO0->FIOPIN & B_MASK) >> 4;      // Read P0.4-P0.7
+    const uint8_t op = (LPC_GPIO0->FIOPIN & OP_MASK) >> 8;     // Read P0.8-P0.10
+    uint32_t result;
+
+    switch (op) {
+        case ALU4_OP_ADD:
+            result = A + B;
+            setOverflow(result > 0x0F);
+            break;
+        case ALU4_OP_SUB:
+            setOverflow(B > A);
+            result = B > A ? B - A : A - B;
+            break;
+        case ALU4_OP_AND:
+            result = A & B;
+            setOverflow(0);
+            break;
+        case ALU4_OP_OR:
+            result = A | B;
+            setOverflow(0);
+            break;
+        case ALU4_OP_XOR:
+            result = A ^ B;
+            setOverflow(0);
+            break;
+        case ALU4_OP_SHL:
+            result = (uint32_t)A << B;
+            setOverflow(result > 0x0F);
+            break;
+        case ALU4_OP_SHR:
+            result = A >> B;
+            setOverflow((result << B) != A);
+            break;
+        default:
+            result = A * B;
+            setOverflow(result > 0x0F);
+            break;
+    }
+    LPC_GPIO2->FIOCLR = LED_MASK;
+    LPC_GPIO2->FIOSET = result & LED_MASK;
+}
+
+void tableALU(void) { LPC_GPIO2->FIOPIN = aluTable[LPC_GPIO0->FIOPIN]; }
+
+void setOverflow(uint8_t flag) {
+    if (flag)
+        LPC_GPIO2->FIOSET = OVF_LED;    // Set overflow LED.
+    else
+        LPC_GPIO2->FIOCLR = OVF_LED;    // Clear overflow LED.
+}
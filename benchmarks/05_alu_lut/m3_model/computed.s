@@ -0,0 +1,20 @@
+@ computedALU(), multiply case (setOverflow() inlined): r0 = &LPC_GPIO0->FIOPIN,
+@ r1 = &LPC_GPIO2->FIOSET, r2 = &LPC_GPIO2->FIOCLR, r4 = jump table of the operations.
+@ The dispatch branch adds 2 cycles and each of the other taken branches 2 more.
+    ldr r3, [r0]
+    and r3, r3, #15
+    ldr r5, [r0]
+    ubfx r5, r5, #4, #4
+    ldr r6, [r0]
+    ubfx r6, r6, #8, #3
+    ldr r7, [r4, r6, lsl #2]
+    mul r8, r3, r5
+    cmp r8, #15
+    mov r9, #16
+    ite hi
+    strhi r9, [r1]
+    strls r9, [r2]
+    mov r9, #15
+    str r9, [r2]
+    and r8, r8, #15
+    str r8, [r1]
@@ -0,0 +1,5 @@
+@ tableALU(): r0 = &LPC_GPIO0->FIOPIN, r1 = aluTable, r2 = &LPC_GPIO2->FIOPIN.
+@ No branches; the two register accesses are timed by the host simulator.
+    ldr r3, [r0]
+    ldrb r3, [r1, r3]
+    str r3, [r2]
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Builds the benchmark for the host simulator, instrumented, and prints the table of README.md
+# from its profile: simulated cycles and register accesses per pass of both versions.
+#
+#   benchmarks/05_alu_lut/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+SRC=benchmarks/05_alu_lut/LPC1769_registers.c
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" bench SRC=$SRC > /dev/null
+"$SIM/build/bench/${SRC%.c}" -q -t 10ms -p "$TMP/profile"
+
+# computedALU() includes its setOverflow() calls.
+awk -F '\t' '
+    $1 == "func" && $2 ~ /^(computed|table)ALU$/ {
+        calls[$2]  = $3
+        cycles[$2] = $4 / $3
+        reads[$2]  = $5 / $3
+        writes[$2] = $6 / $3
+    }
+    END {
+        print "| Version | Passes | Cycles per pass | Reads / writes per pass |"
+        print "|---------|--------|-----------------|-------------------------|"
+        split("computedALU tableALU", order, " ")
+        for (i = 1; i <= 2; i++) {
+            f = order[i]
+            printf "| `%s()` | %d | %d | %d / %d |\n", f, calls[f], cycles[f], reads[f], writes[f]
+        }
+    }
+' "$TMP/profile"
@@ -0,0 +1,60 @@
+#!/bin/sh
+# Runs the scenario of every exercise of benchmark 3 on its register and CMSIS driver versions
+# and prints the table of README.md: the share of the run each one spends awake, in the thread
+# and in its handlers, from the busiest to the most idle.
+#
+#   benchmarks/06_cpu_load/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" all > /dev/null
+
+grep -v '^#' "$ROOT/benchmarks/03_registers_vs_cmsis/scenarios" | while read -r exercise args; do
+    for variant in registers CMSIS_drivers; do
+        "$SIM/build/$exercise/LPC1769_$variant" $args -q -p "$TMP/profile"
+        awk -F '\t' -v OFS='\t' -v exercise="$exercise" -v variant="$variant" \
+            '$1 == "cpu" || $1 == "run" { print exercise, variant, $0 }' "$TMP/profile"
+    done
+done > "$TMP/load"
+
+# One line per exercise, keyed by the awake share of the register version (then of the CMSIS
+# one), sorted from the busiest; equal keys keep the order of the scenarios. Cycles are given per
+# simulated second (100 MHz core), so runs of any length compare.
+awk -F '\t' '
+    {
+        v = $2 == "registers" ? 0 : 1
+        if (!($1 in seen)) { seen[$1] = 1; order[n++] = $1 }
+        if ($3 == "run" && $4 == "total") total[$1, v] = $6
+        if ($3 == "run" && $4 == "sleep") sleep[$1, v] = $6
+        if ($3 == "cpu" && $4 == "thread") thread[$1, v] = $6
+        if ($3 == "cpu" && $4 != "thread") {
+            handlers[$1, v] += $6
+            if ($6 > top[$1, v] + 0) { top[$1, v] = $6; topName[$1, v] = $4 }
+        }
+    }
+    function perSecond(x, e, v) { return x * 100000000 / total[e, v] }
+    END {
+        for (i = 0; i < n; i++) {
+            e  = order[i]
+            a0 = (total[e, 0] - sleep[e, 0]) / total[e, 0]
+            a1 = (total[e, 1] - sleep[e, 1]) / total[e, 1]
+            h  = "-"
+            if ((e, 0) in topName)
+                h = sprintf("`%s` %d / %d", topName[e, 0], perSecond(top[e, 0], e, 0), perSecond(top[e, 1], e, 1))
+            printf "%.9f\t%.9f\t%d\t| `%s` | %.2f / %.2f | %d / %d | %d / %d | %d / %d | %s |\n", a0, a1, i, e,
+                   100 * a0, 100 * a1, perSecond(total[e, 0] - sleep[e, 0], e, 0),
+                   perSecond(total[e, 1] - sleep[e, 1], e, 1), perSecond(thread[e, 0], e, 0),
+                   perSecond(thread[e, 1], e, 1), perSecond(handlers[e, 0], e, 0), perSecond(handlers[e, 1], e, 1), h
+        }
+    }
+' "$TMP/load" | sort -t '	' -k1,1gr -k2,2gr -k3,3n | cut -f4 > "$TMP/rows"
+
+echo "| Rank | Exercise | Awake % | Awake cycles/s | Thread cycles/s | Handler cycles/s | Busiest handler (cycles/s) |"
+echo "|------|----------|---------|----------------|-----------------|------------------|----------------------------|"
+awk '{ print "| " NR " " $0 }' "$TMP/rows"
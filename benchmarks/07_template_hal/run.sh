@@ -0,0 +1,82 @@
+#!/bin/sh
+# Builds every exercise, then compares the C++ template version of each module 1 exercise with
+# its register version: the disassembly of every function of the exercise, and the bus accesses
+# and GPIO levels of a run with the scenario of benchmark 3. Prints the table of README.md and
+# the diff of the first function that differs, if any. A function with no code of its own in
+# both binaries (inlined everywhere, or renamed) is counted apart, not as identical.
+#
+#   benchmarks/07_template_hal/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" all > /dev/null
+
+# Instructions of function $2 in binary $1, without addresses: branch and call targets are
+# kept as symbol+offset, and the addresses of the firmware data (tables) become DATA.
+disasm() {
+    objdump -d --no-show-raw-insn -C "$1" | awk -v f="$2" '
+        $0 ~ "^[0-9a-f]+ <" f "(\\(\\))?>:$" { on = 1; next }
+        on && /^$/                        { exit }
+        on {
+            sub(/^ *[0-9a-f]+:\t/, "")
+            gsub(/[0-9a-f]+ </, "<")
+            gsub(/0x[0-9a-f]+\(%rip\)/, "(%rip)")
+            gsub(/0x4[0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f]\>/, "DATA")
+            print
+        }'
+}
+
+echo "| Exercise | Functions | Identical instructions | Inlined in both | Bus accesses | Same trace and GPIO levels |"
+echo "|----------|-----------|------------------------|-----------------|--------------|----------------------------|"
+
+grep '^module1_gpio_pinsel/' "$ROOT/benchmarks/03_registers_vs_cmsis/scenarios" | while read -r exercise args; do
+    [ -f "$ROOT/$exercise/LPC1769_template_hal.cpp" ] || continue
+    reg=$SIM/build/$exercise/LPC1769_registers
+    tpl=$SIM/build/$exercise/LPC1769_template_hal
+
+    # Functions defined by the register version.
+    funcs=$(sed -n 's/^[A-Za-z].*[ *]\([A-Za-z_][A-Za-z0-9_]*\)(.*) *{.*$/\1/p' "$ROOT/$exercise/LPC1769_registers.c")
+    total=0
+    same=0
+    inlined=0
+    for f in $funcs; do
+        total=$((total + 1))
+        disasm "$reg" "$f" > "$TMP/reg.s"
+        disasm "$tpl" "$f" > "$TMP/tpl.s"
+        # A function inlined into its callers in both versions is compared with them; if only
+        # one version has it, the versions differ.
+        if [ ! -s "$TMP/reg.s" ] && [ ! -s "$TMP/tpl.s" ]; then
+            inlined=$((inlined + 1))
+        elif cmp -s "$TMP/reg.s" "$TMP/tpl.s"; then
+            same=$((same + 1))
+        elif [ ! -f "$TMP/first.diff" ]; then
+            echo "$exercise $f()" > "$TMP/first.diff"
+            diff "$TMP/reg.s" "$TMP/tpl.s" >> "$TMP/first.diff" || true
+        fi
+    done
+
+    for v in reg tpl; do
+        eval bin=\$$v
+        "$bin" $args -g -b "$TMP/$v.bin" > "$TMP/$v.gpio" 2> "$TMP/$v.report"
+        "$SIM/build/bustrace" -d "$TMP/$v.bin" > "$TMP/$v.trace"
+    done
+    accesses=$(sed -n 's/^register accesses *: *\([0-9]*\).*/\1/p' "$TMP/reg.report")
+    if cmp -s "$TMP/reg.trace" "$TMP/tpl.trace" && cmp -s "$TMP/reg.gpio" "$TMP/tpl.gpio" &&
+        [ "$accesses" = "$(sed -n 's/^register accesses *: *\([0-9]*\).*/\1/p' "$TMP/tpl.report")" ]; then
+        trace=yes
+    else
+        trace=no
+    fi
+    echo "| \`$exercise\` | $total | $same of $((total - inlined)) | $inlined | $accesses | $trace |"
+done
+
+if [ -f "$TMP/first.diff" ]; then
+    echo
+    cat "$TMP/first.diff"
+fi
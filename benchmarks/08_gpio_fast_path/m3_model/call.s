@@ -0,0 +1,15 @@
+@ GPIO_SetPins(GPIO_PORT_2, value) through the driver: argument set-up, call, port check and
+@ register block from the switch table, FIOSET store, return. r4 = value.
+@ The bl is left out (llvm-mca charges calls 100 cycles): it costs as a taken branch. bl and
+@ bx lr refill the pipeline, 2 cycles each on top of the model (not modelled).
+    movs r0, #2
+    mov r1, r4
+    b .Lentry
+.Lentry:
+    cmp r0, #4
+    bhi .Lout
+    ldr r3, =0x100
+    ldr r3, [r3, r0, lsl #2]
+    str r1, [r3, #24]
+.Lout:
+    bx lr
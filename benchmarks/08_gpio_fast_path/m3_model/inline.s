@@ -0,0 +1,4 @@
+@ GPIO_SetPinsFast(GPIO_PORT_2, value): the port folds to the address of LPC_GPIO2, one
+@ literal load and the FIOSET store. r4 = value.
+    ldr r3, =0x2009C040
+    str r4, [r3, #24]
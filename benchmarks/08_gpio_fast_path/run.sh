@@ -0,0 +1,69 @@
+#!/bin/sh
+# Builds every exercise with the out-of-line GPIO driver and with its inline fast path
+# (GPIO_FAST_PATH), runs the CMSIS version of each exercise with the scenario of benchmark 3 on
+# both, and prints the table of README.md: GPIO driver calls made, in handlers too, calls left
+# with the fast path, whether both builds make the same accesses and levels, code bytes, and the
+# Cortex-M3 cycles the calls cost according to m3_model.
+#
+#   benchmarks/08_gpio_fast_path/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+FAST=build/fast_path
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+# Cycles of one GPIO_SetPins() call minus one inline FIOSET store: llvm-mca of call.s and
+# inline.s, plus the 2 refill cycles of bl and of bx lr that it does not model.
+mca() {
+    llvm-mca -mtriple=thumbv7m-none-eabi -mcpu=cortex-m3 -iterations=1000 "$HERE/m3_model/$1.s" 2> /dev/null |
+        awk '/^Total Cycles:/ { printf "%d\n", ($3 - 1) / 1000 }'
+}
+PER_CALL=$(($(mca call) + 4 - $(mca inline)))
+
+make -C "$SIM" -j"$(nproc)" all bench > /dev/null
+make -C "$SIM" -j"$(nproc)" BUILD=$FAST DEFS=-DGPIO_FAST_PATH all bench > /dev/null
+
+# Functions of the GPIO driver that have a fast path.
+DATA='^GPIO_(SetDir|SetPins|ClearPins|SetValue|ClearValue|WriteValue|ReadValue)$'
+
+# Bytes of the functions of profile $2 that have a symbol in binary $1.
+bytes() {
+    nm -S -C -t d --defined-only "$1" |
+        awk 'NF >= 4 && $3 ~ /^[tT]$/ { name = $4; sub(/\(.*/, "", name); print name "\t" $2 + 0 }' |
+        awk -F '\t' 'FNR == NR { size[$1] = $2; next } $1 == "func" && $2 in size { n += size[$2] } END { print n + 0 }' - "$2"
+}
+
+echo "| Exercise | Driver calls | In handlers | Calls with fast path | Same trace and GPIO levels | Code bytes | M3 cycles saved |"
+echo "|----------|--------------|-------------|----------------------|----------------------------|------------|-----------------|"
+
+grep -v '^#' "$ROOT/benchmarks/03_registers_vs_cmsis/scenarios" | while read -r exercise args; do
+    for v in drv fast; do
+        [ $v = drv ] && build=$SIM/build || build=$SIM/$FAST
+        "$build/bench/$exercise/LPC1769_CMSIS_drivers" $args -q -g -p "$TMP/$v.profile" -b "$TMP/$v.bin" > "$TMP/$v.gpio"
+        # Access records without their call path, which loses the driver frames with the fast path.
+        "$SIM/build/bustrace" -d "$TMP/$v.bin" | awk '$2 ~ /^[RW]$/ { print $1, $2, $3, $4 }' > "$TMP/$v.trace"
+        eval ${v}_bytes=$(bytes "$build/$exercise/LPC1769_CMSIS_drivers" "$TMP/$v.profile")
+        eval ${v}_calls=$(awk -F '\t' -v re="$DATA" '$1 == "func" && $2 ~ re { n += $3 } END { print n + 0 }' "$TMP/$v.profile")
+    done
+
+    # Driver calls in the handlers of the traced accesses: GPIO_SetDir() makes two, the others one.
+    isr=$("$SIM/build/bustrace" -d "$TMP/drv.bin" | awk '
+        $NF !~ /^main>/ && $NF ~ />GPIO_(SetDir|SetPins|ClearPins|WriteValue|ReadValue)$/ {
+            n += $NF ~ /SetDir$/ ? 0.5 : 1
+        }
+        END { print int(n) }')
+
+    if cmp -s "$TMP/drv.trace" "$TMP/fast.trace" && cmp -s "$TMP/drv.gpio" "$TMP/fast.gpio"; then
+        same=yes
+    else
+        same=no
+    fi
+    echo "| \`$exercise\` | $drv_calls | $isr | $fast_calls | $same | $drv_bytes / $fast_bytes | $((drv_calls * PER_CALL)) |"
+done
+
+echo
+echo "Cycles per call: $PER_CALL"
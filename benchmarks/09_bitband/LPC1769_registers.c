@@ -0,0 +1,153 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Benchmark of single-pin access: bit-band aliases against the GPIO registers.
+ *
+ * Every method of METHODS changes P0.22 ITERATIONS times, in its own function, while TIMER1
+ * interrupts every 1009 core cycles and toggles P0.21, on the same port, with FIOSET/FIOCLR:
+ *
+ * - toggle_SetClr(): FIOPIN read, then FIOSET and FIOCLR of the bit (02_systick_basic).
+ * - toggle_Xor(): `FIOPIN ^= LED` (exam 2025 q2).
+ * - toggle_Masked(): FIOMASK leaves the pin only, `FIOPIN = ~FIOPIN`, FIOMASK cleared.
+ * - toggle_BitBand(): BITBAND_PinToggle(), one load and one store of the alias word.
+ * - pulse_Regs(): FIOSET then FIOCLR of the bit.
+ * - pulse_BitBand(): BITBAND_PinWrite() of 1, then of 0.
+ *
+ * The interrupt period is prime, so it lands on every access of the methods in turn. On each
+ * entry the handler checks that P0.21 is still at the level it left; if not, it calls the
+ * error_<method>() function of the running method. The profile of the host simulator gives the
+ * cycles and accesses per call of each method and the errors of each (see run.sh).
+ */
+
+#include "LPC17xx.h"
+#include "bitband.h"
+
+/** Calls of every method. */
+#define ITERATIONS (20000)
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1 << (x))
+
+/** Pin changed by the methods (P0.22) and its mask. */
+#define LED_PIN (22)
+#define LED_BIT BIT_MASK(LED_PIN)
+/** Pin toggled by the interrupt (P0.21) and its mask. */
+#define ISR_PIN (21)
+#define ISR_BIT BIT_MASK(ISR_PIN)
+
+/** PCONP: TIMER1 power bit. */
+#define PCTIM1      BIT_MASK(2)
+/** PCLKSEL0: TIMER1 peripheral clock field, and its CCLK value. */
+#define PCLK_TIMER1 (4)
+#define PCLK_CCLK   (1)
+/** TIMER1 period in core cycles, a prime. */
+#define ISR_PERIOD  (1009)
+/** MCR: interrupt and reset on MR0. */
+#define MCR_MR0     (BIT_MASK(0) | BIT_MASK(1))
+/** IR: MR0 interrupt flag. */
+#define IR_MR0      BIT_MASK(0)
+/** TCR: counter enable. */
+#define TCR_ENABLE  BIT_MASK(0)
+
+/**
+ * @brief Methods: `METHOD(kind, name, body)`, body changing P0.22 once (toggle) or twice (pulse).
+ */
+#define METHODS(METHOD)                                                                      \
+    METHOD(toggle, SetClr, {                                                                 \
+        const uint32_t current = LPC_GPIO0->FIOPIN;                                          \
+        LPC_GPIO0->FIOSET      = ~current & LED_BIT;                                         \
+        LPC_GPIO0->FIOCLR      = current & LED_BIT;                                          \
+    })                                                                                       \
+    METHOD(toggle, Xor, { LPC_GPIO0->FIOPIN ^= LED_BIT; })                                   \
+    METHOD(toggle, Masked, {                                                                 \
+        LPC_GPIO0->FIOMASK = ~LED_BIT;                                                       \
+        LPC_GPIO0->FIOPIN  = ~LPC_GPIO0->FIOPIN;                                             \
+        LPC_GPIO0->FIOMASK = 0;                                                              \
+    })                                                                                       \
+    METHOD(toggle, BitBand, { BITBAND_PinToggle(0, LED_PIN); })                              \
+    METHOD(pulse, Regs, {                                                                    \
+        LPC_GPIO0->FIOSET = LED_BIT;                                                         \
+        LPC_GPIO0->FIOCLR = LED_BIT;                                                         \
+    })                                                                                       \
+    METHOD(pulse, BitBand, {                                                                 \
+        BITBAND_PinWrite(0, LED_PIN, 1);                                                     \
+        BITBAND_PinWrite(0, LED_PIN, 0);                                                     \
+    })
+
+/** Defines <kind>_<name>() and error_<kind>_<name>(). */
+#define DEFINE_METHOD(kind, name, body)     \
+    void kind##_##name(void) body           \
+    void error_##kind##_##name(void) { benchErrors++; }
+
+/** Runs a method. */
+#define RUN_METHOD(kind, name, body) runMethod(kind##_##name, error_##kind##_##name);
+
+/**
+ * @brief Configures P0.21 and P0.22 as outputs and TIMER1 to interrupt every ISR_PERIOD cycles.
+ */
+void configBench(void);
+
+/**
+ * @brief Runs a method ITERATIONS times, with `error` reporting the interrupt errors.
+ *
+ * @param method Method.
+ * @param error  Called by the interrupt when it finds P0.21 changed.
+ */
+void runMethod(void (*method)(void), void (*error)(void));
+
+/** Interrupt errors, all methods. */
+volatile uint32_t benchErrors = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+/** Error report of the running method. */
+void (*volatile onError)(void) = 0;
+/** Level the interrupt left on P0.21. */
+volatile uint32_t isrLevel = 0;
+
+METHODS(DEFINE_METHOD)
+
+int main(void) {
+    configBench();
+
+    METHODS(RUN_METHOD)
+    benchDone = 1;
+
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void configBench(void) {
+    LPC_PINCON->PINSEL1 &= ~((0x3 << 2 * (LED_PIN - 16)) | (0x3 << 2 * (ISR_PIN - 16)));    // GPIO.
+    LPC_GPIO0->FIODIR |= LED_BIT | ISR_BIT;
+    LPC_GPIO0->FIOCLR = LED_BIT | ISR_BIT;
+
+    LPC_SC->PCONP |= PCTIM1;
+    LPC_SC->PCLKSEL0 = (LPC_SC->PCLKSEL0 & ~(0x3 << PCLK_TIMER1)) | (PCLK_CCLK << PCLK_TIMER1);
+    LPC_TIM1->MR0 = ISR_PERIOD - 1;
+    LPC_TIM1->MCR = MCR_MR0;
+    LPC_TIM1->TCR = TCR_ENABLE;
+    NVIC_EnableIRQ(TIMER1_IRQn);
+}
+
+void runMethod(void (*method)(void), void (*error)(void)) {
+    onError = error;
+    for (uint32_t i = 0; i < ITERATIONS; i++)
+        method();
+}
+
+void TIMER1_IRQHandler(void) {
+    const uint32_t level = (LPC_GPIO0->FIOPIN & ISR_BIT) != 0;
+
+    if (level != isrLevel && onError)
+        onError();
+    isrLevel = !level;    // Toggle from the level read: an error is counted once.
+    if (isrLevel)
+        LPC_GPIO0->FIOSET = ISR_BIT;
+    else
+        LPC_GPIO0->FIOCLR = ISR_BIT;
+
+    LPC_TIM1->IR = IR_MR0;
+}
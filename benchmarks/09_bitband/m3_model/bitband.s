@@ -0,0 +1,6 @@
+@ toggle_BitBand: load of the alias word of P0.22 in FIOPIN, store of its complement. The bus
+@ turns the store into a locked read and write of FIOPIN, behind the write buffer.
+    ldr r2, =0x233802D8
+    ldr r3, [r2]
+    eor r3, r3, #1
+    str r3, [r2]
@@ -0,0 +1,9 @@
+@ toggle_Masked: FIOMASK = ~LED, FIOPIN = ~FIOPIN, FIOMASK = 0.
+    ldr r2, =0x2009C000
+    mvn r1, #0x400000
+    movs r0, #0
+    str r1, [r2, #16]
+    ldr r3, [r2, #20]
+    mvns r3, r3
+    str r3, [r2, #20]
+    str r0, [r2, #16]
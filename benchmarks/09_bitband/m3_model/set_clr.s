@@ -0,0 +1,9 @@
+@ toggle_SetClr: FIOPIN read, FIOSET = ~current & LED, FIOCLR = current & LED.
+@ r2 = LPC_GPIO0, loaded once.
+    ldr r2, =0x2009C000
+    ldr r3, [r2, #20]
+    mvn r1, r3
+    and r1, r1, #0x400000
+    and r3, r3, #0x400000
+    str r1, [r2, #24]
+    str r3, [r2, #28]
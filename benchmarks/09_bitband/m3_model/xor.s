@@ -0,0 +1,5 @@
+@ toggle_Xor: FIOPIN ^= LED, a read and a write the interrupt can split.
+    ldr r2, =0x2009C000
+    ldr r3, [r2, #20]
+    eor r3, r3, #0x400000
+    str r3, [r2, #20]
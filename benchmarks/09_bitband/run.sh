@@ -0,0 +1,38 @@
+#!/bin/sh
+# Builds the benchmark for the host simulator, instrumented, and prints the table of README.md
+# from its profile: simulated cycles and register accesses per call of every method, and the
+# errors found by the interrupt sharing the port.
+#
+#   benchmarks/09_bitband/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+SRC=benchmarks/09_bitband/LPC1769_registers.c
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" bench SRC=$SRC > /dev/null
+"$SIM/build/bench/${SRC%.c}" -q -t 30ms -p "$TMP/profile"
+
+# Methods in the order of METHODS; error_<method>() is only in the profile if it was called.
+awk -F '\t' '
+    $1 == "func" && $2 ~ /^(toggle|pulse)_/ {
+        calls[$2]  = $3
+        cycles[$2] = $4 / $3
+        reads[$2]  = $5 / $3
+        writes[$2] = $6 / $3
+    }
+    $1 == "func" && $2 ~ /^error_/ { errors[substr($2, 7)] = $3 }
+    END {
+        print "| Method | Calls | Cycles per call | Reads / writes per call | Interrupt errors |"
+        print "|--------|-------|-----------------|-------------------------|------------------|"
+        n = split("toggle_SetClr toggle_Xor toggle_Masked toggle_BitBand pulse_Regs pulse_BitBand", order, " ")
+        for (i = 1; i <= n; i++) {
+            f = order[i]
+            printf "| `%s()` | %d | %d | %d / %d | %d |\n", f, calls[f], cycles[f], reads[f], writes[f], errors[f]
+        }
+    }
+' "$TMP/profile"
@@ -0,0 +1,163 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Benchmark of multi-bit output updates: FIOCLR/FIOSET against single-store field writes.
+ *
+ * Every method of METHODS writes ITERATIONS values to the 8-bit field P2.0-P2.7, in its own
+ * function, while TIMER1 interrupts every 1009 core cycles and toggles P2.10, on the same port:
+ *
+ * - write_SetClr(): FIOCLR of the field, then FIOSET of the value (04_hex_counter, 06_bit_counter
+ *   and 10_moving_avg before portfield.h).
+ * - write_Owned(): PORTFIELD_Write(), FIOMASK given to the field by PORTFIELD_Own() for the run.
+ * - write_Byte(): PORTFIELD_WriteByte() of lane 0 (FIO2PIN0).
+ * - write_Shared(): PORTFIELD_WriteShared(), FIOMASK saved and restored around the FIOPIN write.
+ *
+ * Consecutive values always differ, so every call changes the field once; any other change of
+ * the field is an intermediate state. runMethod() toggles P0.22 before each method, so the -g
+ * output of the host simulator splits into one part per method (see run.sh).
+ *
+ * The interrupt shares the port the way portfield.h requires: it saves FIOMASK, masks every pin
+ * but P2.10, reads and writes FIOPIN and restores the mask. On each entry it checks that P2.10 is
+ * still at the level it left; if not, it calls the error_<method>() function of the running
+ * method.
+ */
+
+#include "LPC17xx.h"
+#include "bitband.h"
+#include "portfield.h"
+
+/** Calls of every method. */
+#define ITERATIONS (20000)
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x)     (0x1 << (x))
+/** Generic n-bit mask macro. */
+#define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
+
+/** Field written by the methods (P2.0-P2.7). */
+#define FIELD_BITS BITS_MASK(8, 0)
+/** Step between consecutive values: odd, so no value repeats the previous one. */
+#define FIELD_STEP (37)
+/** Pin toggled by the interrupt (P2.10) and its mask. */
+#define ISR_PIN    (10)
+#define ISR_BIT    BIT_MASK(ISR_PIN)
+/** Method marker pin (P0.22), toggled before every method. */
+#define MARK_PIN   (22)
+
+/** PCONP: TIMER1 power bit. */
+#define PCTIM1      BIT_MASK(2)
+/** PCLKSEL0: TIMER1 peripheral clock field, and its CCLK value. */
+#define PCLK_TIMER1 (4)
+#define PCLK_CCLK   (1)
+/** TIMER1 period in core cycles, a prime. */
+#define ISR_PERIOD  (1009)
+/** MCR: interrupt and reset on MR0. */
+#define MCR_MR0     (BIT_MASK(0) | BIT_MASK(1))
+/** IR: MR0 interrupt flag. */
+#define IR_MR0      BIT_MASK(0)
+/** TCR: counter enable. */
+#define TCR_ENABLE  BIT_MASK(0)
+
+/**
+ * @brief Methods: `METHOD(name, mask, body)`, body writing `value` to the field with FIOMASK set
+ *        to `mask` for the whole run.
+ */
+#define METHODS(METHOD)                                                     \
+    METHOD(SetClr, 0, {                                                     \
+        LPC_GPIO2->FIOCLR = FIELD_BITS;                                     \
+        LPC_GPIO2->FIOSET = value;                                          \
+    })                                                                      \
+    METHOD(Owned, ~FIELD_BITS, { PORTFIELD_Write(LPC_GPIO2, value); })      \
+    METHOD(Byte, 0, { PORTFIELD_WriteByte(LPC_GPIO2, 0, value); })          \
+    METHOD(Shared, 0, { PORTFIELD_WriteShared(LPC_GPIO2, FIELD_BITS, value); })
+
+/** Defines write_<name>() and error_<name>(). */
+#define DEFINE_METHOD(name, mask, body)     \
+    void write_##name(uint32_t value) body  \
+    void error_##name(void) { benchErrors++; }
+
+/** Runs a method. */
+#define RUN_METHOD(name, mask, body) runMethod(write_##name, error_##name, mask);
+
+/**
+ * @brief Configures P2.0-P2.7, P2.10 and P0.22 as outputs and TIMER1 to interrupt every
+ *        ISR_PERIOD cycles.
+ */
+void configBench(void);
+
+/**
+ * @brief Runs a method ITERATIONS times, with `error` reporting the interrupt errors.
+ *
+ * @param method Method.
+ * @param error  Called by the interrupt when it finds P2.10 changed.
+ * @param mask   FIOMASK of port 2 during the run.
+ */
+void runMethod(void (*method)(uint32_t), void (*error)(void), uint32_t mask);
+
+/** Interrupt errors, all methods. */
+volatile uint32_t benchErrors = 0;
+/** Set when the benchmark is complete. */
+volatile uint32_t benchDone = 0;
+
+/** Error report of the running method. */
+void (*volatile onError)(void) = 0;
+/** Level the interrupt left on P2.10. */
+volatile uint32_t isrLevel = 0;
+
+METHODS(DEFINE_METHOD)
+
+int main(void) {
+    configBench();
+
+    METHODS(RUN_METHOD)
+    benchDone = 1;
+
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void configBench(void) {
+    LPC_PINCON->PINSEL4 &= ~(BITS_MASK(16, 0) | (0x3 << 2 * ISR_PIN));    // P2.0-P2.7, P2.10.
+    LPC_PINCON->PINSEL1 &= ~(0x3 << 2 * (MARK_PIN - 16));                  // P0.22.
+    LPC_GPIO2->FIODIR |= FIELD_BITS | ISR_BIT;
+    LPC_GPIO2->FIOCLR = FIELD_BITS | ISR_BIT;
+    LPC_GPIO0->FIOSET = BIT_MASK(MARK_PIN);    // High, as the pin reads as an input.
+    LPC_GPIO0->FIODIR |= BIT_MASK(MARK_PIN);
+
+    LPC_SC->PCONP |= PCTIM1;
+    LPC_SC->PCLKSEL0 = (LPC_SC->PCLKSEL0 & ~(0x3 << PCLK_TIMER1)) | (PCLK_CCLK << PCLK_TIMER1);
+    LPC_TIM1->MR0 = ISR_PERIOD - 1;
+    LPC_TIM1->MCR = MCR_MR0;
+    LPC_TIM1->TCR = TCR_ENABLE;
+    NVIC_EnableIRQ(TIMER1_IRQn);
+}
+
+void runMethod(void (*method)(uint32_t), void (*error)(void), uint32_t mask) {
+    uint32_t value = 0;
+
+    BITBAND_PinToggle(0, MARK_PIN);    // Start of the method in the GPIO levels.
+    onError            = error;
+    LPC_GPIO2->FIOMASK = mask;
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        value = (value + FIELD_STEP) & FIELD_BITS;
+        method(value);
+    }
+    LPC_GPIO2->FIOMASK = 0;
+}
+
+void TIMER1_IRQHandler(void) {
+    const uint32_t saved = LPC_GPIO2->FIOMASK;    // As PORTFIELD_WriteShared(), with a read.
+
+    LPC_GPIO2->FIOMASK = ~ISR_BIT;
+    const uint32_t level = LPC_GPIO2->FIOPIN != 0;
+
+    if (level != isrLevel && onError)
+        onError();
+    isrLevel           = !level;    // Toggle from the level read: an error is counted once.
+    LPC_GPIO2->FIOPIN  = isrLevel ? ISR_BIT : 0;
+    LPC_GPIO2->FIOMASK = saved;
+
+    LPC_TIM1->IR = IR_MR0;
+}
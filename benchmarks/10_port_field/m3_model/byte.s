@@ -0,0 +1,4 @@
+@ write_Byte: FIOPIN0 = value.
+@ r0 = value, r2 = LPC_GPIO2, loaded once.
+    ldr r2, =0x2009C040
+    strb r0, [r2, #20]
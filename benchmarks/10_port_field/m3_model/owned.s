@@ -0,0 +1,4 @@
+@ write_Owned: FIOPIN = value, FIOMASK set once by PORTFIELD_Own().
+@ r0 = value, r2 = LPC_GPIO2, loaded once.
+    ldr r2, =0x2009C040
+    str r0, [r2, #20]
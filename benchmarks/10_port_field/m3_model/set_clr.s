@@ -0,0 +1,6 @@
+@ write_SetClr: FIOCLR = FIELD_BITS, FIOSET = value.
+@ r0 = value, r2 = LPC_GPIO2, loaded once.
+    ldr r2, =0x2009C040
+    movs r3, #0xFF
+    str r3, [r2, #28]
+    str r0, [r2, #24]
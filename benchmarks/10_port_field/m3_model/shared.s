@@ -0,0 +1,8 @@
+@ write_Shared: saved = FIOMASK, FIOMASK = ~FIELD_BITS, FIOPIN = value, FIOMASK = saved.
+@ r0 = value, r2 = LPC_GPIO2, loaded once.
+    ldr r2, =0x2009C040
+    ldr r1, [r2, #16]
+    mvn r3, #0xFF
+    str r3, [r2, #16]
+    str r0, [r2, #20]
+    str r1, [r2, #16]
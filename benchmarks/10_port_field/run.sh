@@ -0,0 +1,53 @@
+#!/bin/sh
+# Builds the benchmark for the host simulator, instrumented, and prints the table of README.md:
+# register accesses per call of every method from its profile, the changes of the field and the
+# intermediate states among them from its GPIO levels, and the errors found by the interrupt
+# sharing the port.
+#
+#   benchmarks/10_port_field/run.sh
+
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$HERE/../.." && pwd)
+SIM=$ROOT/host_sim
+SRC=benchmarks/10_port_field/LPC1769_registers.c
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+make -C "$SIM" -j"$(nproc)" bench SRC=$SRC > /dev/null
+"$SIM/build/bench/${SRC%.c}" -q -g -t 30ms -p "$TMP/profile" > "$TMP/gpio"
+
+# Changes of P2.0-P2.7 per method: each P0 change (P0.22) starts the next method of METHODS.
+awk '
+    $3 == "P0" { method++ }
+    $3 == "P2" {
+        field = substr($5, length($5) - 1)    # Last two hex digits: P2.0-P2.7.
+        if (method && field != last)
+            print "changes\t" method "\t1"
+        last = field
+    }
+' "$TMP/gpio" > "$TMP/changes"
+
+# Methods in the order of METHODS; error_<method>() is only in the profile if it was called.
+awk -F '\t' '
+    FNR == NR { changes[$2] += $3; next }
+    $1 == "func" && $2 ~ /^write_/ {
+        name         = substr($2, 7)
+        calls[name]  = $3
+        cycles[name] = $4 / $3
+        reads[name]  = $5 / $3
+        writes[name] = $6 / $3
+    }
+    $1 == "func" && $2 ~ /^error_/ { errors[substr($2, 7)] = $3 }
+    END {
+        print "| Method | Calls | Cycles per call | Reads / writes per call | Field changes | Intermediate states | Interrupt errors |"
+        print "|--------|-------|-----------------|-------------------------|---------------|---------------------|------------------|"
+        n = split("SetClr Owned Byte Shared", order, " ")
+        for (i = 1; i <= n; i++) {
+            f = order[i]
+            printf "| `write_%s()` | %d | %d | %d / %d | %d | %d | %d |\n", f, calls[f], cycles[f],
+                   reads[f], writes[f], changes[i], changes[i] - calls[f], errors[f]
+        }
+    }
+' "$TMP/changes" "$TMP/profile"
@@ -1,4 +1,5 @@
 #include "LPC17xx.h"
+#include "gpioirq.h"
 
 // configuración de pines PINSEL/PINMODE
 void configPCB(void);
@@ -6,6 +7,8 @@ void configPCB(void);
 void configINT(void);
 // configurar systick 200ms
 void configST(void);
+// flanco de bajada del botón P0.0, llamado por el despachador de EINT3
+void boton(void* arg);
 
 volatile uint8_t fBoton = 0;
 volatile uint8_t cBoton = 0;
@@ -42,9 +45,7 @@ void configINT(void) {
     NVIC_ClearPendingIRQ(EINT0_IRQn);
     NVIC_EnableIRQ(EINT0_IRQn);
 
-    LPC_GPIOINT->IO0IntEnF |= 1 << 0;
-    LPC_GPIOINT->IO0IntClr = 1 << 0;
-    NVIC_EnableIRQ(EINT3_IRQn);
+    GPIOIRQ_Attach(0, 0, GPIOIRQ_FALLING, boton, 0);    // limpia, habilita P0.0 (f) y EINT3
 }
 
 void configST(void) {
@@ -64,14 +65,12 @@ void EINT0_IRQHandler(void) {
     LPC_SC->EXTINT |= 1 << 0;
 }
 
-void EINT3_IRQHandler(void) {
-    if (LPC_GPIOINT->IO0IntStatF & (1 << 0)) {
-        if (fBoton == 1) {
-            pBoton++;
-        }
-        fBoton = 1; // inicia la ventana 3s
+void boton(void* arg) {
+    (void)arg;
+    if (fBoton == 1) {
+        pBoton++;
     }
-    LPC_GPIOINT->IO0IntClr = 1 << 0;
+    fBoton = 1; // inicia la ventana 3s
 }
 
 void SysTick_Handler(void) {
@@ -45,7 +45,7 @@ void configPCB(void) {
 void configInt(void) {
     LPC_SC->EXTMODE |= (1 << 2);    // EINT2 as edge sensitive.
 
-    LPC_SC->EXTINT |= (1 << 2);
+    LPC_SC->EXTINT = (1 << 2);
     NVIC_ClearPendingIRQ(EINT2_IRQn);
     NVIC_EnableIRQ(EINT2_IRQn);
 }
@@ -57,7 +57,7 @@ void configSystick(void) {
                     1 << 2;     // Use processor clock.
 }
 
-void EINT0_IRQHandler(void) {
+void EINT2_IRQHandler(void) {
     if (seq) {                           // Button pressed while sequence running.
         SysTick->CTRL &= ~1;             // Disable SysTick.
         LPC_GPIO2->FIOSET = (1 << 4);    // Set P2.4 to 1. Back to idle state.
@@ -65,8 +65,8 @@ void EINT0_IRQHandler(void) {
         counter = 0;    // Reset sequence counter.
         seq     = 0;    // No sequence running.
 
-        LPC_SC->EXTINT |= (1 << 2);    // Clear EINT2 interrupt flag.
-        return;                        // Early return.
+        LPC_SC->EXTINT = (1 << 2);    // Clear EINT2 interrupt flag.
+        return;                       // Early return.
     }
 
     SysTick->VAL = 0;      // Reset current value.
@@ -76,7 +76,7 @@ void EINT0_IRQHandler(void) {
 
     seq = 1;    // Sequence running.
 
-    LPC_SC->EXTINT |= (1 << 2);    // Clear EINT2 interrupt flag.
+    LPC_SC->EXTINT = (1 << 2);    // Clear EINT2 interrupt flag.
 }
 
 void SysTick_Handler(void) {
@@ -0,0 +1,75 @@
+/*  Exam 2025, question 1, with the waveform generator of the workshop library instead of SysTick.
+
+    Each falling edge on EINT2 (P2.12) plays on P2.4 the sequence of 10 ms states
+    0-0-0-0-1-0-1-0-1-0-1-0-0-0-0. A new interrupt while the sequence plays sets P2.4 to 1 (idle)
+    and ends it; a press after the end or the abort plays it again from the start. The pins of
+    port 2 other than P2.4 are masked.
+
+    The sequence is run-length encoded: a 40 ms low step, seven 10 ms pulses and a 40 ms low step,
+    9 steps in flash instead of 15 ticks. In WAVEGEN_DMA mode the GPDMA writes every step and the
+    CPU only wakes up for the button and the end of the sequence.
+*/
+
+#include "LPC17xx.h"
+#include "wavegen.h"
+
+/** Sequence output: P2.4. */
+#define OUT_BIT (1 << 4)
+
+void configPCB(void);
+void configInt(void);
+void configWave(void);
+
+/** Levels of P2.4 in each step of the sequence. */
+const uint32_t levels[] = {0, OUT_BIT, 0, OUT_BIT, 0, OUT_BIT, 0, OUT_BIT, 0};
+/** Duration of each step, in 1 ms ticks. */
+const uint32_t durations[] = {
+    WAVEGEN_TICKS(40), WAVEGEN_TICKS(10), WAVEGEN_TICKS(10), WAVEGEN_TICKS(10), WAVEGEN_TICKS(10),
+    WAVEGEN_TICKS(10), WAVEGEN_TICKS(10), WAVEGEN_TICKS(10), WAVEGEN_TICKS(40),
+};
+/** The sequence of the statement. */
+const WAVEGEN_Wave secuencia = {levels, durations, sizeof(levels) / sizeof(levels[0])};
+
+int main(void) {
+    configPCB();
+    configWave();
+    configInt();
+
+    while (1) {
+        __WFI();
+    }
+}
+
+void configPCB(void) {
+    LPC_PINCON->PINSEL4 |= (1 << 24);    // P2.12 as EINT2.
+}
+
+void configWave(void) {
+    const WAVEGEN_CFG_Type cfg = {
+        LPC_GPIO2,      // Port 2.
+        OUT_BIT,        // Only P2.4: FIOMASK masks the rest of the port.
+        OUT_BIT,        // Idle state of P2.4 is 1.
+        1000,           // 1 ms ticks.
+        WAVEGEN_DMA,    // No CPU per step.
+    };
+
+    WAVEGEN_Init(&cfg);
+}
+
+void configInt(void) {
+    LPC_SC->EXTMODE |= (1 << 2);    // EINT2 as edge sensitive, falling edge (EXTPOLAR default).
+
+    LPC_SC->EXTINT = (1 << 2);    // Clear EINT2 flag.
+    NVIC_ClearPendingIRQ(EINT2_IRQn);
+    NVIC_EnableIRQ(EINT2_IRQn);
+}
+
+void EINT2_IRQHandler(void) {
+    if (WAVEGEN_IsPlaying()) {    // Button pressed while the sequence plays.
+        WAVEGEN_Stop();           // P2.4 back to 1.
+    } else {
+        WAVEGEN_Play(&secuencia, 0);    // Once, from the first state.
+    }
+
+    LPC_SC->EXTINT = (1 << 2);    // Clear EINT2 interrupt flag.
+}
@@ -20,7 +20,9 @@ Se pide:
  */
 
 #include "LPC17xx.h"
-#define LED (1 << 18)
+#include "bitband.h"
+#define LED_PIN (18)
+#define LED     (1 << LED_PIN)
 
 // volatile uint32_t t, t_prev, periodo;
 volatile uint32_t t      = 0;
@@ -32,7 +34,7 @@ void SysTick_Handler(void) {
     if (i < period) {
         i++;
     } else {
-        LPC_GPIO1->FIOPIN ^= LED;    // Toggle LED state.
+        BITBAND_PinToggle(1, LED_PIN);    // Toggle LED state, other P1 pins untouched.
         i = 0;
     }
 
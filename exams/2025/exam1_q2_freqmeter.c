@@ -0,0 +1,91 @@
+/*
+Exam 2025, question 2, with the period measured by the capture engine of the workshop library.
+
+The LED on P1.18 blinks with the period of the square wave applied to the input, limited to
+100-1000 ms: shorter periods blink at 100 ms, longer ones (or no signal) at 1000 ms.
+
+The original solution counts 1 ms SysTick ticks between EINT1 interrupts: the period is known to
+1 ms and the count is read and reset in a race with the tick. Here the input moves to CAP3.0
+(P0.23) and every edge is timestamped by TIMER3 at the PCLK rate; the LED only needs a software
+timer, on the tickless TIMER0 driver, so the CPU sleeps between edges and LED toggles.
+ */
+
+#include "LPC17xx.h"
+#include "bitband.h"
+#include "freqmeter.h"
+#include "swtimer.h"
+#include "tickless.h"
+
+#define LED_PIN (18)
+#define LED     (1 << LED_PIN)
+
+/** Software timer tick in microseconds (1 ms). */
+#define TICK_US (1000)
+/** Blink period limits in ms. */
+#define MIN_PERIOD (100)
+#define MAX_PERIOD (1000)
+
+/**
+ * @brief Toggles the LED, every half blink period.
+ *
+ * @param arg Unused.
+ */
+void toggleLed(void* arg);
+
+/**
+ * @brief Limits a measured period to the blink range and restarts the blink if it changed.
+ *
+ * @param periodNs Measured period in ns, 0 without signal.
+ */
+void setBlink(uint32_t periodNs);
+
+/** LED blink timer. */
+SWTIMER_Type blink;
+/** Current blink period in ms. */
+uint32_t blinkPeriod = 0;
+
+int main(void) {
+    const FREQMETER_CFG_Type meter = {
+        TICK_US,    // 1 ms ticks.
+        100,        // 100 ms gate.
+        15,         // No edge for 1.5 s: no signal.
+        1,          // Every period is a measurement.
+        1000000,    // Pulses under 1 ms are glitches (contact bounce).
+        0,          // Slow signals only: capture mode.
+    };
+    FREQMETER_Result measure;
+
+    LPC_GPIO1->FIODIR |= LED;    // P1.18 as output.
+
+    TICKLESS_Init(TICK_US);
+    SWTIMER_Init(&blink, toggleLed, 0);
+    setBlink(0);
+    FREQMETER_Init(&meter);
+
+    while (1) {
+        __WFI();
+        FREQMETER_Process();
+        if (FREQMETER_Get(&measure))
+            setBlink(measure.periodNs);
+    }
+}
+
+void toggleLed(void* arg) {
+    (void)arg;
+    BITBAND_PinToggle(1, LED_PIN);    // Toggle LED state, other P1 pins untouched.
+}
+
+void setBlink(uint32_t periodNs) {
+    uint32_t period = periodNs / 1000000;
+
+    if (period < MIN_PERIOD) {
+        period = periodNs ? MIN_PERIOD : MAX_PERIOD;    // No signal: slowest blink.
+    } else if (period > MAX_PERIOD) {
+        period = MAX_PERIOD;
+    }
+
+    if (period != blinkPeriod) {
+        blinkPeriod = period;
+        SWTIMER_Start(&blink, period / 2, period / 2);
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file cpuload.c
+ * @brief Regression check of the cpuload module against the simulator's own accounting.
+ *
+ * A 100 us SysTick and the EINT0 interrupt it pends every other tick, which preempts it, are
+ * both instrumented; the thread does some work and sleeps in CPULOAD_Sleep() between ticks.
+ * After 20 ticks the report of the module must add up to its total and agree with the
+ * simulator (sim.h, read here as a testbench would): elapsed time, sleep, entries and the
+ * cycles of each handler, which the module measures without exception entry and return.
+ *
+ * Returns 0 when every check passes; otherwise prints the failed checks and returns 1.
+ */
+
+#include <stdio.h>
+
+#include "LPC17xx.h"
+#include "cpuload.h"
+#include "sim.h"
+
+/** Handler slots. */
+#define LOAD_SYSTICK (0)
+#define LOAD_EINT0   (1)
+/** Ticks measured. */
+#define TICKS (20)
+/** Cycles of a handler that the module cannot see: entry, return and one CYCCNT read. */
+#define OVERHEAD (sim::COST_IRQ_ENTRY + sim::COST_IRQ_EXIT + 2 * sim::COST_PPB)
+
+/** Ticks so far. */
+static volatile uint32_t ticks = 0;
+/** Failed checks. */
+static uint32_t failures = 0;
+
+/**
+ * @brief Prints a check that failed and counts it.
+ */
+static void check(int ok, const char* what) {
+    if (!ok) {
+        printf("cpuload: FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Checks that a figure of the module is within `tolerance` cycles of the simulator's.
+ */
+static int near(uint64_t measured, uint64_t simulated, uint64_t tolerance) {
+    return measured <= simulated + tolerance && simulated <= measured + tolerance;
+}
+
+/**
+ * @brief Burns `cycles` cycles.
+ */
+static void work(uint32_t cycles) {
+    while (cycles--)
+        __NOP();
+}
+
+void SysTick_Handler(void) {
+    CPULOAD_HANDLER_BEGIN();
+    work(100);
+    if (++ticks % 2 == 0)
+        NVIC_SetPendingIRQ(EINT0_IRQn);    // Preempts this handler: its cycles are not ours.
+    work(100);
+    CPULOAD_HANDLER_END(LOAD_SYSTICK);
+}
+
+void EINT0_IRQHandler(void) {
+    CPULOAD_HANDLER_BEGIN();
+    work(50);
+    CPULOAD_HANDLER_END(LOAD_EINT0);
+}
+
+int main(void) {
+    CPULOAD_Report load;
+
+    NVIC_SetPriority(EINT0_IRQn, 0);
+    NVIC_EnableIRQ(EINT0_IRQn);
+    CPULOAD_Init();
+    SysTick_Config(SystemCoreClock / 10000);    // 100 us.
+
+    const uint64_t start        = sim::now;
+    const uint64_t sleepStart   = sim::stats.sleepCycles;
+    const uint64_t systickStart = sim::stats.handlerCycles[sim::EXC_SYSTICK];
+    const uint64_t eint0Start   = sim::stats.handlerCycles[sim::EXC_IRQ0 + EINT0_IRQn];
+    CPULOAD_Get(&load, 1);
+
+    while (ticks < TICKS) {
+        work(300);
+        CPULOAD_Sleep();
+    }
+
+    CPULOAD_Get(&load, 0);
+    const uint64_t elapsed = sim::now - start;
+    const uint64_t sleep   = sim::stats.sleepCycles - sleepStart;
+    const uint64_t systick = sim::stats.handlerCycles[sim::EXC_SYSTICK] - systickStart;
+    const uint64_t eint0   = sim::stats.handlerCycles[sim::EXC_IRQ0 + EINT0_IRQn] - eint0Start;
+
+    check(load.sleep + load.thread + load.handler[LOAD_SYSTICK] + load.handler[LOAD_EINT0] == load.total &&
+              load.thread < load.total,
+          "sleep, thread and handlers add up to the total");
+    // The CYCCNT reads of the module are charged on either side of the simulator's boundaries.
+    check(near(load.total, elapsed, 4 * sim::COST_PPB), "total matches the simulated time");
+    check(near(load.sleep, sleep, TICKS * 2 * sim::COST_PPB), "sleep matches the __WFI() cycles of the simulator");
+    check(load.entries[LOAD_SYSTICK] == TICKS && load.entries[LOAD_EINT0] == TICKS / 2,
+          "one entry per SysTick and per EINT0");
+    check(load.handler[LOAD_SYSTICK] <= systick && near(load.handler[LOAD_SYSTICK], systick, TICKS * OVERHEAD),
+          "SysTick cycles match the simulator, EINT0 excluded");
+    check(load.handler[LOAD_EINT0] <= eint0 && near(load.handler[LOAD_EINT0], eint0, TICKS / 2 * OVERHEAD),
+          "EINT0 cycles match the simulator");
+    check(load.activePpm == (load.total - load.sleep) * 1000000 / load.total, "awake time in millionths");
+    check(load.activePpm > 0 && load.activePpm < 1000000, "awake time is neither 0 nor all");
+
+    if (!failures)
+        printf("cpuload: ok\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file freqmeter.c
+ * @brief Regression check of the freqmeter module: capture and counter mode and the switch.
+ *
+ * Run with freqmeter.stim, a square wave on CAP3.0 that steps from 20 kHz to 50 kHz, back to
+ * 20 kHz and down to 5 kHz. With counter mode above 30 kHz, averages of 8 periods and 1 ms
+ * gates, the measurements must be, in each step:
+ *
+ * - 20 kHz: capture mode, 20000 Hz and 30.0 % duty, every edge taken by the interrupt.
+ * - 50 kHz: counter mode after the switch, 50 kHz to one edge per gate, no duty.
+ * - 20 kHz again: still counter mode (it switches back below 15 kHz), 20 kHz.
+ * - 5 kHz: capture mode again, 5000 Hz and 20.0 % duty.
+ *
+ * No edge may be lost to a full FIFO, and none taken for a glitch.
+ *
+ * Returns 0 when every check passes; otherwise prints the failed checks and returns 1.
+ */
+
+#include <stdio.h>
+
+#include "LPC17xx.h"
+#include "freqmeter.h"
+#include "swtimer.h"
+
+/** Software timer tick in microseconds. */
+#define TICK_US (100)
+/** Ticks measured: the 15 ms of the stimulus. */
+#define TICKS (150)
+/** Measurements kept. */
+#define MAX_RESULTS (64)
+
+/**
+ * @brief Measurement and the tick at which it was read.
+ */
+typedef struct {
+    uint32_t tick;                /*!< Tick when FREQMETER_Get() returned it. */
+    FREQMETER_Result result;      /*!< Measurement. */
+} Sample;
+
+/** Ticks so far. */
+static volatile uint32_t ticks = 0;
+/** Measurements read so far. */
+static Sample samples[MAX_RESULTS];
+static uint32_t numSamples = 0;
+/** Failed checks. */
+static uint32_t failures = 0;
+
+/**
+ * @brief Prints a check that failed and counts it.
+ */
+static void check(int ok, const char* what) {
+    if (!ok) {
+        printf("freqmeter: FAIL %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Checks the measurements read in ticks [from, to).
+ *
+ * @param from      First tick.
+ * @param to        Tick after the last one.
+ * @param mode      Mode of every measurement.
+ * @param hz        Expected frequency.
+ * @param tolerance Tolerance of the frequency in Hz.
+ * @param duty      Expected duty cycle in thousandths, or FREQMETER_NO_DUTY.
+ * @param what      Step, for the failure message.
+ */
+static void checkStep(uint32_t from, uint32_t to, uint8_t mode, uint32_t hz, uint32_t tolerance, uint16_t duty,
+                      const char* what) {
+    uint32_t found = 0;
+    uint32_t bad   = 0;
+
+    for (uint32_t i = 0; i < numSamples; i++) {
+        const FREQMETER_Result* r = &samples[i].result;
+
+        if (samples[i].tick < from || samples[i].tick >= to)
+            continue;
+        found++;
+        if (r->mode != mode || r->frequencyHz + tolerance < hz || r->frequencyHz > hz + tolerance)
+            bad++;
+        else if (duty == FREQMETER_NO_DUTY ? r->dutyPermille != duty
+                                           : r->dutyPermille + 2 < duty || r->dutyPermille > duty + 2)
+            bad++;
+    }
+    check(found > 0 && bad == 0, what);
+}
+
+void SysTick_Handler(void) {
+    ticks++;
+    SWTIMER_Tick();
+}
+
+int main(void) {
+    const FREQMETER_CFG_Type meter = {
+        TICK_US,    // 100 us ticks.
+        10,         // 1 ms gate.
+        0,          // No idle check.
+        8,          // 8 periods per measurement.
+        1000,       // Pulses under 1 us are glitches.
+        30000,      // Counter mode above 30 kHz.
+    };
+    FREQMETER_Result measure;
+
+    SysTick_Config(SystemCoreClock / (1000000 / TICK_US));
+    check(FREQMETER_Init(&meter) == 0, "FREQMETER_Init() accepts the configuration");
+
+    while (ticks < TICKS) {
+        __WFI();
+        FREQMETER_Process();
+        if (FREQMETER_Get(&measure) && numSamples < MAX_RESULTS) {
+            samples[numSamples].tick   = ticks;
+            samples[numSamples].result = measure;
+            numSamples++;
+        }
+    }
+
+    // Each window leaves out the measurements that may still span the previous step.
+    checkStep(1, 20, FREQMETER_CAPTURE, 20000, 20, 300, "20 kHz measured in capture mode, 30 % duty");
+    checkStep(23, 61, FREQMETER_COUNTER, 50000, 1000, FREQMETER_NO_DUTY, "50 kHz measured in counter mode");
+    checkStep(62, 92, FREQMETER_COUNTER, 20000, 1000, FREQMETER_NO_DUTY, "20 kHz again, still in counter mode");
+    checkStep(101, TICKS + 1, FREQMETER_CAPTURE, 5000, 5, 200, "5 kHz measured in capture mode again, 20 % duty");
+    check(FREQMETER_GetOverruns() == 0, "no edge lost to a full FIFO");
+    check(FREQMETER_GetGlitches() == 0, "no edge taken for a glitch");
+
+    if (!failures)
+        printf("freqmeter: ok\n");
+    return failures ? 1 : 0;
+}
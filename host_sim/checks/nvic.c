@@ -0,0 +1,72 @@
+/**
+ * @file nvic.c
+ * @brief Regression check of the NVIC model: priorities, pending and active state.
+ *
+ * EINT0 and EINT1 are pended with PRIMASK set and dispatched when it is cleared: EINT1, with
+ * the higher priority, must run first, and must see itself active in IABR. EINT2 is pended
+ * while disabled and cleared: it must not be pending any more, nor run once enabled.
+ *
+ * Returns 0 when every check passes; otherwise prints the failed checks and returns 1.
+ */
+
+#include <stdio.h>
+
+#include "LPC17xx.h"
+
+/** Handlers in the order they ran. */
+static volatile uint32_t order[3];
+/** Number of handlers that ran. */
+static volatile uint32_t entries = 0;
+/** NVIC_GetActive() of EINT1 in its own handler. */
+static volatile uint32_t eint1Active = 0;
+/** Failed checks. */
+static uint32_t failures = 0;
+
+/**
+ * @brief Prints a check that failed and counts it.
+ */
+static void check(int ok, const char* what) {
+    if (!ok) {
+        printf("nvic: FAIL %s\n", what);
+        failures++;
+    }
+}
+
+void EINT0_IRQHandler(void) { order[entries++] = 0; }
+
+void EINT1_IRQHandler(void) {
+    eint1Active       = NVIC_GetActive(EINT1_IRQn);
+    order[entries++] = 1;
+}
+
+void EINT2_IRQHandler(void) { order[entries++] = 2; }
+
+int main(void) {
+    NVIC_SetPriority(EINT0_IRQn, 5);
+    NVIC_SetPriority(EINT1_IRQn, 1);
+    check(NVIC_GetPriority(EINT0_IRQn) == 5, "EINT0 priority reads back");
+    check(NVIC_GetPriority(EINT1_IRQn) == 1, "EINT1 priority reads back");
+
+    __disable_irq();
+    NVIC_EnableIRQ(EINT0_IRQn);
+    NVIC_EnableIRQ(EINT1_IRQn);
+    NVIC_SetPendingIRQ(EINT0_IRQn);
+    NVIC_SetPendingIRQ(EINT1_IRQn);
+    __enable_irq();
+
+    check(entries == 2, "EINT0 and EINT1 both dispatched");
+    check(order[0] == 1 && order[1] == 0, "EINT1 (priority 1) dispatched before EINT0 (priority 5)");
+    check(eint1Active, "EINT1 active in IABR in its handler");
+    check(!NVIC_GetActive(EINT1_IRQn), "EINT1 not active after its handler");
+
+    NVIC_SetPendingIRQ(EINT2_IRQn);
+    check(NVIC_GetPendingIRQ(EINT2_IRQn), "EINT2 pending while disabled");
+    NVIC_ClearPendingIRQ(EINT2_IRQn);
+    check(!NVIC_GetPendingIRQ(EINT2_IRQn), "EINT2 no longer pending after NVIC_ClearPendingIRQ");
+    NVIC_EnableIRQ(EINT2_IRQn);
+    check(entries == 2, "cleared EINT2 not dispatched once enabled");
+
+    if (!failures)
+        printf("nvic: ok\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file lpc17xx_exti.h
+ * @brief External interrupt driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#ifndef LPC17XX_EXTI_H
+#define LPC17XX_EXTI_H
+
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** External interrupt lines. */
+#define EXTI_EINT0 (0)
+#define EXTI_EINT1 (1)
+#define EXTI_EINT2 (2)
+#define EXTI_EINT3 (3)
+
+/** Sensitivity modes. */
+#define EXTI_LEVEL_SENSITIVE (0)
+#define EXTI_EDGE_SENSITIVE  (1)
+
+/** Polarities. */
+#define EXTI_LOW_ACTIVE   (0)
+#define EXTI_FALLING_EDGE (0)
+#define EXTI_HIGH_ACTIVE  (1)
+#define EXTI_RISING_EDGE  (1)
+
+/**
+ * @brief External interrupt configuration.
+ */
+typedef struct {
+    uint8_t line;     /*!< EXTI_EINTx. */
+    uint8_t mode;     /*!< EXTI_LEVEL_SENSITIVE or EXTI_EDGE_SENSITIVE. */
+    uint8_t polarity; /*!< EXTI_LOW_ACTIVE/EXTI_FALLING_EDGE or EXTI_HIGH_ACTIVE/EXTI_RISING_EDGE. */
+} EXTI_CFG_Type;
+
+/**
+ * @brief Configures an external interrupt line, clears its flag and enables it in the NVIC.
+ *
+ * @param extiCfg Line configuration.
+ */
+void EXTI_ConfigEnable(const EXTI_CFG_Type* extiCfg);
+
+/**
+ * @brief Clears the flag of an external interrupt line.
+ *
+ * @param line EXTI_EINTx.
+ */
+void EXTI_ClearFlag(uint8_t line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LPC17XX_EXTI_H
@@ -0,0 +1,125 @@
+/**
+ * @file lpc17xx_gpio.h
+ * @brief GPIO driver of the LPC17xx CMSIS drivers (host build).
+ *
+ * Same API and register accesses as the driver used by the LPC1769_CMSIS_drivers.c exercises,
+ * built against the simulated registers so both versions of an exercise can be compared.
+ */
+
+#ifndef LPC17XX_GPIO_H
+#define LPC17XX_GPIO_H
+
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** GPIO ports. */
+#define GPIO_PORT_0 (0)
+#define GPIO_PORT_1 (1)
+#define GPIO_PORT_2 (2)
+#define GPIO_PORT_3 (3)
+#define GPIO_PORT_4 (4)
+
+/** Pin directions. */
+#define GPIO_INPUT  (0)
+#define GPIO_OUTPUT (1)
+
+/** GPIO interrupt edges. */
+#define GPIO_INT_RISING  (0)
+#define GPIO_INT_FALLING (1)
+
+/**
+ * @brief Sets the direction of pins.
+ *
+ * @param portNum  Port (GPIO_PORT_0 ... GPIO_PORT_4).
+ * @param bitValue Pins to configure.
+ * @param dir      GPIO_INPUT or GPIO_OUTPUT.
+ */
+void GPIO_SetDir(uint8_t portNum, uint32_t bitValue, uint8_t dir);
+
+/**
+ * @brief Drives pins high (FIOSET).
+ *
+ * @param portNum  Port.
+ * @param bitValue Pins to set.
+ */
+void GPIO_SetPins(uint8_t portNum, uint32_t bitValue);
+
+/**
+ * @brief Drives pins low (FIOCLR).
+ *
+ * @param portNum  Port.
+ * @param bitValue Pins to clear.
+ */
+void GPIO_ClearPins(uint8_t portNum, uint32_t bitValue);
+
+/**
+ * @brief Former name of GPIO_SetPins().
+ */
+void GPIO_SetValue(uint8_t portNum, uint32_t bitValue);
+
+/**
+ * @brief Former name of GPIO_ClearPins().
+ */
+void GPIO_ClearValue(uint8_t portNum, uint32_t bitValue);
+
+/**
+ * @brief Writes the whole port (FIOPIN); masked pins are not changed.
+ *
+ * @param portNum Port.
+ * @param value   Port value.
+ */
+void GPIO_WriteValue(uint8_t portNum, uint32_t value);
+
+/**
+ * @brief Reads the whole port (FIOPIN).
+ *
+ * @param portNum Port.
+ * @return Port value.
+ */
+uint32_t GPIO_ReadValue(uint8_t portNum);
+
+/**
+ * @brief Masks or unmasks pins (FIOMASK).
+ *
+ * @param portNum  Port.
+ * @param bitValue Pins.
+ * @param newState ENABLE to mask the pins, DISABLE to unmask them.
+ */
+void GPIO_SetMask(uint8_t portNum, uint32_t bitValue, FunctionalState newState);
+
+/**
+ * @brief Enables the GPIO interrupt of pins on one edge. Only ports 0 and 2 have interrupts.
+ *
+ * @param portNum  GPIO_PORT_0 or GPIO_PORT_2.
+ * @param bitValue Pins.
+ * @param edge     GPIO_INT_RISING or GPIO_INT_FALLING.
+ */
+void GPIO_IntCmd(uint8_t portNum, uint32_t bitValue, uint8_t edge);
+
+/**
+ * @brief Clears the GPIO interrupt flags of pins.
+ *
+ * @param portNum  GPIO_PORT_0 or GPIO_PORT_2.
+ * @param bitValue Pins.
+ */
+void GPIO_ClearInt(uint8_t portNum, uint32_t bitValue);
+
+/**
+ * @brief Returns the interrupt status of a pin.
+ *
+ * @param portNum GPIO_PORT_0 or GPIO_PORT_2.
+ * @param pinNum  Pin.
+ * @param edge    GPIO_INT_RISING or GPIO_INT_FALLING.
+ * @return SET if the interrupt is pending, RESET otherwise.
+ */
+FunctionalState GPIO_GetIntStatus(uint8_t portNum, uint32_t pinNum, uint8_t edge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LPC17XX_GPIO_H
@@ -0,0 +1,103 @@
+/**
+ * @file lpc17xx_pinsel.h
+ * @brief Pin connect block driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#ifndef LPC17XX_PINSEL_H
+#define LPC17XX_PINSEL_H
+
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Ports. */
+#define PINSEL_PORT_0 (0)
+#define PINSEL_PORT_1 (1)
+#define PINSEL_PORT_2 (2)
+#define PINSEL_PORT_3 (3)
+#define PINSEL_PORT_4 (4)
+
+/** Pins. */
+#define PINSEL_PIN_0  (0)
+#define PINSEL_PIN_1  (1)
+#define PINSEL_PIN_2  (2)
+#define PINSEL_PIN_3  (3)
+#define PINSEL_PIN_4  (4)
+#define PINSEL_PIN_5  (5)
+#define PINSEL_PIN_6  (6)
+#define PINSEL_PIN_7  (7)
+#define PINSEL_PIN_8  (8)
+#define PINSEL_PIN_9  (9)
+#define PINSEL_PIN_10 (10)
+#define PINSEL_PIN_11 (11)
+#define PINSEL_PIN_12 (12)
+#define PINSEL_PIN_13 (13)
+#define PINSEL_PIN_14 (14)
+#define PINSEL_PIN_15 (15)
+#define PINSEL_PIN_16 (16)
+#define PINSEL_PIN_17 (17)
+#define PINSEL_PIN_18 (18)
+#define PINSEL_PIN_19 (19)
+#define PINSEL_PIN_20 (20)
+#define PINSEL_PIN_21 (21)
+#define PINSEL_PIN_22 (22)
+#define PINSEL_PIN_23 (23)
+#define PINSEL_PIN_24 (24)
+#define PINSEL_PIN_25 (25)
+#define PINSEL_PIN_26 (26)
+#define PINSEL_PIN_27 (27)
+#define PINSEL_PIN_28 (28)
+#define PINSEL_PIN_29 (29)
+#define PINSEL_PIN_30 (30)
+#define PINSEL_PIN_31 (31)
+
+/** Pin functions. */
+#define PINSEL_FUNC_0 (0)
+#define PINSEL_FUNC_1 (1)
+#define PINSEL_FUNC_2 (2)
+#define PINSEL_FUNC_3 (3)
+
+/** Resistor modes. */
+#define PINSEL_PULLUP   (0)
+#define PINSEL_REPEATER (1)
+#define PINSEL_TRISTATE (2)
+#define PINSEL_PULLDOWN (3)
+
+/** Open drain modes. */
+#define PINSEL_OD_NORMAL    (0)
+#define PINSEL_OD_OPENDRAIN (1)
+
+/**
+ * @brief Pin configuration.
+ */
+typedef struct {
+    uint8_t portNum;   /*!< PINSEL_PORT_x. */
+    uint8_t pinNum;    /*!< PINSEL_PIN_x. */
+    uint8_t funcNum;   /*!< PINSEL_FUNC_x. */
+    uint8_t pinMode;   /*!< PINSEL_PULLUP, PINSEL_REPEATER, PINSEL_TRISTATE or PINSEL_PULLDOWN. */
+    uint8_t openDrain; /*!< PINSEL_OD_NORMAL or PINSEL_OD_OPENDRAIN. */
+} PINSEL_CFG_Type;
+
+/**
+ * @brief Configures the function, resistor mode and open drain mode of a pin.
+ *
+ * @param pinCfg Pin configuration.
+ */
+void PINSEL_ConfigPin(const PINSEL_CFG_Type* pinCfg);
+
+/**
+ * @brief Applies the same configuration to several pins of a port.
+ *
+ * @param pinCfg Pin configuration; `pinNum` is ignored.
+ * @param pins   Pins of `pinCfg->portNum` to configure.
+ */
+void PINSEL_ConfigMultiplePins(const PINSEL_CFG_Type* pinCfg, uint32_t pins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LPC17XX_PINSEL_H
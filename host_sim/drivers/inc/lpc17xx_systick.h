@@ -0,0 +1,46 @@
+/**
+ * @file lpc17xx_systick.h
+ * @brief SysTick driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#ifndef LPC17XX_SYSTICK_H
+#define LPC17XX_SYSTICK_H
+
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configures SysTick on the core clock with a period in milliseconds. Does not start it.
+ *
+ * @param time Period in milliseconds; must fit the 24-bit reload value (up to 167 ms at 100 MHz).
+ */
+void SYSTICK_InternalInit(uint32_t time);
+
+/**
+ * @brief Enables or disables the SysTick interrupt.
+ *
+ * @param newState ENABLE or DISABLE.
+ */
+void SYSTICK_IntCmd(FunctionalState newState);
+
+/**
+ * @brief Starts or stops the SysTick counter.
+ *
+ * @param newState ENABLE or DISABLE.
+ */
+void SYSTICK_Cmd(FunctionalState newState);
+
+/**
+ * @brief Returns the current value of the SysTick counter.
+ */
+uint32_t SYSTICK_GetCurrentValue(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // LPC17XX_SYSTICK_H
@@ -0,0 +1,24 @@
+/**
+ * @file lpc_types.h
+ * @brief Common types of the LPC17xx CMSIS drivers (host build).
+ */
+
+#ifndef LPC_TYPES_H
+#define LPC_TYPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Boolean type. */
+typedef enum { FALSE = 0, TRUE = !FALSE } Bool;
+
+/** Flag status. */
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, IntStatus, SetState;
+
+/** Functional state: enables or disables a feature. */
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+
+/** Return status of the driver functions. */
+typedef enum { ERROR = 0, SUCCESS = !ERROR } Status;
+
+#endif    // LPC_TYPES_H
@@ -0,0 +1,25 @@
+/**
+ * @file lpc17xx_exti.c
+ * @brief External interrupt driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#include "lpc17xx_exti.h"
+
+void EXTI_ConfigEnable(const EXTI_CFG_Type* extiCfg) {
+    const uint32_t bit = 1U << extiCfg->line;
+
+    if (extiCfg->mode == EXTI_EDGE_SENSITIVE)
+        LPC_SC->EXTMODE |= bit;
+    else
+        LPC_SC->EXTMODE &= ~bit;
+
+    if (extiCfg->polarity == EXTI_RISING_EDGE)
+        LPC_SC->EXTPOLAR |= bit;
+    else
+        LPC_SC->EXTPOLAR &= ~bit;
+
+    LPC_SC->EXTINT = bit;    // Changing the mode may set the flag.
+    NVIC_EnableIRQ((IRQn_Type)(EINT0_IRQn + extiCfg->line));
+}
+
+void EXTI_ClearFlag(uint8_t line) { LPC_SC->EXTINT = 1U << line; }
@@ -0,0 +1,108 @@
+/**
+ * @file lpc17xx_gpio.c
+ * @brief GPIO driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#include "lpc17xx_gpio.h"
+
+/**
+ * @brief Returns the register block of a port, NULL if it does not exist.
+ *
+ * @param portNum Port.
+ */
+static LPC_GPIO_TypeDef* GPIO_GetPointer(uint8_t portNum);
+
+void GPIO_SetDir(uint8_t portNum, uint32_t bitValue, uint8_t dir) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    if (pGPIO == NULL)
+        return;
+    if (dir == GPIO_OUTPUT)
+        pGPIO->FIODIR |= bitValue;
+    else
+        pGPIO->FIODIR &= ~bitValue;
+}
+
+void GPIO_SetPins(uint8_t portNum, uint32_t bitValue) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    if (pGPIO != NULL)
+        pGPIO->FIOSET = bitValue;
+}
+
+void GPIO_ClearPins(uint8_t portNum, uint32_t bitValue) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    if (pGPIO != NULL)
+        pGPIO->FIOCLR = bitValue;
+}
+
+void GPIO_SetValue(uint8_t portNum, uint32_t bitValue) { GPIO_SetPins(portNum, bitValue); }
+
+void GPIO_ClearValue(uint8_t portNum, uint32_t bitValue) { GPIO_ClearPins(portNum, bitValue); }
+
+void GPIO_WriteValue(uint8_t portNum, uint32_t value) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    if (pGPIO != NULL)
+        pGPIO->FIOPIN = value;
+}
+
+uint32_t GPIO_ReadValue(uint8_t portNum) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    return pGPIO != NULL ? pGPIO->FIOPIN : 0;
+}
+
+void GPIO_SetMask(uint8_t portNum, uint32_t bitValue, FunctionalState newState) {
+    LPC_GPIO_TypeDef* pGPIO = GPIO_GetPointer(portNum);
+
+    if (pGPIO == NULL)
+        return;
+    if (newState == ENABLE)
+        pGPIO->FIOMASK |= bitValue;
+    else
+        pGPIO->FIOMASK &= ~bitValue;
+}
+
+void GPIO_IntCmd(uint8_t portNum, uint32_t bitValue, uint8_t edge) {
+    if (portNum == GPIO_PORT_0) {
+        if (edge == GPIO_INT_RISING)
+            LPC_GPIOINT->IO0IntEnR |= bitValue;
+        else
+            LPC_GPIOINT->IO0IntEnF |= bitValue;
+    } else if (portNum == GPIO_PORT_2) {
+        if (edge == GPIO_INT_RISING)
+            LPC_GPIOINT->IO2IntEnR |= bitValue;
+        else
+            LPC_GPIOINT->IO2IntEnF |= bitValue;
+    }
+}
+
+void GPIO_ClearInt(uint8_t portNum, uint32_t bitValue) {
+    if (portNum == GPIO_PORT_0)
+        LPC_GPIOINT->IO0IntClr = bitValue;
+    else if (portNum == GPIO_PORT_2)
+        LPC_GPIOINT->IO2IntClr = bitValue;
+}
+
+FunctionalState GPIO_GetIntStatus(uint8_t portNum, uint32_t pinNum, uint8_t edge) {
+    uint32_t status = 0;
+
+    if (portNum == GPIO_PORT_0)
+        status = edge == GPIO_INT_RISING ? LPC_GPIOINT->IO0IntStatR : LPC_GPIOINT->IO0IntStatF;
+    else if (portNum == GPIO_PORT_2)
+        status = edge == GPIO_INT_RISING ? LPC_GPIOINT->IO2IntStatR : LPC_GPIOINT->IO2IntStatF;
+    return ((status >> pinNum) & 0x1) ? ENABLE : DISABLE;
+}
+
+static LPC_GPIO_TypeDef* GPIO_GetPointer(uint8_t portNum) {
+    switch (portNum) {
+        case GPIO_PORT_0: return LPC_GPIO0;
+        case GPIO_PORT_1: return LPC_GPIO1;
+        case GPIO_PORT_2: return LPC_GPIO2;
+        case GPIO_PORT_3: return LPC_GPIO3;
+        case GPIO_PORT_4: return LPC_GPIO4;
+        default:          return NULL;
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file lpc17xx_pinsel.c
+ * @brief Pin connect block driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#include "lpc17xx_pinsel.h"
+
+/**
+ * @brief Sets the function of a pin (PINSELn).
+ *
+ * @param port Port.
+ * @param pin  Pin.
+ * @param func Function.
+ */
+static void setPinFunc(uint8_t port, uint8_t pin, uint8_t func);
+
+/**
+ * @brief Sets the resistor mode of a pin (PINMODEn).
+ *
+ * @param port Port.
+ * @param pin  Pin.
+ * @param mode Resistor mode.
+ */
+static void setResistorMode(uint8_t port, uint8_t pin, uint8_t mode);
+
+/**
+ * @brief Sets the open drain mode of a pin (PINMODE_ODn).
+ *
+ * @param port      Port.
+ * @param pin       Pin.
+ * @param openDrain Open drain mode.
+ */
+static void setOpenDrainMode(uint8_t port, uint8_t pin, uint8_t openDrain);
+
+void PINSEL_ConfigPin(const PINSEL_CFG_Type* pinCfg) {
+    setPinFunc(pinCfg->portNum, pinCfg->pinNum, pinCfg->funcNum);
+    setResistorMode(pinCfg->portNum, pinCfg->pinNum, pinCfg->pinMode);
+    setOpenDrainMode(pinCfg->portNum, pinCfg->pinNum, pinCfg->openDrain);
+}
+
+void PINSEL_ConfigMultiplePins(const PINSEL_CFG_Type* pinCfg, uint32_t pins) {
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        if (pins & (1U << pin)) {
+            setPinFunc(pinCfg->portNum, pin, pinCfg->funcNum);
+            setResistorMode(pinCfg->portNum, pin, pinCfg->pinMode);
+            setOpenDrainMode(pinCfg->portNum, pin, pinCfg->openDrain);
+        }
+    }
+}
+
+static void setPinFunc(uint8_t port, uint8_t pin, uint8_t func) {
+    const uint32_t reg   = 2 * port + pin / 16;    // Two PINSEL registers per port.
+    const uint32_t shift = (pin % 16) * 2;
+
+    (&LPC_PINCON->PINSEL0)[reg] &= ~(0x3U << shift);
+    (&LPC_PINCON->PINSEL0)[reg] |= (uint32_t)func << shift;
+}
+
+static void setResistorMode(uint8_t port, uint8_t pin, uint8_t mode) {
+    const uint32_t reg   = 2 * port + pin / 16;
+    const uint32_t shift = (pin % 16) * 2;
+
+    (&LPC_PINCON->PINMODE0)[reg] &= ~(0x3U << shift);
+    (&LPC_PINCON->PINMODE0)[reg] |= (uint32_t)mode << shift;
+}
+
+static void setOpenDrainMode(uint8_t port, uint8_t pin, uint8_t openDrain) {
+    if (openDrain == PINSEL_OD_OPENDRAIN)
+        (&LPC_PINCON->PINMODE_OD0)[port] |= 1U << pin;
+    else
+        (&LPC_PINCON->PINMODE_OD0)[port] &= ~(1U << pin);
+}
@@ -0,0 +1,29 @@
+/**
+ * @file lpc17xx_systick.c
+ * @brief SysTick driver of the LPC17xx CMSIS drivers (host build).
+ */
+
+#include "lpc17xx_systick.h"
+
+void SYSTICK_InternalInit(uint32_t time) {
+    const uint32_t load = (SystemCoreClock / 1000) * time - 1;
+
+    SysTick->CTRL |= SysTick_CTRL_CLKSOURCE_Msk;    // Core clock.
+    SysTick->LOAD = load & SysTick_LOAD_RELOAD_Msk;
+}
+
+void SYSTICK_IntCmd(FunctionalState newState) {
+    if (newState == ENABLE)
+        SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    else
+        SysTick->CTRL &= ~(uint32_t)SysTick_CTRL_TICKINT_Msk;
+}
+
+void SYSTICK_Cmd(FunctionalState newState) {
+    if (newState == ENABLE)
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    else
+        SysTick->CTRL &= ~(uint32_t)SysTick_CTRL_ENABLE_Msk;
+}
+
+uint32_t SYSTICK_GetCurrentValue(void) { return SysTick->VAL & SysTick_VAL_CURRENT_Msk; }
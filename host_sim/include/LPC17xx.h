@@ -0,0 +1,426 @@
+/**
+ * @file LPC17xx.h
+ * @brief Host build of the LPC17xx device header.
+ *
+ * Drop-in replacement for the MCUXpresso/CMSIS LPC17xx.h used by every exercise. Peripheral
+ * structures keep the real register layout and base addresses; each register is a sim::IoReg
+ * so accesses are executed by the peripheral simulator (see host_sim/README.md).
+ *
+ * Only the peripherals used by the workshops are modelled. Registers of other blocks may be
+ * added by extending the structures below and the address decoder in sim_periph.cpp.
+ */
+
+#ifndef LPC17XX_H
+#define LPC17XX_H
+
+#include <stdint.h>
+
+/**
+ * @brief Interrupt number definitions.
+ */
+typedef enum IRQn {
+    /* Cortex-M3 processor exceptions. */
+    NonMaskableInt_IRQn   = -14, /*!< 2 Non Maskable Interrupt. */
+    MemoryManagement_IRQn = -12, /*!< 4 Cortex-M3 Memory Management Interrupt. */
+    BusFault_IRQn         = -11, /*!< 5 Cortex-M3 Bus Fault Interrupt. */
+    UsageFault_IRQn       = -10, /*!< 6 Cortex-M3 Usage Fault Interrupt. */
+    SVCall_IRQn           = -5,  /*!< 11 Cortex-M3 SV Call Interrupt. */
+    DebugMonitor_IRQn     = -4,  /*!< 12 Cortex-M3 Debug Monitor Interrupt. */
+    PendSV_IRQn           = -2,  /*!< 14 Cortex-M3 Pend SV Interrupt. */
+    SysTick_IRQn          = -1,  /*!< 15 Cortex-M3 System Tick Interrupt. */
+
+    /* LPC17xx specific interrupts. */
+    WDT_IRQn         = 0,  /*!< Watchdog Timer Interrupt. */
+    TIMER0_IRQn      = 1,  /*!< Timer0 Interrupt. */
+    TIMER1_IRQn      = 2,  /*!< Timer1 Interrupt. */
+    TIMER2_IRQn      = 3,  /*!< Timer2 Interrupt. */
+    TIMER3_IRQn      = 4,  /*!< Timer3 Interrupt. */
+    UART0_IRQn       = 5,  /*!< UART0 Interrupt. */
+    UART1_IRQn       = 6,  /*!< UART1 Interrupt. */
+    UART2_IRQn       = 7,  /*!< UART2 Interrupt. */
+    UART3_IRQn       = 8,  /*!< UART3 Interrupt. */
+    PWM1_IRQn        = 9,  /*!< PWM1 Interrupt. */
+    I2C0_IRQn        = 10, /*!< I2C0 Interrupt. */
+    I2C1_IRQn        = 11, /*!< I2C1 Interrupt. */
+    I2C2_IRQn        = 12, /*!< I2C2 Interrupt. */
+    SPI_IRQn         = 13, /*!< SPI Interrupt. */
+    SSP0_IRQn        = 14, /*!< SSP0 Interrupt. */
+    SSP1_IRQn        = 15, /*!< SSP1 Interrupt. */
+    PLL0_IRQn        = 16, /*!< PLL0 Lock (Main PLL) Interrupt. */
+    RTC_IRQn         = 17, /*!< Real Time Clock Interrupt. */
+    EINT0_IRQn       = 18, /*!< External Interrupt 0 Interrupt. */
+    EINT1_IRQn       = 19, /*!< External Interrupt 1 Interrupt. */
+    EINT2_IRQn       = 20, /*!< External Interrupt 2 Interrupt. */
+    EINT3_IRQn       = 21, /*!< External Interrupt 3 Interrupt. */
+    ADC_IRQn         = 22, /*!< A/D Converter Interrupt. */
+    BOD_IRQn         = 23, /*!< Brown-Out Detect Interrupt. */
+    USB_IRQn         = 24, /*!< USB Interrupt. */
+    CAN_IRQn         = 25, /*!< CAN Interrupt. */
+    DMA_IRQn         = 26, /*!< General Purpose DMA Interrupt. */
+    I2S_IRQn         = 27, /*!< I2S Interrupt. */
+    ENET_IRQn        = 28, /*!< Ethernet Interrupt. */
+    RIT_IRQn         = 29, /*!< Repetitive Interrupt Timer Interrupt. */
+    MCPWM_IRQn       = 30, /*!< Motor Control PWM Interrupt. */
+    QEI_IRQn         = 31, /*!< Quadrature Encoder Interface Interrupt. */
+    PLL1_IRQn        = 32, /*!< PLL1 Lock (USB PLL) Interrupt. */
+    USBActivity_IRQn = 33, /*!< USB Activity Interrupt. */
+    CANActivity_IRQn = 34, /*!< CAN Activity Interrupt. */
+} IRQn_Type;
+
+/** Cortex-M3 revision r0p0. */
+#define __CM3_REV              0x0200
+/** MPU present or not. */
+#define __MPU_PRESENT          1
+/** Number of bits used for priority levels. */
+#define __NVIC_PRIO_BITS       5
+/** Set to 1 if different SysTick config is used. */
+#define __Vendor_SysTickConfig 0
+
+#include "core_cm3.h"
+#include "system_LPC17xx.h"
+
+/* ------------------------------------------------------------------------------------------ */
+/* Device specific peripheral registers structures.                                           */
+/* ------------------------------------------------------------------------------------------ */
+
+/**
+ * @brief System Control (SC) register map.
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> FLASHCFG; /*!< 0x000 Flash Accelerator Configuration. */
+    uint32_t RESERVED0[31];
+    __IO sim::IoReg<uint32_t> PLL0CON; /*!< 0x080 Clocking and Power Control. */
+    __IO sim::IoReg<uint32_t> PLL0CFG;
+    __I sim::IoReg<uint32_t> PLL0STAT;
+    __O sim::IoReg<uint32_t> PLL0FEED;
+    uint32_t RESERVED1[4];
+    __IO sim::IoReg<uint32_t> PLL1CON; /*!< 0x0A0 */
+    __IO sim::IoReg<uint32_t> PLL1CFG;
+    __I sim::IoReg<uint32_t> PLL1STAT;
+    __O sim::IoReg<uint32_t> PLL1FEED;
+    uint32_t RESERVED2[4];
+    __IO sim::IoReg<uint32_t> PCON;  /*!< 0x0C0 Power Control. */
+    __IO sim::IoReg<uint32_t> PCONP; /*!< 0x0C4 Power Control for Peripherals. */
+    uint32_t RESERVED3[15];
+    __IO sim::IoReg<uint32_t> CCLKCFG; /*!< 0x104 CPU Clock Configuration. */
+    __IO sim::IoReg<uint32_t> USBCLKCFG;
+    __IO sim::IoReg<uint32_t> CLKSRCSEL;
+    __IO sim::IoReg<uint32_t> CANSLEEPCLR;
+    __IO sim::IoReg<uint32_t> CANWAKEFLAGS;
+    uint32_t RESERVED4[10];
+    __IO sim::IoReg<uint32_t> EXTINT; /*!< 0x140 External Interrupt Flag Register. */
+    uint32_t RESERVED5;
+    __IO sim::IoReg<uint32_t> EXTMODE;  /*!< 0x148 External Interrupt Mode Register. */
+    __IO sim::IoReg<uint32_t> EXTPOLAR; /*!< 0x14C External Interrupt Polarity Register. */
+    uint32_t RESERVED6[12];
+    __IO sim::IoReg<uint32_t> RSID; /*!< 0x180 Reset Source Identification. */
+    uint32_t RESERVED7[7];
+    __IO sim::IoReg<uint32_t> SCS; /*!< 0x1A0 System Controls and Status. */
+    __IO sim::IoReg<uint32_t> IRCTRIM;
+    __IO sim::IoReg<uint32_t> PCLKSEL0; /*!< 0x1A8 Peripheral Clock Selection 0. */
+    __IO sim::IoReg<uint32_t> PCLKSEL1; /*!< 0x1AC Peripheral Clock Selection 1. */
+    uint32_t RESERVED8[4];
+    __IO sim::IoReg<uint32_t> USBIntSt;
+    __IO sim::IoReg<uint32_t> DMAREQSEL;
+    __IO sim::IoReg<uint32_t> CLKOUTCFG;
+} LPC_SC_TypeDef;
+
+/**
+ * @brief Pin Connect Block (PINCON) register map.
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> PINSEL0; /*!< 0x000 Pin function select registers. */
+    __IO sim::IoReg<uint32_t> PINSEL1;
+    __IO sim::IoReg<uint32_t> PINSEL2;
+    __IO sim::IoReg<uint32_t> PINSEL3;
+    __IO sim::IoReg<uint32_t> PINSEL4;
+    __IO sim::IoReg<uint32_t> PINSEL5;
+    __IO sim::IoReg<uint32_t> PINSEL6;
+    __IO sim::IoReg<uint32_t> PINSEL7;
+    __IO sim::IoReg<uint32_t> PINSEL8;
+    __IO sim::IoReg<uint32_t> PINSEL9;
+    __IO sim::IoReg<uint32_t> PINSEL10;
+    uint32_t RESERVED0[5];
+    __IO sim::IoReg<uint32_t> PINMODE0; /*!< 0x040 Pin mode select registers. */
+    __IO sim::IoReg<uint32_t> PINMODE1;
+    __IO sim::IoReg<uint32_t> PINMODE2;
+    __IO sim::IoReg<uint32_t> PINMODE3;
+    __IO sim::IoReg<uint32_t> PINMODE4;
+    __IO sim::IoReg<uint32_t> PINMODE5;
+    __IO sim::IoReg<uint32_t> PINMODE6;
+    __IO sim::IoReg<uint32_t> PINMODE7;
+    __IO sim::IoReg<uint32_t> PINMODE8;
+    __IO sim::IoReg<uint32_t> PINMODE9;
+    __IO sim::IoReg<uint32_t> PINMODE_OD0; /*!< 0x068 Open drain mode registers. */
+    __IO sim::IoReg<uint32_t> PINMODE_OD1;
+    __IO sim::IoReg<uint32_t> PINMODE_OD2;
+    __IO sim::IoReg<uint32_t> PINMODE_OD3;
+    __IO sim::IoReg<uint32_t> PINMODE_OD4;
+    __IO sim::IoReg<uint32_t> I2CPADCFG;
+} LPC_PINCON_TypeDef;
+
+/**
+ * @brief Fast GPIO port register map, with the word/halfword/byte views of the real header.
+ */
+typedef struct {
+    union {
+        __IO sim::IoReg<uint32_t> FIODIR; /*!< 0x000 Port direction. */
+        struct {
+            __IO sim::IoReg<uint16_t> FIODIRL;
+            __IO sim::IoReg<uint16_t> FIODIRH;
+        };
+        struct {
+            __IO sim::IoReg<uint8_t> FIODIR0;
+            __IO sim::IoReg<uint8_t> FIODIR1;
+            __IO sim::IoReg<uint8_t> FIODIR2;
+            __IO sim::IoReg<uint8_t> FIODIR3;
+        };
+    };
+    uint32_t RESERVED0[3];
+    union {
+        __IO sim::IoReg<uint32_t> FIOMASK; /*!< 0x010 Port access mask. */
+        struct {
+            __IO sim::IoReg<uint16_t> FIOMASKL;
+            __IO sim::IoReg<uint16_t> FIOMASKH;
+        };
+        struct {
+            __IO sim::IoReg<uint8_t> FIOMASK0;
+            __IO sim::IoReg<uint8_t> FIOMASK1;
+            __IO sim::IoReg<uint8_t> FIOMASK2;
+            __IO sim::IoReg<uint8_t> FIOMASK3;
+        };
+    };
+    union {
+        __IO sim::IoReg<uint32_t> FIOPIN; /*!< 0x014 Port pin value. */
+        struct {
+            __IO sim::IoReg<uint16_t> FIOPINL;
+            __IO sim::IoReg<uint16_t> FIOPINH;
+        };
+        struct {
+            __IO sim::IoReg<uint8_t> FIOPIN0;
+            __IO sim::IoReg<uint8_t> FIOPIN1;
+            __IO sim::IoReg<uint8_t> FIOPIN2;
+            __IO sim::IoReg<uint8_t> FIOPIN3;
+        };
+    };
+    union {
+        __IO sim::IoReg<uint32_t> FIOSET; /*!< 0x018 Port output set. */
+        struct {
+            __IO sim::IoReg<uint16_t> FIOSETL;
+            __IO sim::IoReg<uint16_t> FIOSETH;
+        };
+        struct {
+            __IO sim::IoReg<uint8_t> FIOSET0;
+            __IO sim::IoReg<uint8_t> FIOSET1;
+            __IO sim::IoReg<uint8_t> FIOSET2;
+            __IO sim::IoReg<uint8_t> FIOSET3;
+        };
+    };
+    union {
+        __O sim::IoReg<uint32_t> FIOCLR; /*!< 0x01C Port output clear. */
+        struct {
+            __O sim::IoReg<uint16_t> FIOCLRL;
+            __O sim::IoReg<uint16_t> FIOCLRH;
+        };
+        struct {
+            __O sim::IoReg<uint8_t> FIOCLR0;
+            __O sim::IoReg<uint8_t> FIOCLR1;
+            __O sim::IoReg<uint8_t> FIOCLR2;
+            __O sim::IoReg<uint8_t> FIOCLR3;
+        };
+    };
+} LPC_GPIO_TypeDef;
+
+/**
+ * @brief GPIO interrupt register map.
+ */
+typedef struct {
+    __I sim::IoReg<uint32_t> IntStatus;   /*!< 0x080 GPIO overall interrupt status. */
+    __I sim::IoReg<uint32_t> IO0IntStatR; /*!< 0x084 Port 0 rising edge status. */
+    __I sim::IoReg<uint32_t> IO0IntStatF; /*!< 0x088 Port 0 falling edge status. */
+    __O sim::IoReg<uint32_t> IO0IntClr;   /*!< 0x08C Port 0 interrupt clear. */
+    __IO sim::IoReg<uint32_t> IO0IntEnR;  /*!< 0x090 Port 0 rising edge enable. */
+    __IO sim::IoReg<uint32_t> IO0IntEnF;  /*!< 0x094 Port 0 falling edge enable. */
+    uint32_t RESERVED0[3];
+    __I sim::IoReg<uint32_t> IO2IntStatR; /*!< 0x0A4 Port 2 rising edge status. */
+    __I sim::IoReg<uint32_t> IO2IntStatF; /*!< 0x0A8 Port 2 falling edge status. */
+    __O sim::IoReg<uint32_t> IO2IntClr;   /*!< 0x0AC Port 2 interrupt clear. */
+    __IO sim::IoReg<uint32_t> IO2IntEnR;  /*!< 0x0B0 Port 2 rising edge enable. */
+    __IO sim::IoReg<uint32_t> IO2IntEnF;  /*!< 0x0B4 Port 2 falling edge enable. */
+} LPC_GPIOINT_TypeDef;
+
+/**
+ * @brief Timer/counter register map (TIMER0-TIMER3).
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> IR;  /*!< 0x000 Interrupt Register. */
+    __IO sim::IoReg<uint32_t> TCR; /*!< 0x004 Timer Control Register. */
+    __IO sim::IoReg<uint32_t> TC;  /*!< 0x008 Timer Counter. */
+    __IO sim::IoReg<uint32_t> PR;  /*!< 0x00C Prescale Register. */
+    __IO sim::IoReg<uint32_t> PC;  /*!< 0x010 Prescale Counter. */
+    __IO sim::IoReg<uint32_t> MCR; /*!< 0x014 Match Control Register. */
+    __IO sim::IoReg<uint32_t> MR0; /*!< 0x018 Match Register 0. */
+    __IO sim::IoReg<uint32_t> MR1; /*!< 0x01C Match Register 1. */
+    __IO sim::IoReg<uint32_t> MR2; /*!< 0x020 Match Register 2. */
+    __IO sim::IoReg<uint32_t> MR3; /*!< 0x024 Match Register 3. */
+    __IO sim::IoReg<uint32_t> CCR; /*!< 0x028 Capture Control Register. */
+    __I sim::IoReg<uint32_t> CR0;  /*!< 0x02C Capture Register 0. */
+    __I sim::IoReg<uint32_t> CR1;  /*!< 0x030 Capture Register 1. */
+    uint32_t RESERVED0[2];
+    __IO sim::IoReg<uint32_t> EMR; /*!< 0x03C External Match Register. */
+    uint32_t RESERVED1[12];
+    __IO sim::IoReg<uint32_t> CTCR; /*!< 0x070 Count Control Register. */
+} LPC_TIM_TypeDef;
+
+/**
+ * @brief General purpose DMA controller register map.
+ */
+typedef struct {
+    __I sim::IoReg<uint32_t> DMACIntStat;       /*!< 0x000 Interrupt Status. */
+    __I sim::IoReg<uint32_t> DMACIntTCStat;     /*!< 0x004 Terminal Count Interrupt Status. */
+    __O sim::IoReg<uint32_t> DMACIntTCClear;    /*!< 0x008 Terminal Count Interrupt Clear. */
+    __I sim::IoReg<uint32_t> DMACIntErrStat;    /*!< 0x00C Error Interrupt Status. */
+    __O sim::IoReg<uint32_t> DMACIntErrClr;     /*!< 0x010 Error Interrupt Clear. */
+    __I sim::IoReg<uint32_t> DMACRawIntTCStat;  /*!< 0x014 Raw Terminal Count Status. */
+    __I sim::IoReg<uint32_t> DMACRawIntErrStat; /*!< 0x018 Raw Error Status. */
+    __I sim::IoReg<uint32_t> DMACEnbldChns;     /*!< 0x01C Enabled Channels. */
+    __IO sim::IoReg<uint32_t> DMACSoftBReq;     /*!< 0x020 Software Burst Request. */
+    __IO sim::IoReg<uint32_t> DMACSoftSReq;     /*!< 0x024 Software Single Request. */
+    __IO sim::IoReg<uint32_t> DMACSoftLBReq;    /*!< 0x028 Software Last Burst Request. */
+    __IO sim::IoReg<uint32_t> DMACSoftLSReq;    /*!< 0x02C Software Last Single Request. */
+    __IO sim::IoReg<uint32_t> DMACConfig;       /*!< 0x030 Configuration. */
+    __IO sim::IoReg<uint32_t> DMACSync;         /*!< 0x034 Synchronization. */
+} LPC_GPDMA_TypeDef;
+
+/**
+ * @brief General purpose DMA channel register map (channels 0-7).
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> DMACCSrcAddr;  /*!< 0x000 Source Address. */
+    __IO sim::IoReg<uint32_t> DMACCDestAddr; /*!< 0x004 Destination Address. */
+    __IO sim::IoReg<uint32_t> DMACCLLI;      /*!< 0x008 Linked List Item. */
+    __IO sim::IoReg<uint32_t> DMACCControl;  /*!< 0x00C Control. */
+    __IO sim::IoReg<uint32_t> DMACCConfig;   /*!< 0x010 Configuration. */
+} LPC_GPDMACH_TypeDef;
+
+/* ------------------------------------------------------------------------------------------ */
+/* Peripheral memory map.                                                                     */
+/* ------------------------------------------------------------------------------------------ */
+
+/** Base addresses. */
+#define LPC_FLASH_BASE (0x00000000UL)
+#define LPC_RAM_BASE   (0x10000000UL)
+#define LPC_GPIO_BASE  (0x2009C000UL)
+#define LPC_APB0_BASE  (0x40000000UL)
+#define LPC_APB1_BASE  (0x40080000UL)
+#define LPC_AHB_BASE   (0x50000000UL)
+#define LPC_CM3_BASE   (0xE0000000UL)
+
+/** APB0 peripherals. */
+#define LPC_TIM0_BASE    (LPC_APB0_BASE + 0x04000)
+#define LPC_TIM1_BASE    (LPC_APB0_BASE + 0x08000)
+#define LPC_GPIOINT_BASE (LPC_APB0_BASE + 0x28080)
+#define LPC_PINCON_BASE  (LPC_APB0_BASE + 0x2C000)
+
+/** APB1 peripherals. */
+#define LPC_TIM2_BASE (LPC_APB1_BASE + 0x10000)
+#define LPC_TIM3_BASE (LPC_APB1_BASE + 0x14000)
+#define LPC_SC_BASE   (LPC_APB1_BASE + 0x7C000)
+
+/** AHB peripherals. */
+#define LPC_GPDMA_BASE    (LPC_AHB_BASE + 0x04000)
+#define LPC_GPDMACH0_BASE (LPC_AHB_BASE + 0x04100)
+#define LPC_GPDMACH1_BASE (LPC_AHB_BASE + 0x04120)
+#define LPC_GPDMACH2_BASE (LPC_AHB_BASE + 0x04140)
+#define LPC_GPDMACH3_BASE (LPC_AHB_BASE + 0x04160)
+#define LPC_GPDMACH4_BASE (LPC_AHB_BASE + 0x04180)
+#define LPC_GPDMACH5_BASE (LPC_AHB_BASE + 0x041A0)
+#define LPC_GPDMACH6_BASE (LPC_AHB_BASE + 0x041C0)
+#define LPC_GPDMACH7_BASE (LPC_AHB_BASE + 0x041E0)
+
+/** GPIOs. */
+#define LPC_GPIO0_BASE (LPC_GPIO_BASE + 0x00000)
+#define LPC_GPIO1_BASE (LPC_GPIO_BASE + 0x00020)
+#define LPC_GPIO2_BASE (LPC_GPIO_BASE + 0x00040)
+#define LPC_GPIO3_BASE (LPC_GPIO_BASE + 0x00060)
+#define LPC_GPIO4_BASE (LPC_GPIO_BASE + 0x00080)
+
+/* ------------------------------------------------------------------------------------------ */
+/* Peripheral declaration.                                                                    */
+/* ------------------------------------------------------------------------------------------ */
+
+#define LPC_SC      ((LPC_SC_TypeDef*)LPC_SC_BASE)
+#define LPC_TIM0    ((LPC_TIM_TypeDef*)LPC_TIM0_BASE)
+#define LPC_TIM1    ((LPC_TIM_TypeDef*)LPC_TIM1_BASE)
+#define LPC_TIM2    ((LPC_TIM_TypeDef*)LPC_TIM2_BASE)
+#define LPC_TIM3    ((LPC_TIM_TypeDef*)LPC_TIM3_BASE)
+#define LPC_GPIO0   ((LPC_GPIO_TypeDef*)LPC_GPIO0_BASE)
+#define LPC_GPIO1   ((LPC_GPIO_TypeDef*)LPC_GPIO1_BASE)
+#define LPC_GPIO2   ((LPC_GPIO_TypeDef*)LPC_GPIO2_BASE)
+#define LPC_GPIO3   ((LPC_GPIO_TypeDef*)LPC_GPIO3_BASE)
+#define LPC_GPIO4   ((LPC_GPIO_TypeDef*)LPC_GPIO4_BASE)
+#define LPC_GPIOINT ((LPC_GPIOINT_TypeDef*)LPC_GPIOINT_BASE)
+#define LPC_PINCON  ((LPC_PINCON_TypeDef*)LPC_PINCON_BASE)
+#define LPC_GPDMA    ((LPC_GPDMA_TypeDef*)LPC_GPDMA_BASE)
+#define LPC_GPDMACH0 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH0_BASE)
+#define LPC_GPDMACH1 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH1_BASE)
+#define LPC_GPDMACH2 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH2_BASE)
+#define LPC_GPDMACH3 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH3_BASE)
+#define LPC_GPDMACH4 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH4_BASE)
+#define LPC_GPDMACH5 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH5_BASE)
+#define LPC_GPDMACH6 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH6_BASE)
+#define LPC_GPDMACH7 ((LPC_GPDMACH_TypeDef*)LPC_GPDMACH7_BASE)
+
+/* ------------------------------------------------------------------------------------------ */
+/* Exception and interrupt handlers. Declared with C linkage so that the definitions in the   */
+/* (C++-compiled) firmware keep their unmangled vector names.                                 */
+/* ------------------------------------------------------------------------------------------ */
+
+extern "C" {
+void NMI_Handler(void);
+void HardFault_Handler(void);
+void MemManage_Handler(void);
+void BusFault_Handler(void);
+void UsageFault_Handler(void);
+void SVC_Handler(void);
+void DebugMon_Handler(void);
+void PendSV_Handler(void);
+void SysTick_Handler(void);
+void WDT_IRQHandler(void);
+void TIMER0_IRQHandler(void);
+void TIMER1_IRQHandler(void);
+void TIMER2_IRQHandler(void);
+void TIMER3_IRQHandler(void);
+void UART0_IRQHandler(void);
+void UART1_IRQHandler(void);
+void UART2_IRQHandler(void);
+void UART3_IRQHandler(void);
+void PWM1_IRQHandler(void);
+void I2C0_IRQHandler(void);
+void I2C1_IRQHandler(void);
+void I2C2_IRQHandler(void);
+void SPI_IRQHandler(void);
+void SSP0_IRQHandler(void);
+void SSP1_IRQHandler(void);
+void PLL0_IRQHandler(void);
+void RTC_IRQHandler(void);
+void EINT0_IRQHandler(void);
+void EINT1_IRQHandler(void);
+void EINT2_IRQHandler(void);
+void EINT3_IRQHandler(void);
+void ADC_IRQHandler(void);
+void BOD_IRQHandler(void);
+void USB_IRQHandler(void);
+void CAN_IRQHandler(void);
+void DMA_IRQHandler(void);
+void I2S_IRQHandler(void);
+void ENET_IRQHandler(void);
+void RIT_IRQHandler(void);
+void MCPWM_IRQHandler(void);
+void QEI_IRQHandler(void);
+void PLL1_IRQHandler(void);
+void USBActivity_IRQHandler(void);
+void CANActivity_IRQHandler(void);
+}
+
+#endif    // LPC17XX_H
@@ -0,0 +1,243 @@
+/**
+ * @file core_cm3.h
+ * @brief Host build of the Cortex-M3 core peripheral access layer (NVIC, SCB, SysTick, DWT).
+ *
+ * Register layouts, addresses and the inline NVIC/SysTick helpers mirror CMSIS core_cm3.h so the
+ * exercises compile unchanged. The core intrinsics (__NOP, __WFI, __enable_irq...) are routed to
+ * the simulator instead of emitting Cortex-M3 instructions.
+ */
+
+#ifndef CORE_CM3_H
+#define CORE_CM3_H
+
+#include <stdint.h>
+
+#include "sim_io.h"
+
+/** Defines 'read only' permissions. */
+#define __I  volatile
+/** Defines 'write only' permissions. */
+#define __O  volatile
+/** Defines 'read / write' permissions. */
+#define __IO volatile
+
+#ifndef __INLINE
+#define __INLINE inline
+#endif
+
+/**
+ * @brief Nested Vectored Interrupt Controller register map.
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> ISER[8]; /*!< 0x000 Interrupt Set Enable Register. */
+    uint32_t RESERVED0[24];
+    __IO sim::IoReg<uint32_t> ICER[8]; /*!< 0x080 Interrupt Clear Enable Register. */
+    uint32_t RSERVED1[24];
+    __IO sim::IoReg<uint32_t> ISPR[8]; /*!< 0x100 Interrupt Set Pending Register. */
+    uint32_t RESERVED2[24];
+    __IO sim::IoReg<uint32_t> ICPR[8]; /*!< 0x180 Interrupt Clear Pending Register. */
+    uint32_t RESERVED3[24];
+    __IO sim::IoReg<uint32_t> IABR[8]; /*!< 0x200 Interrupt Active bit Register. */
+    uint32_t RESERVED4[56];
+    __IO sim::IoReg<uint8_t> IP[240]; /*!< 0x300 Interrupt Priority Register (8 bit wide). */
+    uint32_t RESERVED5[644];
+    __O sim::IoReg<uint32_t> STIR; /*!< 0xE00 Software Trigger Interrupt Register. */
+} NVIC_Type;
+
+/**
+ * @brief System Control Block register map.
+ */
+typedef struct {
+    __I sim::IoReg<uint32_t> CPUID;  /*!< 0x000 CPU ID Base Register. */
+    __IO sim::IoReg<uint32_t> ICSR;  /*!< 0x004 Interrupt Control State Register. */
+    __IO sim::IoReg<uint32_t> VTOR;  /*!< 0x008 Vector Table Offset Register. */
+    __IO sim::IoReg<uint32_t> AIRCR; /*!< 0x00C Application Interrupt / Reset Control Register. */
+    __IO sim::IoReg<uint32_t> SCR;   /*!< 0x010 System Control Register. */
+    __IO sim::IoReg<uint32_t> CCR;   /*!< 0x014 Configuration Control Register. */
+    __IO sim::IoReg<uint8_t> SHP[12]; /*!< 0x018 System Handlers Priority Registers (4-7, 8-11, 12-15). */
+    __IO sim::IoReg<uint32_t> SHCSR; /*!< 0x024 System Handler Control and State Register. */
+    __IO sim::IoReg<uint32_t> CFSR;  /*!< 0x028 Configurable Fault Status Register. */
+    __IO sim::IoReg<uint32_t> HFSR;  /*!< 0x02C Hard Fault Status Register. */
+    __IO sim::IoReg<uint32_t> DFSR;  /*!< 0x030 Debug Fault Status Register. */
+    __IO sim::IoReg<uint32_t> MMFAR; /*!< 0x034 Mem Manage Address Register. */
+    __IO sim::IoReg<uint32_t> BFAR;  /*!< 0x038 Bus Fault Address Register. */
+    __IO sim::IoReg<uint32_t> AFSR;  /*!< 0x03C Auxiliary Fault Status Register. */
+} SCB_Type;
+
+/**
+ * @brief System Timer (SysTick) register map.
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> CTRL;  /*!< 0x000 SysTick Control and Status Register. */
+    __IO sim::IoReg<uint32_t> LOAD;  /*!< 0x004 SysTick Reload Value Register. */
+    __IO sim::IoReg<uint32_t> VAL;   /*!< 0x008 SysTick Current Value Register. */
+    __I sim::IoReg<uint32_t> CALIB;  /*!< 0x00C SysTick Calibration Register. */
+} SysTick_Type;
+
+/**
+ * @brief Data Watchpoint and Trace unit register map (cycle counter only).
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> CTRL;   /*!< 0x000 Control Register. */
+    __IO sim::IoReg<uint32_t> CYCCNT; /*!< 0x004 Cycle Count Register. */
+} DWT_Type;
+
+/**
+ * @brief Core Debug register map.
+ */
+typedef struct {
+    __IO sim::IoReg<uint32_t> DHCSR; /*!< 0x000 Debug Halting Control and Status Register. */
+    __O sim::IoReg<uint32_t> DCRSR;  /*!< 0x004 Debug Core Register Selector Register. */
+    __IO sim::IoReg<uint32_t> DCRDR; /*!< 0x008 Debug Core Register Data Register. */
+    __IO sim::IoReg<uint32_t> DEMCR; /*!< 0x00C Debug Exception and Monitor Control Register. */
+} CoreDebug_Type;
+
+/** Data Watchpoint and Trace unit base address. */
+#define DWT_BASE       (0xE0001000UL)
+/** System Control Space base address. */
+#define SCS_BASE       (0xE000E000UL)
+/** SysTick base address. */
+#define SysTick_BASE   (SCS_BASE + 0x0010UL)
+/** NVIC base address. */
+#define NVIC_BASE      (SCS_BASE + 0x0100UL)
+/** System Control Block base address. */
+#define SCB_BASE       (SCS_BASE + 0x0D00UL)
+/** Core Debug base address. */
+#define CoreDebug_BASE (0xE000EDF0UL)
+
+#define SCB       ((SCB_Type*)SCB_BASE)
+#define SysTick   ((SysTick_Type*)SysTick_BASE)
+#define NVIC      ((NVIC_Type*)NVIC_BASE)
+#define DWT       ((DWT_Type*)DWT_BASE)
+#define CoreDebug ((CoreDebug_Type*)CoreDebug_BASE)
+
+/** SCB ICSR: PendSV set-pending bit. */
+#define SCB_ICSR_PENDSVSET_Msk    (1UL << 28)
+/** SCB ICSR: PendSV clear-pending bit. */
+#define SCB_ICSR_PENDSVCLR_Msk    (1UL << 27)
+/** SCB ICSR: SysTick set-pending bit. */
+#define SCB_ICSR_PENDSTSET_Msk    (1UL << 26)
+/** SCB ICSR: SysTick clear-pending bit. */
+#define SCB_ICSR_PENDSTCLR_Msk    (1UL << 25)
+/** SCB ICSR: active vector field. */
+#define SCB_ICSR_VECTACTIVE_Msk   (0x1FFUL)
+/** SCB SCR: sleep-on-exit bit. */
+#define SCB_SCR_SLEEPONEXIT_Msk   (1UL << 1)
+
+/** SysTick CTRL: COUNTFLAG bit. */
+#define SysTick_CTRL_COUNTFLAG_Msk (1UL << 16)
+/** SysTick CTRL: CLKSOURCE bit. */
+#define SysTick_CTRL_CLKSOURCE_Msk (1UL << 2)
+/** SysTick CTRL: TICKINT bit. */
+#define SysTick_CTRL_TICKINT_Msk   (1UL << 1)
+/** SysTick CTRL: ENABLE bit. */
+#define SysTick_CTRL_ENABLE_Msk    (1UL << 0)
+/** SysTick LOAD: RELOAD field. */
+#define SysTick_LOAD_RELOAD_Msk    (0xFFFFFFUL)
+/** SysTick VAL: CURRENT field. */
+#define SysTick_VAL_CURRENT_Msk    (0xFFFFFFUL)
+
+/** DWT CTRL: cycle counter enable bit. */
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+/** CoreDebug DEMCR: trace enable bit, powers the DWT. */
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+/* ------------------------------------------------------------------------------------------ */
+/* Core intrinsics, implemented by the simulator.                                             */
+/* ------------------------------------------------------------------------------------------ */
+
+namespace sim {
+/** Current virtual time in core cycles. */
+extern uint64_t now;
+/** Time of the earliest scheduled simulator event. */
+extern uint64_t nextEvent;
+/** Processes every due event and dispatches pending interrupts. */
+void service(void);
+/** Advances the virtual clock by a number of core cycles. */
+inline void tick(uint32_t cycles) {
+    now += cycles;
+    if (now >= nextEvent)
+        service();
+}
+/** Sleeps until an enabled interrupt is pending, then services it. */
+void waitForInterrupt(void);
+/** Sets or clears PRIMASK. */
+void setPrimask(uint32_t primask);
+/** Returns PRIMASK. */
+uint32_t getPrimask(void);
+}    // namespace sim
+
+static __INLINE void __NOP(void) { sim::tick(1); }
+static __INLINE void __WFI(void) { sim::waitForInterrupt(); }
+static __INLINE void __WFE(void) { sim::waitForInterrupt(); }
+static __INLINE void __SEV(void) {}
+static __INLINE void __ISB(void) { __asm__ volatile("" ::: "memory"); }
+static __INLINE void __DSB(void) { __asm__ volatile("" ::: "memory"); }
+static __INLINE void __DMB(void) { __asm__ volatile("" ::: "memory"); }
+static __INLINE void __enable_irq(void) { sim::setPrimask(0); }
+static __INLINE void __disable_irq(void) { sim::setPrimask(1); }
+static __INLINE uint32_t __get_PRIMASK(void) { return sim::getPrimask(); }
+static __INLINE void __set_PRIMASK(uint32_t priMask) { sim::setPrimask(priMask); }
+static __INLINE uint32_t __REV(uint32_t value) { return __builtin_bswap32(value); }
+static __INLINE uint32_t __RBIT(uint32_t value) {
+    value = ((value >> 1) & 0x55555555UL) | ((value & 0x55555555UL) << 1);
+    value = ((value >> 2) & 0x33333333UL) | ((value & 0x33333333UL) << 2);
+    value = ((value >> 4) & 0x0F0F0F0FUL) | ((value & 0x0F0F0F0FUL) << 4);
+    return __builtin_bswap32(value);
+}
+static __INLINE uint8_t __CLZ(uint32_t value) { return value ? (uint8_t)__builtin_clz(value) : 32; }
+
+/* ------------------------------------------------------------------------------------------ */
+/* NVIC functions, identical to CMSIS core_cm3.h.                                             */
+/* ------------------------------------------------------------------------------------------ */
+
+static __INLINE void NVIC_EnableIRQ(IRQn_Type IRQn) {
+    NVIC->ISER[((uint32_t)(IRQn) >> 5)] = (1UL << ((uint32_t)(IRQn) & 0x1F));
+}
+
+static __INLINE void NVIC_DisableIRQ(IRQn_Type IRQn) {
+    NVIC->ICER[((uint32_t)(IRQn) >> 5)] = (1UL << ((uint32_t)(IRQn) & 0x1F));
+}
+
+static __INLINE uint32_t NVIC_GetPendingIRQ(IRQn_Type IRQn) {
+    return ((uint32_t)((NVIC->ISPR[(uint32_t)(IRQn) >> 5] & (1UL << ((uint32_t)(IRQn) & 0x1F))) ? 1 : 0));
+}
+
+static __INLINE void NVIC_SetPendingIRQ(IRQn_Type IRQn) {
+    NVIC->ISPR[((uint32_t)(IRQn) >> 5)] = (1UL << ((uint32_t)(IRQn) & 0x1F));
+}
+
+static __INLINE void NVIC_ClearPendingIRQ(IRQn_Type IRQn) {
+    NVIC->ICPR[((uint32_t)(IRQn) >> 5)] = (1UL << ((uint32_t)(IRQn) & 0x1F));
+}
+
+static __INLINE uint32_t NVIC_GetActive(IRQn_Type IRQn) {
+    return ((uint32_t)((NVIC->IABR[(uint32_t)(IRQn) >> 5] & (1UL << ((uint32_t)(IRQn) & 0x1F))) ? 1 : 0));
+}
+
+static __INLINE void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority) {
+    if (IRQn < 0)
+        SCB->SHP[((uint32_t)(IRQn) & 0xF) - 4] = ((priority << (8 - __NVIC_PRIO_BITS)) & 0xFF);
+    else
+        NVIC->IP[(uint32_t)(IRQn)] = ((priority << (8 - __NVIC_PRIO_BITS)) & 0xFF);
+}
+
+static __INLINE uint32_t NVIC_GetPriority(IRQn_Type IRQn) {
+    if (IRQn < 0)
+        return ((uint32_t)(SCB->SHP[((uint32_t)(IRQn) & 0xF) - 4] >> (8 - __NVIC_PRIO_BITS)));
+    else
+        return ((uint32_t)(NVIC->IP[(uint32_t)(IRQn)] >> (8 - __NVIC_PRIO_BITS)));
+}
+
+static __INLINE uint32_t SysTick_Config(uint32_t ticks) {
+    if (ticks > SysTick_LOAD_RELOAD_Msk)
+        return 1;    // Reload value impossible.
+
+    SysTick->LOAD = (ticks & SysTick_LOAD_RELOAD_Msk) - 1;           // Set reload register.
+    NVIC_SetPriority(SysTick_IRQn, (1 << __NVIC_PRIO_BITS) - 1);    // Set priority to lowest.
+    SysTick->VAL  = 0;                                               // Load the counter value.
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+    return 0;
+}
+
+#endif    // CORE_CM3_H
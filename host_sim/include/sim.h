@@ -0,0 +1,360 @@
+/**
+ * @file sim.h
+ * @brief Internal and testbench interface of the LPC1769 host simulator.
+ *
+ * Exercise firmware never includes this header; it is shared by the simulator sources, by tools
+ * built on top of it and by the regression checks in checks/. Time is measured in core clock cycles of the simulated 100 MHz CPU.
+ * The clock fast path, sim::tick(), is inline in core_cm3.h.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+#include <string>
+
+namespace sim {
+
+/** Simulated core clock in Hz. */
+constexpr uint32_t CORE_CLOCK = 100000000;
+
+/** Number of exception vectors tracked (16 system exceptions + 35 LPC17xx interrupts). */
+constexpr int NUM_EXCEPTIONS = 51;
+
+/** Exception number of SysTick. */
+constexpr int EXC_SYSTICK = 15;
+/** Exception number of PendSV. */
+constexpr int EXC_PENDSV = 14;
+/** Exception number of the first device interrupt (IRQ0). */
+constexpr int EXC_IRQ0 = 16;
+
+/** Cycles charged per access to the AHB fast GPIO block. */
+constexpr uint32_t COST_AHB = 2;
+/** Cycles charged per access to an APB peripheral. */
+constexpr uint32_t COST_APB = 4;
+/** Cycles charged per access to the private peripheral bus (SysTick, NVIC, SCB). */
+constexpr uint32_t COST_PPB = 2;
+/** Cycles charged for exception entry (stacking + vector fetch). */
+constexpr uint32_t COST_IRQ_ENTRY = 12;
+/** Cycles charged for exception return (unstacking). */
+constexpr uint32_t COST_IRQ_EXIT = 10;
+
+/**
+ * @brief Run statistics.
+ */
+struct Stats {
+    uint64_t reads;                    /**< Register reads. */
+    uint64_t writes;                   /**< Register writes. */
+    uint64_t sleepCycles;              /**< Cycles spent inside __WFI(). */
+    uint64_t wfiCalls;                 /**< Number of __WFI() calls. */
+    uint64_t events;                   /**< Scheduler events run. */
+    uint64_t dmaTransfers;             /**< Items moved by the DMA controller. */
+    uint64_t exc[NUM_EXCEPTIONS];      /**< Entries per exception number. */
+    uint64_t maxLatency[NUM_EXCEPTIONS]; /**< Worst cycles from pending (and enabled) to handler start. */
+    uint64_t maxHandler[NUM_EXCEPTIONS]; /**< Worst cycles from handler start to return, preemptions included. */
+    uint64_t handlerCycles[NUM_EXCEPTIONS]; /**< Cycles in each handler, nested handlers and sleep excluded. */
+};
+
+/** Current virtual time in core cycles. */
+extern uint64_t now;
+/** Time of the earliest scheduled event; sim::service() runs when now reaches it. */
+extern uint64_t nextEvent;
+/** Run statistics. */
+extern Stats stats;
+
+/**
+ * @brief Deadline owned by a simulator component (SysTick reload, stimulus, end of run...).
+ *
+ * An event is scheduled at most once at a time; scheduling it again moves its deadline.
+ */
+struct Event {
+    void (*action)(void);       /**< Called when the deadline is reached. */
+    uint64_t time = UINT64_MAX; /**< Current deadline, UINT64_MAX when not scheduled. */
+    uint32_t gen  = 0;          /**< Generation, invalidates older heap entries. */
+};
+
+/* ------------------------------- Scheduler (sim_event.cpp) ------------------------------ */
+
+/**
+ * @brief Schedules (or moves) an event.
+ *
+ * @param event Event to schedule.
+ * @param time  Absolute deadline in cycles.
+ */
+void schedule(Event& event, uint64_t time);
+
+/**
+ * @brief Removes an event from the schedule. Does nothing if it is not scheduled.
+ *
+ * @param event Event to cancel.
+ */
+void cancel(Event& event);
+
+/**
+ * @brief Runs, in deadline order, every event due at the current time.
+ */
+void runEvents(void);
+
+/* -------------------------------- Core (sim_core.cpp) ----------------------------------- */
+
+/**
+ * @brief Maps the register pages at their LPC1769 addresses and resets all peripherals.
+ */
+void init(void);
+
+/**
+ * @brief Processes every event due at the current time and dispatches pending interrupts.
+ */
+void service(void);
+
+/**
+ * @brief Marks an exception as pending.
+ *
+ * @param exc Exception number (16 + IRQn for device interrupts).
+ */
+void setPending(int exc);
+
+/**
+ * @brief Drives the level of a device interrupt line.
+ *
+ * An asserted line keeps its interrupt pending, as the NVIC does for level-style peripherals.
+ *
+ * @param irqn     Device interrupt number (IRQn_Type >= 0).
+ * @param asserted True while the peripheral requests service.
+ */
+void setLine(int irqn, bool asserted);
+
+/**
+ * @brief Enters every pending interrupt whose priority preempts the current execution priority.
+ */
+void dispatch(void);
+
+/**
+ * @brief Returns the name of an exception for reports.
+ *
+ * @param exc Exception number.
+ */
+const char* excName(int exc);
+
+/**
+ * @brief Stops the simulation: prints the report and exits the process.
+ *
+ * @param reason Short human readable reason.
+ */
+[[noreturn]] void finish(const char* reason);
+
+/**
+ * @brief Raw storage of a 32-bit register.
+ *
+ * @param addr Register address.
+ */
+inline volatile uint32_t& word(uint32_t addr) {
+    return *reinterpret_cast<volatile uint32_t*>(static_cast<uintptr_t>(addr));
+}
+
+/* ----------------------------- Peripherals (sim_periph.cpp) ----------------------------- */
+
+/**
+ * @brief Resets every peripheral model to its power-on state.
+ */
+void periphReset(void);
+
+/**
+ * @brief Handles a bus access to a peripheral register.
+ *
+ * @param addr  Register address.
+ * @param value Value to write (ignored for reads).
+ * @param width Access width in bytes.
+ * @param write True for writes.
+ * @return Value read (0 for writes).
+ */
+uint32_t periphAccess(uint32_t addr, uint32_t value, uint32_t width, bool write);
+
+/* ------------------------------- Timers (sim_timer.cpp) --------------------------------- */
+
+/**
+ * @brief Resets TIMER0-TIMER3 to their power-on state.
+ */
+void timerReset(void);
+
+/**
+ * @brief Handles a bus access if it targets a timer.
+ *
+ * @param addr   Register address.
+ * @param value  Value to write (ignored for reads).
+ * @param write  True for writes.
+ * @param result Value read (0 for writes).
+ * @return True if the address belongs to a timer.
+ */
+bool timerAccess(uint32_t addr, uint32_t value, bool write, uint32_t* result);
+
+/**
+ * @brief Passes the level changes of a port to the capture inputs (CAPn.0, CAPn.1) on it.
+ *
+ * @param port    Port number (0-4).
+ * @param changed Pins whose level changed.
+ * @param level   New level of the port.
+ */
+void timerPinChanged(uint32_t port, uint32_t changed, uint32_t level);
+
+/* -------------------------------- GPDMA (sim_dma.cpp) ---------------------------------- */
+
+/**
+ * @brief Resets the DMA controller: every channel disabled, no interrupt flag.
+ */
+void dmaReset(void);
+
+/**
+ * @brief Handles a bus access if it targets the DMA controller.
+ *
+ * @param addr   Register address.
+ * @param value  Value to write (ignored for reads).
+ * @param write  True for writes.
+ * @param result Value read (0 for writes).
+ * @return True if the address belongs to the DMA controller.
+ */
+bool dmaAccess(uint32_t addr, uint32_t value, bool write, uint32_t* result);
+
+/**
+ * @brief Checks whether DMAREQSEL routes a timer match to the DMA controller.
+ *
+ * @param timer Timer number (0-3).
+ * @param match Match channel (0 or 1).
+ */
+bool dmaTimerSelected(int timer, int match);
+
+/**
+ * @brief Raises the DMA request of a timer match, if DMAREQSEL selects it.
+ *
+ * @param timer Timer number (0-3).
+ * @param match Match channel (0 or 1).
+ */
+void dmaTimerMatch(int timer, int match);
+
+/**
+ * @brief Drives an input pin from the testbench.
+ *
+ * @param port  Port number (0-4).
+ * @param pin   Pin number (0-31).
+ * @param level 0 or 1 to drive the pin, -1 to release it (pull resistor decides).
+ */
+void drivePin(uint32_t port, uint32_t pin, int level);
+
+/**
+ * @brief Returns the PINSEL function of a pin (0 = GPIO, 1-3 = alternate functions).
+ *
+ * @param port Port number (0-4).
+ * @param pin  Pin number (0-31).
+ */
+uint32_t pinFunction(uint32_t port, uint32_t pin);
+
+/**
+ * @brief Returns the current electrical level of a port.
+ *
+ * @param port Port number (0-4).
+ */
+uint32_t portLevel(uint32_t port);
+
+/**
+ * @brief Enables printing of every GPIO level change.
+ *
+ * @param enable True to log.
+ */
+void setGpioLog(bool enable);
+
+/* ------------------------------ Profiling (sim_profile.cpp) ----------------------------- */
+
+/** True when the profile (-p) or the bus trace (-b) is enabled; the hooks below are only called then. */
+extern bool profiling;
+
+/**
+ * @brief Enables profiling; the table is written to `path` when the run ends.
+ *
+ * Function figures need firmware built with -finstrument-functions (`make bench`).
+ *
+ * @param path Output file.
+ */
+void profileOpen(const char* path);
+
+/**
+ * @brief Records a register access for the bus counts and the ISR output latency.
+ *
+ * @param addr  Register address.
+ * @param write True for writes.
+ */
+void profileAccess(uint32_t addr, bool write);
+
+/**
+ * @brief Records the start of an exception, before its entry cycles are charged.
+ *
+ * @param exc   Exception number.
+ * @param ready Time at which it became pending and enabled.
+ */
+void profileIsrEnter(int exc, uint64_t ready);
+
+/**
+ * @brief Records the return from the innermost exception, after its exit cycles are charged.
+ */
+void profileIsrExit(void);
+
+/**
+ * @brief Call context of the running code, used to attribute traced accesses.
+ */
+struct CallContext {
+    uint32_t path;    /**< Call path, see profilePathName(). */
+    uint32_t call;    /**< Serial number of the running top-level call. */
+    int exc;          /**< Running exception, 0 in thread mode. */
+};
+
+/**
+ * @brief Returns the context of the running code.
+ *
+ * Top-level calls are the functions called by main() (or main() itself, for its own accesses)
+ * and the entries of exception handlers. Without instrumentation every handler entry is still
+ * a call and the thread is one call.
+ */
+CallContext profileContext(void);
+
+/** Returns the number of call paths seen so far. */
+uint32_t profilePathCount(void);
+
+/**
+ * @brief Returns the name of a call path, its functions joined by '>'.
+ *
+ * @param path Call path.
+ * @return "main>configGPIO>PINSEL_ConfigPin" or "EINT0>EINT0_IRQHandler", "thread" for code
+ *         outside any instrumented function.
+ */
+std::string profilePathName(uint32_t path);
+
+/* ------------------------------ Bus trace (sim_trace.cpp) ------------------------------- */
+
+/** True when the bus trace is enabled (-b); traceAccess() is only called then. */
+extern bool tracing;
+
+/**
+ * @brief Enables the bus trace; the file is written when the run ends (see sim_trace.h).
+ *
+ * Accesses to GPIO, PINCON, GPIOINT, the system control block and SysTick are kept in a ring
+ * buffer, so a long run keeps the last `capacity` of them. Calling functions are only known
+ * for firmware built with -finstrument-functions (`make bench`).
+ *
+ * @param path     Output file.
+ * @param capacity Ring buffer size in records.
+ */
+void traceOpen(const char* path, uint32_t capacity);
+
+/**
+ * @brief Records a register access, after it completed.
+ *
+ * @param addr  Register address.
+ * @param value Value read or written.
+ * @param width Access width in bytes.
+ * @param write True for writes.
+ */
+void traceAccess(uint32_t addr, uint32_t value, uint32_t width, bool write);
+
+}    // namespace sim
+
+#endif    // SIM_H
@@ -0,0 +1,92 @@
+/**
+ * @file sim_io.h
+ * @brief Memory-mapped register proxy used by the host build of the LPC17xx headers.
+ *
+ * Every peripheral register in the host LPC17xx.h / core_cm3.h is declared as an IoReg<T>
+ * placed at its genuine LPC1769 address. Reads and writes go through sim::ioRead() and
+ * sim::ioWrite(), which advance the virtual clock, apply the peripheral side effects
+ * (FIOSET/FIOCLR, write-1-to-clear flags, SysTick reload, NVIC set/clear registers...) and
+ * dispatch any interrupt that becomes ready.
+ *
+ * The firmware is compiled as C++ so that plain C statements such as
+ * `LPC_GPIO0->FIOSET = RED_BIT;` or `LPC_SC->EXTINT |= EINT0_BIT;` resolve to these operators.
+ */
+
+#ifndef SIM_IO_H
+#define SIM_IO_H
+
+#ifndef __cplusplus
+#error "The host LPC17xx headers must be compiled as C++ (see host_sim/Makefile)."
+#endif
+
+#include <stdint.h>
+
+namespace sim {
+
+/**
+ * @brief Reads a register through the simulated bus.
+ *
+ * @param reg   Register address.
+ * @param width Access width in bytes (1, 2 or 4).
+ * @return Register value as seen by the firmware.
+ */
+uint32_t ioRead(const volatile void* reg, uint32_t width);
+
+/**
+ * @brief Writes a register through the simulated bus.
+ *
+ * @param reg   Register address.
+ * @param value Value to write.
+ * @param width Access width in bytes (1, 2 or 4).
+ */
+void ioWrite(volatile void* reg, uint32_t value, uint32_t width);
+
+/**
+ * @brief Register proxy of width sizeof(T).
+ *
+ * The object only holds the raw storage of the register; all behaviour lives in the simulator.
+ * Registers are always declared volatile, so `A->X = B->Y` resolves to the templated
+ * assignment below (a read followed by a write) rather than to the trivial copy assignment,
+ * which must stay trivial for the anonymous unions of the GPIO block.
+ */
+template <typename T>
+class IoReg {
+  public:
+    operator T() const volatile { return static_cast<T>(ioRead(this, sizeof(T))); }
+
+    T operator=(uint32_t v) volatile {
+        ioWrite(this, static_cast<T>(v), sizeof(T));
+        return static_cast<T>(v);
+    }
+    template <typename U>
+    T operator=(const volatile IoReg<U>& o) volatile {
+        return *this = static_cast<U>(o);
+    }
+
+    T operator|=(uint32_t v) volatile { return *this = static_cast<T>(*this) | v; }
+    T operator&=(uint32_t v) volatile { return *this = static_cast<T>(*this) & v; }
+    T operator^=(uint32_t v) volatile { return *this = static_cast<T>(*this) ^ v; }
+    T operator+=(uint32_t v) volatile { return *this = static_cast<T>(*this) + v; }
+    T operator-=(uint32_t v) volatile { return *this = static_cast<T>(*this) - v; }
+    T operator<<=(uint32_t v) volatile { return *this = static_cast<T>(*this) << v; }
+    T operator>>=(uint32_t v) volatile { return *this = static_cast<T>(*this) >> v; }
+    T operator++() volatile { return *this += 1; }
+    T operator--() volatile { return *this -= 1; }
+    T operator++(int) volatile {
+        const T old = *this;
+        *this       = old + 1;
+        return old;
+    }
+    T operator--(int) volatile {
+        const T old = *this;
+        *this       = old - 1;
+        return old;
+    }
+
+    /** Raw storage, only touched by the simulator. */
+    T raw;
+};
+
+}    // namespace sim
+
+#endif    // SIM_IO_H
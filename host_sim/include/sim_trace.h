@@ -0,0 +1,53 @@
+/**
+ * @file sim_trace.h
+ * @brief File format of the peripheral bus trace (-b), shared by the simulator and bustrace.
+ *
+ * A trace file is a TraceHeader, `stored` TraceRecords in time order and `paths` call path
+ * names, each terminated by a NUL. A call path is the chain of instrumented functions from the
+ * thread (main() first) or from an exception ("EINT0" first), joined by '>'.
+ */
+
+#ifndef SIM_TRACE_H
+#define SIM_TRACE_H
+
+#include <stdint.h>
+
+namespace sim {
+
+/** Magic number at the start of a trace file. */
+constexpr char TRACE_MAGIC[8] = {'L', 'P', 'C', 'B', 'U', 'S', '1', '\0'};
+
+/** TraceRecord::flags: the access is a write. */
+constexpr uint8_t TRACE_WRITE = 0x01;
+/** TraceRecord::flags: position of the access width in bytes (1, 2 or 4). */
+constexpr uint8_t TRACE_WIDTH_POS = 1;
+
+/**
+ * @brief Start of a trace file.
+ */
+struct TraceHeader {
+    char magic[8];        /**< TRACE_MAGIC. */
+    uint32_t recordSize;  /**< sizeof(TraceRecord). */
+    uint32_t paths;       /**< Number of call path names after the records. */
+    uint64_t recorded;    /**< Accesses recorded during the run. */
+    uint64_t stored;      /**< Records in the file: the last ones that fit in the ring buffer. */
+};
+
+/**
+ * @brief One register access.
+ */
+struct TraceRecord {
+    uint64_t time;    /**< Core cycle of the access. */
+    uint32_t addr;    /**< Register address. */
+    uint32_t value;   /**< Value read or written. */
+    uint32_t call;    /**< Top-level call: a function called by main() or a handler entry. */
+    uint16_t path;    /**< Call path of the accessing function. */
+    uint8_t flags;    /**< TRACE_WRITE and the width. */
+    uint8_t exc;      /**< Running exception, 0 in thread mode. */
+};
+
+static_assert(sizeof(TraceRecord) == 24, "trace records must stay packed");
+
+}    // namespace sim
+
+#endif    // SIM_TRACE_H
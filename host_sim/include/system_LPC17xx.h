@@ -0,0 +1,26 @@
+/**
+ * @file system_LPC17xx.h
+ * @brief Host build of the LPC17xx system/clock header.
+ *
+ * The simulated core always runs at 100 MHz, the clock assumed by every exercise.
+ */
+
+#ifndef SYSTEM_LPC17XX_H
+#define SYSTEM_LPC17XX_H
+
+#include <stdint.h>
+
+/** System clock frequency (core clock). */
+extern uint32_t SystemCoreClock;
+
+/**
+ * @brief Setup the microcontroller system. Nothing to do on the host.
+ */
+void SystemInit(void);
+
+/**
+ * @brief Updates SystemCoreClock. The simulated clock is fixed at 100 MHz.
+ */
+void SystemCoreClockUpdate(void);
+
+#endif    // SYSTEM_LPC17XX_H
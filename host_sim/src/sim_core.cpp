@@ -0,0 +1,490 @@
+/**
+ * @file sim_core.cpp
+ * @brief Virtual clock, register bus decoder and NVIC model of the LPC1769 host simulator.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "LPC17xx.h"
+#include "sim.h"
+
+/* Handlers not defined by the firmware resolve to null. */
+#pragma weak NMI_Handler
+#pragma weak HardFault_Handler
+#pragma weak MemManage_Handler
+#pragma weak BusFault_Handler
+#pragma weak UsageFault_Handler
+#pragma weak SVC_Handler
+#pragma weak DebugMon_Handler
+#pragma weak PendSV_Handler
+#pragma weak SysTick_Handler
+#pragma weak WDT_IRQHandler
+#pragma weak TIMER0_IRQHandler
+#pragma weak TIMER1_IRQHandler
+#pragma weak TIMER2_IRQHandler
+#pragma weak TIMER3_IRQHandler
+#pragma weak UART0_IRQHandler
+#pragma weak UART1_IRQHandler
+#pragma weak UART2_IRQHandler
+#pragma weak UART3_IRQHandler
+#pragma weak PWM1_IRQHandler
+#pragma weak I2C0_IRQHandler
+#pragma weak I2C1_IRQHandler
+#pragma weak I2C2_IRQHandler
+#pragma weak SPI_IRQHandler
+#pragma weak SSP0_IRQHandler
+#pragma weak SSP1_IRQHandler
+#pragma weak PLL0_IRQHandler
+#pragma weak RTC_IRQHandler
+#pragma weak EINT0_IRQHandler
+#pragma weak EINT1_IRQHandler
+#pragma weak EINT2_IRQHandler
+#pragma weak EINT3_IRQHandler
+#pragma weak ADC_IRQHandler
+#pragma weak BOD_IRQHandler
+#pragma weak USB_IRQHandler
+#pragma weak CAN_IRQHandler
+#pragma weak DMA_IRQHandler
+#pragma weak I2S_IRQHandler
+#pragma weak ENET_IRQHandler
+#pragma weak RIT_IRQHandler
+#pragma weak MCPWM_IRQHandler
+#pragma weak QEI_IRQHandler
+#pragma weak PLL1_IRQHandler
+#pragma weak USBActivity_IRQHandler
+#pragma weak CANActivity_IRQHandler
+
+uint32_t SystemCoreClock = sim::CORE_CLOCK;
+
+void SystemInit(void) {}
+
+void SystemCoreClockUpdate(void) { SystemCoreClock = sim::CORE_CLOCK; }
+
+namespace sim {
+
+uint64_t now       = 0;
+uint64_t nextEvent = UINT64_MAX;
+Stats stats        = {};
+
+namespace {
+
+/** Vector table indexed by exception number. */
+void (*const vectors[NUM_EXCEPTIONS])(void) = {
+    nullptr,           nullptr,          NMI_Handler,       HardFault_Handler, MemManage_Handler,
+    BusFault_Handler,  UsageFault_Handler, nullptr,         nullptr,           nullptr,
+    nullptr,           SVC_Handler,      DebugMon_Handler,  nullptr,           PendSV_Handler,
+    SysTick_Handler,   WDT_IRQHandler,   TIMER0_IRQHandler, TIMER1_IRQHandler, TIMER2_IRQHandler,
+    TIMER3_IRQHandler, UART0_IRQHandler, UART1_IRQHandler,  UART2_IRQHandler,  UART3_IRQHandler,
+    PWM1_IRQHandler,   I2C0_IRQHandler,  I2C1_IRQHandler,   I2C2_IRQHandler,   SPI_IRQHandler,
+    SSP0_IRQHandler,   SSP1_IRQHandler,  PLL0_IRQHandler,   RTC_IRQHandler,    EINT0_IRQHandler,
+    EINT1_IRQHandler,  EINT2_IRQHandler, EINT3_IRQHandler,  ADC_IRQHandler,    BOD_IRQHandler,
+    USB_IRQHandler,    CAN_IRQHandler,   DMA_IRQHandler,    I2S_IRQHandler,    ENET_IRQHandler,
+    RIT_IRQHandler,    MCPWM_IRQHandler, QEI_IRQHandler,    PLL1_IRQHandler,   USBActivity_IRQHandler,
+    CANActivity_IRQHandler,
+};
+
+const char* const names[NUM_EXCEPTIONS] = {
+    "-",      "Reset",  "NMI",    "HardFault", "MemManage", "BusFault", "UsageFault", "-",
+    "-",      "-",      "-",      "SVCall",    "DebugMon",  "-",        "PendSV",     "SysTick",
+    "WDT",    "TIMER0", "TIMER1", "TIMER2",    "TIMER3",    "UART0",    "UART1",      "UART2",
+    "UART3",  "PWM1",   "I2C0",   "I2C1",      "I2C2",      "SPI",      "SSP0",       "SSP1",
+    "PLL0",   "RTC",    "EINT0",  "EINT1",     "EINT2",     "EINT3",    "ADC",        "BOD",
+    "USB",    "CAN",    "DMA",    "I2S",       "ENET",      "RIT",      "MCPWM",      "QEI",
+    "PLL1",   "USBAct", "CANAct",
+};
+
+/** System exceptions that can be pended by the simulator are always enabled. */
+constexpr uint64_t SYSTEM_EXC_MASK = (1ULL << EXC_IRQ0) - 1;
+
+/** Page-aligned register regions mapped at their device addresses. */
+const uint32_t regions[][2] = {
+    {LPC_GPIO_BASE, 0x1000},       // Fast GPIO.
+    {LPC_TIM0_BASE, 0x1000},       // Timer 0.
+    {LPC_TIM1_BASE, 0x1000},       // Timer 1.
+    {LPC_TIM2_BASE, 0x1000},       // Timer 2.
+    {LPC_TIM3_BASE, 0x1000},       // Timer 3.
+    {0x40028000, 0x1000},          // GPIO interrupts.
+    {LPC_PINCON_BASE, 0x1000},     // Pin connect block.
+    {LPC_SC_BASE, 0x1000},         // System control.
+    {LPC_GPDMA_BASE, 0x1000},      // General purpose DMA.
+    {DWT_BASE, 0x1000},            // Data Watchpoint and Trace (cycle counter).
+    {SCS_BASE, 0x1000},            // SysTick, NVIC, SCB, Core Debug.
+};
+
+uint64_t enabled   = SYSTEM_EXC_MASK; /**< Enabled exceptions. */
+uint64_t pending   = 0;               /**< Pending exceptions. */
+uint64_t lines     = 0;               /**< Asserted device interrupt lines. */
+uint64_t active    = 0;               /**< Active exceptions. */
+uint8_t prio[NUM_EXCEPTIONS];         /**< Priority of each exception (8-bit field). */
+uint32_t primask   = 0;               /**< PRIMASK register. */
+int execPrio       = 256;             /**< Current execution priority (256 = thread). */
+int activeExc      = 0;               /**< Exception being serviced (0 = thread). */
+uint64_t readyAt[NUM_EXCEPTIONS];     /**< Time each exception became pending and enabled. */
+uint64_t handlerTotal = 0;            /**< Sum of stats.handlerCycles. */
+uint32_t cyccnt       = 0;            /**< DWT CYCCNT at cyccntTime. */
+uint64_t cyccntTime   = 0;            /**< Time CYCCNT was last brought up to date. */
+
+/** Marks exceptions as pending, timestamping the ones that were not. */
+inline void pend(uint64_t bits) {
+    uint64_t fresh = bits & ~pending;
+    pending |= bits;
+    while (fresh) {
+        readyAt[__builtin_ctzll(fresh)] = now;
+        fresh &= fresh - 1;
+    }
+}
+
+/** Enables exceptions; a pending one starts waiting from now. */
+inline void enable(uint64_t bits) {
+    uint64_t fresh = bits & ~enabled & pending;
+    enabled |= bits;
+    while (fresh) {
+        readyAt[__builtin_ctzll(fresh)] = now;
+        fresh &= fresh - 1;
+    }
+}
+
+/** Start of the bit-band regions (SRAM bank holding the GPIO, APB peripherals) and their size. */
+constexpr uint32_t BITBAND_SRAM   = 0x20000000;
+constexpr uint32_t BITBAND_PERIPH = 0x40000000;
+constexpr uint32_t BITBAND_SIZE   = 0x00100000;
+/** Distance from a bit-band region to its alias region, 32 words per byte of the region. */
+constexpr uint32_t BITBAND_ALIAS  = 0x02000000;
+
+/** Returns true if `addr` is in the alias region of a bit-band region. */
+inline bool isAlias(uint32_t addr) {
+    const uint32_t base = addr & 0xF0000000;
+
+    return (base == BITBAND_SRAM || base == BITBAND_PERIPH) && addr - base >= BITBAND_ALIAS &&
+           addr - base < BITBAND_ALIAS + BITBAND_SIZE * 32;
+}
+
+/** Returns the word addressed by an alias word. */
+inline uint32_t aliasWord(uint32_t addr) {
+    return (addr & 0xF0000000) + (((addr & 0x0FFFFFFF) - BITBAND_ALIAS) >> 5 & ~0x3u);
+}
+
+/** Returns the bit of its word addressed by an alias word. */
+inline uint32_t aliasBit(uint32_t addr) { return (addr >> 2) & 0x1F; }
+
+/** Returns the access cost of an address. */
+inline uint32_t accessCost(uint32_t addr) {
+    if (addr >= LPC_CM3_BASE)
+        return COST_PPB;
+    if (addr >= LPC_APB0_BASE && addr < LPC_AHB_BASE)
+        return COST_APB;
+    return COST_AHB;
+}
+
+/** Reads raw register storage of the given width. */
+inline uint32_t rawRead(uint32_t addr, uint32_t width) {
+    const volatile void* p = reinterpret_cast<const volatile void*>(static_cast<uintptr_t>(addr));
+    switch (width) {
+        case 1:  return *static_cast<const volatile uint8_t*>(p);
+        case 2:  return *static_cast<const volatile uint16_t*>(p);
+        default: return *static_cast<const volatile uint32_t*>(p);
+    }
+}
+
+/** Writes raw register storage of the given width. */
+inline void rawWrite(uint32_t addr, uint32_t value, uint32_t width) {
+    volatile void* p = reinterpret_cast<volatile void*>(static_cast<uintptr_t>(addr));
+    switch (width) {
+        case 1:  *static_cast<volatile uint8_t*>(p) = static_cast<uint8_t>(value); break;
+        case 2:  *static_cast<volatile uint16_t*>(p) = static_cast<uint16_t>(value); break;
+        default: *static_cast<volatile uint32_t*>(p) = value; break;
+    }
+}
+
+/** Brings CYCCNT up to date: it counts the virtual clock while DEMCR.TRCENA and CYCCNTENA are set. */
+void syncCycleCounter(void) {
+    if ((rawRead(CoreDebug_BASE + 0x0C, 4) & CoreDebug_DEMCR_TRCENA_Msk) &&
+        (rawRead(DWT_BASE, 4) & DWT_CTRL_CYCCNTENA_Msk))
+        cyccnt += static_cast<uint32_t>(now - cyccntTime);
+    cyccntTime = now;
+}
+
+/** Handles accesses to the DWT: CYCCNT follows the virtual clock, the rest is plain storage. */
+uint32_t dwtAccess(uint32_t addr, uint32_t value, uint32_t width, bool write) {
+    syncCycleCounter();
+    if (addr - DWT_BASE == 0x004 && width == 4) {    // CYCCNT.
+        if (write)
+            cyccnt = value;
+        return write ? 0 : cyccnt;
+    }
+    if (write)
+        rawWrite(addr, value, width);
+    return write ? 0 : rawRead(addr, width);
+}
+
+/** Handles accesses to the NVIC, SCB and Core Debug; SysTick is left to the peripheral models. */
+uint32_t scsAccess(uint32_t addr, uint32_t value, uint32_t width, bool write) {
+    const uint32_t off = addr - SCS_BASE;
+
+    if (off >= 0x100 && off < 0x300) {    // ISER / ICER / ISPR / ICPR.
+        const uint32_t bank  = (off & 0x7F) >> 2;
+        const uint32_t group = (off - 0x100) >> 7;
+        if (bank != 0 && bank != 1)
+            return 0;
+        const int shift     = EXC_IRQ0 + 32 * bank;
+        const uint64_t bits = (static_cast<uint64_t>(value) << shift) & ~SYSTEM_EXC_MASK;
+        uint64_t& reg       = group < 2 ? enabled : pending;
+        if (!write)
+            return static_cast<uint32_t>(reg >> shift);
+        switch (group) {
+            case 0: enable(bits); break;
+            case 1: enabled &= ~bits; break;
+            case 2: pend(bits); break;
+            case 3:    // Asserted lines pend again at once.
+                pending &= ~bits;
+                pend(lines & bits);
+                break;
+        }
+        return 0;
+    }
+    if (off >= 0x300 && off < 0x308) {    // IABR.
+        const uint32_t bank = (off - 0x300) >> 2;
+        return write ? 0 : static_cast<uint32_t>(active >> (EXC_IRQ0 + 32 * bank));
+    }
+    if (off >= 0x400 && off < 0x400 + NUM_EXCEPTIONS - EXC_IRQ0) {    // IP[].
+        if (write) {
+            for (uint32_t i = 0; i < width; i++) {
+                const uint32_t irq                   = off - 0x400 + i;
+                prio[EXC_IRQ0 + irq]                 = (value >> (8 * i)) & 0xF8;
+                *reinterpret_cast<volatile uint8_t*>(static_cast<uintptr_t>(addr + i)) =
+                    prio[EXC_IRQ0 + irq];
+            }
+            return 0;
+        }
+        return rawRead(addr, width);
+    }
+    if (off == 0xF00 && write) {    // STIR.
+        pend(1ULL << (EXC_IRQ0 + (value & 0x3F)));
+        return 0;
+    }
+    if (off == 0xD04) {    // ICSR.
+        if (!write) {
+            uint32_t icsr = activeExc;
+            if (pending & (1ULL << EXC_PENDSV))
+                icsr |= SCB_ICSR_PENDSVSET_Msk;
+            if (pending & (1ULL << EXC_SYSTICK))
+                icsr |= SCB_ICSR_PENDSTSET_Msk;
+            return icsr;
+        }
+        if (value & SCB_ICSR_PENDSVSET_Msk)
+            pend(1ULL << EXC_PENDSV);
+        if (value & SCB_ICSR_PENDSVCLR_Msk)
+            pending &= ~(1ULL << EXC_PENDSV);
+        if (value & SCB_ICSR_PENDSTSET_Msk)
+            pend(1ULL << EXC_SYSTICK);
+        if (value & SCB_ICSR_PENDSTCLR_Msk)
+            pending &= ~(1ULL << EXC_SYSTICK);
+        return 0;
+    }
+    if (off >= 0xD18 && off < 0xD24) {    // SHP[].
+        if (write) {
+            for (uint32_t i = 0; i < width; i++) {
+                const uint32_t exc = 4 + off - 0xD18 + i;
+                prio[exc]          = (value >> (8 * i)) & 0xF8;
+                *reinterpret_cast<volatile uint8_t*>(static_cast<uintptr_t>(addr + i)) = prio[exc];
+            }
+            return 0;
+        }
+        return rawRead(addr, width);
+    }
+    if (off >= 0x010 && off < 0x020)    // SysTick.
+        return periphAccess(addr, value, width, write);
+    if (off >= 0xDFC && off < 0xE00 && write)    // DEMCR: TRCENA starts or stops CYCCNT.
+        syncCycleCounter();
+
+    if (write)
+        rawWrite(addr, value, width);
+    return write ? 0 : rawRead(addr, width);
+}
+
+/** Returns the highest priority pending exception that may preempt, or 0. */
+int nextException(void) {
+    if (primask)
+        return 0;
+    uint64_t ready = pending & enabled;
+    int best       = 0;
+    int bestPrio   = execPrio;
+    while (ready) {
+        const int exc = __builtin_ctzll(ready);
+        ready &= ready - 1;
+        if (prio[exc] < bestPrio) {
+            best     = exc;
+            bestPrio = prio[exc];
+        }
+    }
+    return best;
+}
+
+}    // namespace
+
+void init(void) {
+    for (const auto& region : regions) {
+        void* want = reinterpret_cast<void*>(static_cast<uintptr_t>(region[0]));
+        void* got  = mmap(want, region[1], PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (got != want) {
+            fprintf(stderr, "host_sim: cannot map registers at 0x%08X\n", region[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    memset(prio, 0, sizeof(prio));
+    periphReset();
+}
+
+void service(void) {
+    runEvents();
+    dispatch();
+}
+
+void setPending(int exc) { pend(1ULL << exc); }
+
+void setLine(int irqn, bool asserted) {
+    const uint64_t bit = 1ULL << (EXC_IRQ0 + irqn);
+    if (asserted) {
+        if (!(lines & bit))
+            pend(bit);    // Latched on assertion; re-checked at exception return.
+        lines |= bit;
+    } else {
+        lines &= ~bit;
+    }
+}
+
+void dispatch(void) {
+    int exc;
+    while ((exc = nextException()) != 0) {
+        const uint64_t bit = 1ULL << exc;
+        const int prevPrio = execPrio;
+        const int prevExc  = activeExc;
+
+        pending &= ~bit;
+        active |= bit;
+        execPrio  = prio[exc];
+        activeExc = exc;
+        stats.exc[exc]++;
+
+        if (profiling)
+            profileIsrEnter(exc, readyAt[exc]);
+        const uint64_t entry = now;
+        const uint64_t inner = handlerTotal;
+        const uint64_t sleep = stats.sleepCycles;
+        tick(COST_IRQ_ENTRY);
+        const uint64_t start = now;
+        if (start - readyAt[exc] > stats.maxLatency[exc])
+            stats.maxLatency[exc] = start - readyAt[exc];
+        if (vectors[exc])
+            vectors[exc]();
+        tick(COST_IRQ_EXIT);
+        if (now - start > stats.maxHandler[exc])
+            stats.maxHandler[exc] = now - start;
+        // Entry and return included; preempting handlers and sleep are charged elsewhere.
+        const uint64_t own = (now - entry) - (handlerTotal - inner) - (stats.sleepCycles - sleep);
+        stats.handlerCycles[exc] += own;
+        handlerTotal += own;
+        if (profiling)
+            profileIsrExit();
+
+        active &= ~bit;
+        execPrio  = prevPrio;
+        activeExc = prevExc;
+        pend(lines & bit);    // A still asserted line pends again.
+    }
+}
+
+void waitForInterrupt(void) {
+    stats.wfiCalls++;
+    stats.sleepCycles++;
+    tick(1);
+    while (!(pending & enabled)) {
+        // Nothing can happen before the next deadline: jump straight to it.
+        stats.sleepCycles += nextEvent - now;    // Counted first: the run may end there.
+        now = nextEvent;
+        runEvents();
+    }
+    dispatch();
+}
+
+void setPrimask(uint32_t mask) {
+    primask = mask & 1;
+    if (!primask)
+        dispatch();
+}
+
+uint32_t getPrimask(void) { return primask; }
+
+namespace {
+
+/** One bus read: counters, profile, peripheral model and trace. The caller charges the cycles. */
+uint32_t busRead(uint32_t addr, uint32_t width) {
+    stats.reads++;
+    if (profiling)
+        profileAccess(addr, false);
+    const uint32_t value = addr >= SCS_BASE   ? scsAccess(addr, 0, width, false)
+                           : addr >= DWT_BASE ? dwtAccess(addr, 0, width, false)
+                                              : periphAccess(addr, 0, width, false);
+    if (tracing)
+        traceAccess(addr, value, width, false);
+    return value;
+}
+
+/** One bus write: counters, profile, peripheral model and trace. The caller charges the cycles. */
+void busWrite(uint32_t addr, uint32_t value, uint32_t width) {
+    stats.writes++;
+    if (profiling)
+        profileAccess(addr, true);
+    if (addr >= SCS_BASE)
+        scsAccess(addr, value, width, true);
+    else if (addr >= DWT_BASE)
+        dwtAccess(addr, value, width, true);
+    else
+        periphAccess(addr, value, width, true);
+    if (tracing)
+        traceAccess(addr, value, width, true);
+}
+
+}    // namespace
+
+uint32_t ioRead(const volatile void* reg, uint32_t width) {
+    const uint32_t addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(reg));
+
+    // An alias word reads as one bit of its word.
+    if (isAlias(addr)) {
+        const uint32_t word = aliasWord(addr);
+
+        tick(accessCost(word));
+        return (busRead(word, 4) >> aliasBit(addr)) & 0x1;
+    }
+    tick(accessCost(addr));
+    return busRead(addr, width);
+}
+
+void ioWrite(volatile void* reg, uint32_t value, uint32_t width) {
+    const uint32_t addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(reg));
+
+    if (isAlias(addr)) {
+        // The bus reads the word and writes it back with one bit changed, locked: both accesses
+        // are charged first, so no interrupt runs between them.
+        const uint32_t word = aliasWord(addr);
+        const uint32_t bit  = 1UL << aliasBit(addr);
+
+        tick(2 * accessCost(word));
+        const uint32_t old = busRead(word, 4);
+        busWrite(word, (value & 0x1) ? old | bit : old & ~bit, 4);
+    } else {
+        tick(accessCost(addr));
+        busWrite(addr, value, width);
+    }
+    if (pending & enabled)
+        dispatch();
+}
+
+const char* excName(int exc) { return (exc >= 0 && exc < NUM_EXCEPTIONS) ? names[exc] : "?"; }
+
+}    // namespace sim
@@ -0,0 +1,263 @@
+/**
+ * @file sim_dma.cpp
+ * @brief Behavioural model of the LPC1769 general purpose DMA controller (GPDMA).
+ *
+ * Eight channels, served in priority order (channel 0 first), with source/destination widths
+ * and increments, burst sizes, linked lists and the terminal count and error interrupts.
+ * Memory-to-memory transfers run to completion when the channel is enabled; memory-to-peripheral
+ * and peripheral-to-memory transfers move one burst per request. The only request sources are
+ * the timer matches MAT0.0-MAT3.1 selected in DMAREQSEL (lines 8-15).
+ *
+ * Transfers take no simulated time and are not counted as register accesses of the firmware:
+ * they are counted in stats.dmaTransfers. A request with no enabled channel is dropped, not
+ * latched. Addresses outside the register regions are host memory: the firmware is linked at
+ * 32-bit addresses (-no-pie), so buffers and linked list items must be static.
+ */
+
+#include "LPC17xx.h"
+#include "sim.h"
+
+namespace sim {
+
+namespace {
+
+/** Number of channels. */
+constexpr int NUM_CHANNELS = 8;
+/** First request line of the timer matches (MAT0.0). */
+constexpr uint32_t LINE_MAT0_0 = 8;
+
+/** Controller register offsets. */
+enum : uint32_t {
+    INT_STAT     = 0x000,
+    INT_TC_STAT  = 0x004,
+    INT_TC_CLEAR = 0x008,
+    INT_ERR_STAT = 0x00C,
+    INT_ERR_CLR  = 0x010,
+    RAW_TC_STAT  = 0x014,
+    RAW_ERR_STAT = 0x018,
+    ENBLD_CHNS   = 0x01C,
+    CONFIG       = 0x030,
+};
+
+/** Channel register offsets. */
+enum : uint32_t {
+    SRC     = 0x00,
+    DEST    = 0x04,
+    LLI     = 0x08,
+    CONTROL = 0x0C,
+    CFG     = 0x10,
+};
+
+/** DMACCControl fields. */
+constexpr uint32_t CTRL_SIZE_MASK = 0xFFF;
+constexpr uint32_t CTRL_DBSIZE    = 15;
+constexpr uint32_t CTRL_SWIDTH    = 18;
+constexpr uint32_t CTRL_DWIDTH    = 21;
+constexpr uint32_t CTRL_SI        = 1u << 26;
+constexpr uint32_t CTRL_DI        = 1u << 27;
+constexpr uint32_t CTRL_I         = 1u << 31;
+
+/** DMACCConfig fields. */
+constexpr uint32_t CFG_E          = 1u << 0;
+constexpr uint32_t CFG_SRC_PERIPH = 1;
+constexpr uint32_t CFG_DST_PERIPH = 6;
+constexpr uint32_t CFG_TYPE       = 11;
+constexpr uint32_t CFG_IE         = 1u << 14;
+constexpr uint32_t CFG_ITC        = 1u << 15;
+
+/** Transfer types. */
+enum : uint32_t { M2M = 0, M2P = 1, P2M = 2 };
+
+/** DMAREQSEL offset in the SC block. */
+constexpr uint32_t DMAREQSEL = 0x1C4;
+
+uint32_t rawTc  = 0; /**< Raw terminal count flags. */
+uint32_t rawErr = 0; /**< Raw error flags. */
+
+inline uint32_t chBase(int ch) { return LPC_GPDMACH0_BASE + 0x20 * ch; }
+inline volatile uint32_t& chReg(int ch, uint32_t off) { return word(chBase(ch) + off); }
+
+/** Channels whose terminal count interrupt is enabled (ITC). */
+uint32_t tcMask(void) {
+    uint32_t mask = 0;
+    for (int ch = 0; ch < NUM_CHANNELS; ch++)
+        if (chReg(ch, CFG) & CFG_ITC)
+            mask |= 1u << ch;
+    return mask;
+}
+
+/** Channels whose error interrupt is enabled (IE). */
+uint32_t errMask(void) {
+    uint32_t mask = 0;
+    for (int ch = 0; ch < NUM_CHANNELS; ch++)
+        if (chReg(ch, CFG) & CFG_IE)
+            mask |= 1u << ch;
+    return mask;
+}
+
+void updateLine(void) { setLine(DMA_IRQn, (rawTc & tcMask()) || (rawErr & errMask())); }
+
+/** Register blocks accessed through the peripheral models; anything else is host memory. */
+inline bool isDevice(uint32_t addr) {
+    return (addr >= LPC_GPIO_BASE && addr < LPC_GPIO_BASE + 0x4000) ||
+           (addr >= LPC_APB0_BASE && addr < LPC_APB1_BASE + 0x80000) ||
+           (addr >= LPC_AHB_BASE && addr < LPC_AHB_BASE + 0x200000);
+}
+
+uint32_t busRead(uint32_t addr, uint32_t width) {
+    if (isDevice(addr))
+        return periphAccess(addr, 0, width, false);
+    const volatile void* p = reinterpret_cast<const volatile void*>(static_cast<uintptr_t>(addr));
+    switch (width) {
+        case 1:  return *static_cast<const volatile uint8_t*>(p);
+        case 2:  return *static_cast<const volatile uint16_t*>(p);
+        default: return *static_cast<const volatile uint32_t*>(p);
+    }
+}
+
+void busWrite(uint32_t addr, uint32_t value, uint32_t width) {
+    if (isDevice(addr)) {
+        periphAccess(addr, value, width, true);
+        return;
+    }
+    volatile void* p = reinterpret_cast<volatile void*>(static_cast<uintptr_t>(addr));
+    switch (width) {
+        case 1:  *static_cast<volatile uint8_t*>(p) = static_cast<uint8_t>(value); break;
+        case 2:  *static_cast<volatile uint16_t*>(p) = static_cast<uint16_t>(value); break;
+        default: *static_cast<volatile uint32_t*>(p) = value; break;
+    }
+}
+
+/** The transfer of a channel is done: load the next linked list item or disable it. */
+void complete(int ch) {
+    if (chReg(ch, CONTROL) & CTRL_I)
+        rawTc |= 1u << ch;
+
+    const uint32_t lli = chReg(ch, LLI);
+    if (lli) {
+        chReg(ch, SRC)     = busRead(lli, 4);
+        chReg(ch, DEST)    = busRead(lli + 4, 4);
+        chReg(ch, LLI)     = busRead(lli + 8, 4);
+        chReg(ch, CONTROL) = busRead(lli + 12, 4);
+    } else {
+        chReg(ch, CFG) &= ~CFG_E;
+    }
+    updateLine();
+}
+
+/** Moves up to `count` items of a channel, then completes it if its size reached 0. */
+void transfer(int ch, uint32_t count) {
+    const uint32_t control = chReg(ch, CONTROL);
+    const uint32_t swidth  = 1u << ((control >> CTRL_SWIDTH) & 0x7);
+    const uint32_t dwidth  = 1u << ((control >> CTRL_DWIDTH) & 0x7);
+    uint32_t size          = control & CTRL_SIZE_MASK;
+    uint32_t src           = chReg(ch, SRC);
+    uint32_t dest          = chReg(ch, DEST);
+
+    for (; count && size; count--, size--) {
+        busWrite(dest, busRead(src, swidth), dwidth);
+        stats.dmaTransfers++;
+        if (control & CTRL_SI)
+            src += swidth;
+        if (control & CTRL_DI)
+            dest += dwidth;
+    }
+    chReg(ch, SRC)     = src;
+    chReg(ch, DEST)    = dest;
+    chReg(ch, CONTROL) = (control & ~CTRL_SIZE_MASK) | size;
+    if (size == 0)
+        complete(ch);
+}
+
+/** Runs a memory-to-memory channel, linked list included, to completion. */
+void runMemToMem(int ch) {
+    while ((chReg(ch, CFG) & CFG_E) && ((chReg(ch, CFG) >> CFG_TYPE) & 0x7) == M2M)
+        transfer(ch, UINT32_MAX);
+}
+
+/** Serves a request line with the highest priority enabled channel waiting for it. */
+void request(uint32_t line) {
+    if (!(word(LPC_GPDMA_BASE + CONFIG) & 0x1))
+        return;
+    for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+        const uint32_t cfg  = chReg(ch, CFG);
+        const uint32_t type = (cfg >> CFG_TYPE) & 0x7;
+        if (!(cfg & CFG_E) || (type != M2P && type != P2M))
+            continue;
+        const uint32_t periph = (cfg >> (type == M2P ? CFG_DST_PERIPH : CFG_SRC_PERIPH)) & 0x1F;
+        if (periph != line)
+            continue;
+        static const uint32_t bursts[8] = {1, 4, 8, 16, 32, 64, 128, 256};
+        transfer(ch, bursts[(chReg(ch, CONTROL) >> CTRL_DBSIZE) & 0x7]);
+        return;
+    }
+}
+
+}    // namespace
+
+void dmaReset(void) {
+    rawTc  = 0;
+    rawErr = 0;
+    for (int ch = 0; ch < NUM_CHANNELS; ch++)
+        chReg(ch, CFG) = 0;
+    updateLine();
+}
+
+bool dmaAccess(uint32_t addr, uint32_t value, bool write, uint32_t* result) {
+    if (addr < LPC_GPDMA_BASE || addr >= LPC_GPDMA_BASE + 0x1000)
+        return false;
+    *result = 0;
+
+    if (addr >= LPC_GPDMACH0_BASE) {    // Channel registers: plain storage, except enabling.
+        const int ch       = static_cast<int>((addr - LPC_GPDMACH0_BASE) / 0x20);
+        const uint32_t off = (addr - LPC_GPDMACH0_BASE) % 0x20;
+        if (ch >= NUM_CHANNELS || off > CFG)
+            return true;
+        if (!write) {
+            *result = chReg(ch, off);
+            return true;
+        }
+        chReg(ch, off) = value;
+        if (off == CFG) {
+            updateLine();
+            runMemToMem(ch);
+        }
+        return true;
+    }
+
+    const uint32_t off = addr - LPC_GPDMA_BASE;
+    if (!write) {
+        switch (off) {
+            case INT_STAT:     *result = (rawTc & tcMask()) | (rawErr & errMask()); break;
+            case INT_TC_STAT:  *result = rawTc & tcMask(); break;
+            case INT_ERR_STAT: *result = rawErr & errMask(); break;
+            case RAW_TC_STAT:  *result = rawTc; break;
+            case RAW_ERR_STAT: *result = rawErr; break;
+            case ENBLD_CHNS:
+                for (int ch = 0; ch < NUM_CHANNELS; ch++)
+                    if (chReg(ch, CFG) & CFG_E)
+                        *result |= 1u << ch;
+                break;
+            default: *result = word(addr); break;
+        }
+        return true;
+    }
+    switch (off) {
+        case INT_TC_CLEAR: rawTc &= ~value; break;
+        case INT_ERR_CLR:  rawErr &= ~value; break;
+        default:           word(addr) = value; break;
+    }
+    updateLine();
+    return true;
+}
+
+bool dmaTimerSelected(int timer, int match) {
+    return (word(LPC_SC_BASE + DMAREQSEL) >> (2 * timer + match)) & 0x1;
+}
+
+void dmaTimerMatch(int timer, int match) {
+    if (dmaTimerSelected(timer, match))
+        request(LINE_MAT0_0 + 2 * timer + match);
+}
+
+}    // namespace sim
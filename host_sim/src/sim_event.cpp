@@ -0,0 +1,95 @@
+/**
+ * @file sim_event.cpp
+ * @brief Discrete-event scheduler of the LPC1769 host simulator.
+ *
+ * Pending deadlines are kept in a binary min-heap ordered by time, then by scheduling order so
+ * that simultaneous events run deterministically. Rescheduling or cancelling an event does not
+ * search the heap: the event's generation number is bumped and the stale heap entry is dropped
+ * when it reaches the top. The heap is compacted when stale entries outnumber live ones.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "sim.h"
+
+namespace sim {
+
+namespace {
+
+/**
+ * @brief Heap entry; valid while its generation matches the one of its event.
+ */
+struct Entry {
+    uint64_t time;    /**< Deadline in cycles. */
+    uint64_t order;   /**< Scheduling order, breaks ties between equal deadlines. */
+    Event* event;     /**< Scheduled event. */
+    uint32_t gen;     /**< Generation of the event when it was scheduled. */
+};
+
+/** Heap comparator: the earliest deadline ends up at the front. */
+inline bool later(const Entry& a, const Entry& b) {
+    return a.time != b.time ? a.time > b.time : a.order > b.order;
+}
+
+/** Initialised ahead of the simulator constructor, which schedules the first events. */
+std::vector<Entry> heap __attribute__((init_priority(101)));
+uint64_t scheduled = 0;    /**< Events scheduled so far, used as tie breaker. */
+size_t live        = 0;    /**< Heap entries that are still valid. */
+
+inline bool stale(const Entry& e) { return e.gen != e.event->gen; }
+
+/** Drops stale entries from the top and refreshes sim::nextEvent. */
+void settle(void) {
+    while (!heap.empty() && stale(heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        heap.pop_back();
+    }
+    nextEvent = heap.empty() ? UINT64_MAX : heap.front().time;
+}
+
+/** Rebuilds the heap from its valid entries. */
+void compact(void) {
+    heap.erase(std::remove_if(heap.begin(), heap.end(), stale), heap.end());
+    std::make_heap(heap.begin(), heap.end(), later);
+}
+
+}    // namespace
+
+void schedule(Event& event, uint64_t time) {
+    if (event.time != UINT64_MAX)
+        live--;
+    event.gen++;
+    event.time = time;
+    live++;
+    heap.push_back(Entry{time, scheduled++, &event, event.gen});
+    std::push_heap(heap.begin(), heap.end(), later);
+    if (heap.size() > 2 * live + 64)
+        compact();
+    settle();
+}
+
+void cancel(Event& event) {
+    if (event.time == UINT64_MAX)
+        return;
+    live--;
+    event.gen++;
+    event.time = UINT64_MAX;
+    settle();
+}
+
+void runEvents(void) {
+    while (now >= nextEvent) {
+        Event& event = *heap.front().event;
+        std::pop_heap(heap.begin(), heap.end(), later);
+        heap.pop_back();
+        live--;
+        event.gen++;
+        event.time = UINT64_MAX;
+        settle();
+        stats.events++;
+        event.action();    // May schedule further events, including itself.
+    }
+}
+
+}    // namespace sim
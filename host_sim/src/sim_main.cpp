@@ -0,0 +1,222 @@
+/**
+ * @file sim_main.cpp
+ * @brief Command line, testbench stimulus and end-of-run report of the LPC1769 host simulator.
+ *
+ * The firmware keeps its own main(). The simulator starts from an ELF constructor, which
+ * receives argc/argv from glibc before main() runs, maps the register file and installs the
+ * report that is printed when the firmware returns or the simulated time runs out.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "sim.h"
+
+namespace sim {
+
+namespace {
+
+/**
+ * @brief Testbench action: drive a pin at a given time.
+ */
+struct Stimulus {
+    uint64_t time;    /**< Time in cycles. */
+    uint32_t port;    /**< Port number. */
+    uint32_t pin;     /**< Pin number. */
+    int level;        /**< 0, 1 or -1 (release). */
+};
+
+/** Initialised ahead of startup(), which fills it from the command line. */
+std::vector<Stimulus> stimuli __attribute__((init_priority(101)));
+size_t nextStimulus   = 0;
+uint64_t runEnd       = CORE_CLOCK;    // 1 s by default.
+bool quiet            = false;
+const char* tracePath = nullptr;
+uint32_t traceRecords = 1u << 20;    // 24 MiB.
+timespec hostStart;
+
+void applyStimuli(void);
+void endOfRun(void);
+
+/** Next stimulus to apply. */
+Event stimulusEvent{applyStimuli};
+/** End of the simulated time (-t). */
+Event endEvent{endOfRun};
+
+void usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  -t TIME            simulated time to run (default 1s)\n"
+            "  -s TIME:Pp.n=V     drive pin p.n to V (0, 1 or z) at TIME; repeatable\n"
+            "  -f FILE            read stimuli from FILE, one 'TIME Pp.n=V' per line\n"
+            "  -g                 log every GPIO level change\n"
+            "  -p FILE            write the per-function profile to FILE (see make bench)\n"
+            "  -b FILE            write the bus trace to FILE (see build/bustrace)\n"
+            "  -B RECORDS         size of the bus trace ring buffer (default 1048576)\n"
+            "  -q                 do not print the end-of-run report\n"
+            "TIME accepts the suffixes s, ms, us, ns and c (cycles); the default unit is s.\n",
+            prog);
+    exit(EXIT_FAILURE);
+}
+
+/** Parses a duration such as "5s", "250ms" or "1200c" into cycles. */
+bool parseTime(const char* text, uint64_t* cycles) {
+    char* end;
+    const double value = strtod(text, &end);
+    double scale       = CORE_CLOCK;
+    if (end == text)
+        return false;
+    if (!strcmp(end, "ms"))
+        scale = CORE_CLOCK / 1e3;
+    else if (!strcmp(end, "us"))
+        scale = CORE_CLOCK / 1e6;
+    else if (!strcmp(end, "ns"))
+        scale = CORE_CLOCK / 1e9;
+    else if (!strcmp(end, "c"))
+        scale = 1;
+    else if (*end && strcmp(end, "s"))
+        return false;
+    *cycles = static_cast<uint64_t>(value * scale + 0.5);
+    return true;
+}
+
+/** Parses "TIME:Pp.n=V" (or "TIME Pp.n=V" when sep is ' '). */
+bool parseStimulus(const char* text, char sep) {
+    char timeText[32];
+    const char* split = strchr(text, sep);
+    Stimulus s;
+    char level;
+    if (!split || split - text >= static_cast<long>(sizeof(timeText)))
+        return false;
+    memcpy(timeText, text, split - text);
+    timeText[split - text] = '\0';
+    if (!parseTime(timeText, &s.time))
+        return false;
+    while (*++split == ' ') {}
+    if (sscanf(split, "P%u.%u=%c", &s.port, &s.pin, &level) != 3 || s.port > 4 || s.pin > 31)
+        return false;
+    if (level != '0' && level != '1' && level != 'z')
+        return false;
+    s.level = level == 'z' ? -1 : level - '0';
+    stimuli.push_back(s);
+    return true;
+}
+
+void loadStimulusFile(const char* path) {
+    FILE* f = fopen(path, "r");
+    char line[128];
+    if (!f) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "#\r\n")] = '\0';
+        if (line[strspn(line, " \t")] == '\0')
+            continue;
+        if (!parseStimulus(line + strspn(line, " \t"), ' ')) {
+            fprintf(stderr, "%s: bad stimulus '%s'\n", path, line);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fclose(f);
+}
+
+/** Applies every stimulus due now and schedules the next one. */
+void applyStimuli(void) {
+    while (nextStimulus < stimuli.size() && stimuli[nextStimulus].time <= now) {
+        const Stimulus& s = stimuli[nextStimulus++];
+        drivePin(s.port, s.pin, s.level);
+    }
+    if (nextStimulus < stimuli.size())
+        schedule(stimulusEvent, stimuli[nextStimulus].time);
+}
+
+void endOfRun(void) { finish("end of simulated time"); }
+
+void report(void) {
+    timespec hostEnd;
+    clock_gettime(CLOCK_MONOTONIC, &hostEnd);
+    fflush(stdout);
+    if (quiet)
+        return;
+
+    const double host     = (hostEnd.tv_sec - hostStart.tv_sec) + (hostEnd.tv_nsec - hostStart.tv_nsec) / 1e9;
+    const double simTime  = static_cast<double>(now) / CORE_CLOCK;
+    const uint64_t access = stats.reads + stats.writes;
+    uint64_t handlers     = 0;
+    for (int exc = 0; exc < NUM_EXCEPTIONS; exc++)
+        handlers += stats.handlerCycles[exc];
+    const auto percent = [](uint64_t cycles) { return now ? 100.0 * cycles / now : 0.0; };
+
+    fprintf(stderr, "--- host_sim report ---\n");
+    fprintf(stderr, "simulated time   : %.6f s (%llu cycles)\n", simTime, (unsigned long long)now);
+    fprintf(stderr, "host time        : %.6f s (%.1fx real time)\n", host, host > 0 ? simTime / host : 0.0);
+    fprintf(stderr, "register accesses: %llu (%llu reads, %llu writes), %.1f M/s\n", (unsigned long long)access,
+            (unsigned long long)stats.reads, (unsigned long long)stats.writes, host > 0 ? access / host / 1e6 : 0.0);
+    fprintf(stderr, "sleep (__WFI)    : %.2f %% of simulated time, %llu calls\n", percent(stats.sleepCycles),
+            (unsigned long long)stats.wfiCalls);
+    fprintf(stderr, "cpu active       : %.4f %% of simulated time (thread %.4f %%, handlers %.4f %%)\n",
+            percent(now - stats.sleepCycles), percent(now - stats.sleepCycles - handlers),
+            percent(handlers));
+    fprintf(stderr, "scheduler events : %llu\n", (unsigned long long)stats.events);
+    if (stats.dmaTransfers)
+        fprintf(stderr, "dma transfers    : %llu\n", (unsigned long long)stats.dmaTransfers);
+    for (int exc = 0; exc < NUM_EXCEPTIONS; exc++)
+        if (stats.exc[exc])
+            fprintf(stderr, "exception %-7s: %llu, worst latency %.3f us, worst handler %.3f us, cpu %.4f %%\n",
+                    excName(exc), (unsigned long long)stats.exc[exc], stats.maxLatency[exc] * 1e6 / CORE_CLOCK,
+                    stats.maxHandler[exc] * 1e6 / CORE_CLOCK, percent(stats.handlerCycles[exc]));
+}
+
+/**
+ * @brief Simulator entry point, run by glibc before the firmware main().
+ */
+__attribute__((constructor(102))) void startup(int argc, char** argv, char**) {
+    int opt;
+    while ((opt = getopt(argc, argv, "t:s:f:gp:b:B:qh")) != -1) {
+        switch (opt) {
+            case 't':
+                if (!parseTime(optarg, &runEnd))
+                    usage(argv[0]);
+                break;
+            case 's':
+                if (!parseStimulus(optarg, ':'))
+                    usage(argv[0]);
+                break;
+            case 'f': loadStimulusFile(optarg); break;
+            case 'g': setGpioLog(true); break;
+            case 'p': profileOpen(optarg); break;
+            case 'b': tracePath = optarg; break;
+            case 'B': traceRecords = static_cast<uint32_t>(strtoul(optarg, nullptr, 0)); break;
+            case 'q': quiet = true; break;
+            default:  usage(argv[0]);
+        }
+    }
+    if (tracePath)
+        traceOpen(tracePath, traceRecords);
+    std::stable_sort(stimuli.begin(), stimuli.end(),
+                     [](const Stimulus& a, const Stimulus& b) { return a.time < b.time; });
+
+    clock_gettime(CLOCK_MONOTONIC, &hostStart);
+    atexit(report);
+    init();
+    schedule(endEvent, runEnd);
+    if (!stimuli.empty())
+        schedule(stimulusEvent, stimuli.front().time);
+}
+
+}    // namespace
+
+void finish(const char* reason) {
+    if (!quiet)
+        fprintf(stderr, "host_sim: %s\n", reason);
+    exit(EXIT_SUCCESS);
+}
+
+}    // namespace sim
@@ -0,0 +1,385 @@
+/**
+ * @file sim_periph.cpp
+ * @brief Behavioural models of the LPC1769 peripherals used by the workshops.
+ *
+ * - Fast GPIO: FIODIR, FIOMASK, FIOPIN, FIOSET, FIOCLR with word/halfword/byte lanes.
+ * - Pin connect block: PINSEL selects GPIO/EINT functions, PINMODE drives undriven inputs.
+ * - GPIO interrupts on ports 0 and 2, shared with EINT3.
+ * - External interrupts EINT0-EINT3 on P2.10-P2.13 (edge/level, polarity, write-1-to-clear).
+ * - Edges of the timer capture inputs, passed to the timer models (sim_timer.cpp).
+ * - SysTick with lazy counter evaluation: the counter is never stepped, only computed from the
+ *   deadline of its next wrap, which is a scheduler event.
+ */
+
+#include <stdio.h>
+
+#include "LPC17xx.h"
+#include "sim.h"
+
+namespace sim {
+
+namespace {
+
+/** Number of GPIO ports. */
+constexpr uint32_t NUM_PORTS = 5;
+/** Size of one GPIO port register block. */
+constexpr uint32_t GPIO_STRIDE = 0x20;
+/** First pin of the EINT0-EINT3 group on port 2. */
+constexpr uint32_t EINT_PIN0 = 10;
+
+/**
+ * @brief Simulated state of one GPIO port.
+ */
+struct Port {
+    uint32_t out;       /**< Output latch. */
+    uint32_t ext;       /**< Level applied by the testbench. */
+    uint32_t driven;    /**< Pins driven by the testbench. */
+    uint32_t pull;      /**< Level produced by the PINMODE resistors. */
+    uint32_t gpioFunc;  /**< Pins whose PINSEL function is GPIO. */
+    uint32_t level;     /**< Current pin level. */
+};
+
+Port ports[NUM_PORTS];
+
+/** GPIO interrupt status of ports 0 and 2 (index 0 and 1). */
+uint32_t statR[2], statF[2];
+
+/**
+ * @brief SysTick state. The counter is derived from zeroAt instead of being decremented.
+ */
+struct {
+    bool enabled;         /**< CTRL.ENABLE. */
+    uint32_t ctrl;        /**< CTRL.TICKINT and CTRL.CLKSOURCE. */
+    bool countFlag;       /**< CTRL.COUNTFLAG. */
+    uint32_t frozen;      /**< Counter value while disabled. */
+    uint64_t zeroAt;      /**< Time at which the counter next reaches zero. */
+} systick;
+
+void sysTickWrap(void);
+
+/** Deadline of the next SysTick wrap. */
+Event sysTickEvent{sysTickWrap};
+
+bool gpioLog = false;
+
+inline uint32_t gpioDir(uint32_t port) { return word(LPC_GPIO_BASE + port * GPIO_STRIDE + 0x00); }
+inline uint32_t gpioMask(uint32_t port) { return word(LPC_GPIO_BASE + port * GPIO_STRIDE + 0x10); }
+
+/** Returns the 2-bit field of pin `pin` of port `port` in the PINSEL (base 0) or PINMODE (0x40) bank. */
+inline uint32_t pinField(uint32_t bank, uint32_t port, uint32_t pin) {
+    const uint32_t reg = word(LPC_PINCON_BASE + bank + 4 * (2 * port + pin / 16));
+    return (reg >> (2 * (pin % 16))) & 0x3;
+}
+
+/** Recomputes the PINSEL/PINMODE derived masks of a port. */
+void updatePinConfig(uint32_t port) {
+    Port& p    = ports[port];
+    p.pull     = 0;
+    p.gpioFunc = 0;
+    for (uint32_t pin = 0; pin < 32; pin++) {
+        const uint32_t mode = pinField(0x40, port, pin);
+        // 00 pull-up, 01 repeater (keeps last level), 10 no pull (reads low), 11 pull-down.
+        if (mode == 0 || (mode == 1 && (p.level & (1u << pin))))
+            p.pull |= 1u << pin;
+        if (pinField(0x00, port, pin) == 0)
+            p.gpioFunc |= 1u << pin;
+    }
+}
+
+/** Asserts or releases the EINT0-EINT3 lines from EXTINT and the GPIO interrupt status. */
+void updateLines(void) {
+    const uint32_t extint = word(LPC_SC_BASE + 0x140) & 0xF;
+    setLine(EINT0_IRQn, extint & 0x1);
+    setLine(EINT1_IRQn, extint & 0x2);
+    setLine(EINT2_IRQn, extint & 0x4);
+    setLine(EINT3_IRQn, (extint & 0x8) || statR[0] || statF[0] || statR[1] || statF[1]);
+}
+
+/** Returns true when EINTn is at its active level. */
+inline bool eintActive(uint32_t n) {
+    const bool high  = ports[2].level & (1u << (EINT_PIN0 + n));
+    const bool polar = word(LPC_SC_BASE + 0x14C) & (1u << n);
+    return high == polar;
+}
+
+/** Returns true when EINTn is routed to its pin (PINSEL4 function 01). */
+inline bool eintSelected(uint32_t n) { return pinField(0x00, 2, EINT_PIN0 + n) == 1; }
+
+/** Sets the EXTINT flag of every level-sensitive EINT whose pin is at the active level. */
+void evalLevelEints(void) {
+    const uint32_t mode = word(LPC_SC_BASE + 0x148);
+    for (uint32_t n = 0; n < 4; n++)
+        if (!(mode & (1u << n)) && eintSelected(n) && eintActive(n))
+            word(LPC_SC_BASE + 0x140) |= 1u << n;
+}
+
+/** Reacts to a level change of a port: GPIO interrupts, EINT edges and logging. */
+void levelChanged(uint32_t port, uint32_t old) {
+    const uint32_t level   = ports[port].level;
+    const uint32_t changed = old ^ level;
+
+    if (port == 0 || port == 2) {
+        const uint32_t idx  = port >> 1;
+        const uint32_t base = LPC_GPIOINT_BASE + idx * 0x20;
+        statR[idx] |= changed & level & word(base + 0x10);
+        statF[idx] |= changed & old & word(base + 0x14);
+    }
+    if (port == 2 && (changed & (0xFu << EINT_PIN0))) {
+        for (uint32_t n = 0; n < 4; n++) {
+            if (!(changed & (1u << (EINT_PIN0 + n))) || !eintSelected(n))
+                continue;
+            // Level mode: the pin became active. Edge mode: a transition to the active level.
+            if (eintActive(n))
+                word(LPC_SC_BASE + 0x140) |= 1u << n;
+        }
+    }
+    timerPinChanged(port, changed, level);
+    updateLines();
+
+    if (gpioLog)
+        printf("%16.6f ms  P%u = 0x%08X\n", now / (CORE_CLOCK / 1000.0), port, level);
+}
+
+/** Recomputes the pin levels of a port after any change of its inputs or outputs. */
+void updateLevel(uint32_t port) {
+    Port& p             = ports[port];
+    const uint32_t old  = p.level;
+    const uint32_t outs = gpioDir(port) & p.gpioFunc;
+    const uint32_t in   = (p.driven & p.ext) | (~p.driven & p.pull);
+    p.level             = (outs & p.out) | (~outs & in);
+    if (p.level != old)
+        levelChanged(port, old);
+}
+
+/** Handles the FIOxxx registers. */
+uint32_t gpioAccess(uint32_t addr, uint32_t value, uint32_t width, bool write) {
+    const uint32_t port  = (addr - LPC_GPIO_BASE) / GPIO_STRIDE;
+    const uint32_t reg   = (addr - LPC_GPIO_BASE) % GPIO_STRIDE & ~0x3u;
+    const uint32_t shift = 8 * (addr & 0x3);
+    const uint32_t lanes = (width == 4 ? 0xFFFFFFFFu : ((1u << (8 * width)) - 1)) << shift;
+    const uint32_t v     = (value << shift) & lanes;
+    if (port >= NUM_PORTS)
+        return 0;
+
+    Port& p             = ports[port];
+    const uint32_t open = lanes & ~gpioMask(port);    // Bits not protected by FIOMASK.
+    uint32_t result     = 0;
+
+    switch (reg) {
+        case 0x14:    // FIOPIN.
+            if (write)
+                p.out = (p.out & ~open) | (v & open);
+            else
+                result = p.level & open;
+            break;
+        case 0x18:    // FIOSET.
+            if (write)
+                p.out |= v & open;
+            else
+                result = p.out & open;
+            break;
+        case 0x1C:    // FIOCLR.
+            if (write)
+                p.out &= ~(v & open);
+            break;
+        default: {    // FIODIR, FIOMASK: plain storage.
+            volatile uint32_t& w = word(LPC_GPIO_BASE + port * GPIO_STRIDE + reg);
+            if (write)
+                w = (w & ~lanes) | v;
+            else
+                result = w & lanes;
+            break;
+        }
+    }
+    if (write)
+        updateLevel(port);
+    return result >> shift;
+}
+
+/** Handles the GPIO interrupt block. */
+uint32_t gpioIntAccess(uint32_t addr, uint32_t value, bool write) {
+    const uint32_t off = addr - LPC_GPIOINT_BASE;
+    const uint32_t idx = off >= 0x20 ? 1 : 0;
+
+    switch (off) {
+        case 0x00:    // IntStatus.
+            return write ? 0 : ((statR[0] | statF[0]) ? 0x1 : 0) | ((statR[1] | statF[1]) ? 0x4 : 0);
+        case 0x04:
+        case 0x24:    // IOxIntStatR.
+            return write ? 0 : statR[idx];
+        case 0x08:
+        case 0x28:    // IOxIntStatF.
+            return write ? 0 : statF[idx];
+        case 0x0C:
+        case 0x2C:    // IOxIntClr.
+            if (write) {
+                statR[idx] &= ~value;
+                statF[idx] &= ~value;
+                updateLines();
+            }
+            return 0;
+        default:
+            if (write)
+                word(addr) = value;
+            return write ? 0 : word(addr);
+    }
+}
+
+/** Handles the system control block (external interrupts). */
+uint32_t scAccess(uint32_t addr, uint32_t value, bool write) {
+    const uint32_t off = addr - LPC_SC_BASE;
+    if (!write)
+        return word(addr);
+
+    switch (off) {
+        case 0x140:    // EXTINT: write 1 to clear.
+            word(addr) &= ~(value & 0xF);
+            evalLevelEints();
+            updateLines();
+            break;
+        case 0x148:    // EXTMODE.
+        case 0x14C:    // EXTPOLAR.
+            word(addr) = value & 0xF;
+            evalLevelEints();
+            updateLines();
+            break;
+        default: word(addr) = value; break;
+    }
+    return 0;
+}
+
+/** Returns the SysTick reload value. */
+inline uint32_t stLoad(void) { return word(SysTick_BASE + 0x4) & SysTick_LOAD_RELOAD_Msk; }
+
+/** Returns the current SysTick counter value. */
+uint32_t stValue(void) {
+    if (!systick.enabled)
+        return systick.frozen;
+    const uint64_t remaining = systick.zeroAt - now;
+    return remaining > stLoad() ? 0 : static_cast<uint32_t>(remaining);
+}
+
+/** Schedules the next wrap of a running counter, or stops if LOAD is 0. */
+void sysTickArm(uint64_t zeroAt) {
+    systick.zeroAt = zeroAt;
+    if (systick.enabled && stLoad() != 0)
+        schedule(sysTickEvent, zeroAt);
+    else
+        cancel(sysTickEvent);
+}
+
+/** Counter reached zero: set COUNTFLAG, request the interrupt and reload. */
+void sysTickWrap(void) {
+    systick.countFlag = true;
+    if (systick.ctrl & SysTick_CTRL_TICKINT_Msk)
+        setPending(EXC_SYSTICK);
+    sysTickArm(systick.zeroAt + stLoad() + 1);    // Deadline based: no drift.
+}
+
+/** Handles the SysTick registers. */
+uint32_t sysTickAccess(uint32_t addr, uint32_t value, bool write) {
+    switch (addr - SysTick_BASE) {
+        case 0x0:    // CTRL.
+            if (!write) {
+                const uint32_t ctrl = systick.ctrl | (systick.enabled ? SysTick_CTRL_ENABLE_Msk : 0) |
+                                      (systick.countFlag ? SysTick_CTRL_COUNTFLAG_Msk : 0);
+                systick.countFlag = false;    // COUNTFLAG clears on read.
+                return ctrl;
+            }
+            systick.ctrl = value & (SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk);
+            if ((value & SysTick_CTRL_ENABLE_Msk) && !systick.enabled) {
+                systick.enabled = true;
+                // From zero the counter reloads on the next clock, then counts LOAD cycles.
+                sysTickArm(now + (systick.frozen ? systick.frozen : stLoad() + 1));
+            } else if (!(value & SysTick_CTRL_ENABLE_Msk) && systick.enabled) {
+                systick.frozen  = stValue();
+                systick.enabled = false;
+                cancel(sysTickEvent);
+            }
+            return 0;
+        case 0x8:    // VAL: any write clears the counter and COUNTFLAG.
+            if (!write)
+                return stValue();
+            systick.countFlag = false;
+            systick.frozen    = 0;
+            if (systick.enabled)
+                sysTickArm(now + stLoad() + 1);
+            return 0;
+        case 0x4:    // LOAD: used at the next reload; restarts a counter stopped by LOAD = 0.
+            if (!write)
+                return word(addr);
+            word(addr) = value;
+            if (systick.enabled && sysTickEvent.time == UINT64_MAX)
+                sysTickArm(now + stLoad() + 1);
+            return 0;
+        default:    // CALIB.
+            return write ? 0 : word(addr);
+    }
+}
+
+}    // namespace
+
+void periphReset(void) {
+    for (uint32_t port = 0; port < NUM_PORTS; port++) {
+        ports[port] = Port{};
+        updatePinConfig(port);
+        ports[port].level = ports[port].pull;
+    }
+    statR[0] = statR[1] = statF[0] = statF[1] = 0;
+    systick = {};
+    cancel(sysTickEvent);
+    timerReset();
+    dmaReset();
+    word(LPC_SC_BASE + 0x0C4)  = 0x042887DE;    // PCONP reset value.
+    word(SysTick_BASE + 0xC)   = 0x000F423F;    // CALIB: 10 ms at 100 MHz.
+}
+
+uint32_t periphAccess(uint32_t addr, uint32_t value, uint32_t width, bool write) {
+    uint32_t result;
+    if (addr >= LPC_GPIO_BASE && addr < LPC_GPIO_BASE + NUM_PORTS * GPIO_STRIDE)
+        return gpioAccess(addr, value, width, write);
+    if (addr >= SysTick_BASE && addr < SysTick_BASE + 0x10)
+        return sysTickAccess(addr, value, write);
+    if (timerAccess(addr, value, write, &result))
+        return result;
+    if (dmaAccess(addr, value, write, &result))
+        return result;
+    if (addr >= LPC_GPIOINT_BASE && addr < LPC_GPIOINT_BASE + 0x40)
+        return gpioIntAccess(addr, value, write);
+    if (addr >= LPC_SC_BASE && addr < LPC_SC_BASE + 0x1000)
+        return scAccess(addr, value, write);
+    if (addr >= LPC_PINCON_BASE && addr < LPC_PINCON_BASE + 0x1000) {
+        if (!write)
+            return word(addr);
+        word(addr) = value;
+        for (uint32_t port = 0; port < NUM_PORTS; port++) {
+            updatePinConfig(port);
+            updateLevel(port);
+        }
+        evalLevelEints();
+        updateLines();
+        return 0;
+    }
+    return 0;
+}
+
+void drivePin(uint32_t port, uint32_t pin, int level) {
+    if (port >= NUM_PORTS || pin > 31)
+        return;
+    Port& p = ports[port];
+    if (level < 0) {
+        p.driven &= ~(1u << pin);
+    } else {
+        p.driven |= 1u << pin;
+        p.ext = level ? (p.ext | (1u << pin)) : (p.ext & ~(1u << pin));
+    }
+    updateLevel(port);
+}
+
+uint32_t pinFunction(uint32_t port, uint32_t pin) { return pinField(0x00, port, pin); }
+
+uint32_t portLevel(uint32_t port) { return port < NUM_PORTS ? ports[port].level : 0; }
+
+void setGpioLog(bool enable) { gpioLog = enable; }
+
+}    // namespace sim
@@ -0,0 +1,365 @@
+/**
+ * @file sim_profile.cpp
+ * @brief Per-function profile of the firmware, written as a tab-separated table (-p).
+ *
+ * Firmware built with -finstrument-functions calls __cyg_profile_func_enter/exit around every
+ * function. Each call is charged the simulated cycles and register accesses between its entry
+ * and exit, callees included, but not the time spent in __WFI() or in interrupts that preempt
+ * it: those are charged to the handlers. Without instrumentation only the ISR, CPU, bus and
+ * run rows are filled.
+ *
+ * The ISR rows give, for every exception, the worst latency from pending (and enabled) to the
+ * first write to a GPIO output register (FIOPIN, FIOSET, FIOCLR or their byte and halfword
+ * views) made by the handler: the response time seen on the pins.
+ *
+ * The CPU rows split the time the core was awake between the thread and each handler, nested
+ * handlers excluded; with the sleep row they add up to the run total.
+ *
+ * The same hooks keep the call path of the running code for the bus trace (sim_trace.cpp).
+ */
+
+#include <dlfcn.h>
+#include <link.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "LPC17xx.h"
+#include "sim.h"
+
+namespace sim {
+
+bool profiling = false;
+
+namespace {
+
+/** Buses, in the order of the report. */
+enum Bus { BUS_AHB, BUS_APB, BUS_PPB, NUM_BUSES };
+
+const char* const busNames[NUM_BUSES] = {"AHB", "APB", "PPB"};
+const uint32_t busCosts[NUM_BUSES]    = {COST_AHB, COST_APB, COST_PPB};
+
+/**
+ * @brief Totals of one function.
+ */
+struct Totals {
+    uint64_t calls;     /**< Number of calls. */
+    uint64_t cycles;    /**< Cycles, callees included, sleep and preemption excluded. */
+    uint64_t reads;     /**< Register reads. */
+    uint64_t writes;    /**< Register writes. */
+};
+
+/**
+ * @brief Running function call.
+ */
+struct Frame {
+    void* fn;           /**< Function address. */
+    uint64_t start;     /**< Time of entry. */
+    uint64_t hidden;    /**< Hidden cycles at entry. */
+    uint64_t reads;     /**< Visible reads at entry. */
+    uint64_t writes;    /**< Visible writes at entry. */
+    size_t level;       /**< Handlers running when it was called: 0 in thread mode. */
+    uint32_t depth;     /**< Callers in the same context: 0 for main() and handlers. */
+    CallContext ctx;    /**< Call path and top-level call. */
+};
+
+/**
+ * @brief Running exception handler.
+ */
+struct Isr {
+    int exc;              /**< Exception number. */
+    uint64_t ready;       /**< Time it became pending and enabled. */
+    uint64_t start;       /**< Time of entry, before the entry cycles. */
+    uint64_t isrCycles;   /**< isrCycles at entry. */
+    uint64_t sleep;       /**< stats.sleepCycles at entry. */
+    uint64_t reads;       /**< stats.reads at entry. */
+    uint64_t writes;      /**< stats.writes at entry. */
+    uint64_t isrReads;    /**< isrReads at entry. */
+    uint64_t isrWrites;   /**< isrWrites at entry. */
+    bool output;          /**< The handler already wrote a GPIO output. */
+    CallContext ctx;      /**< Root call path of the exception and its top-level call. */
+};
+
+/**
+ * @brief Node of the call path tree.
+ */
+struct PathNode {
+    uint32_t parent;    /**< Calling path, NO_PATH for a root. */
+    void* fn;           /**< Function, nullptr for a root. */
+    int exc;            /**< Exception of a root, 0 for the thread. */
+};
+
+/** Parent of the root paths. */
+constexpr uint32_t NO_PATH = UINT32_MAX;
+
+/**
+ * @brief Totals of one exception.
+ */
+struct IsrTotals {
+    uint64_t entries;         /**< Number of entries. */
+    uint64_t outputs;         /**< Entries that wrote a GPIO output. */
+    uint64_t worstLatency;    /**< Worst cycles from pending to the first output write. */
+    uint64_t reads;           /**< Register reads, nested handlers included. */
+    uint64_t writes;          /**< Register writes, nested handlers included. */
+};
+
+const char* outPath = nullptr;
+/** Initialised ahead of startup(), which may enable profiling. */
+std::unordered_map<void*, Totals> functions __attribute__((init_priority(101)));
+std::vector<Frame> frames __attribute__((init_priority(101)));
+std::vector<Isr> isrs __attribute__((init_priority(101)));
+IsrTotals isrTotals[NUM_EXCEPTIONS];
+uint64_t busReads[NUM_BUSES];
+uint64_t busWrites[NUM_BUSES];
+uint64_t isrCycles = 0;    /**< Cycles spent in handlers that preempted other code. */
+uint64_t isrReads  = 0;    /**< Reads made by handlers. */
+uint64_t isrWrites = 0;    /**< Writes made by handlers. */
+/** Call path tree, path 0 is the thread root. */
+std::vector<PathNode> paths __attribute__((init_priority(101))) = {{NO_PATH, nullptr, 0}};
+std::map<std::pair<uint32_t, void*>, uint32_t> children __attribute__((init_priority(101)));
+uint32_t excPaths[NUM_EXCEPTIONS];
+uint32_t lastCall = 0;    /**< Serial number of the last top-level call, 0 is the thread. */
+std::unordered_map<void*, std::string> names __attribute__((init_priority(101)));
+
+/** Cycles not charged to the running code: sleep and preempting handlers. */
+inline uint64_t hidden(void) { return isrCycles + stats.sleepCycles; }
+
+inline Bus busOf(uint32_t addr) {
+    if (addr >= LPC_CM3_BASE)
+        return BUS_PPB;
+    if (addr >= LPC_APB0_BASE && addr < LPC_AHB_BASE)
+        return BUS_APB;
+    return BUS_AHB;
+}
+
+/** FIOPIN, FIOSET and FIOCLR (and their narrow views) sit at offsets 0x14-0x1F of a port. */
+inline bool isOutput(uint32_t addr) {
+    return addr >= LPC_GPIO0_BASE && addr < LPC_GPIO0_BASE + 5 * 0x20 && (addr & 0x1F) >= 0x14;
+}
+
+/** Returns the path of `fn` called from `parent`, adding it on first use. */
+uint32_t childPath(uint32_t parent, void* fn, int exc) {
+    const auto key = std::make_pair(parent, fn);
+    const auto it  = children.find(key);
+    if (it != children.end())
+        return it->second;
+    paths.push_back({parent, fn, exc});
+    return children[key] = static_cast<uint32_t>(paths.size() - 1);
+}
+
+/** Charges a frame to its function up to now. */
+void charge(const Frame& f) {
+    Totals& t = functions[f.fn];
+    t.cycles += (now - f.start) - (hidden() - f.hidden);
+    t.reads += (stats.reads - isrReads) - f.reads;
+    t.writes += (stats.writes - isrWrites) - f.writes;
+}
+
+/** Resolves function addresses to names with addr2line, falling back to the address. */
+std::unordered_map<void*, std::string> resolveNames(void) {
+    std::unordered_map<void*, std::string> names;
+    std::vector<void*> addrs;
+    char buf[512];
+
+    // Resolved here: in the shell started by popen(), /proc/self is the shell.
+    const ssize_t len = readlink("/proc/self/exe", buf, sizeof(buf) - 1);
+    buf[len > 0 ? len : 0] = '\0';
+    std::string command    = std::string("addr2line -f -C -e '") + buf + "'";
+
+    for (const auto& entry : functions) {
+        // addr2line takes offsets in a position independent object, absolute addresses otherwise
+        // (the firmware is linked without PIE, see the Makefile).
+        Dl_info info;
+        const bool pie = dladdr(entry.first, &info) &&
+                         static_cast<const ElfW(Ehdr)*>(info.dli_fbase)->e_type == ET_DYN;
+        const uintptr_t base = pie ? reinterpret_cast<uintptr_t>(info.dli_fbase) : 0;
+        snprintf(buf, sizeof(buf), " 0x%lx", static_cast<unsigned long>(reinterpret_cast<uintptr_t>(entry.first) - base));
+        command += buf;
+        addrs.push_back(entry.first);
+        names[entry.first] = buf + 1;
+    }
+    if (addrs.empty())
+        return names;
+
+    fflush(nullptr);
+    FILE* pipe = popen((command + " 2>/dev/null").c_str(), "r");
+    if (!pipe)
+        return names;
+    for (void* addr : addrs) {
+        if (!fgets(buf, sizeof(buf), pipe))    // Function name.
+            break;
+        buf[strcspn(buf, "(\n")] = '\0';       // Drop the C++ parameter list.
+        if (buf[0] != '?')
+            names[addr] = buf;
+        if (!fgets(buf, sizeof(buf), pipe))    // File and line.
+            break;
+    }
+    pclose(pipe);
+    return names;
+}
+
+/** Writes the profile when the run ends. */
+void writeProfile(void) {
+    // Calls still running (main(), an interrupted handler) are charged up to the end.
+    for (const Frame& f : frames)
+        charge(f);
+    frames.clear();
+
+    FILE* out = fopen(outPath, "w");
+    if (!out) {
+        perror(outPath);
+        return;
+    }
+
+    if (names.empty())
+        names = resolveNames();
+    std::vector<std::pair<std::string, Totals>> rows;
+    for (const auto& entry : functions)
+        rows.emplace_back(names[entry.first], entry.second);
+    std::sort(rows.begin(), rows.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    fprintf(out, "kind\tname\tcalls\tcycles\treads\twrites\n");
+    for (const auto& row : rows)
+        fprintf(out, "func\t%s\t%llu\t%llu\t%llu\t%llu\n", row.first.c_str(), (unsigned long long)row.second.calls,
+                (unsigned long long)row.second.cycles, (unsigned long long)row.second.reads,
+                (unsigned long long)row.second.writes);
+    for (int exc = 0; exc < NUM_EXCEPTIONS; exc++) {
+        const IsrTotals& t = isrTotals[exc];
+        if (!t.entries)
+            continue;
+        fprintf(out, "isr\t%s\t%llu\t", excName(exc), (unsigned long long)t.entries);
+        if (t.outputs)
+            fprintf(out, "%llu", (unsigned long long)t.worstLatency);
+        else
+            fprintf(out, "-");
+        fprintf(out, "\t%llu\t%llu\n", (unsigned long long)t.reads, (unsigned long long)t.writes);
+    }
+    // Active cycles: the thread, then every handler on its own (sleep and preemption excluded).
+    uint64_t handlers = 0;
+    for (int exc = 0; exc < NUM_EXCEPTIONS; exc++)
+        handlers += stats.handlerCycles[exc];
+    fprintf(out, "cpu\tthread\t-\t%llu\t-\t-\n", (unsigned long long)(now - stats.sleepCycles - handlers));
+    for (int exc = 0; exc < NUM_EXCEPTIONS; exc++)
+        if (stats.exc[exc])
+            fprintf(out, "cpu\t%s\t%llu\t%llu\t-\t-\n", excName(exc), (unsigned long long)stats.exc[exc],
+                    (unsigned long long)stats.handlerCycles[exc]);
+    for (int bus = 0; bus < NUM_BUSES; bus++)
+        fprintf(out, "bus\t%s\t-\t%llu\t%llu\t%llu\n", busNames[bus],
+                (unsigned long long)(busReads[bus] + busWrites[bus]) * busCosts[bus],
+                (unsigned long long)busReads[bus], (unsigned long long)busWrites[bus]);
+    fprintf(out, "run\ttotal\t-\t%llu\t%llu\t%llu\n", (unsigned long long)now, (unsigned long long)stats.reads,
+            (unsigned long long)stats.writes);
+    fprintf(out, "run\tsleep\t%llu\t%llu\t-\t-\n", (unsigned long long)stats.wfiCalls,
+            (unsigned long long)stats.sleepCycles);
+    fclose(out);
+}
+
+}    // namespace
+
+void profileOpen(const char* path) {
+    outPath   = path;
+    profiling = true;
+    frames.reserve(64);
+    atexit(writeProfile);
+}
+
+void profileAccess(uint32_t addr, bool write) {
+    const Bus bus = busOf(addr);
+    if (!write) {
+        busReads[bus]++;
+        return;
+    }
+    busWrites[bus]++;
+    if (!isrs.empty() && !isrs.back().output && isOutput(addr)) {
+        Isr& isr         = isrs.back();
+        IsrTotals& t     = isrTotals[isr.exc];
+        isr.output       = true;
+        t.outputs++;
+        t.worstLatency = std::max(t.worstLatency, now - isr.ready);
+    }
+}
+
+void profileIsrEnter(int exc, uint64_t ready) {
+    if (!excPaths[exc]) {
+        paths.push_back({NO_PATH, nullptr, exc});
+        excPaths[exc] = static_cast<uint32_t>(paths.size() - 1);
+    }
+    isrs.push_back({exc, ready, now, isrCycles, stats.sleepCycles, stats.reads, stats.writes, isrReads, isrWrites,
+                    false, {excPaths[exc], ++lastCall, exc}});
+    isrTotals[exc].entries++;
+}
+
+void profileIsrExit(void) {
+    const Isr isr = isrs.back();
+    isrs.pop_back();
+
+    const uint64_t reads  = stats.reads - isr.reads;
+    const uint64_t writes = stats.writes - isr.writes;
+    // Set rather than added: nested handlers are already part of this one.
+    isrCycles = isr.isrCycles + (now - isr.start) - (stats.sleepCycles - isr.sleep);
+    isrReads  = isr.isrReads + reads;
+    isrWrites = isr.isrWrites + writes;
+    isrTotals[isr.exc].reads += reads;
+    isrTotals[isr.exc].writes += writes;
+}
+
+CallContext profileContext(void) {
+    if (!frames.empty() && frames.back().level == isrs.size())
+        return frames.back().ctx;
+    return isrs.empty() ? CallContext{0, 0, 0} : isrs.back().ctx;
+}
+
+uint32_t profilePathCount(void) { return static_cast<uint32_t>(paths.size()); }
+
+std::string profilePathName(uint32_t path) {
+    if (names.empty())
+        names = resolveNames();
+    std::string name;
+    for (; path != NO_PATH; path = paths[path].parent) {
+        const PathNode& node = paths[path];
+        if (node.fn)
+            name = names[node.fn] + (name.empty() ? "" : ">") + name;
+        else if (node.exc)
+            name = std::string(excName(node.exc)) + (name.empty() ? "" : ">") + name;
+    }
+    return name.empty() ? "thread" : name;
+}
+
+}    // namespace sim
+
+extern "C" {
+
+void __cyg_profile_func_enter(void* fn, void* callSite) {
+    (void)callSite;
+    if (!sim::profiling)
+        return;
+    sim::functions[fn].calls++;
+
+    // Calls nest in the running function if it belongs to the same handler (or to the thread).
+    const size_t level          = sim::isrs.size();
+    const bool nested           = !sim::frames.empty() && sim::frames.back().level == level;
+    const uint32_t depth        = nested ? sim::frames.back().depth + 1 : 0;
+    const sim::CallContext base = nested ? sim::frames.back().ctx : sim::profileContext();
+    // In thread mode the top-level calls are main() and the functions it calls.
+    const bool top              = level == 0 && depth <= 1;
+    sim::frames.push_back({fn, sim::now, sim::hidden(), sim::stats.reads - sim::isrReads,
+                           sim::stats.writes - sim::isrWrites, level, depth,
+                           {sim::childPath(base.path, fn, 0), top ? ++sim::lastCall : base.call, base.exc}});
+}
+
+void __cyg_profile_func_exit(void* fn, void* callSite) {
+    (void)callSite;
+    if (!sim::profiling || sim::frames.empty() || sim::frames.back().fn != fn)
+        return;
+    sim::charge(sim::frames.back());
+    sim::frames.pop_back();
+}
+}
@@ -0,0 +1,380 @@
+/**
+ * @file sim_timer.cpp
+ * @brief Behavioural model of the LPC1769 timer/counters TIMER0-TIMER3.
+ *
+ * In timer mode TC and PC are computed from the time the counter was last (re)started, never
+ * stepped, and each timer schedules a single event at its next match. In counter mode (CTCR) TC
+ * is stepped by the edges of the selected CAP input, without prescaler. Matches implement the
+ * MCR interrupt, reset and stop actions, the EMR external match bits and the DMA requests of
+ * MR0 and MR1. The CAPn.0/CAPn.1 pins, when selected in PINSEL, load CR0/CR1 with TC on the
+ * edges enabled in CCR and may raise the capture interrupts.
+ */
+
+#include "LPC17xx.h"
+#include "sim.h"
+
+namespace sim {
+
+namespace {
+
+/** Number of timers. */
+constexpr int NUM_TIMERS = 4;
+
+/** CCR bits of one capture channel: capture on rising edge, on falling edge, interrupt. */
+constexpr uint32_t CCR_RISE = 0x1;
+constexpr uint32_t CCR_FALL = 0x2;
+constexpr uint32_t CCR_INT  = 0x4;
+/** IR flag of capture channel 0 (channel 1 is the next bit). */
+constexpr uint32_t IR_CR0 = 0x10;
+/** PINSEL function of the capture inputs. */
+constexpr uint32_t FUNC_CAP = 3;
+
+/** Register offsets. */
+enum : uint32_t {
+    IR   = 0x00,
+    TCR  = 0x04,
+    TC   = 0x08,
+    PR   = 0x0C,
+    PC   = 0x10,
+    MCR  = 0x14,
+    MR0  = 0x18,
+    CCR  = 0x28,
+    CR0  = 0x2C,
+    EMR  = 0x3C,
+    CTCR = 0x70,
+};
+
+/**
+ * @brief Simulated state of one timer.
+ */
+struct Timer {
+    uint32_t base;        /**< Register block address. */
+    int irqn;             /**< NVIC interrupt number. */
+    uint32_t pclkReg;     /**< PCLKSEL register offset in the SC block. */
+    uint32_t pclkShift;   /**< Position of the PCLKSEL field. */
+    bool running;         /**< TCR enabled and not held in reset. */
+    uint32_t tcr;         /**< TCR value. */
+    uint32_t ir;          /**< Interrupt flags. */
+    uint32_t tc0;         /**< TC at epoch. */
+    uint32_t pc0;         /**< PC at epoch. */
+    uint64_t epoch;       /**< Time from which the counter is computed (on a PCLK edge). */
+    uint64_t resetAt;     /**< Time of a pending reset-on-match, UINT64_MAX if none. */
+    uint64_t due;         /**< Time of the scheduled event. */
+    Event event;          /**< Next match or reset. */
+    bool countReset;      /**< Counter mode: the next counted edge resets TC. */
+};
+
+/**
+ * @brief Pin of a capture input.
+ */
+struct CapPin {
+    uint32_t port;    /**< Port number. */
+    uint32_t pin;     /**< Pin number. */
+};
+
+/** CAPn.0 and CAPn.1 of each timer. */
+const CapPin capPins[NUM_TIMERS][2] = {
+    {{1, 26}, {1, 27}},
+    {{1, 18}, {1, 19}},
+    {{0, 4}, {0, 5}},
+    {{0, 23}, {0, 24}},
+};
+
+void timer0Event(void);
+void timer1Event(void);
+void timer2Event(void);
+void timer3Event(void);
+
+Timer timers[NUM_TIMERS] = {
+    {LPC_TIM0_BASE, TIMER0_IRQn, 0x1A8, 2, false, 0, 0, 0, 0, 0, UINT64_MAX, 0, {timer0Event}, false},
+    {LPC_TIM1_BASE, TIMER1_IRQn, 0x1A8, 4, false, 0, 0, 0, 0, 0, UINT64_MAX, 0, {timer1Event}, false},
+    {LPC_TIM2_BASE, TIMER2_IRQn, 0x1AC, 12, false, 0, 0, 0, 0, 0, UINT64_MAX, 0, {timer2Event}, false},
+    {LPC_TIM3_BASE, TIMER3_IRQn, 0x1AC, 14, false, 0, 0, 0, 0, 0, UINT64_MAX, 0, {timer3Event}, false},
+};
+
+inline uint32_t reg(const Timer& t, uint32_t off) { return word(t.base + off); }
+
+/** Counter mode: TC counts edges of a CAP input instead of prescaled PCLK cycles. */
+inline bool counting(const Timer& t) { return (reg(t, CTCR) & 0x3) != 0; }
+
+/** Core cycles per PCLK period, from PCLKSEL (00 = CCLK/4, 01 = CCLK, 10 = CCLK/2, 11 = CCLK/8). */
+uint32_t pclkDiv(const Timer& t) {
+    static const uint32_t divs[4] = {4, 1, 2, 8};
+    return divs[(word(LPC_SC_BASE + t.pclkReg) >> t.pclkShift) & 0x3];
+}
+
+/** Computes TC and PC at a given time. */
+void counterAt(const Timer& t, uint64_t at, uint32_t* tc, uint32_t* pc) {
+    if (!t.running || at < t.epoch || counting(t)) {
+        *tc = t.tc0;
+        *pc = t.pc0;
+        return;
+    }
+    const uint64_t prescale = static_cast<uint64_t>(reg(t, PR)) + 1;
+    const uint64_t total    = t.pc0 + (at - t.epoch) / pclkDiv(t);
+    *tc                     = t.tc0 + static_cast<uint32_t>(total / prescale);
+    *pc                     = static_cast<uint32_t>(total % prescale);
+}
+
+/** Moves the epoch to the last PCLK edge before `at`, keeping the counter value. */
+void rebase(Timer& t, uint64_t at) {
+    if (!t.running) {
+        t.epoch = at;
+        return;
+    }
+    counterAt(t, at, &t.tc0, &t.pc0);
+    t.epoch = at - (at - t.epoch) % pclkDiv(t);
+}
+
+/** Returns the time at which TC next becomes `value`. */
+uint64_t timeToReach(const Timer& t, uint32_t value) {
+    uint32_t tc, pc;
+    counterAt(t, now, &tc, &pc);
+    const uint64_t counts   = (value - tc) ? static_cast<uint32_t>(value - tc) : (1ULL << 32);
+    const uint64_t prescale = static_cast<uint64_t>(reg(t, PR)) + 1;
+    const uint32_t div      = pclkDiv(t);
+    const uint64_t edge     = now - (now - t.epoch) % div;
+    return edge + (counts * prescale - pc) * div;
+}
+
+/** Schedules the next match or pending reset of a timer. */
+void reschedule(Timer& t) {
+    uint64_t next = t.resetAt;
+    if (t.running && !counting(t)) {
+        const uint32_t mcr = reg(t, MCR);
+        const uint32_t emr = reg(t, EMR);
+        for (int m = 0; m < 4; m++) {
+            if (((mcr >> (3 * m)) & 0x7) == 0 && ((emr >> (4 + 2 * m)) & 0x3) == 0 &&
+                !(m < 2 && dmaTimerSelected(static_cast<int>(&t - timers), m)))
+                continue;
+            const uint64_t at = timeToReach(t, reg(t, MR0 + 4 * m));
+            if (at < next)
+                next = at;
+        }
+    }
+    t.due = next;
+    if (next == UINT64_MAX)
+        cancel(t.event);
+    else
+        schedule(t.event, next);
+}
+
+void updateLine(const Timer& t) { setLine(t.irqn, t.ir != 0); }
+
+/** Applies the external match action of channel m. */
+void externalMatch(Timer& t, int m) {
+    uint32_t emr = reg(t, EMR);
+    switch ((emr >> (4 + 2 * m)) & 0x3) {
+        case 1: emr &= ~(1u << m); break;
+        case 2: emr |= 1u << m; break;
+        case 3: emr ^= 1u << m; break;
+        default: return;
+    }
+    word(t.base + EMR) = emr;
+}
+
+/**
+ * @brief Applies the MCR and EMR actions of every match register equal to `tc`.
+ *
+ * @param t     Timer.
+ * @param tc    Timer counter value.
+ * @param reset Set if a match resets the counter.
+ * @param stop  Set if a match stops the counter.
+ * @return Matched channels, one bit each.
+ */
+uint32_t match(Timer& t, uint32_t tc, bool* reset, bool* stop) {
+    const uint32_t mcr = reg(t, MCR);
+    uint32_t matched   = 0;
+    *reset = *stop = false;
+    for (int m = 0; m < 4; m++) {
+        if (reg(t, MR0 + 4 * m) != tc)
+            continue;
+        matched |= 1u << m;
+        const uint32_t actions = (mcr >> (3 * m)) & 0x7;
+        if (actions & 0x1)
+            t.ir |= 1u << m;
+        *reset |= (actions & 0x2) != 0;
+        *stop |= (actions & 0x4) != 0;
+        externalMatch(t, m);
+    }
+    return matched;
+}
+
+/** Raises the DMA requests of the matched MR0 and MR1, last: a transfer may write the timer. */
+void requestDma(const Timer& t, uint32_t matched) {
+    for (int m = 0; m < 2; m++)
+        if (matched & (1u << m))
+            dmaTimerMatch(static_cast<int>(&t - timers), m);
+}
+
+/** Handles the event of a timer at its due time. */
+void timerEvent(Timer& t) {
+    const uint64_t at = t.due;
+
+    if (at == t.resetAt) {    // TC was held at MR for one count: now it restarts from 0.
+        t.resetAt = UINT64_MAX;
+        t.tc0     = 0;
+        t.pc0     = 0;
+        t.epoch   = at;
+    }
+
+    uint32_t tc, pc;
+    counterAt(t, at, &tc, &pc);
+    bool reset, stop;
+    const uint32_t matched = match(t, tc, &reset, &stop);
+
+    rebase(t, at);
+    if (stop) {
+        t.running = false;
+        t.tcr &= ~0x1u;
+        if (reset) {
+            t.tc0 = 0;
+            t.pc0 = 0;
+        }
+    } else if (reset) {
+        t.resetAt = at + (static_cast<uint64_t>(reg(t, PR)) + 1) * pclkDiv(t);
+    }
+    updateLine(t);
+    reschedule(t);
+    requestDma(t, matched);
+}
+
+/** Counter mode: steps TC on a counted edge and applies its matches. */
+void countEdge(Timer& t) {
+    if (!t.running)
+        return;
+    t.tc0        = t.countReset ? 0 : t.tc0 + 1;
+    t.countReset = false;
+
+    bool reset, stop;
+    const uint32_t matched = match(t, t.tc0, &reset, &stop);
+    if (stop) {
+        t.running = false;
+        t.tcr &= ~0x1u;
+        if (reset)
+            t.tc0 = 0;
+    } else {
+        t.countReset = reset;
+    }
+    updateLine(t);
+    requestDma(t, matched);
+}
+
+/** Loads a capture register on an edge of its input, if CCR enables that edge. */
+void capture(Timer& t, int c, bool rising) {
+    const uint32_t ccr = reg(t, CCR) >> (3 * c);
+    if (!(ccr & (rising ? CCR_RISE : CCR_FALL)))
+        return;
+    uint32_t tc, pc;
+    counterAt(t, now, &tc, &pc);
+    word(t.base + CR0 + 4 * c) = tc;
+    if (ccr & CCR_INT) {
+        t.ir |= IR_CR0 << c;
+        updateLine(t);
+    }
+}
+
+void timer0Event(void) { timerEvent(timers[0]); }
+void timer1Event(void) { timerEvent(timers[1]); }
+void timer2Event(void) { timerEvent(timers[2]); }
+void timer3Event(void) { timerEvent(timers[3]); }
+
+}    // namespace
+
+void timerReset(void) {
+    for (Timer& t : timers) {
+        cancel(t.event);
+        t.running    = false;
+        t.tcr        = 0;
+        t.ir         = 0;
+        t.tc0        = 0;
+        t.pc0        = 0;
+        t.epoch      = 0;
+        t.resetAt    = UINT64_MAX;
+        t.countReset = false;
+        updateLine(t);
+    }
+}
+
+bool timerAccess(uint32_t addr, uint32_t value, bool write, uint32_t* result) {
+    Timer* t = nullptr;
+    for (Timer& candidate : timers)
+        if (addr >= candidate.base && addr < candidate.base + 0x1000)
+            t = &candidate;
+    if (!t)
+        return false;
+
+    const uint32_t off = addr - t->base;
+    uint32_t tc, pc;
+    *result = 0;
+
+    if (!write) {
+        switch (off) {
+            case IR:  *result = t->ir; break;
+            case TCR: *result = t->tcr; break;
+            case TC:  counterAt(*t, now, &tc, &pc); *result = tc; break;
+            case PC:  counterAt(*t, now, &tc, &pc); *result = pc; break;
+            default:  *result = word(addr); break;
+        }
+        return true;
+    }
+
+    switch (off) {
+        case IR:    // Write 1 to clear.
+            t->ir &= ~value;
+            updateLine(*t);
+            return true;
+        case TCR:
+            rebase(*t, now);
+            t->tcr = value & 0x3;
+            if (value & 0x2) {    // Counter reset: TC and PC held at 0.
+                t->tc0        = 0;
+                t->pc0        = 0;
+                t->resetAt    = UINT64_MAX;
+                t->countReset = false;
+            }
+            t->running = t->tcr == 0x1;
+            t->epoch   = now;
+            break;
+        case TC:
+            rebase(*t, now);
+            t->tc0 = value;
+            break;
+        case PC:
+            rebase(*t, now);
+            t->pc0 = value;
+            break;
+        case PR:
+        case CTCR:
+            rebase(*t, now);
+            word(addr) = value;
+            break;
+        case CR0:
+        case CR0 + 4:    // Read only.
+            return true;
+        default:    // MCR, MRn, CCR, EMR.
+            word(addr) = value;
+            break;
+    }
+    reschedule(*t);
+    return true;
+}
+
+void timerPinChanged(uint32_t port, uint32_t changed, uint32_t level) {
+    for (int n = 0; n < NUM_TIMERS; n++) {
+        for (int c = 0; c < 2; c++) {
+            const CapPin& cap = capPins[n][c];
+            if (cap.port != port || !(changed & (1u << cap.pin)) || pinFunction(port, cap.pin) != FUNC_CAP)
+                continue;
+            Timer& t            = timers[n];
+            const bool rising   = level & (1u << cap.pin);
+            const uint32_t ctcr = reg(t, CTCR);
+            capture(t, c, rising);
+            // CTCR: 01 rising, 10 falling, 11 both edges of CAPn.0 (00) or CAPn.1 (01).
+            if (counting(t) && ((ctcr >> 2) & 0x3) == static_cast<uint32_t>(c) && (ctcr & (rising ? 0x1 : 0x2)))
+                countEdge(t);
+        }
+    }
+}
+
+}    // namespace sim
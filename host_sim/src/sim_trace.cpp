@@ -0,0 +1,91 @@
+/**
+ * @file sim_trace.cpp
+ * @brief Binary trace of the accesses to the GPIO and configuration registers (-b).
+ *
+ * Every access to GPIO, PINCON, GPIOINT, the system control block and SysTick is stored in a
+ * ring buffer with its time, value and the call path from the profile hooks. The buffer is
+ * written at the end of the run in the format of sim_trace.h; build/bustrace summarises it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "LPC17xx.h"
+#include "sim.h"
+#include "sim_trace.h"
+
+namespace sim {
+
+bool tracing = false;
+
+namespace {
+
+const char* outPath = nullptr;
+/** Initialised ahead of startup(), which may enable the trace. */
+std::vector<TraceRecord> ring __attribute__((init_priority(101)));
+uint64_t recorded = 0;
+
+/** GPIO, PINCON, GPIOINT, system control and SysTick: the registers the exercises configure. */
+inline bool isTraced(uint32_t addr) {
+    return (addr >= LPC_GPIO0_BASE && addr < LPC_GPIO0_BASE + 5 * 0x20) ||
+           (addr >= LPC_PINCON_BASE && addr < LPC_PINCON_BASE + 0x80) ||
+           (addr >= LPC_GPIOINT_BASE && addr < LPC_GPIOINT_BASE + 0x40) ||
+           (addr >= LPC_SC_BASE && addr < LPC_SC_BASE + 0x200) ||
+           (addr >= SysTick_BASE && addr < SysTick_BASE + 0x10);
+}
+
+/** Writes the trace when the run ends. */
+void writeTrace(void) {
+    FILE* out = fopen(outPath, "wb");
+    if (!out) {
+        perror(outPath);
+        return;
+    }
+
+    const size_t capacity = ring.size();
+    const size_t stored   = recorded < capacity ? static_cast<size_t>(recorded) : capacity;
+    const size_t first    = recorded < capacity ? 0 : static_cast<size_t>(recorded % capacity);
+    // Paths past the 16-bit range are recorded as UINT16_MAX and left unnamed.
+    const uint32_t paths  = std::min<uint32_t>(profilePathCount(), UINT16_MAX);
+    TraceHeader header    = {{}, sizeof(TraceRecord), paths, recorded, stored};
+    std::copy(TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC), header.magic);
+
+    fwrite(&header, sizeof(header), 1, out);
+    // Oldest record first.
+    fwrite(&ring[first], sizeof(TraceRecord), stored - first, out);
+    fwrite(&ring[0], sizeof(TraceRecord), first, out);
+    for (uint32_t path = 0; path < header.paths; path++) {
+        const std::string name = profilePathName(path);
+        fwrite(name.c_str(), 1, name.size() + 1, out);
+    }
+    fclose(out);
+}
+
+}    // namespace
+
+void traceOpen(const char* path, uint32_t capacity) {
+    outPath   = path;
+    tracing   = true;
+    profiling = true;    // For the call paths.
+    ring.resize(capacity ? capacity : 1);
+    atexit(writeTrace);
+}
+
+void traceAccess(uint32_t addr, uint32_t value, uint32_t width, bool write) {
+    if (!isTraced(addr))
+        return;
+    const CallContext ctx = profileContext();
+    ring[recorded++ % ring.size()] = {now,
+                                      addr,
+                                      value,
+                                      ctx.call,
+                                      static_cast<uint16_t>(ctx.path < UINT16_MAX ? ctx.path : UINT16_MAX),
+                                      static_cast<uint8_t>((write ? TRACE_WRITE : 0) | width << TRACE_WIDTH_POS),
+                                      static_cast<uint8_t>(ctx.exc)};
+}
+
+}    // namespace sim
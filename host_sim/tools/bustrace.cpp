@@ -0,0 +1,370 @@
+/**
+ * @file bustrace.cpp
+ * @brief Summary of a bus trace written by the simulator with -b.
+ *
+ *   bustrace [-d] TRACE
+ *
+ * Prints the register reads and writes of every calling function, split by peripheral, and
+ * flags the redundant accesses of every top-level call (a function called by main(), or a
+ * handler entry):
+ *
+ * - Several read-modify-writes of the same register, which one read-modify-write would do.
+ * - Writes of the value the register already holds.
+ * - Reads of a register whose value the call already knows, with no write in between.
+ *
+ * Only configuration registers (FIODIR, FIOMASK, PINSEL, PINMODE, interrupt enables, EXTMODE,
+ * EXTPOLAR, PCONP, PCLKSEL, SysTick LOAD...) are checked: the other ones change on their own or
+ * act on write. With -d every record is printed as well.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "LPC17xx.h"
+#include "sim.h"
+#include "sim_trace.h"
+
+namespace {
+
+using sim::TraceHeader;
+using sim::TraceRecord;
+
+/**
+ * @brief Named register of a traced peripheral.
+ */
+struct RegName {
+    uint32_t offset;     /**< Offset in the peripheral. */
+    const char* name;    /**< Register name. */
+    bool config;         /**< Holds configuration: keeps its value until written. */
+};
+
+const RegName gpioRegs[] = {
+    {0x00, "FIODIR", true}, {0x10, "FIOMASK", true}, {0x14, "FIOPIN", false},
+    {0x18, "FIOSET", false}, {0x1C, "FIOCLR", false},
+};
+
+const RegName gpioIntRegs[] = {
+    {0x00, "IntStatus", false},   {0x04, "IO0IntStatR", false}, {0x08, "IO0IntStatF", false},
+    {0x0C, "IO0IntClr", false},   {0x10, "IO0IntEnR", true},    {0x14, "IO0IntEnF", true},
+    {0x24, "IO2IntStatR", false}, {0x28, "IO2IntStatF", false}, {0x2C, "IO2IntClr", false},
+    {0x30, "IO2IntEnR", true},    {0x34, "IO2IntEnF", true},
+};
+
+const RegName scRegs[] = {
+    {0x000, "FLASHCFG", true},  {0x080, "PLL0CON", false},   {0x084, "PLL0CFG", false},
+    {0x088, "PLL0STAT", false}, {0x08C, "PLL0FEED", false},  {0x0A0, "PLL1CON", false},
+    {0x0A4, "PLL1CFG", false},  {0x0A8, "PLL1STAT", false},  {0x0AC, "PLL1FEED", false},
+    {0x0C0, "PCON", false},     {0x0C4, "PCONP", true},      {0x104, "CCLKCFG", true},
+    {0x108, "USBCLKCFG", true}, {0x10C, "CLKSRCSEL", true},  {0x140, "EXTINT", false},
+    {0x148, "EXTMODE", true},   {0x14C, "EXTPOLAR", true},   {0x180, "RSID", false},
+    {0x1A0, "SCS", false},      {0x1A8, "PCLKSEL0", true},   {0x1AC, "PCLKSEL1", true},
+};
+
+const RegName sysTickRegs[] = {
+    {0x0, "CTRL", false}, {0x4, "LOAD", true}, {0x8, "VAL", false}, {0xC, "CALIB", false},
+};
+
+/**
+ * @brief Decoded register address.
+ */
+struct Reg {
+    std::string block;    /**< Peripheral: GPIO2, PINCON, GPIOINT, SC or SysTick. */
+    std::string name;     /**< Peripheral and register, e.g. "PINCON.PINSEL4". */
+    bool config;          /**< Configuration register. */
+};
+
+/** Looks up a register by offset, falling back to the offset. */
+template <size_t N>
+Reg lookup(const char* block, const RegName (&regs)[N], uint32_t offset) {
+    char buf[64];
+    for (const RegName& reg : regs) {
+        if (reg.offset == offset) {
+            snprintf(buf, sizeof(buf), "%s.%s", block, reg.name);
+            return {block, buf, reg.config};
+        }
+    }
+    snprintf(buf, sizeof(buf), "%s+0x%03X", block, offset);
+    return {block, buf, false};
+}
+
+/** Decodes a 32-bit aligned register address. */
+Reg decode(uint32_t word) {
+    char buf[64];
+    if (word >= LPC_GPIO0_BASE && word < LPC_GPIO0_BASE + 5 * 0x20) {
+        snprintf(buf, sizeof(buf), "GPIO%u", static_cast<uint32_t>(word - LPC_GPIO0_BASE) / 0x20);
+        return lookup(buf, gpioRegs, word & 0x1F);
+    }
+    if (word >= LPC_PINCON_BASE && word < LPC_PINCON_BASE + 0x80) {
+        const uint32_t offset = word - LPC_PINCON_BASE;
+        if (offset < 0x2C)
+            snprintf(buf, sizeof(buf), "PINCON.PINSEL%u", offset / 4);
+        else if (offset >= 0x40 && offset < 0x68)
+            snprintf(buf, sizeof(buf), "PINCON.PINMODE%u", (offset - 0x40) / 4);
+        else if (offset >= 0x68 && offset < 0x7C)
+            snprintf(buf, sizeof(buf), "PINCON.PINMODE_OD%u", (offset - 0x68) / 4);
+        else
+            snprintf(buf, sizeof(buf), "PINCON.I2CPADCFG");
+        return {"PINCON", buf, true};
+    }
+    if (word >= LPC_GPIOINT_BASE && word < LPC_GPIOINT_BASE + 0x40)
+        return lookup("GPIOINT", gpioIntRegs, word - LPC_GPIOINT_BASE);
+    if (word >= LPC_SC_BASE && word < LPC_SC_BASE + 0x200)
+        return lookup("SC", scRegs, word - LPC_SC_BASE);
+    if (word >= SysTick_BASE && word < SysTick_BASE + 0x10)
+        return lookup("SysTick", sysTickRegs, word - SysTick_BASE);
+    snprintf(buf, sizeof(buf), "0x%08X", word);
+    return {"?", buf, false};
+}
+
+/** Name of an access: the register, with the byte (FIOSET2) or halfword (FIOSETH) view. */
+std::string accessName(const Reg& reg, uint32_t addr, uint32_t width) {
+    if (width == 4)
+        return reg.name;
+    if (width == 2)
+        return reg.name + ((addr & 2) ? "H" : "L");
+    return reg.name + static_cast<char>('0' + (addr & 3));
+}
+
+/** Splits a call path into its functions. */
+std::vector<std::string> splitPath(const std::string& path) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    for (size_t end; (end = path.find('>', start)) != std::string::npos; start = end + 1)
+        parts.push_back(path.substr(start, end - start));
+    parts.push_back(path.substr(start));
+    return parts;
+}
+
+/**
+ * @brief Names used to attribute the accesses of one call path.
+ */
+struct PathInfo {
+    std::string full;    /**< Whole path. */
+    std::string leaf;    /**< Accessing function. */
+    std::string top;     /**< Top-level call: function called by main(), or the handler. */
+};
+
+PathInfo pathInfo(const std::string& full, bool handler) {
+    const std::vector<std::string> parts = splitPath(full);
+    PathInfo info{full, parts.back(), parts.front()};
+    // Thread paths start at main(), handler paths at the exception name.
+    if (parts.size() > 1 && (handler || parts.front() == "main"))
+        info.top = parts[1];
+    return info;
+}
+
+/**
+ * @brief Tracking of a configuration register over the whole trace.
+ */
+struct RegState {
+    bool known;         /**< The value is known. */
+    uint32_t value;     /**< Last value read or written. */
+    uint64_t writes;    /**< Number of writes. */
+};
+
+/**
+ * @brief Tracking of a configuration register within one top-level call.
+ */
+struct CallRegState {
+    bool seen;             /**< Accessed by the call. */
+    uint64_t writes;       /**< RegState::writes at the last access. */
+    bool read;             /**< Read since the last write of the call. */
+    uint32_t rmw;          /**< Read-modify-writes. */
+    uint32_t rewrites;     /**< Writes of the value already held. */
+    uint32_t rereads;      /**< Reads of a known value. */
+};
+
+/** Kinds of redundant access, in the order of the report. */
+enum Issue { ISSUE_RMW, ISSUE_REWRITE, ISSUE_REREAD };
+
+const char* const issueNames[] = {
+    "read-modify-writes (1 would do)",
+    "writes of the value already held",
+    "reads of a value already known",
+};
+
+/**
+ * @brief Redundant accesses of one kind, to one register, by one top-level function.
+ */
+struct IssueTotals {
+    uint64_t calls;    /**< Calls with the issue. */
+    uint64_t total;    /**< Accesses over all those calls. */
+    uint32_t worst;    /**< Most accesses in one call. */
+};
+
+/**
+ * @brief Reads and writes.
+ */
+struct Counts {
+    uint64_t reads;
+    uint64_t writes;
+};
+
+[[noreturn]] void usage(const char* prog) {
+    fprintf(stderr, "usage: %s [-d] TRACE\n  -d  print every record\n", prog);
+    exit(EXIT_FAILURE);
+}
+
+/** Reads the whole file, exiting on error. */
+std::vector<char> readFile(const char* path) {
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    std::vector<char> data;
+    char buf[65536];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), in)) > 0;)
+        data.insert(data.end(), buf, buf + n);
+    fclose(in);
+    return data;
+}
+
+}    // namespace
+
+int main(int argc, char** argv) {
+    bool dump = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "dh")) != -1) {
+        if (opt != 'd')
+            usage(argv[0]);
+        dump = true;
+    }
+    if (optind != argc - 1)
+        usage(argv[0]);
+
+    const char* path             = argv[optind];
+    const std::vector<char> data = readFile(path);
+    TraceHeader header;
+    if (data.size() < sizeof(header) || memcmp(data.data(), sim::TRACE_MAGIC, sizeof(sim::TRACE_MAGIC)) != 0) {
+        fprintf(stderr, "%s: not a bus trace\n", path);
+        return EXIT_FAILURE;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    const size_t recordsEnd = sizeof(header) + header.stored * sizeof(TraceRecord);
+    if (header.recordSize != sizeof(TraceRecord) || data.size() < recordsEnd) {
+        fprintf(stderr, "%s: truncated or incompatible trace\n", path);
+        return EXIT_FAILURE;
+    }
+    std::vector<TraceRecord> records(header.stored);
+    memcpy(records.data(), data.data() + sizeof(header), recordsEnd - sizeof(header));
+
+    std::vector<std::string> pathNames;
+    for (size_t pos = recordsEnd; pos < data.size() && pathNames.size() < header.paths;) {
+        pathNames.emplace_back(data.data() + pos);
+        pos += pathNames.back().size() + 1;
+    }
+
+    std::map<std::pair<uint16_t, bool>, PathInfo> paths;    // Handler paths differ in their root.
+    auto infoOf = [&](const TraceRecord& r) -> const PathInfo& {
+        const auto key = std::make_pair(r.path, r.exc != 0);
+        auto it        = paths.find(key);
+        if (it == paths.end())
+            it = paths.emplace(key, pathInfo(r.path < pathNames.size() ? pathNames[r.path] : "?", r.exc != 0)).first;
+        return it->second;
+    };
+    std::unordered_map<uint32_t, Reg> regs;
+    auto regOf = [&](uint32_t word) -> const Reg& {
+        auto it = regs.find(word);
+        if (it == regs.end())
+            it = regs.emplace(word, decode(word)).first;
+        return it->second;
+    };
+
+    std::map<std::pair<std::string, std::string>, Counts> byFunction;    // Leaf function, block.
+    std::unordered_map<uint32_t, RegState> state;
+    std::map<uint32_t, std::map<uint32_t, CallRegState>> calls;          // Call, register.
+    std::map<uint32_t, std::string> callTops;
+
+    if (dump)
+        printf("%14s  %-2s %-24s %-10s %s\n", "cycle", "", "register", "value", "call path");
+    for (const TraceRecord& r : records) {
+        const bool write      = r.flags & sim::TRACE_WRITE;
+        const uint32_t width  = r.flags >> sim::TRACE_WIDTH_POS;
+        const uint32_t word   = r.addr & ~3u;
+        const Reg& reg        = regOf(word);
+        const PathInfo& info  = infoOf(r);
+
+        if (dump)
+            printf("%14llu  %-2s %-24s 0x%08X %s\n", (unsigned long long)r.time, write ? "W" : "R",
+                   accessName(reg, r.addr, width).c_str(), r.value, info.full.c_str());
+
+        Counts& counts = byFunction[{info.leaf, reg.block}];
+        (write ? counts.writes : counts.reads)++;
+        callTops.emplace(r.call, info.top);
+
+        if (!reg.config)
+            continue;
+        RegState& rs = state[word];
+        if (width != 4) {    // Narrow views are only counted: the word is no longer known.
+            rs.known = false;
+            rs.writes += write;
+            continue;
+        }
+        CallRegState& cs = calls[r.call][word];
+        if (write) {
+            cs.rmw += cs.read;
+            cs.rewrites += rs.known && rs.value == r.value;
+            cs.read = false;
+            rs.writes++;
+        } else {
+            cs.rereads += cs.seen && cs.writes == rs.writes;
+            cs.read = true;
+        }
+        cs.seen   = true;
+        cs.writes = rs.writes;
+        rs.known  = true;
+        rs.value  = r.value;
+    }
+
+    std::map<std::tuple<std::string, std::string, int>, IssueTotals> issues;    // Call, register, issue.
+    auto addIssue = [&](const std::string& top, uint32_t word, Issue issue, uint32_t count) {
+        IssueTotals& t = issues[std::make_tuple(top, regOf(word).name, static_cast<int>(issue))];
+        t.calls++;
+        t.total += count;
+        t.worst = std::max(t.worst, count);
+    };
+    for (const auto& call : calls) {
+        const std::string& top = callTops[call.first];
+        for (const auto& entry : call.second) {
+            const CallRegState& cs = entry.second;
+            if (cs.rmw > 1)
+                addIssue(top, entry.first, ISSUE_RMW, cs.rmw);
+            if (cs.rewrites)
+                addIssue(top, entry.first, ISSUE_REWRITE, cs.rewrites);
+            if (cs.rereads)
+                addIssue(top, entry.first, ISSUE_REREAD, cs.rereads);
+        }
+    }
+
+    if (dump)
+        printf("\n");
+    const uint64_t span = records.empty() ? 0 : records.back().time - records.front().time;
+    printf("%llu accesses recorded, %llu in the trace over %.6f s, %zu top-level calls\n\n",
+           (unsigned long long)header.recorded, (unsigned long long)header.stored,
+           span / static_cast<double>(sim::CORE_CLOCK), callTops.size());
+
+    printf("Accesses by function\n%-32s %-8s %10s %10s\n", "function", "block", "reads", "writes");
+    for (const auto& row : byFunction)
+        printf("%-32s %-8s %10llu %10llu\n", row.first.first.c_str(), row.first.second.c_str(),
+               (unsigned long long)row.second.reads, (unsigned long long)row.second.writes);
+
+    printf("\nRedundant accesses by top-level call\n%-24s %-22s %8s %8s %6s  %s\n", "call", "register", "calls",
+           "total", "worst", "issue");
+    if (issues.empty())
+        printf("none\n");
+    for (const auto& row : issues)
+        printf("%-24s %-22s %8llu %8llu %6u  %s\n", std::get<0>(row.first).c_str(), std::get<1>(row.first).c_str(),
+               (unsigned long long)row.second.calls, (unsigned long long)row.second.total, row.second.worst,
+               issueNames[std::get<2>(row.first)]);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file alu4.h
+ * @brief 4-bit ALU precomputed into a flash table indexed by the raw input pins.
+ *
+ * The inputs of the ALU are 11 contiguous bits: operand A in bits 0-3, operand B in bits 4-7
+ * and the operation in bits 8-10. The table holds, for each of the 2048 input words, the output
+ * word: the 4-bit result in bits 0-3 and the flag in bit 4. With the inputs on P0.0-P0.10 and
+ * the outputs on P2.0-P2.4, both ports masked to those pins (FIOMASK), an input change costs a
+ * FIOPIN read, one table load and a FIOPIN write:
+ *
+ *     const uint8_t aluTable[ALU4_ENTRIES] = ALU4_TABLE;
+ *     LPC_GPIO2->FIOPIN = aluTable[LPC_GPIO0->FIOPIN];
+ *
+ * The table is built by the preprocessor from ALU4_OUTPUT(), so it costs 2 KB of flash and no
+ * start-up code. The operation codes keep the original add (select pins high, as left by the
+ * pull-ups) and subtract (P0.8 low) of the two-operation ALU.
+ *
+ * Header only: the table is defined in the file that uses it.
+ */
+
+#ifndef ALU4_H
+#define ALU4_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Operations (bits 8-10 of the input word). */
+#define ALU4_OP_MUL (0)    /*!< A * B, flag if the product exceeds 4 bits. */
+#define ALU4_OP_SHR (1)    /*!< A >> B, flag if a 1 is shifted out. */
+#define ALU4_OP_SHL (2)    /*!< A << B, flag if a 1 is shifted out. */
+#define ALU4_OP_XOR (3)    /*!< A ^ B. */
+#define ALU4_OP_OR  (4)    /*!< A | B. */
+#define ALU4_OP_AND (5)    /*!< A & B. */
+#define ALU4_OP_SUB (6)    /*!< |A - B|, flag if the difference is negative. */
+#define ALU4_OP_ADD (7)    /*!< A + B, flag if the sum exceeds 4 bits. */
+
+/** Position of the operands and the operation in the input word. */
+#define ALU4_A_SHIFT  (0)
+#define ALU4_B_SHIFT  (4)
+#define ALU4_OP_SHIFT (8)
+/** Number of input words (table entries). */
+#define ALU4_ENTRIES  (1 << 11)
+
+/** Bits of the 4-bit result in the output word. */
+#define ALU4_RESULT (0x0F)
+/** Overflow / negative / shifted-out flag in the output word. */
+#define ALU4_FLAG   (0x10)
+
+/** Output word of a wide result: its low 4 bits, and the flag if it does not fit in them. */
+#define ALU4_FIT(r) (((r) & ALU4_RESULT) | ((r) > ALU4_RESULT ? ALU4_FLAG : 0))
+
+/** Output word of one operation on constant operands. */
+#define ALU4_OUTPUT(a, b, op)                                                        \
+    ((op) == ALU4_OP_ADD   ? ALU4_FIT((a) + (b))                                     \
+     : (op) == ALU4_OP_SUB ? ((b) > (a) ? ((b) - (a)) | ALU4_FLAG : (a) - (b))       \
+     : (op) == ALU4_OP_AND ? (a) & (b)                                               \
+     : (op) == ALU4_OP_OR  ? (a) | (b)                                               \
+     : (op) == ALU4_OP_XOR ? (a) ^ (b)                                               \
+     : (op) == ALU4_OP_SHL ? ALU4_FIT((a) << (b))                                    \
+     : (op) == ALU4_OP_SHR ? (((a) >> (b)) | (((a) >> (b)) << (b) != (a) ? ALU4_FLAG : 0)) \
+                           : ALU4_FIT((a) * (b)))
+
+/** The 16 entries of one B and operation, A = 0-15. */
+#define ALU4_ROW_(b, op)                                                                       \
+    ALU4_OUTPUT(0, b, op), ALU4_OUTPUT(1, b, op), ALU4_OUTPUT(2, b, op), ALU4_OUTPUT(3, b, op),     \
+        ALU4_OUTPUT(4, b, op), ALU4_OUTPUT(5, b, op), ALU4_OUTPUT(6, b, op), ALU4_OUTPUT(7, b, op), \
+        ALU4_OUTPUT(8, b, op), ALU4_OUTPUT(9, b, op), ALU4_OUTPUT(10, b, op),                       \
+        ALU4_OUTPUT(11, b, op), ALU4_OUTPUT(12, b, op), ALU4_OUTPUT(13, b, op),                     \
+        ALU4_OUTPUT(14, b, op), ALU4_OUTPUT(15, b, op)
+
+/** The 256 entries of one operation, B = 0-15. */
+#define ALU4_OP_(op)                                                                          \
+    ALU4_ROW_(0, op), ALU4_ROW_(1, op), ALU4_ROW_(2, op), ALU4_ROW_(3, op), ALU4_ROW_(4, op),   \
+        ALU4_ROW_(5, op), ALU4_ROW_(6, op), ALU4_ROW_(7, op), ALU4_ROW_(8, op), ALU4_ROW_(9, op), \
+        ALU4_ROW_(10, op), ALU4_ROW_(11, op), ALU4_ROW_(12, op), ALU4_ROW_(13, op),               \
+        ALU4_ROW_(14, op), ALU4_ROW_(15, op)
+
+/**
+ * @brief Initializer of the table: ALU4_ENTRIES output words, indexed by the input word.
+ *
+ * Usage: `const uint8_t aluTable[ALU4_ENTRIES] = ALU4_TABLE;`
+ */
+#define ALU4_TABLE                                                                               \
+    {ALU4_OP_(0), ALU4_OP_(1), ALU4_OP_(2), ALU4_OP_(3), ALU4_OP_(4), ALU4_OP_(5), ALU4_OP_(6), \
+     ALU4_OP_(7)}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // ALU4_H
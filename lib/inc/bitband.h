@@ -0,0 +1,98 @@
+/**
+ * @file bitband.h
+ * @brief Single-bit register and pin access through the Cortex-M3 bit-band aliases.
+ *
+ * The first megabyte of the SRAM region (0x20000000, where the LPC1769 places its GPIO blocks)
+ * and of the peripheral region (0x40000000, the APB peripherals) have an alias region where each
+ * word maps to one bit: reading it returns the bit, writing bit 0 of the value sets or clears
+ * it. A write is a single store for the core; the bus reads the word and writes it back with the
+ * bit changed, locked, so no interrupt or DMA transfer can slip between them and no other bit
+ * of the register is lost.
+ *
+ * Pins are accessed through FIOPIN, so a set or clear is one store and a toggle one load and
+ * one store, where `FIOPIN ^= LED` takes a FIOPIN read and write that an interrupt changing
+ * another pin of the port can preempt, and undo:
+ *
+ *     BITBAND_PinToggle(1, 18);    // P1.18 = !P1.18, the other pins of port 1 untouched.
+ *
+ * Writes read back the whole register: do not use them on write-1-to-clear registers (EXTINT,
+ * IOxIntClr), which would clear every pending flag, nor on write-only ones (FIOSET, FIOCLR).
+ * Pins masked in FIOMASK read as 0 and are not written.
+ *
+ * Header only.
+ */
+
+#ifndef BITBAND_H
+#define BITBAND_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Address of the alias word of bit `bit` of the word at `addr`.
+ *
+ * `addr` must be in the first megabyte of the SRAM or peripheral region.
+ */
+#define BITBAND_ALIAS(addr, bit)                                                \
+    (((addr) & 0xF0000000UL) + 0x02000000UL + (((addr) & 0x000FFFFFUL) << 5) + \
+     ((uint32_t)(bit) << 2))
+
+/**
+ * @brief Alias word of bit `bit` of register `reg`, with the register type: read it for the bit,
+ *        assign 0 or 1 to clear or set it.
+ *
+ * Usage: `BITBAND_REG(LPC_SC->PCONP, 15) = 1;`
+ */
+#define BITBAND_REG(reg, bit) (*(__typeof__(reg)*)BITBAND_ALIAS((uintptr_t)&(reg), bit))
+
+/** Register block of GPIO port `port`. */
+#define BITBAND_GPIO(port) \
+    ((LPC_GPIO_TypeDef*)(LPC_GPIO0_BASE + (port) * (LPC_GPIO1_BASE - LPC_GPIO0_BASE)))
+
+/** Alias word of pin `pin` of GPIO port `port` (bit of FIOPIN). */
+#define BITBAND_PIN(port, pin) BITBAND_REG(BITBAND_GPIO(port)->FIOPIN, pin)
+
+/**
+ * @brief Reads a pin: one load.
+ *
+ * @param port GPIO port (0 to 4).
+ * @param pin  Pin (0 to 31).
+ * @return 1 if the pin is high, 0 if it is low or masked.
+ */
+static inline uint32_t BITBAND_PinRead(uint32_t port, uint32_t pin) {
+    return BITBAND_PIN(port, pin);
+}
+
+/**
+ * @brief Drives a pin: one store, atomic.
+ *
+ * @param port  GPIO port (0 to 4).
+ * @param pin   Pin (0 to 31).
+ * @param level 1 for high, 0 for low.
+ */
+static inline void BITBAND_PinWrite(uint32_t port, uint32_t pin, uint32_t level) {
+    BITBAND_PIN(port, pin) = level;
+}
+
+/**
+ * @brief Toggles a pin: one load and one store.
+ *
+ * The other pins of the port are never changed. An interrupt that drives the same pin between
+ * the load and the store is overridden: toggle a pin from one context only, or in a critical
+ * section.
+ *
+ * @param port GPIO port (0 to 4).
+ * @param pin  Pin (0 to 31).
+ */
+static inline void BITBAND_PinToggle(uint32_t port, uint32_t pin) {
+    BITBAND_PIN(port, pin) = !BITBAND_PIN(port, pin);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // BITBAND_H
@@ -0,0 +1,102 @@
+/**
+ * @file cpuload.h
+ * @brief CPU load measurement on the DWT cycle counter: time asleep, in the thread and per handler.
+ *
+ * CYCCNT counts core cycles. CPULOAD_Sleep() replaces the __WFI() of the main loop: it sleeps
+ * with interrupts masked, so the cycles until the wake-up are sleep and the handler that woke the
+ * core runs right after, as active time. Handlers that bracket their body with
+ * CPULOAD_HANDLER_BEGIN() and CPULOAD_HANDLER_END() get their own share, nested handlers
+ * excluded; whatever is left is the thread. A handler that is not instrumented is charged to
+ * the code it preempted, and exception entry and return (about 12 cycles each) to the thread:
+ *
+ *     void SysTick_Handler(void) {
+ *         CPULOAD_HANDLER_BEGIN();
+ *         ...
+ *         CPULOAD_HANDLER_END(LOAD_SYSTICK);
+ *     }
+ *
+ * CYCCNT wraps every 2^32 cycles (about 43 s at 100 MHz): CPULOAD_Sleep() or CPULOAD_Get() must
+ * run more often than that, and no single sleep or handler may last longer. On the host
+ * simulator CYCCNT follows the virtual clock.
+ */
+
+#ifndef CPULOAD_H
+#define CPULOAD_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CPULOAD_MAX_HANDLERS
+/** Handler slots: the `slot` of CPULOAD_HANDLER_END() is below this. */
+#define CPULOAD_MAX_HANDLERS (8)
+#endif
+
+/**
+ * @brief Entry of an instrumented handler, kept on its stack.
+ */
+typedef struct {
+    uint32_t start;     /*!< CYCCNT at entry. */
+    uint32_t nested;    /*!< Handler cycles counted before entry. */
+} CPULOAD_Mark;
+
+/**
+ * @brief Cycles measured since CPULOAD_Init() or the last reset.
+ */
+typedef struct {
+    uint64_t total;                              /*!< Elapsed cycles. */
+    uint64_t sleep;                              /*!< Cycles asleep in CPULOAD_Sleep(). */
+    uint64_t thread;                             /*!< Active cycles outside the instrumented handlers. */
+    uint64_t handler[CPULOAD_MAX_HANDLERS];      /*!< Active cycles of each handler slot. */
+    uint32_t entries[CPULOAD_MAX_HANDLERS];      /*!< Entries of each handler slot. */
+    uint32_t activePpm;                          /*!< Awake time, in millionths of the elapsed time. */
+} CPULOAD_Report;
+
+/** Starts the accounting of an instrumented handler: first statement of its body. */
+#define CPULOAD_HANDLER_BEGIN() const CPULOAD_Mark cpuloadMark = CPULOAD_Enter()
+/** Ends the accounting of an instrumented handler in `slot`: last statement of its body. */
+#define CPULOAD_HANDLER_END(slot) CPULOAD_Exit((slot), &cpuloadMark)
+
+/**
+ * @brief Enables the DWT cycle counter and starts the measurement.
+ */
+void CPULOAD_Init(void);
+
+/**
+ * @brief Sleeps in __WFI() until an interrupt is pending, counting the cycles as sleep.
+ *
+ * The pending handler runs before the function returns, unless interrupts were already masked.
+ */
+void CPULOAD_Sleep(void);
+
+/**
+ * @brief Marks the entry of an instrumented handler. Use CPULOAD_HANDLER_BEGIN().
+ *
+ * @return Entry mark to pass to CPULOAD_Exit().
+ */
+CPULOAD_Mark CPULOAD_Enter(void);
+
+/**
+ * @brief Charges an instrumented handler its cycles since CPULOAD_Enter(), nested handlers
+ * excluded. Use CPULOAD_HANDLER_END().
+ *
+ * @param slot Handler slot, below CPULOAD_MAX_HANDLERS.
+ * @param mark Mark returned by CPULOAD_Enter() on entry.
+ */
+void CPULOAD_Exit(uint32_t slot, const CPULOAD_Mark* mark);
+
+/**
+ * @brief Reads the cycles measured so far.
+ *
+ * @param report Filled with the measurement.
+ * @param reset  1 to start a new measurement from now, 0 to keep accumulating.
+ */
+void CPULOAD_Get(CPULOAD_Report* report, uint8_t reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // CPULOAD_H
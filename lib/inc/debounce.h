@@ -0,0 +1,107 @@
+/**
+ * @file debounce.h
+ * @brief Non-blocking debouncer for all the pins of a GPIO port, on bit-sliced vertical counters.
+ *
+ * Replaces debounce loops that wait in a delay and then spin until the button is released:
+ * a periodic tick (e.g. SysTick_Handler()) samples the port and calls DEBOUNCE_Update(), and
+ * the main loop collects the press, release and long-press events.
+ *
+ * Each pin has a 2-bit counter of consecutive samples that differ from its debounced state, and
+ * a DEBOUNCE_HOLD_BITS counter of the ticks it has been held. Bit k of every counter of the port
+ * is stored in one word (a vertical counter), so a handful of logic operations count, reset and
+ * compare the counters of the 32 pins at once: the cost of a tick is the same for 1 or 32 buttons.
+ *
+ * A pin changes state after DEBOUNCE_SAMPLES equal samples, i.e. bounces shorter than
+ * DEBOUNCE_SAMPLES - 1 ticks are filtered out. A tick of 5-10 ms suits mechanical buttons.
+ */
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Equal samples needed to change the debounced state of a pin. */
+#define DEBOUNCE_SAMPLES   (4)
+/** Bits of the hold counters: long presses up to 2^DEBOUNCE_HOLD_BITS - 1 ticks. */
+#define DEBOUNCE_HOLD_BITS (8)
+
+/**
+ * @brief Debouncer of one GPIO port. Fields are private to the module.
+ */
+typedef struct {
+    uint32_t mask;                          /*!< Pins debounced. */
+    uint32_t activeLow;                     /*!< Pins pressed at logic 0. */
+    uint32_t state;                         /*!< Debounced state, 1 = pressed. */
+    uint32_t count0;                        /*!< Bit 0 of the change counters. */
+    uint32_t count1;                        /*!< Bit 1 of the change counters. */
+    uint32_t hold[DEBOUNCE_HOLD_BITS];      /*!< Bit k of the hold counters. */
+    uint32_t longDone;                      /*!< Pins whose long press was already reported. */
+    uint32_t longTicks;                     /*!< Hold time of a long press, in ticks. */
+    uint32_t longEnable;                    /*!< All 1s if long presses are enabled, else 0. */
+    volatile uint32_t pressed;              /*!< Pending press events. */
+    volatile uint32_t released;             /*!< Pending release events. */
+    volatile uint32_t longPressed;          /*!< Pending long-press events. */
+} DEBOUNCE_Type;
+
+/**
+ * @brief Initializes a debouncer with every pin released.
+ *
+ * @param debouncer Debouncer to initialize.
+ * @param mask      Pins to debounce; the others never produce events.
+ * @param activeLow Pins pressed at logic 0 (buttons with pull-up), the others at logic 1.
+ * @param longTicks Ticks a pin must be held for a long-press event, 0 to disable them.
+ * @return 0 on success, 1 if `longTicks` does not fit the hold counters.
+ */
+uint32_t DEBOUNCE_Init(DEBOUNCE_Type* debouncer, uint32_t mask, uint32_t activeLow, uint32_t longTicks);
+
+/**
+ * @brief Takes one sample of the port. Must be called at a fixed period, from the tick interrupt.
+ *
+ * @param debouncer Debouncer.
+ * @param pins      Port value (FIOPIN).
+ */
+void DEBOUNCE_Update(DEBOUNCE_Type* debouncer, uint32_t pins);
+
+/**
+ * @brief Returns and clears the pins pressed since the last call.
+ *
+ * @param debouncer Debouncer.
+ * @return Mask of the pins with a press event.
+ */
+uint32_t DEBOUNCE_GetPressed(DEBOUNCE_Type* debouncer);
+
+/**
+ * @brief Returns and clears the pins released since the last call.
+ *
+ * @param debouncer Debouncer.
+ * @return Mask of the pins with a release event.
+ */
+uint32_t DEBOUNCE_GetReleased(DEBOUNCE_Type* debouncer);
+
+/**
+ * @brief Returns and clears the pins held for `longTicks` since the last call.
+ *
+ * A long press is reported once per press, while the pin is still held; its release is
+ * reported too.
+ *
+ * @param debouncer Debouncer.
+ * @return Mask of the pins with a long-press event.
+ */
+uint32_t DEBOUNCE_GetLongPressed(DEBOUNCE_Type* debouncer);
+
+/**
+ * @brief Returns the debounced state of the pins (1 = pressed).
+ *
+ * @param debouncer Debouncer.
+ */
+uint32_t DEBOUNCE_GetState(const DEBOUNCE_Type* debouncer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // DEBOUNCE_H
@@ -0,0 +1,80 @@
+/**
+ * @file evqueue.h
+ * @brief Lock-free single-producer/single-consumer event queue, from an ISR to deferred work.
+ *
+ * Long work inside an interrupt handler (a LED sequence with delays, a display update) blocks
+ * every interrupt of the same or lower priority until it ends. With this queue the handler only
+ * clears its flag and posts an event; the work runs later in the main loop or in PendSV, which
+ * has the lowest priority and is preempted by every other interrupt.
+ *
+ * A queue has exactly one producer and one consumer, each running at a single priority: no
+ * critical section is needed because the producer only writes `head` and the consumer only
+ * writes `tail`. Handlers of different priorities must post to different queues.
+ */
+
+#ifndef EVQUEUE_H
+#define EVQUEUE_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Event queue. Its fields are private to the module.
+ */
+typedef struct {
+    uint32_t* buffer;              /*!< Event storage. */
+    uint32_t mask;                 /*!< Capacity - 1 (capacity is a power of 2). */
+    volatile uint32_t head;        /*!< Events posted, written by the producer only. */
+    volatile uint32_t tail;        /*!< Events taken, written by the consumer only. */
+    volatile uint32_t overflows;   /*!< Events dropped because the queue was full. */
+} EVQUEUE_Type;
+
+/**
+ * @brief Initializes an empty queue.
+ *
+ * @param queue    Queue to initialize.
+ * @param buffer   Event storage of `capacity` entries.
+ * @param capacity Number of entries (power of 2).
+ */
+void EVQUEUE_Init(EVQUEUE_Type* queue, uint32_t* buffer, uint32_t capacity);
+
+/**
+ * @brief Posts an event. Called by the producer only (usually an interrupt handler).
+ *
+ * @param queue Queue to post to.
+ * @param event Event value.
+ * @return 1 if posted, 0 if the queue was full (the overflow counter is incremented).
+ */
+uint8_t EVQUEUE_Post(EVQUEUE_Type* queue, uint32_t event);
+
+/**
+ * @brief Takes the oldest event. Called by the consumer only.
+ *
+ * @param queue Queue to take from.
+ * @param event Set to the event taken.
+ * @return 1 if an event was taken, 0 if the queue was empty.
+ */
+uint8_t EVQUEUE_Get(EVQUEUE_Type* queue, uint32_t* event);
+
+/**
+ * @brief Returns the number of events waiting in the queue.
+ *
+ * @param queue Queue to check.
+ */
+uint32_t EVQUEUE_Count(const EVQUEUE_Type* queue);
+
+/**
+ * @brief Returns the number of events dropped because the queue was full.
+ *
+ * @param queue Queue to check.
+ */
+uint32_t EVQUEUE_GetOverflows(const EVQUEUE_Type* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // EVQUEUE_H
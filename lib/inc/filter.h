@@ -0,0 +1,190 @@
+/**
+ * @file filter.h
+ * @brief Streaming multi-channel digital filters: moving average, EMA, CIC decimator and median.
+ *
+ * Every filter processes one sample of each of its channels per call, so a tick that samples
+ * many channels makes a single call. Storage is provided by the caller (see the *_SIZE macros),
+ * samples are unsigned 16-bit values (GPIO bytes, 12-bit ADC results...).
+ *
+ * No filter divides or takes a modulo: windows and decimation rates are powers of 2, ring
+ * buffers wrap with a mask and averages are shifts. Each filter has a cycle budget per channel
+ * and sample on the Cortex-M3, from a model of its inner loop checked by benchmarks/02_filters:
+ *
+ * | Filter           | Budget                            |
+ * |------------------|-----------------------------------|
+ * | Moving average   | FILTER_MA_CYCLES                  |
+ * | EMA              | FILTER_EMA_CYCLES                 |
+ * | CIC decimator    | FILTER_CIC_CYCLES(order) averaged |
+ * | Running median   | FILTER_MEDIAN_CYCLES(window)      |
+ */
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Cycle budget of the moving average, per channel-sample. */
+#define FILTER_MA_CYCLES             (16)
+/** Cycle budget of the EMA, per channel-sample. */
+#define FILTER_EMA_CYCLES            (16)
+/** Cycle budget of the CIC decimator, per channel-sample averaged over the decimation period. */
+#define FILTER_CIC_CYCLES(order)     (8 + 8 * (order))
+/** Worst-case cycle budget of the running median, per channel-sample. */
+#define FILTER_MEDIAN_CYCLES(window) (24 + 8 * (window))
+/** Cycle budget of a call besides its channels (call, loads of the filter fields, return). */
+#define FILTER_CALL_CYCLES           (30)
+
+/** Fractional bits of the EMA state. */
+#define FILTER_EMA_FRAC_BITS (8)
+
+/** Sample words needed by a moving average. */
+#define FILTER_MA_SIZE(channels, log2Window) ((channels) << (log2Window))
+/** State words needed by a CIC decimator. */
+#define FILTER_CIC_SIZE(channels, order)     ((channels) * 2 * (order))
+/** Sample words needed by each of the two arrays of a running median. */
+#define FILTER_MEDIAN_SIZE(channels, window) ((channels) * (window))
+
+/**
+ * @brief Moving average (boxcar) over a power of 2 window. Fields are private to the module.
+ */
+typedef struct {
+    uint16_t* samples;    /*!< Window, `channels` samples per slot. */
+    uint32_t* sums;       /*!< Running sum of each channel. */
+    uint32_t channels;    /*!< Number of channels. */
+    uint32_t log2Window;  /*!< Window length is 2^log2Window samples. */
+    uint32_t mask;        /*!< Window length - 1. */
+    uint32_t index;       /*!< Slot of the oldest samples. */
+} FILTER_MA_Type;
+
+/**
+ * @brief Exponential moving average y += (x - y) / 2^shift, in fixed point.
+ */
+typedef struct {
+    int32_t* state;       /*!< Output of each channel, FILTER_EMA_FRAC_BITS fractional bits. */
+    uint32_t channels;    /*!< Number of channels. */
+    uint32_t shift;       /*!< Smoothing: time constant of about 2^shift samples. */
+} FILTER_EMA_Type;
+
+/**
+ * @brief CIC decimator: `order` cascaded boxcars of 2^log2Rate samples, one output per 2^log2Rate
+ * inputs, normalized to the input scale. Order 1 is a boxcar average with decimation.
+ */
+typedef struct {
+    uint32_t* state;      /*!< Integrators then comb delays of each channel. */
+    uint32_t channels;    /*!< Number of channels. */
+    uint32_t order;       /*!< Number of integrator and comb stages. */
+    uint32_t gainShift;   /*!< order * log2Rate: log2 of the DC gain. */
+    uint32_t rateMask;    /*!< Decimation rate - 1. */
+    uint32_t phase;       /*!< Inputs since the last output. */
+} FILTER_CIC_Type;
+
+/**
+ * @brief Running median over the last `window` samples.
+ */
+typedef struct {
+    uint16_t* ring;       /*!< Last samples of each channel, in arrival order. */
+    uint16_t* sorted;     /*!< Same samples of each channel, sorted. */
+    uint32_t channels;    /*!< Number of channels. */
+    uint32_t window;      /*!< Window length (odd for a true median). */
+    uint32_t index;       /*!< Ring position of the oldest samples. */
+} FILTER_MEDIAN_Type;
+
+/**
+ * @brief Initializes a moving average with every sample at 0.
+ *
+ * @param filter     Filter to initialize.
+ * @param samples    Storage of FILTER_MA_SIZE(channels, log2Window) samples.
+ * @param sums       Storage of `channels` sums.
+ * @param channels   Number of channels.
+ * @param log2Window Window length is 2^log2Window samples (0-16).
+ * @return 0 on success, 1 if the window is too long.
+ */
+uint32_t FILTER_MA_Init(FILTER_MA_Type* filter, uint16_t* samples, uint32_t* sums, uint32_t channels,
+                        uint32_t log2Window);
+
+/**
+ * @brief Adds one sample per channel and returns the averages.
+ *
+ * @param filter Filter.
+ * @param in     One sample per channel.
+ * @param out    Average of each channel (may be `in`).
+ */
+void FILTER_MA_Update(FILTER_MA_Type* filter, const uint16_t* in, uint16_t* out);
+
+/**
+ * @brief Initializes an EMA with every output at 0.
+ *
+ * @param filter   Filter to initialize.
+ * @param state    Storage of `channels` words.
+ * @param channels Number of channels.
+ * @param shift    Smoothing, 1-15: each sample weighs 1/2^shift.
+ * @return 0 on success, 1 if the shift is out of range.
+ */
+uint32_t FILTER_EMA_Init(FILTER_EMA_Type* filter, int32_t* state, uint32_t channels, uint32_t shift);
+
+/**
+ * @brief Adds one sample per channel and returns the rounded outputs.
+ *
+ * @param filter Filter.
+ * @param in     One sample per channel.
+ * @param out    Output of each channel (may be `in`).
+ */
+void FILTER_EMA_Update(FILTER_EMA_Type* filter, const uint16_t* in, uint16_t* out);
+
+/**
+ * @brief Initializes a CIC decimator.
+ *
+ * @param filter   Filter to initialize.
+ * @param state    Storage of FILTER_CIC_SIZE(channels, order) words.
+ * @param channels Number of channels.
+ * @param order    Number of stages (1-4).
+ * @param log2Rate Decimation rate is 2^log2Rate; order * log2Rate must not exceed 16.
+ * @return 0 on success, 1 if the order or rate is out of range.
+ */
+uint32_t FILTER_CIC_Init(FILTER_CIC_Type* filter, uint32_t* state, uint32_t channels, uint32_t order,
+                         uint32_t log2Rate);
+
+/**
+ * @brief Adds one sample per channel; every 2^log2Rate calls, produces one output per channel.
+ *
+ * @param filter Filter.
+ * @param in     One sample per channel.
+ * @param out    Output of each channel, written only when the function returns 1.
+ * @return 1 if outputs were produced, 0 otherwise.
+ */
+uint8_t FILTER_CIC_Update(FILTER_CIC_Type* filter, const uint16_t* in, uint16_t* out);
+
+/**
+ * @brief Initializes a running median with every sample at 0.
+ *
+ * @param filter   Filter to initialize.
+ * @param ring     Storage of FILTER_MEDIAN_SIZE(channels, window) samples.
+ * @param sorted   Storage of FILTER_MEDIAN_SIZE(channels, window) samples.
+ * @param channels Number of channels.
+ * @param window   Window length (1 or more, odd for a true median).
+ * @return 0 on success, 1 if the window is empty.
+ */
+uint32_t FILTER_MEDIAN_Init(FILTER_MEDIAN_Type* filter, uint16_t* ring, uint16_t* sorted, uint32_t channels,
+                            uint32_t window);
+
+/**
+ * @brief Adds one sample per channel and returns the medians.
+ *
+ * The oldest sample leaves the sorted window and the new one is inserted in its place, moving
+ * only the samples between both positions.
+ *
+ * @param filter Filter.
+ * @param in     One sample per channel.
+ * @param out    Median of each channel (may be `in`).
+ */
+void FILTER_MEDIAN_Update(FILTER_MEDIAN_Type* filter, const uint16_t* in, uint16_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // FILTER_H
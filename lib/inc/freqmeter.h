@@ -0,0 +1,116 @@
+/**
+ * @file freqmeter.h
+ * @brief Period, frequency and duty cycle measurement on the TIMER3 capture input CAP3.0 (P0.23).
+ *
+ * Counting software ticks between two edge interrupts gives the period to one tick, and reading
+ * and resetting the count races with the tick. Here the edges are timestamped by the capture
+ * hardware at the PCLK rate (TIMER3 prescaler 0): the capture interrupt only toggles the edge
+ * captured next (CCR) and queues the timestamp in a FIFO (an EVQUEUE_Type), so late interrupts
+ * do not lose resolution. FREQMETER_Process(), called from the main loop, drains the FIFO:
+ *
+ * - Two edges closer than `minPulseNs` (a high or low pulse that short) are a glitch and are
+ *   both dropped, so the phase around the glitch is measured as if it were not there.
+ * - Each period (rising edge to rising edge) and its high time are summed; every `average`
+ *   periods the mean period, frequency and duty cycle are published.
+ *
+ * Above `counterAboveHz` the input switches to counter mode: TC counts the rising edges with no
+ * interrupt at all and a periodic software timer publishes the edges counted in each gate of
+ * `gateTicks`; it switches back below half of that frequency. A full FIFO, when the edges come
+ * faster than the main loop drains them, also switches to counter mode. Counter mode measures
+ * up to PCLK/4 but has no duty cycle.
+ *
+ * In capture mode the same gate timer detects an idle input: after `idleGates` gates without an
+ * edge, a measurement of 0 (no signal) is published.
+ *
+ * The software timers must already have a tick source (SWTIMER_Tick() or a tickless driver).
+ * The module owns TIMER3 and defines TIMER3_IRQHandler().
+ */
+
+#ifndef FREQMETER_H
+#define FREQMETER_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef FREQMETER_FIFO_SIZE
+/** Capture FIFO entries (power of 2): edges the main loop may fall behind by. */
+#define FREQMETER_FIFO_SIZE (64)
+#endif
+
+/** Duty cycle of a measurement made in counter mode. */
+#define FREQMETER_NO_DUTY (0xFFFF)
+
+/**
+ * @brief Measurement modes.
+ */
+typedef enum {
+    FREQMETER_CAPTURE = 0,    /*!< Edges timestamped by CR0, one interrupt per edge. */
+    FREQMETER_COUNTER         /*!< Rising edges counted by TC over a gate time. */
+} FREQMETER_Mode;
+
+/**
+ * @brief Measurement engine configuration.
+ */
+typedef struct {
+    uint32_t tickUs;            /*!< Software timer tick in microseconds. */
+    uint32_t gateTicks;         /*!< Gate of counter mode and of the idle check, in ticks. */
+    uint32_t idleGates;         /*!< Gates without an edge before the input is idle, 0 never. */
+    uint32_t average;           /*!< Periods averaged by each measurement (capture mode), at least 1. */
+    uint32_t minPulseNs;        /*!< Shorter high or low pulses are glitches, 0 keeps every edge. */
+    uint32_t counterAboveHz;    /*!< Counter mode above this frequency, 0 for capture mode only. */
+} FREQMETER_CFG_Type;
+
+/**
+ * @brief Published measurement.
+ */
+typedef struct {
+    uint32_t periodNs;        /*!< Mean period in ns (saturated), 0 without signal. */
+    uint32_t frequencyHz;     /*!< Mean frequency in Hz, rounded; 0 without signal. */
+    uint16_t dutyPermille;    /*!< High time in thousandths of the period, or FREQMETER_NO_DUTY. */
+    uint8_t mode;             /*!< FREQMETER_Mode of the measurement. */
+} FREQMETER_Result;
+
+/**
+ * @brief Selects CAP3.0 on P0.23, starts TIMER3 in capture mode and the gate timer.
+ *
+ * P0.23 keeps its PINMODE. The capture interrupt gets the highest priority: it is short, and a
+ * late one can miss the next edge.
+ *
+ * @param config Engine configuration, copied by the module.
+ * @return 0 on success, 1 if `tickUs`, `gateTicks` or `average` is 0.
+ */
+uint32_t FREQMETER_Init(const FREQMETER_CFG_Type* config);
+
+/**
+ * @brief Drains the capture FIFO: rejects glitches, averages periods and publishes measurements.
+ *
+ * Call it from the main loop, e.g. after every __WFI().
+ */
+void FREQMETER_Process(void);
+
+/**
+ * @brief Reads the last measurement.
+ *
+ * @param result Set to the last measurement (all 0 before the first one).
+ * @return 1 if it was published after the previous call, 0 otherwise.
+ */
+uint8_t FREQMETER_Get(FREQMETER_Result* result);
+
+/**
+ * @brief Returns the number of glitches dropped.
+ */
+uint32_t FREQMETER_GetGlitches(void);
+
+/**
+ * @brief Returns the number of edges lost because the capture FIFO was full.
+ */
+uint32_t FREQMETER_GetOverruns(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // FREQMETER_H
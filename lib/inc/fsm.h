@@ -0,0 +1,108 @@
+/**
+ * @file fsm.h
+ * @brief Table-driven timed state machines on a software timer.
+ *
+ * Sequencers that count ticks in SysTick_Handler() encode a long state by repeating it in their
+ * table, one entry per tick, and rewrite the outputs on every tick. Here a table is run-length
+ * encoded instead: each state holds an output vector and the number of ticks it lasts, so a
+ * state of any length is a single entry. The machine owns a one-shot software timer started for
+ * the duration of the current state, and only runs when a state ends or an event arrives: with
+ * a tickless driver (see tickless.h) the CPU is only woken on transitions.
+ *
+ * A state ends after its duration and the machine enters its `next` state. Events (e.g. a
+ * button interrupt) are looked up in a transition table, in order; the first entry matching
+ * the event and the current state (or FSM_ANY) gives the state to enter. Entering a state
+ * writes its outputs through the output function of the machine and restarts the timer.
+ *
+ * Timeouts run in the context of the tick interrupt, events in the context of the caller; they
+ * may preempt each other.
+ */
+
+#ifndef FSM_H
+#define FSM_H
+
+#include "LPC17xx.h"
+#include "swtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Duration of a state left only by an event. */
+#define FSM_FOREVER (0)
+/** Matches any state in a transition. */
+#define FSM_ANY     (0xFF)
+
+/**
+ * @brief State of a machine: outputs and run length.
+ */
+typedef struct {
+    uint32_t outputs;     /*!< Output vector written on entry. */
+    uint16_t duration;    /*!< Ticks spent in the state, FSM_FOREVER to wait for an event. */
+    uint8_t next;         /*!< State entered when the duration elapses. */
+} FSM_State;
+
+/**
+ * @brief Transition taken on an event.
+ */
+typedef struct {
+    uint8_t event;    /*!< Event. */
+    uint8_t from;     /*!< Current state, or FSM_ANY. */
+    uint8_t to;       /*!< State entered. */
+} FSM_Transition;
+
+/** Writes the output vector of a state. */
+typedef void (*FSM_Output)(uint32_t outputs);
+
+/**
+ * @brief Constant description of a machine, meant to be placed in flash.
+ */
+typedef struct {
+    const FSM_State* states;                 /*!< States, indexed by number. */
+    const FSM_Transition* transitions;       /*!< Event transitions, searched in order. */
+    uint8_t numTransitions;                  /*!< Entries of `transitions`. */
+    FSM_Output output;                       /*!< Output function. */
+} FSM_Table;
+
+/**
+ * @brief State machine. Its fields are private to the module.
+ */
+typedef struct {
+    const FSM_Table* table;      /*!< Description of the machine. */
+    SWTIMER_Type timer;          /*!< Duration of the current state. */
+    volatile uint8_t state;      /*!< Current state. */
+    uint8_t timed;               /*!< 1 if the current state ends on a timeout. */
+} FSM_Type;
+
+/**
+ * @brief Initializes a machine and enters its first state.
+ *
+ * The software timers must already have a tick source (SWTIMER_Tick() or a tickless driver).
+ *
+ * @param machine Machine to initialize.
+ * @param table   Description of the machine, must stay valid while the machine runs.
+ * @param state   First state.
+ */
+void FSM_Init(FSM_Type* machine, const FSM_Table* table, uint8_t state);
+
+/**
+ * @brief Feeds an event to a machine.
+ *
+ * @param machine Machine.
+ * @param event   Event.
+ * @return 1 if a transition was taken, 0 if the event is ignored in the current state.
+ */
+uint8_t FSM_Event(FSM_Type* machine, uint8_t event);
+
+/**
+ * @brief Returns the current state of a machine.
+ *
+ * @param machine Machine.
+ */
+uint8_t FSM_GetState(const FSM_Type* machine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // FSM_H
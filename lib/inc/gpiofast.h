@@ -0,0 +1,95 @@
+/**
+ * @file gpiofast.h
+ * @brief Inline fast path of the data functions of the CMSIS GPIO driver.
+ *
+ * GPIO_SetDir(), GPIO_SetPins(), GPIO_ClearPins(), GPIO_WriteValue() and GPIO_ReadValue() (and
+ * the former names GPIO_SetValue() and GPIO_ClearValue()) are out-of-line functions of
+ * lpc17xx_gpio.c that look up and check the port on every call. This header gives them inline
+ * versions, GPIO_SetPinsFast() and so on, whose register block is computed from the port: with a
+ * constant port they compile to the register access alone, without the call and the port check.
+ *
+ * Defining GPIO_FAST_PATH (in the project settings or with -D) makes the usual names use them,
+ * so a file that includes this header switches without changing its calls. The driver source
+ * does not include it and keeps the out-of-line functions, for code that takes their address.
+ * With DEBUG defined the inline versions keep the port check of the driver.
+ *
+ * Header only: it wraps lpc17xx_gpio.h, the NXP driver on the board or its host build in the
+ * simulator, and needs no source file.
+ */
+
+#ifndef GPIOFAST_H
+#define GPIOFAST_H
+
+#include "LPC17xx.h"
+#include "lpc17xx_gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Inline versions are always inlined and are not reported to the profile of `make bench`. */
+#define GPIO_INLINE static inline __attribute__((always_inline, no_instrument_function))
+
+/** Register block of a port, a constant when the port is one. */
+#define GPIO_PORT_REGS(portNum) \
+    ((LPC_GPIO_TypeDef*)(LPC_GPIO0_BASE + (uint32_t)(portNum) * (LPC_GPIO1_BASE - LPC_GPIO0_BASE)))
+
+/** Port check of the inline versions: only in DEBUG builds, like CHECK_PARAM() in the NXP drivers. */
+#ifdef DEBUG
+#define GPIO_PORT_OK(portNum) ((portNum) <= GPIO_PORT_4)
+#else
+#define GPIO_PORT_OK(portNum) (1)
+#endif
+
+/** Inline version of GPIO_SetDir(). */
+GPIO_INLINE void GPIO_SetDirFast(uint8_t portNum, uint32_t bitValue, uint8_t dir) {
+    if (!GPIO_PORT_OK(portNum))
+        return;
+    if (dir == GPIO_OUTPUT)
+        GPIO_PORT_REGS(portNum)->FIODIR |= bitValue;
+    else
+        GPIO_PORT_REGS(portNum)->FIODIR &= ~bitValue;
+}
+
+/** Inline version of GPIO_SetPins(). */
+GPIO_INLINE void GPIO_SetPinsFast(uint8_t portNum, uint32_t bitValue) {
+    if (GPIO_PORT_OK(portNum))
+        GPIO_PORT_REGS(portNum)->FIOSET = bitValue;
+}
+
+/** Inline version of GPIO_ClearPins(). */
+GPIO_INLINE void GPIO_ClearPinsFast(uint8_t portNum, uint32_t bitValue) {
+    if (GPIO_PORT_OK(portNum))
+        GPIO_PORT_REGS(portNum)->FIOCLR = bitValue;
+}
+
+/** Inline version of GPIO_WriteValue(). */
+GPIO_INLINE void GPIO_WriteValueFast(uint8_t portNum, uint32_t value) {
+    if (GPIO_PORT_OK(portNum))
+        GPIO_PORT_REGS(portNum)->FIOPIN = value;
+}
+
+/** Inline version of GPIO_ReadValue(). */
+GPIO_INLINE uint32_t GPIO_ReadValueFast(uint8_t portNum) {
+    return GPIO_PORT_OK(portNum) ? (uint32_t)GPIO_PORT_REGS(portNum)->FIOPIN : 0;
+}
+
+/*
+ * The driver prototypes are already declared above, so the redirection only changes the calls
+ * of the file that includes this header.
+ */
+#ifdef GPIO_FAST_PATH
+#define GPIO_SetDir(portNum, bitValue, dir) GPIO_SetDirFast(portNum, bitValue, dir)
+#define GPIO_SetPins(portNum, bitValue)     GPIO_SetPinsFast(portNum, bitValue)
+#define GPIO_ClearPins(portNum, bitValue)   GPIO_ClearPinsFast(portNum, bitValue)
+#define GPIO_SetValue(portNum, bitValue)    GPIO_SetPinsFast(portNum, bitValue)
+#define GPIO_ClearValue(portNum, bitValue)  GPIO_ClearPinsFast(portNum, bitValue)
+#define GPIO_WriteValue(portNum, value)     GPIO_WriteValueFast(portNum, value)
+#define GPIO_ReadValue(portNum)             GPIO_ReadValueFast(portNum)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // GPIOFAST_H
@@ -0,0 +1,262 @@
+/**
+ * @file gpiohal.hpp
+ * @brief C++17 GPIO/PINSEL layer whose pins, masks and PINSEL fields are types.
+ *
+ * The CMSIS drivers take the port, pins and function as run-time arguments: every call checks
+ * them and builds its masks (GPIO_SetPins(), PINSEL_ConfigPin()). Here a pin is a type,
+ * `Pin<0, 22>`, and a set of pins on one port is a mask, `PortPins<2, 0x7F>` or
+ * `PinRange<2, 0, 7>`. Every mask, PINSEL/PINMODE field and register address is a constant
+ * of the type, and every function is forced inline, so
+ *
+ *     using Red = hal::Pin<0, 22>;
+ *     Red::select();    // LPC_PINCON->PINSEL1 &= ~(0x3 << 12);
+ *     Red::output();    // LPC_GPIO0->FIODIR |= 1 << 22;
+ *     Red::set();       // LPC_GPIO0->FIOSET = 1 << 22;
+ *
+ * compiles to the statements in the comments and nothing else. `PinGroup<Red, Green, Blue>`
+ * merges pins of several ports: configuring it touches each PINSEL, PINMODE or FIODIR register
+ * holding one of its pins once, in register order, like PINMAP_Apply(). A register fully
+ * covered by the pins is written without being read; the others take one read-modify-write.
+ * `Port<N>` gives the whole-port accesses used for data (FIOPIN, FIOSET and FIOCLR with a value
+ * only known at run time), and `PortPins<P, Mask>::write()` drives a group of pins of one port
+ * in a single store.
+ *
+ * PINSEL10 (trace port) is not handled. Header only, C++ only: include it from a .cpp file.
+ */
+
+#ifndef GPIOHAL_HPP
+#define GPIOHAL_HPP
+
+#include "LPC17xx.h"
+
+/** Forced inline: the layer must never cost a call, whatever the optimization level. */
+#define GPIOHAL_INLINE __attribute__((always_inline, no_instrument_function)) inline
+
+namespace hal {
+
+/**
+ * @brief Pin functions (PINSEL).
+ */
+enum class Func : uint32_t {
+    Gpio = 0,    /*!< GPIO. */
+    Alt1,        /*!< First alternate function. */
+    Alt2,        /*!< Second alternate function. */
+    Alt3         /*!< Third alternate function. */
+};
+
+/**
+ * @brief Resistor modes (PINMODE).
+ */
+enum class Mode : uint32_t {
+    PullUp = 0,    /*!< Pull-up resistor. */
+    Repeater,      /*!< Repeater mode. */
+    None,          /*!< Neither pull-up nor pull-down. */
+    PullDown       /*!< Pull-down resistor. */
+};
+
+namespace detail {
+
+/** Number of PINSEL/PINMODE registers handled: two per port, 16 pins each. */
+constexpr unsigned HALVES = 10;
+
+/** 2-bit fields of PINSEL/PINMODE register `half` of the pins `mask` of port `port`. */
+constexpr uint32_t fields(unsigned half, unsigned port, uint32_t mask) {
+    uint32_t out = 0;
+
+    if (half / 2 != port)
+        return 0;
+    mask = half % 2 ? mask >> 16 : mask & 0xFFFF;
+    for (unsigned i = 0; i < 16; i++)
+        if (mask & (1UL << i))
+            out |= 0x3UL << (2 * i);
+    return out;
+}
+
+/**
+ * @brief Writes the bits `Mask` of a register to `Value`, in the fewest accesses.
+ *
+ * Nothing for an empty mask, a plain write for a full one, a read-modify-write otherwise.
+ */
+template <uint32_t Mask, uint32_t Value, typename Reg>
+GPIOHAL_INLINE void write(Reg& reg) {
+    if constexpr (Mask == 0xFFFFFFFF)
+        reg = Value;
+    else if constexpr (Mask != 0 && Value == 0)
+        reg &= ~Mask;
+    else if constexpr (Mask != 0 && Value == Mask)
+        reg |= Mask;
+    else if constexpr (Mask != 0)
+        reg = (reg & ~Mask) | Value;
+}
+
+/** Lane of `bits` pins (8 or 16) filled exactly by the pins `mask`, or -1. */
+constexpr int lane(uint32_t mask, unsigned bits) {
+    for (unsigned i = 0; i < 32 / bits; i++)
+        if (mask == static_cast<uint32_t>(((1ULL << bits) - 1) << (i * bits)))
+            return static_cast<int>(i);
+    return -1;
+}
+
+}    // namespace detail
+
+/**
+ * @brief Whole-port accesses of GPIO port `N`.
+ */
+template <unsigned N>
+struct Port {
+    static_assert(N <= 4, "The LPC1769 has GPIO ports 0 to 4.");
+
+    /** Registers of the port. */
+    GPIOHAL_INLINE static LPC_GPIO_TypeDef* regs() {
+        return reinterpret_cast<LPC_GPIO_TypeDef*>(LPC_GPIO0_BASE + N * (LPC_GPIO1_BASE - LPC_GPIO0_BASE));
+    }
+
+    /** Drives the pins of `mask` high (FIOSET). */
+    GPIOHAL_INLINE static void set(uint32_t mask) { regs()->FIOSET = mask; }
+    /** Drives the pins of `mask` low (FIOCLR). */
+    GPIOHAL_INLINE static void clear(uint32_t mask) { regs()->FIOCLR = mask; }
+    /** Reads the unmasked pins (FIOPIN). */
+    GPIOHAL_INLINE static uint32_t read() { return regs()->FIOPIN; }
+    /** Writes the unmasked pins (FIOPIN). */
+    GPIOHAL_INLINE static void write(uint32_t value) { regs()->FIOPIN = value; }
+};
+
+/**
+ * @brief Pins of several ports, given as Pin, PortPins or PinRange types.
+ *
+ * Each function touches the registers of the ports and PINSEL/PINMODE halves holding pins of
+ * the group, in register order. Pins must not be listed twice.
+ */
+template <typename... Pins>
+struct PinGroup {
+    /** Pins of the group on port `P`. */
+    template <unsigned P>
+    static constexpr uint32_t mask() {
+        return (0u | ... | (Pins::PORT == P ? Pins::MASK : 0u));
+    }
+
+    /** 2-bit fields of the group in PINSEL/PINMODE register `half`. */
+    template <unsigned H>
+    static constexpr uint32_t fields() {
+        return (0u | ... | detail::fields(H, Pins::PORT, Pins::MASK));
+    }
+
+    /** Selects function `F` for every pin (PINSEL). */
+    template <Func F = Func::Gpio, unsigned H = 0>
+    GPIOHAL_INLINE static void select() {
+        if constexpr (H < detail::HALVES) {
+            detail::write<fields<H>(), fields<H>() & (0x55555555u * static_cast<uint32_t>(F))>(
+                (&LPC_PINCON->PINSEL0)[H]);
+            select<F, H + 1>();
+        }
+    }
+
+    /** Selects resistor mode `M` for every pin (PINMODE). */
+    template <Mode M = Mode::PullUp, unsigned H = 0>
+    GPIOHAL_INLINE static void pull() {
+        if constexpr (H < detail::HALVES) {
+            detail::write<fields<H>(), fields<H>() & (0x55555555u * static_cast<uint32_t>(M))>(
+                (&LPC_PINCON->PINMODE0)[H]);
+            pull<M, H + 1>();
+        }
+    }
+
+    /** Makes every pin an output (FIODIR). */
+    template <unsigned P = 0>
+    GPIOHAL_INLINE static void output() {
+        if constexpr (P <= 4) {
+            detail::write<mask<P>(), mask<P>()>(Port<P>::regs()->FIODIR);
+            output<P + 1>();
+        }
+    }
+
+    /** Makes every pin an input (FIODIR). */
+    template <unsigned P = 0>
+    GPIOHAL_INLINE static void input() {
+        if constexpr (P <= 4) {
+            detail::write<mask<P>(), 0>(Port<P>::regs()->FIODIR);
+            input<P + 1>();
+        }
+    }
+
+    /** Drives every pin high (FIOSET). */
+    template <unsigned P = 0>
+    GPIOHAL_INLINE static void set() {
+        if constexpr (P <= 4) {
+            constexpr uint32_t pins = mask<P>();    // A constant even at -O0.
+
+            if constexpr (pins != 0)
+                Port<P>::set(pins);
+            set<P + 1>();
+        }
+    }
+
+    /** Drives every pin low (FIOCLR). */
+    template <unsigned P = 0>
+    GPIOHAL_INLINE static void clear() {
+        if constexpr (P <= 4) {
+            constexpr uint32_t pins = mask<P>();    // A constant even at -O0.
+
+            if constexpr (pins != 0)
+                Port<P>::clear(pins);
+            clear<P + 1>();
+        }
+    }
+};
+
+/**
+ * @brief Pins `Mask` of GPIO port `P`.
+ */
+template <unsigned P, uint32_t Mask>
+struct PortPins : PinGroup<PortPins<P, Mask>> {
+    static_assert(P <= 4, "The LPC1769 has GPIO ports 0 to 4.");
+
+    /** Port of the pins. */
+    static constexpr unsigned PORT = P;
+    /** Pins on the port. */
+    static constexpr uint32_t MASK = Mask;
+
+    /** Reads the pins, the others read as 0 (FIOPIN). */
+    GPIOHAL_INLINE static uint32_t read() { return Port<P>::read() & Mask; }
+
+    /** Leaves only these pins to FIOPIN reads and writes of the port (FIOMASK). */
+    GPIOHAL_INLINE static void exclusive() { Port<P>::regs()->FIOMASK = ~Mask; }
+
+    /**
+     * @brief Drives the pins to `value` (in their port positions) in one store, the other pins
+     *        of the port untouched: the byte or halfword lane the pins fill (FIOPINn, FIOPINL/H),
+     *        else FIOPIN between a save and a restore of FIOMASK (see portfield.h).
+     */
+    GPIOHAL_INLINE static void write(uint32_t value) {
+        constexpr int byte = detail::lane(Mask, 8);
+        constexpr int half = detail::lane(Mask, 16);
+
+        if constexpr (byte >= 0) {
+            (&Port<P>::regs()->FIOPIN0)[byte] = static_cast<uint8_t>(value >> (8 * byte));
+        } else if constexpr (half >= 0) {
+            (&Port<P>::regs()->FIOPINL)[half] = static_cast<uint16_t>(value >> (16 * half));
+        } else if constexpr (Mask == 0xFFFFFFFF) {
+            Port<P>::write(value);
+        } else {
+            const uint32_t saved = Port<P>::regs()->FIOMASK;
+
+            Port<P>::regs()->FIOMASK = ~Mask;
+            Port<P>::write(value);
+            Port<P>::regs()->FIOMASK = saved;
+        }
+    }
+};
+
+/** Pin `N` of GPIO port `P`. */
+template <unsigned P, unsigned N>
+struct Pin : PortPins<P, 1UL << N> {
+    static_assert(N < 32, "Pin numbers go from 0 to 31.");
+};
+
+/** `Count` consecutive pins of GPIO port `P`, from pin `First`. */
+template <unsigned P, unsigned First, unsigned Count>
+using PinRange = PortPins<P, static_cast<uint32_t>(((1ULL << Count) - 1) << First)>;
+
+}    // namespace hal
+
+#endif    // GPIOHAL_HPP
@@ -0,0 +1,70 @@
+/**
+ * @file gpioirq.h
+ * @brief Dispatcher of the GPIO interrupts of ports 0 and 2, which all share EINT3_IRQHandler().
+ *
+ * Every GPIO interrupt source reaches the same vector, so a handler written for one pin reads
+ * the wrong flags, or clears flags it did not serve, as soon as a second pin is enabled. Here
+ * each pin and edge gets its own callback in a registration table, and the module owns
+ * EINT3_IRQHandler():
+ *
+ * - IntStatus is read once, and only the ports it flags are read further: their rising and
+ *   falling edge status, then one clear of every flag read, before any callback runs (an edge
+ *   during a callback interrupts again).
+ * - Only the set bits are visited, lowest pin first, with RBIT and CLZ (two instructions each on
+ *   the Cortex-M3): the dispatch cost grows with the edges pending, not with the 64 pins.
+ *
+ * Flags of edges enabled without a callback are cleared and ignored. The EINT3 pin (P2.13 as
+ * EINT3) shares the vector too and is not served: it cannot be used with this module.
+ */
+
+#ifndef GPIOIRQ_H
+#define GPIOIRQ_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Callback of a pin and edge. Runs in EINT3_IRQHandler(). */
+typedef void (*GPIOIRQ_Callback)(void* arg);
+
+/**
+ * @brief Interrupting edges.
+ */
+typedef enum {
+    GPIOIRQ_RISING = 0,    /*!< Rising edge (IOxIntEnR). */
+    GPIOIRQ_FALLING        /*!< Falling edge (IOxIntEnF). */
+} GPIOIRQ_Edge;
+
+/**
+ * @brief Registers the callback of a pin and edge and enables its interrupt.
+ *
+ * The pending flags of the pin are cleared first (IOxIntClr clears both edges), unless its other
+ * edge already has a callback: a pending edge of that callback is kept, and the edge attached
+ * now, disabled until then, has no flag. EINT3 is enabled in the NVIC with the priority it
+ * already has. Registering a callback again replaces it.
+ *
+ * @param port     GPIO port, 0 or 2.
+ * @param pin      Pin number, 0 to 31.
+ * @param edge     Edge that calls the callback.
+ * @param callback Function to call.
+ * @param arg      Argument passed to the callback.
+ * @return 0 on success, 1 if the port has no GPIO interrupts or the pin or edge is out of range.
+ */
+uint32_t GPIOIRQ_Attach(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge, GPIOIRQ_Callback callback, void* arg);
+
+/**
+ * @brief Disables the interrupt of a pin and edge and removes its callback.
+ *
+ * @param port GPIO port, 0 or 2.
+ * @param pin  Pin number, 0 to 31.
+ * @param edge Edge to disable.
+ */
+void GPIOIRQ_Detach(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // GPIOIRQ_H
@@ -0,0 +1,82 @@
+/**
+ * @file pingroup.h
+ * @brief Pin groups: logical outputs spread over several GPIO ports, written with precomputed masks.
+ *
+ * A pin group is a set of outputs driven as one value, such as the channels of the onboard RGB
+ * LED (red on P0.22, green and blue on P3.25 and P3.26, all active low). Writing each output
+ * with its own branch and FIOSET or FIOCLR costs one write and one branch per output, and the
+ * outputs of a port change one after another.
+ *
+ * Instead, the set and clear masks of every port are computed at compile time for every value
+ * of the group, in a table built with PINGROUP_SET(), PINGROUP_CLR() and PINGROUP_TABLE8().
+ * Writing a value is then one FIOSET and one FIOCLR per port, with no branch, whatever the
+ * number of outputs, and the outputs of a port that turn on change together.
+ *
+ * Header only: the tables live in the exercise that owns the pins.
+ */
+
+#ifndef PINGROUP_H
+#define PINGROUP_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Output on at logic 1. */
+#define PINGROUP_ACTIVE_HIGH (0)
+/** Output on at logic 0 (e.g. LEDs wired to the supply). */
+#define PINGROUP_ACTIVE_LOW  (1)
+
+/**
+ * @brief Pins of `mask` to set when output `bit` of the group holds its state in `value`.
+ *
+ * @param value     Group value, one bit per output (1 = on).
+ * @param bit       Output of the group.
+ * @param mask      Port pins of the output.
+ * @param activeLow PINGROUP_ACTIVE_HIGH or PINGROUP_ACTIVE_LOW.
+ */
+#define PINGROUP_SET(value, bit, mask, activeLow) (((((value) >> (bit)) & 0x1) != (activeLow)) ? (mask) : 0)
+
+/**
+ * @brief Pins of `mask` to clear for output `bit` of `value` (see PINGROUP_SET()).
+ */
+#define PINGROUP_CLR(value, bit, mask, activeLow) (((((value) >> (bit)) & 0x1) == (activeLow)) ? (mask) : 0)
+
+/**
+ * @brief Initializer of a table with the masks of every value of a 3-output group.
+ *
+ * `ENTRY(value)` must expand to the initializer of the masks of one value, one
+ * PINGROUP_Masks per port.
+ */
+#define PINGROUP_TABLE8(ENTRY) \
+    {ENTRY(0), ENTRY(1), ENTRY(2), ENTRY(3), ENTRY(4), ENTRY(5), ENTRY(6), ENTRY(7)}
+
+/**
+ * @brief Writes of one port for one value of a group.
+ */
+typedef struct {
+    uint32_t set;    /*!< Pins driven high (FIOSET). */
+    uint32_t clr;    /*!< Pins driven low (FIOCLR). */
+} PINGROUP_Masks;
+
+/**
+ * @brief Writes the precomputed masks of one port: one FIOSET and one FIOCLR, no branch.
+ *
+ * Writing 0 to FIOSET or FIOCLR leaves the port unchanged, so every value takes the same two
+ * writes.
+ *
+ * @param port  GPIO port.
+ * @param masks Masks of the port for the value to write.
+ */
+static inline void PINGROUP_Write(LPC_GPIO_TypeDef* port, const PINGROUP_Masks* masks) {
+    port->FIOSET = masks->set;
+    port->FIOCLR = masks->clr;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // PINGROUP_H
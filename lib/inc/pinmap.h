@@ -0,0 +1,152 @@
+/**
+ * @file pinmap.h
+ * @brief Declarative pin maps, resolved at compile time into whole-register writes.
+ *
+ * Configuring pins one at a time (PINSEL_ConfigPin(), or one `&=`/`|=` pair per pin group)
+ * reads and writes the same PINSELn, PINMODEn and FIODIR registers again for every pin. A pin
+ * map instead lists every pin of the board once:
+ *
+ *     #define BOARD_PINS(PIN, reg)                                                   \
+ *         PIN(reg, 2, 10, PINMAP_FUNC1, PINMAP_PULLUP, PINMAP_KEEP, PINMAP_INPUT)      \
+ *         PIN(reg, 0, 22, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)
+ *
+ * PINMAP_Apply(BOARD_PINS) then writes each PINSEL, PINMODE, PINMODE_OD and FIODIR register
+ * holding a pin of the map exactly once. The mask and value of every register are constant
+ * expressions: registers without pins of the map compile to nothing, a register fully covered
+ * by the map is written without being read, and the others take one read-modify-write.
+ *
+ * Each pin must be listed once. PINSEL10 (trace port) is not handled.
+ *
+ * Header only: the map lives in the exercise that owns the pins.
+ */
+
+#ifndef PINMAP_H
+#define PINMAP_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pin functions (PINSEL). */
+#define PINMAP_FUNC0     (0)    /*!< GPIO. */
+#define PINMAP_FUNC1     (1)    /*!< First alternate function. */
+#define PINMAP_FUNC2     (2)    /*!< Second alternate function. */
+#define PINMAP_FUNC3     (3)    /*!< Third alternate function. */
+
+/** Resistor modes (PINMODE). */
+#define PINMAP_PULLUP    (0)    /*!< Pull-up resistor. */
+#define PINMAP_REPEATER  (1)    /*!< Repeater mode. */
+#define PINMAP_TRISTATE  (2)    /*!< Neither pull-up nor pull-down. */
+#define PINMAP_PULLDOWN  (3)    /*!< Pull-down resistor. */
+
+/** Open-drain modes (PINMODE_OD). */
+#define PINMAP_NORMAL    (0)    /*!< Push-pull output. */
+#define PINMAP_OPENDRAIN (1)    /*!< Open-drain output. */
+
+/** Directions (FIODIR). */
+#define PINMAP_INPUT     (0)    /*!< Input. */
+#define PINMAP_OUTPUT    (1)    /*!< Output. */
+
+/** Leaves the field (function, mode, open-drain or direction) of the pin as it is. */
+#define PINMAP_KEEP      (0x80)
+
+/** Index of the PINSEL/PINMODE register of a pin: two per port, 16 pins each. */
+#define PINMAP_HALF(port, pin)  (2 * (port) + (pin) / 16)
+/** Position of the 2-bit field of a pin in its PINSEL/PINMODE register. */
+#define PINMAP_SHIFT(pin)       (2 * ((pin) % 16))
+
+/** Mask and value of a 2-bit field, if `field` is set and the pin sits in register `reg`. */
+#define PINMAP_FIELD2_MASK(reg, port, pin, field) \
+    | (((field) != PINMAP_KEEP && PINMAP_HALF(port, pin) == (reg)) ? 0x3u << PINMAP_SHIFT(pin) : 0u)
+#define PINMAP_FIELD2_VALUE(reg, port, pin, field) \
+    | (((field) != PINMAP_KEEP && PINMAP_HALF(port, pin) == (reg)) ? (uint32_t)(field) << PINMAP_SHIFT(pin) : 0u)
+/** Mask and value of a 1-bit field, if `field` is set and the pin belongs to port `reg`. */
+#define PINMAP_FIELD1_MASK(reg, port, pin, field) \
+    | (((field) != PINMAP_KEEP && (port) == (reg)) ? 0x1u << (pin) : 0u)
+#define PINMAP_FIELD1_VALUE(reg, port, pin, field) \
+    | (((field) != PINMAP_KEEP && (port) == (reg)) ? (uint32_t)(field) << (pin) : 0u)
+
+/** Terms of one pin, OR-ed together over the map. */
+#define PINMAP_SEL_MASK_(reg, port, pin, func, mode, od, dir)    PINMAP_FIELD2_MASK(reg, port, pin, func)
+#define PINMAP_SEL_VALUE_(reg, port, pin, func, mode, od, dir)   PINMAP_FIELD2_VALUE(reg, port, pin, func)
+#define PINMAP_MODE_MASK_(reg, port, pin, func, mode, od, dir)   PINMAP_FIELD2_MASK(reg, port, pin, mode)
+#define PINMAP_MODE_VALUE_(reg, port, pin, func, mode, od, dir)  PINMAP_FIELD2_VALUE(reg, port, pin, mode)
+#define PINMAP_OD_MASK_(reg, port, pin, func, mode, od, dir)     PINMAP_FIELD1_MASK(reg, port, pin, od)
+#define PINMAP_OD_VALUE_(reg, port, pin, func, mode, od, dir)    PINMAP_FIELD1_VALUE(reg, port, pin, od)
+#define PINMAP_DIR_MASK_(reg, port, pin, func, mode, od, dir)    PINMAP_FIELD1_MASK(reg, port, pin, dir)
+#define PINMAP_DIR_VALUE_(reg, port, pin, func, mode, od, dir)   PINMAP_FIELD1_VALUE(reg, port, pin, dir)
+
+/**
+ * @brief Bits of PINSELn (`n` = `reg`) set by the map, and their value.
+ *
+ * The PINMODE, PINMODE_OD (`reg` = port) and FIODIR (`reg` = port) variants follow the same
+ * pattern. All are constant expressions.
+ */
+#define PINMAP_SEL_MASK(MAP, reg)   (0u MAP(PINMAP_SEL_MASK_, reg))
+#define PINMAP_SEL_VALUE(MAP, reg)  (0u MAP(PINMAP_SEL_VALUE_, reg))
+#define PINMAP_MODE_MASK(MAP, reg)  (0u MAP(PINMAP_MODE_MASK_, reg))
+#define PINMAP_MODE_VALUE(MAP, reg) (0u MAP(PINMAP_MODE_VALUE_, reg))
+#define PINMAP_OD_MASK(MAP, reg)    (0u MAP(PINMAP_OD_MASK_, reg))
+#define PINMAP_OD_VALUE(MAP, reg)   (0u MAP(PINMAP_OD_VALUE_, reg))
+#define PINMAP_DIR_MASK(MAP, reg)   (0u MAP(PINMAP_DIR_MASK_, reg))
+#define PINMAP_DIR_VALUE(MAP, reg)  (0u MAP(PINMAP_DIR_VALUE_, reg))
+
+/**
+ * @brief Writes the bits of `mask` of a register to `value`, in the fewest accesses.
+ *
+ * `mask` and `value` are constants, so only one branch is compiled: nothing for an empty mask,
+ * a plain write for a full one, a read-modify-write otherwise.
+ */
+#define PINMAP_WRITE(reg, mask, value)                \
+    do {                                              \
+        if ((mask) == 0xFFFFFFFFu)                    \
+            (reg) = (value);                          \
+        else if ((mask) != 0u)                        \
+            (reg) = ((reg) & ~(mask)) | (value);      \
+    } while (0)
+
+/** Writes PINSELn and PINMODEn of the map. */
+#define PINMAP_APPLY_HALF(MAP, n)                                                                       \
+    PINMAP_WRITE(LPC_PINCON->PINSEL##n, PINMAP_SEL_MASK(MAP, n), PINMAP_SEL_VALUE(MAP, n));            \
+    PINMAP_WRITE(LPC_PINCON->PINMODE##n, PINMAP_MODE_MASK(MAP, n), PINMAP_MODE_VALUE(MAP, n))
+
+/** Writes PINMODE_ODn and the FIODIR of port `n` of the map. */
+#define PINMAP_APPLY_PORT(MAP, n)                                                                       \
+    PINMAP_WRITE(LPC_PINCON->PINMODE_OD##n, PINMAP_OD_MASK(MAP, n), PINMAP_OD_VALUE(MAP, n));          \
+    PINMAP_WRITE(LPC_GPIO##n->FIODIR, PINMAP_DIR_MASK(MAP, n), PINMAP_DIR_VALUE(MAP, n))
+
+/**
+ * @brief Configures every pin of a map: function, resistor mode, open-drain mode and direction.
+ *
+ * Each register is written at most once. Functions and modes are set before the directions,
+ * so an output is never driven while its pin still has another function.
+ *
+ * @param MAP Pin map: a macro `MAP(PIN, reg)` expanding to one
+ *            `PIN(reg, port, pin, func, mode, od, dir)` per pin.
+ */
+#define PINMAP_Apply(MAP)                                                                               \
+    do {                                                                                                \
+        PINMAP_APPLY_HALF(MAP, 0);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 1);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 2);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 3);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 4);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 5);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 6);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 7);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 8);                                                                      \
+        PINMAP_APPLY_HALF(MAP, 9);                                                                      \
+        PINMAP_APPLY_PORT(MAP, 0);                                                                      \
+        PINMAP_APPLY_PORT(MAP, 1);                                                                      \
+        PINMAP_APPLY_PORT(MAP, 2);                                                                      \
+        PINMAP_APPLY_PORT(MAP, 3);                                                                      \
+        PINMAP_APPLY_PORT(MAP, 4);                                                                      \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // PINMAP_H
@@ -0,0 +1,54 @@
+/**
+ * @file pinselspread.h
+ * @brief PINSEL_ConfigMultiplePins() without the per-pin loop: the pin mask spread to whole registers.
+ *
+ * The NXP PINSEL_ConfigMultiplePins() walks the 32 bits of its mask and configures every pin set
+ * on its own: two read-modify-writes of PINSELn, two of PINMODEn and one of PINMODE_ODn per pin,
+ * after a loop over all 32 bits.
+ *
+ * PINSEL_ConfigMultiplePinsSpread() takes the same arguments and leaves the same registers. It
+ * spreads each 16-bit half of the mask into the 2-bit-per-pin field layout of PINSEL/PINMODE
+ * with a branch-free Morton interleave and applies each register with a single
+ * read-modify-write: 6 accesses when the pins sit in one half of the port, 10 when they span
+ * both, whatever their number (see benchmarks/04_pinsel_spread).
+ *
+ * Written against the PINSEL_CFG_Type of lpc17xx_pinsel.h, so it is used next to the driver.
+ */
+
+#ifndef PINSELSPREAD_H
+#define PINSELSPREAD_H
+
+#include "LPC17xx.h"
+#include "lpc17xx_pinsel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Spreads the 16 low bits of a pin mask to the 2-bit fields of a PINSEL/PINMODE register.
+ *
+ * Bit n goes to bits 2n and 2n+1, with no loop and no branch: each step moves the upper half
+ * of every group of bits to the next group (Morton interleave with zeros), then the spread
+ * bits are doubled.
+ *
+ * @param pins Pin mask, one bit per pin of a register.
+ * @return Field mask, 0x3 for every pin.
+ */
+uint32_t PINSEL_SpreadPins(uint32_t pins);
+
+/**
+ * @brief Applies the same configuration to several pins of a port, one write per register.
+ *
+ * Same result as PINSEL_ConfigMultiplePins() of the driver.
+ *
+ * @param pinCfg Pin configuration; `pinNum` is ignored.
+ * @param pins   Pins of `pinCfg->portNum` to configure.
+ */
+void PINSEL_ConfigMultiplePinsSpread(const PINSEL_CFG_Type* pinCfg, uint32_t pins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // PINSELSPREAD_H
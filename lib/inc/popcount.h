@@ -0,0 +1,85 @@
+/**
+ * @file popcount.h
+ * @brief Population count (number of bits set) with compile-time selectable algorithms.
+ *
+ * Every variant is available under its own name for benchmarking; POPCOUNT_Count() uses the
+ * one selected with POPCOUNT_METHOD. Cortex-M3 cost (llvm-mca model plus 2 cycles per taken
+ * branch, call excluded), k being the number of bits set:
+ *
+ * | Method                       | Cycles    | Table     |
+ * |------------------------------|-----------|-----------|
+ * | POPCOUNT_METHOD_LOOP         | 256       | -         |
+ * | POPCOUNT_METHOD_NIBBLE_LUT   | 41        | 16 bytes  |
+ * | POPCOUNT_METHOD_BYTE_LUT     | 13 (+)    | 256 bytes |
+ * | POPCOUNT_METHOD_SWAR         | 12        | -         |
+ * | POPCOUNT_METHOD_SPARSE       | 1 + 7 * k | -         |
+ *
+ * (+) Table reads that miss the flash accelerator add the flash wait states.
+ *
+ * SWAR is the default: it is the fastest for any value with more than one bit set, takes
+ * constant time and needs no table in flash.
+ */
+
+#ifndef POPCOUNT_H
+#define POPCOUNT_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bit by bit loop with a branch per bit. */
+#define POPCOUNT_METHOD_LOOP       (0)
+/** 16-entry table, one lookup per nibble. */
+#define POPCOUNT_METHOD_NIBBLE_LUT (1)
+/** 256-entry table, one lookup per byte. */
+#define POPCOUNT_METHOD_BYTE_LUT   (2)
+/** SIMD within a register: parallel sums of 2, 4 and 8 bits, then one multiply. */
+#define POPCOUNT_METHOD_SWAR       (3)
+/** One iteration per bit set, each one found with CLZ. */
+#define POPCOUNT_METHOD_SPARSE     (4)
+
+#ifndef POPCOUNT_METHOD
+/** Algorithm used by POPCOUNT_Count(). */
+#define POPCOUNT_METHOD POPCOUNT_METHOD_SWAR
+#endif
+
+/**
+ * @brief Counts the bits set with the algorithm selected by POPCOUNT_METHOD.
+ *
+ * @param value Value to count.
+ * @return Number of bits set (0-32).
+ */
+uint32_t POPCOUNT_Count(uint32_t value);
+
+/**
+ * @brief Counts the bits set testing one bit per iteration.
+ */
+uint32_t POPCOUNT_Loop(uint32_t value);
+
+/**
+ * @brief Counts the bits set with a 16-entry nibble table.
+ */
+uint32_t POPCOUNT_NibbleLUT(uint32_t value);
+
+/**
+ * @brief Counts the bits set with a 256-entry byte table.
+ */
+uint32_t POPCOUNT_ByteLUT(uint32_t value);
+
+/**
+ * @brief Counts the bits set with parallel additions inside the register.
+ */
+uint32_t POPCOUNT_SWAR(uint32_t value);
+
+/**
+ * @brief Counts the bits set clearing the highest one, found with CLZ, on each iteration.
+ */
+uint32_t POPCOUNT_Sparse(uint32_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // POPCOUNT_H
@@ -0,0 +1,109 @@
+/**
+ * @file portfield.h
+ * @brief Port fields: multi-bit outputs of one GPIO port updated in a single store.
+ *
+ * A port field is a group of pins of one port driven as one value, such as the segments of a
+ * 7-segment display on P2.0-P2.6 or a bank of LEDs. Writing it as
+ *
+ *     LPC_GPIO2->FIOCLR = SVN_SGS_BITS;    // Every segment off...
+ *     LPC_GPIO2->FIOSET = glyph;           // ...then the new ones on.
+ *
+ * costs two writes and shows an all-off state between them, on every update. The LPC1769 offers
+ * two ways of changing the pins of a field, and only them, with one store:
+ *
+ * - FIOMASK: pins set in the mask are ignored by FIOPIN writes (and by FIOSET and FIOCLR). With
+ *   the other pins of the port masked, a FIOPIN write drives exactly the field.
+ * - Byte and halfword lanes: FIOPIN0 to FIOPIN3 and FIOPINL/FIOPINH write 8 or 16 pins and leave
+ *   the rest of the port alone, with no mask at all.
+ *
+ * Three ways of using them, by how the port is shared:
+ *
+ * - The field fills a byte or a halfword lane: PORTFIELD_WriteByte() or PORTFIELD_WriteHalf().
+ * - The field is the only output of its port: PORTFIELD_Own() once at start-up, then
+ *   PORTFIELD_Write() on every update. FIOMASK stays set, so FIOSET and FIOCLR of the other pins
+ *   of the port are ignored from then on.
+ * - The port has other outputs: PORTFIELD_WriteShared() saves FIOMASK, masks the other pins,
+ *   writes FIOPIN and restores the mask. An interrupt that preempts it sees the mask of the field
+ *   for up to two accesses: the interrupts that write the same port must use
+ *   PORTFIELD_WriteShared() too (it nests, as each call restores the mask it found), or the call
+ *   must run with the interrupts disabled.
+ *
+ * Header only.
+ */
+
+#ifndef PORTFIELD_H
+#define PORTFIELD_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writes byte lane `lane` of a port (pins 8 * lane to 8 * lane + 7): one FIOPINn store.
+ *
+ * @param port  GPIO port.
+ * @param lane  Byte lane, 0 to 3.
+ * @param value Levels of the 8 pins, pin 8 * lane in bit 0.
+ */
+static inline void PORTFIELD_WriteByte(LPC_GPIO_TypeDef* port, uint32_t lane, uint8_t value) {
+    (&port->FIOPIN0)[lane] = value;
+}
+
+/**
+ * @brief Writes halfword lane `half` of a port (pins 16 * half to 16 * half + 15): one
+ *        FIOPINL or FIOPINH store.
+ *
+ * @param port  GPIO port.
+ * @param half  0 for FIOPINL, 1 for FIOPINH.
+ * @param value Levels of the 16 pins, pin 16 * half in bit 0.
+ */
+static inline void PORTFIELD_WriteHalf(LPC_GPIO_TypeDef* port, uint32_t half, uint16_t value) {
+    (&port->FIOPINL)[half] = value;
+}
+
+/**
+ * @brief Gives FIOPIN of a port to the field `mask`: every other pin is masked (FIOMASK).
+ *
+ * @param port GPIO port.
+ * @param mask Pins of the field.
+ */
+static inline void PORTFIELD_Own(LPC_GPIO_TypeDef* port, uint32_t mask) {
+    port->FIOMASK = ~mask;
+}
+
+/**
+ * @brief Writes the field of a port given to it by PORTFIELD_Own(): one FIOPIN store.
+ *
+ * @param port  GPIO port.
+ * @param value Levels of the pins of the field, in their port positions.
+ */
+static inline void PORTFIELD_Write(LPC_GPIO_TypeDef* port, uint32_t value) {
+    port->FIOPIN = value;
+}
+
+/**
+ * @brief Writes the field `mask` of a port shared with other outputs: the pins of the field
+ *        change in one FIOPIN store, between a save and a restore of FIOMASK.
+ *
+ * One read and three writes. The interrupts writing the same port must use it too, or the call
+ * must run with the interrupts disabled (see the file description).
+ *
+ * @param port  GPIO port.
+ * @param mask  Pins of the field.
+ * @param value Levels of the pins of the field, in their port positions.
+ */
+static inline void PORTFIELD_WriteShared(LPC_GPIO_TypeDef* port, uint32_t mask, uint32_t value) {
+    const uint32_t saved = port->FIOMASK;
+
+    port->FIOMASK = ~mask;
+    port->FIOPIN  = value;
+    port->FIOMASK = saved;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // PORTFIELD_H
@@ -0,0 +1,133 @@
+/**
+ * @file sevenseg.h
+ * @brief Multiplexed 7-segment display engine refreshed by a TIMER1 interrupt, and glyph table.
+ *
+ * Segments a-g and dp of every digit share the 8 pins of one byte lane of a GPIO port (e.g.
+ * P2.0-P2.7) and each digit has its own enable pin. TIMER1 interrupts `scanHz` times per second
+ * for every digit; each interrupt turns the current digit off, writes the segments of the next
+ * one from the frame buffer and turns it on.
+ *
+ * Segments are written with a single byte store to FIOPINx, so they never pass through an
+ * intermediate pattern as with FIOCLR followed by FIOSET, and other pins of the port are not
+ * touched. Frame buffer entries are bytes too: updating a digit is one store, which the refresh
+ * interrupt can never see half done.
+ *
+ * The module owns TIMER1 and defines TIMER1_IRQHandler().
+ */
+
+#ifndef SEVENSEG_H
+#define SEVENSEG_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Segment a (top). */
+#define SEVENSEG_A  (0x01)
+/** Segment b (top right). */
+#define SEVENSEG_B  (0x02)
+/** Segment c (bottom right). */
+#define SEVENSEG_C  (0x04)
+/** Segment d (bottom). */
+#define SEVENSEG_D  (0x08)
+/** Segment e (bottom left). */
+#define SEVENSEG_E  (0x10)
+/** Segment f (top left). */
+#define SEVENSEG_F  (0x20)
+/** Segment g (middle). */
+#define SEVENSEG_G  (0x40)
+/** Decimal point. */
+#define SEVENSEG_DP (0x80)
+
+/** Glyph of each hexadecimal digit, built from its segments. */
+#define SEVENSEG_GLYPH_0 (SEVENSEG_A | SEVENSEG_B | SEVENSEG_C | SEVENSEG_D | SEVENSEG_E | SEVENSEG_F)
+#define SEVENSEG_GLYPH_1 (SEVENSEG_B | SEVENSEG_C)
+#define SEVENSEG_GLYPH_2 (SEVENSEG_A | SEVENSEG_B | SEVENSEG_D | SEVENSEG_E | SEVENSEG_G)
+#define SEVENSEG_GLYPH_3 (SEVENSEG_A | SEVENSEG_B | SEVENSEG_C | SEVENSEG_D | SEVENSEG_G)
+#define SEVENSEG_GLYPH_4 (SEVENSEG_B | SEVENSEG_C | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_5 (SEVENSEG_A | SEVENSEG_C | SEVENSEG_D | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_6 (SEVENSEG_A | SEVENSEG_C | SEVENSEG_D | SEVENSEG_E | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_7 (SEVENSEG_A | SEVENSEG_B | SEVENSEG_C)
+#define SEVENSEG_GLYPH_8 (SEVENSEG_GLYPH_0 | SEVENSEG_G)
+#define SEVENSEG_GLYPH_9 (SEVENSEG_A | SEVENSEG_B | SEVENSEG_C | SEVENSEG_D | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_A (SEVENSEG_A | SEVENSEG_B | SEVENSEG_C | SEVENSEG_E | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_B (SEVENSEG_C | SEVENSEG_D | SEVENSEG_E | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_C (SEVENSEG_A | SEVENSEG_D | SEVENSEG_E | SEVENSEG_F)
+#define SEVENSEG_GLYPH_D (SEVENSEG_B | SEVENSEG_C | SEVENSEG_D | SEVENSEG_E | SEVENSEG_G)
+#define SEVENSEG_GLYPH_E (SEVENSEG_A | SEVENSEG_D | SEVENSEG_E | SEVENSEG_F | SEVENSEG_G)
+#define SEVENSEG_GLYPH_F (SEVENSEG_A | SEVENSEG_E | SEVENSEG_F | SEVENSEG_G)
+
+/**
+ * @brief Initializer of a 16-entry table with the glyphs of 0-F, evaluated at compile time.
+ *
+ * Usage: `const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;`
+ */
+#define SEVENSEG_HEX_GLYPHS                                                                    \
+    {SEVENSEG_GLYPH_0, SEVENSEG_GLYPH_1, SEVENSEG_GLYPH_2, SEVENSEG_GLYPH_3, SEVENSEG_GLYPH_4, \
+     SEVENSEG_GLYPH_5, SEVENSEG_GLYPH_6, SEVENSEG_GLYPH_7, SEVENSEG_GLYPH_8, SEVENSEG_GLYPH_9, \
+     SEVENSEG_GLYPH_A, SEVENSEG_GLYPH_B, SEVENSEG_GLYPH_C, SEVENSEG_GLYPH_D, SEVENSEG_GLYPH_E, \
+     SEVENSEG_GLYPH_F}
+
+/** Maximum number of multiplexed digits. */
+#define SEVENSEG_MAX_DIGITS (8)
+
+/**
+ * @brief Display wiring and scan rate.
+ */
+typedef struct {
+    LPC_GPIO_TypeDef* segPort;    /*!< GPIO port of the segment lines. */
+    uint8_t segByte;              /*!< Byte lane of the segments (0: pins 0-7 ... 3: pins 24-31). */
+    uint8_t segActiveLow;         /*!< 1 if a segment lights with a low level (common anode). */
+    LPC_GPIO_TypeDef* digitPort;  /*!< GPIO port of the digit enable lines. */
+    uint8_t digitPin;             /*!< Enable pin of digit 0; digit k uses digitPin + k. */
+    uint8_t digitActiveLow;       /*!< 1 if a digit is enabled with a low level. */
+    uint8_t numDigits;            /*!< Number of digits, 1 to SEVENSEG_MAX_DIGITS. Digit 0 is the rightmost. */
+    uint16_t scanHz;              /*!< Refresh rate of the whole display in Hz. */
+} SEVENSEG_CFG_Type;
+
+/**
+ * @brief Configures the segment and digit pins as outputs, blanks the display and starts TIMER1.
+ *
+ * The pins must already be selected as GPIO (PINSEL). The refresh interrupt runs
+ * `scanHz * numDigits` times per second with the lowest priority.
+ *
+ * @param config Display configuration, copied by the module.
+ * @return 0 on success, 1 if the configuration is invalid.
+ */
+uint32_t SEVENSEG_Init(const SEVENSEG_CFG_Type* config);
+
+/**
+ * @brief Sets the segments of one digit.
+ *
+ * @param digit    Digit position, 0 is the rightmost.
+ * @param segments Segment bits (SEVENSEG_A ... SEVENSEG_DP).
+ */
+void SEVENSEG_SetSegments(uint8_t digit, uint8_t segments);
+
+/**
+ * @brief Shows a hexadecimal digit (0-F) at one position.
+ *
+ * @param digit Digit position, 0 is the rightmost.
+ * @param value Value, only its 4 lower bits are shown.
+ */
+void SEVENSEG_SetHex(uint8_t digit, uint32_t value);
+
+/**
+ * @brief Shows a number in hexadecimal on all the digits, leading zeros included.
+ *
+ * @param value Value to show.
+ */
+void SEVENSEG_ShowHex(uint32_t value);
+
+/**
+ * @brief Returns the number of refresh interrupts taken, to measure their CPU cost.
+ */
+uint32_t SEVENSEG_GetRefreshes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // SEVENSEG_H
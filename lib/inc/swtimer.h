@@ -0,0 +1,131 @@
+/**
+ * @file swtimer.h
+ * @brief Software timers on a hashed timing wheel, driven by a periodic tick interrupt.
+ *
+ * Replaces the per-task countdown counters kept in SysTick_Handler(): each task owns a
+ * SWTIMER_Type with a callback, and the tick handler only calls SWTIMER_Tick().
+ *
+ * Timers are hashed by expiry tick into SWTIMER_WHEEL_SIZE slots of doubly linked lists, so
+ * starting, stopping and expiring a timer are O(1), and a tick only visits the timers of one
+ * slot. Timers further away than one wheel turn stay in their slot and are skipped until the
+ * turn in which they expire.
+ *
+ * Callbacks run in the context of the tick interrupt and may start or stop any timer,
+ * including their own.
+ *
+ * The tick can come from a periodic interrupt that calls SWTIMER_Tick(), or from a tickless
+ * driver (see tickless.h) that only interrupts at the next expiry and then calls
+ * SWTIMER_AdvanceTo().
+ */
+
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+#include <stddef.h>
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SWTIMER_WHEEL_SIZE
+/** Number of wheel slots (power of 2). Should exceed the usual timer delay in ticks. */
+#define SWTIMER_WHEEL_SIZE (64)
+#endif
+
+/** Timer callback. */
+typedef void (*SWTIMER_Callback)(void* arg);
+
+/**
+ * @brief Tick source of a tickless driver.
+ */
+typedef struct {
+    uint32_t (*getTick)(void);         /*!< Returns the current tick. */
+    void (*requestWake)(uint32_t tick); /*!< Asks for SWTIMER_AdvanceTo() to run at `tick`. */
+} SWTIMER_Driver;
+
+/**
+ * @brief Software timer. Its fields are private to the module.
+ */
+typedef struct SWTIMER_Struct {
+    struct SWTIMER_Struct* next;     /*!< Next timer in the slot. */
+    struct SWTIMER_Struct** pprev;   /*!< Link pointing to this timer, NULL when stopped. */
+    uint32_t expiry;                 /*!< Tick at which the timer expires. */
+    uint32_t period;                 /*!< Reload period in ticks, 0 for one-shot timers. */
+    SWTIMER_Callback callback;       /*!< Function called on expiry. */
+    void* arg;                       /*!< Argument passed to the callback. */
+} SWTIMER_Type;
+
+/**
+ * @brief Initializes a stopped timer.
+ *
+ * @param timer    Timer to initialize.
+ * @param callback Function called on expiry.
+ * @param arg      Argument passed to the callback.
+ */
+void SWTIMER_Init(SWTIMER_Type* timer, SWTIMER_Callback callback, void* arg);
+
+/**
+ * @brief Starts (or restarts) a timer.
+ *
+ * @param timer  Timer to start.
+ * @param delay  Ticks until the first expiry (0 is treated as 1).
+ * @param period Ticks between later expiries, 0 for a one-shot timer.
+ */
+void SWTIMER_Start(SWTIMER_Type* timer, uint32_t delay, uint32_t period);
+
+/**
+ * @brief Stops a timer. Does nothing if it is not running.
+ *
+ * @param timer Timer to stop.
+ */
+void SWTIMER_Stop(SWTIMER_Type* timer);
+
+/**
+ * @brief Checks whether a timer is running.
+ *
+ * @param timer Timer to check.
+ * @return 1 if the timer is running, 0 otherwise.
+ */
+uint8_t SWTIMER_IsActive(const SWTIMER_Type* timer);
+
+/**
+ * @brief Advances the wheel by one tick and runs the callbacks of the expired timers.
+ *
+ * Must be called from the periodic tick interrupt (e.g. SysTick_Handler()).
+ */
+void SWTIMER_Tick(void);
+
+/**
+ * @brief Advances the wheel to the given tick and runs the callbacks of every timer that expired.
+ *
+ * Periods missed by a late call are skipped, keeping periodic timers in phase.
+ * Must be called from the tick interrupt of a tickless driver.
+ *
+ * @param tick Current tick.
+ */
+void SWTIMER_AdvanceTo(uint32_t tick);
+
+/**
+ * @brief Finds the earliest expiry of the running timers.
+ *
+ * Scans the whole wheel, so it is meant to run once per tickless wake-up, not every tick.
+ *
+ * @param tick Set to the earliest expiry tick.
+ * @return 1 if a timer is running, 0 otherwise.
+ */
+uint8_t SWTIMER_NextExpiry(uint32_t* tick);
+
+/**
+ * @brief Installs a tickless driver, or restores SWTIMER_Tick() operation with NULL.
+ *
+ * @param driver Tick source, must stay valid while installed.
+ */
+void SWTIMER_SetDriver(const SWTIMER_Driver* driver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // SWTIMER_H
@@ -0,0 +1,46 @@
+/**
+ * @file tickless.h
+ * @brief Tickless driver for the software timers, built on a TIMER0 match register.
+ *
+ * A periodic tick interrupts the CPU even when no timer expires. In tickless mode TIMER0 counts
+ * software timer ticks (its prescaler divides PCLK down to one tick) and MR0 is always set to the
+ * next expiry, so the CPU is only interrupted when a timer actually expires.
+ *
+ * TIMER0 is used instead of SysTick because its 32-bit counter runs freely: it is never
+ * reloaded, so moving the next wake-up never loses counts and there is no long-term drift, and
+ * intervals are not limited to the 2^24 cycles (~167 ms) of the SysTick reload value.
+ *
+ * The module owns TIMER0 and defines TIMER0_IRQHandler().
+ */
+
+#ifndef TICKLESS_H
+#define TICKLESS_H
+
+#include "LPC17xx.h"
+#include "swtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Starts TIMER0 as the tick source of the software timers.
+ *
+ * Timer delays and periods passed to SWTIMER_Start() are then counted in ticks of `tickUs`.
+ * TIMER0 gets the lowest interrupt priority, like SysTick in SysTick_Config().
+ *
+ * @param tickUs Software timer tick in microseconds.
+ * @return 0 on success, 1 if the tick is 0 or too long for the TIMER0 prescaler.
+ */
+uint32_t TICKLESS_Init(uint32_t tickUs);
+
+/**
+ * @brief Returns the number of TIMER0 interrupts taken, to measure the wake-up rate.
+ */
+uint32_t TICKLESS_GetWakeups(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // TICKLESS_H
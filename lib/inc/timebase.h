@@ -0,0 +1,81 @@
+/**
+ * @file timebase.h
+ * @brief Calibrated 1 ms timebase built on SysTick, with sleeping delays and deadlines.
+ *
+ * Replaces the nested __NOP() loops used as delays: the delay length is computed from
+ * SystemCoreClock instead of depending on the clock, flash wait states and optimisation level,
+ * and the CPU sleeps in __WFI() between ticks instead of spinning.
+ *
+ * The module owns SysTick and defines SysTick_Handler(). Delays rely on the SysTick interrupt and
+ * must not be called from handlers with the same or higher priority.
+ */
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Timebase tick period in milliseconds. */
+#define TIMEBASE_TICK_MS (1)
+
+/**
+ * @brief Starts the SysTick timer with a 1 ms period derived from SystemCoreClock.
+ *
+ * SysTick keeps the lowest interrupt priority set by SysTick_Config().
+ *
+ * @return 0 on success, 1 if the core clock does not allow a 1 ms reload value.
+ */
+uint32_t TIMEBASE_Init(void);
+
+/**
+ * @brief Returns the milliseconds elapsed since TIMEBASE_Init(). Wraps after ~49.7 days.
+ */
+uint32_t TIMEBASE_GetMs(void);
+
+/**
+ * @brief Returns the core cycles elapsed since TIMEBASE_Init(), including the fraction of the
+ * current millisecond.
+ */
+uint64_t TIMEBASE_GetCycles(void);
+
+/**
+ * @brief Blocks for at least the given number of milliseconds, sleeping between ticks.
+ *
+ * @param ms Delay in milliseconds.
+ */
+void TIMEBASE_DelayMs(uint32_t ms);
+
+/**
+ * @brief Blocks for at least the given number of microseconds.
+ *
+ * Whole ticks are slept in __WFI(); the last fraction is measured on the SysTick counter.
+ *
+ * @param us Delay in microseconds.
+ */
+void TIMEBASE_DelayUs(uint32_t us);
+
+/**
+ * @brief Computes a deadline for non-blocking waits.
+ *
+ * @param ms Milliseconds from now.
+ * @return Deadline to pass to TIMEBASE_Expired().
+ */
+uint32_t TIMEBASE_Deadline(uint32_t ms);
+
+/**
+ * @brief Checks a deadline computed by TIMEBASE_Deadline(). Safe across counter wrap-around.
+ *
+ * @param deadline Deadline to check.
+ * @return 1 if the deadline has been reached, 0 otherwise.
+ */
+uint8_t TIMEBASE_Expired(uint32_t deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // TIMEBASE_H
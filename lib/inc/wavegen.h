@@ -0,0 +1,110 @@
+/**
+ * @file wavegen.h
+ * @brief Multi-pin waveform generator on TIMER2, played from flash by its interrupt or by the GPDMA.
+ *
+ * A wave is a sequence of steps, each with the levels of the pins of one GPIO port and its own
+ * duration, so long constant stretches take a single step and the length of a wave is not tied
+ * to the bits of an integer. The wave is played on the pins selected at init; FIOMASK protects
+ * the other pins of the port, and each step is a single FIOPIN write.
+ *
+ * TIMER2 counts ticks of `tickUs`; MR0 holds the duration of the current step and resets the
+ * counter, so steps follow each other without drift. MR1 (= 0) marks the start of every step.
+ *
+ * - WAVEGEN_TIMER: the MR1 interrupt writes the levels and the duration of each step.
+ * - WAVEGEN_DMA: GPDMA channel 0, requested by MAT2.0, writes the next duration to MR0 and
+ *   channel 1, requested by MAT2.1, writes the levels to FIOPIN. Their linked lists follow the
+ *   wave, loop back to its first step or end with the idle levels, so playback takes no CPU at
+ *   all until the end of the wave (one DMA interrupt), or never in a loop.
+ *
+ * A wave that is not looped ends with the idle levels, like an aborted one.
+ *
+ * The module owns TIMER2, GPDMA channels 0 and 1, and defines TIMER2_IRQHandler() and
+ * DMA_IRQHandler(). In DMA mode the level and duration arrays must be static (flash or RAM).
+ */
+
+#ifndef WAVEGEN_H
+#define WAVEGEN_H
+
+#include "LPC17xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest wave in DMA mode, in steps: 4095 steps per linked list item. */
+#define WAVEGEN_MAX_DMA_STEPS (4095UL * 4)
+
+/**
+ * @brief Converts a step duration in ticks to its entry in a durations array.
+ *
+ * The counter is reset one tick after it reaches MR0, so MR0 holds the duration minus 1. A step
+ * lasts at least 1 tick in DMA mode and 2 in timer mode, where the interrupt writes MR0 after the
+ * step started.
+ */
+#define WAVEGEN_TICKS(ticks) ((ticks) - 1)
+
+/**
+ * @brief Playback engines.
+ */
+typedef enum {
+    WAVEGEN_TIMER = 0,    /*!< TIMER2 match interrupt at every step. */
+    WAVEGEN_DMA           /*!< GPDMA transfers paced by TIMER2 matches. */
+} WAVEGEN_Mode;
+
+/**
+ * @brief Generator configuration.
+ */
+typedef struct {
+    LPC_GPIO_TypeDef* port;    /*!< GPIO port of the wave pins. */
+    uint32_t pins;             /*!< Pins driven by the wave; FIOMASK masks the others. */
+    uint32_t idle;             /*!< Levels of the pins when no wave plays. */
+    uint32_t tickUs;           /*!< Duration tick in microseconds. */
+    WAVEGEN_Mode mode;         /*!< Playback engine. */
+} WAVEGEN_CFG_Type;
+
+/**
+ * @brief Wave: levels and duration of every step.
+ */
+typedef struct {
+    const uint32_t* levels;       /*!< Port value of every step; only the wave pins are written. */
+    const uint32_t* durations;    /*!< Duration of every step, as WAVEGEN_TICKS(ticks). */
+    uint32_t length;              /*!< Number of steps, at least 1. */
+} WAVEGEN_Wave;
+
+/**
+ * @brief Configures the wave pins as outputs at their idle levels and prepares TIMER2.
+ *
+ * The pins must already be selected as GPIO (PINSEL). FIOMASK of the port is set to mask every
+ * other pin, for the rest of the program. The interrupts get the lowest priority.
+ *
+ * @param config Generator configuration, copied by the module.
+ * @return 0 on success, 1 if the tick is 0 or too long for the TIMER2 prescaler.
+ */
+uint32_t WAVEGEN_Init(const WAVEGEN_CFG_Type* config);
+
+/**
+ * @brief Starts a wave from its first step, aborting the one playing.
+ *
+ * @param wave Wave to play, must stay valid while it plays.
+ * @param loop 1 to repeat the wave until WAVEGEN_Stop(), 0 to play it once.
+ * @return 0 on success, 1 if the wave is empty or too long for DMA mode.
+ */
+uint32_t WAVEGEN_Play(const WAVEGEN_Wave* wave, uint8_t loop);
+
+/**
+ * @brief Aborts the wave playing and sets the pins to their idle levels.
+ */
+void WAVEGEN_Stop(void);
+
+/**
+ * @brief Checks whether a wave is playing.
+ *
+ * @return 1 while a wave plays, 0 once it ended or was stopped.
+ */
+uint8_t WAVEGEN_IsPlaying(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif    // WAVEGEN_H
@@ -0,0 +1,107 @@
+/**
+ * @file cpuload.c
+ * @brief CPU load measurement on the DWT cycle counter: time asleep, in the thread and per handler.
+ */
+
+#include "cpuload.h"
+
+#ifndef DWT_CTRL_CYCCNTENA_Msk
+/** DWT CTRL: cycle counter enable bit (missing from older CMSIS core headers). */
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#endif
+
+/** Cycles measured so far; `thread` and `activePpm` are only computed by CPULOAD_Get(). */
+static CPULOAD_Report load;
+/** Start of a measurement. */
+static const CPULOAD_Report empty = {0};
+/** CYCCNT when `load.total` was last brought up to date. */
+static uint32_t lastCount = 0;
+/** Cycles of every instrumented handler, wrapping: the nested handlers of an entry are a difference. */
+static volatile uint32_t handlerCount = 0;
+
+/**
+ * @brief Brings the elapsed cycles up to date. Must be called with interrupts disabled.
+ */
+static void sample(void);
+
+void CPULOAD_Init(void) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;    // Power the DWT.
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    load         = empty;
+    lastCount    = 0;
+    handlerCount = 0;
+
+    __set_PRIMASK(primask);
+}
+
+void CPULOAD_Sleep(void) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The handler that wakes the core runs after the sleep is counted.
+
+    sample();
+    __WFI();
+    const uint32_t wake = DWT->CYCCNT;
+    load.sleep += wake - lastCount;
+    load.total += wake - lastCount;
+    lastCount = wake;
+
+    __set_PRIMASK(primask);
+}
+
+CPULOAD_Mark CPULOAD_Enter(void) {
+    CPULOAD_Mark mark;
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // A handler preempting between both reads would be counted as nested.
+
+    mark.nested = handlerCount;
+    mark.start  = DWT->CYCCNT;
+
+    __set_PRIMASK(primask);
+    return mark;
+}
+
+void CPULOAD_Exit(uint32_t slot, const CPULOAD_Mark* mark) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    const uint32_t own = (DWT->CYCCNT - mark->start) - (handlerCount - mark->nested);
+    handlerCount += own;
+    if (slot < CPULOAD_MAX_HANDLERS) {
+        load.handler[slot] += own;
+        load.entries[slot]++;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+void CPULOAD_Get(CPULOAD_Report* report, uint8_t reset) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    sample();
+    *report = load;
+    if (reset)
+        load = empty;    // handlerCount keeps running for the handlers in progress.
+
+    __set_PRIMASK(primask);
+
+    uint64_t handlers = 0;
+    for (uint32_t slot = 0; slot < CPULOAD_MAX_HANDLERS; slot++)
+        handlers += report->handler[slot];
+    report->thread = report->total - report->sleep - handlers;
+    // Millionths: a tick-driven design is awake well under 0.1 % of the time.
+    report->activePpm =
+        report->total ? (uint32_t)((report->total - report->sleep) * 1000000 / report->total) : 0;
+}
+
+static void sample(void) {
+    const uint32_t count = DWT->CYCCNT;
+
+    load.total += count - lastCount;
+    lastCount = count;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file debounce.c
+ * @brief Non-blocking debouncer for all the pins of a GPIO port, on bit-sliced vertical counters.
+ */
+
+#include "debounce.h"
+
+/**
+ * @brief Returns and clears a set of pending events, atomically with respect to the tick.
+ *
+ * @param events Pending events.
+ */
+static uint32_t takeEvents(volatile uint32_t* events);
+
+uint32_t DEBOUNCE_Init(DEBOUNCE_Type* debouncer, uint32_t mask, uint32_t activeLow, uint32_t longTicks) {
+    if (longTicks >> DEBOUNCE_HOLD_BITS)
+        return 1;
+
+    debouncer->mask      = mask;
+    debouncer->activeLow = activeLow & mask;
+    debouncer->state     = 0;
+    debouncer->count0    = ~0U;    // Both counters start at 3: DEBOUNCE_SAMPLES to a change.
+    debouncer->count1    = ~0U;
+    for (uint32_t k = 0; k < DEBOUNCE_HOLD_BITS; k++)
+        debouncer->hold[k] = 0;
+    debouncer->longDone    = 0;
+    debouncer->longTicks   = longTicks;
+    debouncer->longEnable  = longTicks ? ~0U : 0;
+    debouncer->pressed     = 0;
+    debouncer->released    = 0;
+    debouncer->longPressed = 0;
+    return 0;
+}
+
+void DEBOUNCE_Update(DEBOUNCE_Type* debouncer, uint32_t pins) {
+    const uint32_t sample = (pins ^ debouncer->activeLow) & debouncer->mask;    // 1 = pressed.
+    uint32_t changed      = sample ^ debouncer->state;
+
+    // 2-bit down counters, reset to 3 where the sample equals the state: a pin toggles when
+    // its counter wraps, after DEBOUNCE_SAMPLES samples in a row that differ from its state.
+    debouncer->count0 = ~(debouncer->count0 & changed);
+    debouncer->count1 = debouncer->count0 ^ (debouncer->count1 & changed);
+    changed &= debouncer->count0 & debouncer->count1;
+
+    const uint32_t state = debouncer->state ^ changed;
+    debouncer->state     = state;
+    debouncer->pressed |= changed & state;
+    debouncer->released |= changed & ~state;
+
+    // Hold counters: cleared while released, counted while held until the long press.
+    uint32_t carry = state & ~debouncer->longDone & debouncer->longEnable;
+    uint32_t match = carry;
+    for (uint32_t k = 0; k < DEBOUNCE_HOLD_BITS; k++) {
+        const uint32_t bit  = debouncer->hold[k] & state;
+        const uint32_t want = 0U - ((debouncer->longTicks >> k) & 0x1);    // All 0s or all 1s.
+
+        debouncer->hold[k] = bit ^ carry;
+        carry              = bit & carry;
+        match &= ~(debouncer->hold[k] ^ want);
+    }
+    debouncer->longDone = (debouncer->longDone & state) | match;
+    debouncer->longPressed |= match;
+}
+
+uint32_t DEBOUNCE_GetPressed(DEBOUNCE_Type* debouncer) { return takeEvents(&debouncer->pressed); }
+
+uint32_t DEBOUNCE_GetReleased(DEBOUNCE_Type* debouncer) { return takeEvents(&debouncer->released); }
+
+uint32_t DEBOUNCE_GetLongPressed(DEBOUNCE_Type* debouncer) { return takeEvents(&debouncer->longPressed); }
+
+uint32_t DEBOUNCE_GetState(const DEBOUNCE_Type* debouncer) { return debouncer->state; }
+
+static uint32_t takeEvents(volatile uint32_t* events) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The tick may add events between the read and the clear.
+
+    const uint32_t taken = *events;
+    *events              = 0;
+
+    __set_PRIMASK(primask);
+    return taken;
+}
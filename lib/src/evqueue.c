@@ -0,0 +1,42 @@
+/**
+ * @file evqueue.c
+ * @brief Lock-free single-producer/single-consumer event queue.
+ */
+
+#include "evqueue.h"
+
+void EVQUEUE_Init(EVQUEUE_Type* queue, uint32_t* buffer, uint32_t capacity) {
+    queue->buffer    = buffer;
+    queue->mask      = capacity - 1;
+    queue->head      = 0;
+    queue->tail      = 0;
+    queue->overflows = 0;
+}
+
+uint8_t EVQUEUE_Post(EVQUEUE_Type* queue, uint32_t event) {
+    const uint32_t head = queue->head;
+
+    if (head - queue->tail > queue->mask) {    // Full: head and tail are free-running.
+        queue->overflows++;
+        return 0;
+    }
+    queue->buffer[head & queue->mask] = event;
+    __DMB();    // The event must be stored before it is published.
+    queue->head = head + 1;
+    return 1;
+}
+
+uint8_t EVQUEUE_Get(EVQUEUE_Type* queue, uint32_t* event) {
+    const uint32_t tail = queue->tail;
+
+    if (tail == queue->head)
+        return 0;
+    *event = queue->buffer[tail & queue->mask];
+    __DMB();    // The event must be read before its entry is released.
+    queue->tail = tail + 1;
+    return 1;
+}
+
+uint32_t EVQUEUE_Count(const EVQUEUE_Type* queue) { return queue->head - queue->tail; }
+
+uint32_t EVQUEUE_GetOverflows(const EVQUEUE_Type* queue) { return queue->overflows; }
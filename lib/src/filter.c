@@ -0,0 +1,167 @@
+/**
+ * @file filter.c
+ * @brief Streaming multi-channel digital filters: moving average, EMA, CIC decimator and median.
+ */
+
+#include "filter.h"
+
+/** Longest moving average window: keeps the 32-bit sums exact. */
+#define MA_MAX_LOG2_WINDOW  (16)
+/** Longest CIC register growth: 16-bit samples must fit the 32-bit integrators. */
+#define CIC_MAX_GAIN_SHIFT  (16)
+/** Largest CIC order. */
+#define CIC_MAX_ORDER       (4)
+/** Largest EMA shift: keeps (x << FRAC) - y in 32 bits. */
+#define EMA_MAX_SHIFT       (15)
+
+uint32_t FILTER_MA_Init(FILTER_MA_Type* filter, uint16_t* samples, uint32_t* sums, uint32_t channels,
+                        uint32_t log2Window) {
+    if (log2Window > MA_MAX_LOG2_WINDOW)
+        return 1;
+
+    filter->samples    = samples;
+    filter->sums       = sums;
+    filter->channels   = channels;
+    filter->log2Window = log2Window;
+    filter->mask       = (1U << log2Window) - 1;
+    filter->index      = 0;
+
+    for (uint32_t i = 0; i < FILTER_MA_SIZE(channels, log2Window); i++)
+        samples[i] = 0;
+    for (uint32_t ch = 0; ch < channels; ch++)
+        sums[ch] = 0;
+    return 0;
+}
+
+void FILTER_MA_Update(FILTER_MA_Type* filter, const uint16_t* in, uint16_t* out) {
+    uint16_t* slot = filter->samples + filter->index * filter->channels;    // Oldest samples.
+
+    for (uint32_t ch = 0; ch < filter->channels; ch++) {
+        const uint16_t x   = in[ch];
+        const uint32_t sum = filter->sums[ch] - slot[ch] + x;
+
+        slot[ch]          = x;
+        filter->sums[ch]  = sum;
+        out[ch]           = (uint16_t)(sum >> filter->log2Window);
+    }
+    filter->index = (filter->index + 1) & filter->mask;
+}
+
+uint32_t FILTER_EMA_Init(FILTER_EMA_Type* filter, int32_t* state, uint32_t channels, uint32_t shift) {
+    if (shift == 0 || shift > EMA_MAX_SHIFT)
+        return 1;
+
+    filter->state    = state;
+    filter->channels = channels;
+    filter->shift    = shift;
+
+    for (uint32_t ch = 0; ch < channels; ch++)
+        state[ch] = 0;
+    return 0;
+}
+
+void FILTER_EMA_Update(FILTER_EMA_Type* filter, const uint16_t* in, uint16_t* out) {
+    for (uint32_t ch = 0; ch < filter->channels; ch++) {
+        int32_t y = filter->state[ch];
+
+        y += (((int32_t)in[ch] << FILTER_EMA_FRAC_BITS) - y) >> filter->shift;    // Arithmetic shift.
+        filter->state[ch] = y;
+        out[ch]           = (uint16_t)((y + (1 << (FILTER_EMA_FRAC_BITS - 1))) >> FILTER_EMA_FRAC_BITS);
+    }
+}
+
+uint32_t FILTER_CIC_Init(FILTER_CIC_Type* filter, uint32_t* state, uint32_t channels, uint32_t order,
+                         uint32_t log2Rate) {
+    if (order == 0 || order > CIC_MAX_ORDER || order * log2Rate > CIC_MAX_GAIN_SHIFT)
+        return 1;
+
+    filter->state     = state;
+    filter->channels  = channels;
+    filter->order     = order;
+    filter->gainShift = order * log2Rate;
+    filter->rateMask  = (1U << log2Rate) - 1;
+    filter->phase     = 0;
+
+    for (uint32_t i = 0; i < FILTER_CIC_SIZE(channels, order); i++)
+        state[i] = 0;
+    return 0;
+}
+
+uint8_t FILTER_CIC_Update(FILTER_CIC_Type* filter, const uint16_t* in, uint16_t* out) {
+    const uint32_t order = filter->order;
+    uint32_t* integrator = filter->state;
+
+    // Integrators run at the input rate. They wrap around, which the combs undo exactly.
+    for (uint32_t ch = 0; ch < filter->channels; ch++, integrator += 2 * order) {
+        uint32_t acc = in[ch];
+        for (uint32_t k = 0; k < order; k++) {
+            acc += integrator[k];
+            integrator[k] = acc;
+        }
+    }
+
+    filter->phase = (filter->phase + 1) & filter->rateMask;
+    if (filter->phase != 0)
+        return 0;
+
+    // Combs run at the output rate, with a delay of one output sample.
+    integrator = filter->state;
+    for (uint32_t ch = 0; ch < filter->channels; ch++, integrator += 2 * order) {
+        uint32_t* comb = integrator + order;
+        uint32_t acc   = integrator[order - 1];
+        for (uint32_t k = 0; k < order; k++) {
+            const uint32_t delayed = comb[k];
+            comb[k]                = acc;
+            acc -= delayed;
+        }
+        out[ch] = (uint16_t)(acc >> filter->gainShift);
+    }
+    return 1;
+}
+
+uint32_t FILTER_MEDIAN_Init(FILTER_MEDIAN_Type* filter, uint16_t* ring, uint16_t* sorted, uint32_t channels,
+                            uint32_t window) {
+    if (window == 0)
+        return 1;
+
+    filter->ring     = ring;
+    filter->sorted   = sorted;
+    filter->channels = channels;
+    filter->window   = window;
+    filter->index    = 0;
+
+    for (uint32_t i = 0; i < FILTER_MEDIAN_SIZE(channels, window); i++) {
+        ring[i]   = 0;
+        sorted[i] = 0;
+    }
+    return 0;
+}
+
+void FILTER_MEDIAN_Update(FILTER_MEDIAN_Type* filter, const uint16_t* in, uint16_t* out) {
+    const uint32_t window = filter->window;
+    uint16_t* ring        = filter->ring + filter->index;
+    uint16_t* sorted      = filter->sorted;
+
+    for (uint32_t ch = 0; ch < filter->channels; ch++, ring += window, sorted += window) {
+        const uint16_t x   = in[ch];
+        const uint16_t old = *ring;
+        uint32_t pos       = 0;
+
+        *ring = x;
+        while (sorted[pos] != old)    // The oldest sample is always in the window.
+            pos++;
+        // Slide the samples between the old and new positions over the hole left by `old`.
+        if (x > old) {
+            for (; pos + 1 < window && sorted[pos + 1] < x; pos++)
+                sorted[pos] = sorted[pos + 1];
+        } else {
+            for (; pos > 0 && sorted[pos - 1] > x; pos--)
+                sorted[pos] = sorted[pos - 1];
+        }
+        sorted[pos] = x;
+        out[ch]     = sorted[window >> 1];
+    }
+
+    // Wrap by comparison: the window need not be a power of 2.
+    filter->index = (filter->index + 1 == window) ? 0 : filter->index + 1;
+}
@@ -0,0 +1,325 @@
+/**
+ * @file freqmeter.c
+ * @brief Period, frequency and duty cycle measurement on the TIMER3 capture input CAP3.0 (P0.23).
+ */
+
+#include "freqmeter.h"
+
+#include "evqueue.h"
+#include "swtimer.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1UL << (x))
+
+/** PCONP: TIMER3 power bit. */
+#define PCTIM3      BIT_MASK(23)
+/** PCLKSEL1: position of the TIMER3 peripheral clock field. */
+#define PCLK_TIMER3 (14)
+/** PINSEL1: position of the P0.23 function field, CAP3.0 is function 3. */
+#define PINSEL_P0_23 (14)
+#define FUNC_CAP     (0x3UL)
+/** TCR: counter enable. */
+#define TCR_ENABLE  BIT_MASK(0)
+/** TCR: counter reset. */
+#define TCR_RESET   BIT_MASK(1)
+/** CCR: capture CR0 on rising edge, on falling edge, interrupt on capture. */
+#define CCR_RISE    BIT_MASK(0)
+#define CCR_FALL    BIT_MASK(1)
+#define CCR_INT     BIT_MASK(2)
+/** IR: CR0 interrupt flag. */
+#define IR_CR0      BIT_MASK(4)
+/** CTCR: counter mode, TC incremented on the rising edges of CAP3.0. */
+#define CTCR_RISING (0x1UL)
+
+/** Bit 0 of a queued timestamp: 1 for a rising edge. The edge costs one tick of resolution. */
+#define EDGE_RISING BIT_MASK(0)
+/** Time of a queued timestamp. */
+#define TIME(event) ((event) & ~EDGE_RISING)
+
+/** Engine configuration. */
+static FREQMETER_CFG_Type cfg;
+/** TIMER3 ticks per second. */
+static uint32_t pclk = 0;
+/** Shortest pulse in ticks. */
+static uint32_t minPulse = 0;
+/** Capture FIFO, from the capture interrupt to FREQMETER_Process(). */
+static uint32_t fifoBuffer[FREQMETER_FIFO_SIZE];
+static EVQUEUE_Type fifo;
+/** Gate of counter mode and of the idle check. */
+static SWTIMER_Type gate;
+/** Current mode. */
+static volatile uint8_t mode = FREQMETER_CAPTURE;
+/** Set when the edges queued so far must not be paired with the next ones. */
+static volatile uint8_t restart = 0;
+/** Edges captured since the last gate. */
+static volatile uint32_t edges = 0;
+/** Gates without an edge. */
+static uint32_t idleCount = 0;
+/** Counter mode: TC at the last gate, and whether that gate was cut by the switch. */
+static uint32_t lastCount = 0;
+static uint8_t partialGate = 0;
+/** Glitches dropped. */
+static volatile uint32_t glitches = 0;
+
+/** Edge waiting for the next one to rule out a glitch. */
+static uint32_t pending = 0;
+static uint8_t havePending = 0;
+/** Last rising and falling edges of the current period. */
+static uint32_t rise = 0;
+static uint32_t fall = 0;
+static uint8_t haveRise = 0;
+static uint8_t haveFall = 0;
+/** Periods and high times summed for the next measurement. */
+static uint64_t sumPeriod = 0;
+static uint64_t sumHigh = 0;
+static uint32_t periods = 0;
+
+/** Last measurement, and measurements published and read. */
+static FREQMETER_Result result;
+static volatile uint32_t published = 0;
+static uint32_t taken = 0;
+
+/**
+ * @brief Restarts TIMER3 as a timer capturing the next rising edge.
+ *
+ * Must be called with interrupts disabled.
+ */
+static void enterCapture(void);
+
+/**
+ * @brief Restarts TIMER3 as a counter of rising edges, without capture interrupts.
+ *
+ * Must be called with interrupts disabled (or from the capture interrupt).
+ */
+static void enterCounter(void);
+
+/**
+ * @brief Passes a queued edge through the glitch filter.
+ *
+ * @param event Queued timestamp.
+ */
+static void filterEdge(uint32_t event);
+
+/**
+ * @brief Adds an edge to the current period, publishing a measurement every `average` periods.
+ *
+ * @param event Queued timestamp.
+ */
+static void addEdge(uint32_t event);
+
+/**
+ * @brief Publishes a measurement. Must be called with interrupts disabled.
+ *
+ * @param periodNs     Mean period in ns.
+ * @param frequencyHz  Mean frequency in Hz.
+ * @param dutyPermille Duty cycle in thousandths, or FREQMETER_NO_DUTY.
+ */
+static void publish(uint32_t periodNs, uint32_t frequencyHz, uint16_t dutyPermille);
+
+/**
+ * @brief Gate timer callback: counter mode measurement and idle check.
+ *
+ * @param arg Unused.
+ */
+static void gateElapsed(void* arg);
+
+uint32_t FREQMETER_Init(const FREQMETER_CFG_Type* config) {
+    static const uint8_t pclkDiv[4] = {4, 1, 2, 8};    // PCLKSEL: CCLK/4, CCLK, CCLK/2, CCLK/8.
+
+    if (config->tickUs == 0 || config->gateTicks == 0 || config->average == 0)
+        return 1;
+
+    cfg      = *config;
+    pclk     = SystemCoreClock / pclkDiv[(LPC_SC->PCLKSEL1 >> PCLK_TIMER3) & 0x3];
+    minPulse = (uint32_t)((uint64_t)pclk * cfg.minPulseNs / 1000000000);
+    EVQUEUE_Init(&fifo, fifoBuffer, FREQMETER_FIFO_SIZE);
+
+    LPC_PINCON->PINSEL1 |= FUNC_CAP << PINSEL_P0_23;    // P0.23 as CAP3.0.
+    LPC_SC->PCONP |= PCTIM3;    // Power TIMER3; its PCLK is left as configured at start-up.
+
+    LPC_TIM3->PR  = 0;    // Timestamps at the PCLK rate.
+    LPC_TIM3->MCR = 0;    // No match action: TC runs freely.
+
+    NVIC_SetPriority(TIMER3_IRQn, 0);    // Highest priority.
+    NVIC_ClearPendingIRQ(TIMER3_IRQn);
+    NVIC_EnableIRQ(TIMER3_IRQn);
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    enterCapture();
+    __set_PRIMASK(primask);
+
+    SWTIMER_Init(&gate, gateElapsed, 0);
+    SWTIMER_Start(&gate, cfg.gateTicks, cfg.gateTicks);
+    return 0;
+}
+
+void FREQMETER_Process(void) {
+    uint32_t event;
+
+    while (1) {
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();    // The mode and the restart flag change in the interrupts.
+
+        if (restart) {
+            restart     = 0;
+            havePending = 0;
+            haveRise    = 0;
+            haveFall    = 0;
+            sumPeriod   = 0;
+            sumHigh     = 0;
+            periods     = 0;
+        }
+        const uint8_t capturing = mode == FREQMETER_CAPTURE;
+        const uint8_t got       = EVQUEUE_Get(&fifo, &event);
+
+        __set_PRIMASK(primask);
+        if (!got)
+            break;
+        if (capturing)    // Edges queued before a switch to counter mode are dropped.
+            filterEdge(event);
+    }
+}
+
+uint8_t FREQMETER_Get(FREQMETER_Result* last) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The gate timer publishes too.
+
+    const uint8_t fresh = published != taken;
+    *last               = result;
+    taken               = published;
+
+    __set_PRIMASK(primask);
+    return fresh;
+}
+
+uint32_t FREQMETER_GetGlitches(void) { return glitches; }
+
+uint32_t FREQMETER_GetOverruns(void) { return EVQUEUE_GetOverflows(&fifo); }
+
+void TIMER3_IRQHandler(void) {
+    const uint32_t ccr  = LPC_TIM3->CCR;
+    const uint32_t time = LPC_TIM3->CR0;
+
+    LPC_TIM3->IR  = IR_CR0;                         // Clear flag.
+    LPC_TIM3->CCR = ccr ^ (CCR_RISE | CCR_FALL);    // The other edge comes next.
+    edges++;
+
+    if (!EVQUEUE_Post(&fifo, TIME(time) | (ccr & CCR_RISE)) && cfg.counterAboveHz)
+        enterCounter();    // Edges faster than the main loop: stop interrupting.
+}
+
+static void enterCapture(void) {
+    LPC_TIM3->TCR  = TCR_RESET;
+    LPC_TIM3->CTCR = 0;                     // Timer mode.
+    LPC_TIM3->CCR  = CCR_RISE | CCR_INT;    // A period starts with a rising edge.
+    LPC_TIM3->IR   = IR_CR0;
+
+    mode      = FREQMETER_CAPTURE;
+    restart   = 1;
+    edges     = 0;
+    idleCount = 0;
+    LPC_TIM3->TCR = TCR_ENABLE;
+}
+
+static void enterCounter(void) {
+    LPC_TIM3->TCR  = TCR_RESET;
+    LPC_TIM3->CCR  = 0;              // No capture interrupts.
+    LPC_TIM3->CTCR = CTCR_RISING;    // TC counts the rising edges of CAP3.0.
+    LPC_TIM3->IR   = IR_CR0;
+
+    mode        = FREQMETER_COUNTER;
+    lastCount   = 0;
+    partialGate = 1;
+    LPC_TIM3->TCR = TCR_ENABLE;
+}
+
+static void filterEdge(uint32_t event) {
+    if (havePending && TIME(event) - TIME(pending) < minPulse) {    // A pulse too short to be real.
+        havePending = 0;
+        glitches++;
+        return;
+    }
+    if (havePending)
+        addEdge(pending);
+    pending     = event;
+    havePending = 1;
+}
+
+static void addEdge(uint32_t event) {
+    const uint32_t time = TIME(event);
+
+    if (!(event & EDGE_RISING)) {
+        fall     = time;
+        haveFall = haveRise;
+        return;
+    }
+    if (haveRise && haveFall) {    // An edge lost on the way only skips a period.
+        sumPeriod += time - rise;
+        sumHigh += fall - rise;
+        periods++;
+    }
+    rise     = time;
+    haveRise = 1;
+    haveFall = 0;
+
+    if (periods < cfg.average)
+        return;
+
+    // Mean period in 1/16 ticks, so that averaging adds resolution.
+    const uint64_t mean16    = sumPeriod * 16 / periods;
+    const uint64_t periodNs  = mean16 * (1000000000 / 16) / pclk;
+    const uint32_t frequency = (uint32_t)(((uint64_t)pclk * periods + sumPeriod / 2) / sumPeriod);
+    const uint16_t duty      = (uint16_t)(sumHigh * 1000 / sumPeriod);
+
+    sumPeriod = 0;
+    sumHigh   = 0;
+    periods   = 0;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    publish(periodNs > UINT32_MAX ? UINT32_MAX : (uint32_t)periodNs, frequency, duty);
+    if (cfg.counterAboveHz && frequency > cfg.counterAboveHz && mode == FREQMETER_CAPTURE)
+        enterCounter();
+    __set_PRIMASK(primask);
+}
+
+static void publish(uint32_t periodNs, uint32_t frequencyHz, uint16_t dutyPermille) {
+    result.periodNs     = periodNs;
+    result.frequencyHz  = frequencyHz;
+    result.dutyPermille = dutyPermille;
+    result.mode         = mode;
+    published++;
+}
+
+static void gateElapsed(void* arg) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The mode changes in the capture interrupt and in FREQMETER_Process().
+
+    (void)arg;
+    if (mode == FREQMETER_COUNTER) {
+        const uint32_t count   = LPC_TIM3->TC;
+        const uint32_t counted = count - lastCount;
+        const uint64_t gateUs  = (uint64_t)cfg.gateTicks * cfg.tickUs;
+
+        lastCount = count;
+        if (partialGate) {    // The first gate started at the switch, not at a tick.
+            partialGate = 0;
+        } else {
+            const uint64_t periodNs  = counted ? gateUs * 1000 / counted : 0;
+            const uint32_t frequency = (uint32_t)((counted * 1000000ULL + gateUs / 2) / gateUs);
+
+            publish(periodNs > UINT32_MAX ? UINT32_MAX : (uint32_t)periodNs, frequency, FREQMETER_NO_DUTY);
+            if (frequency < cfg.counterAboveHz / 2)
+                enterCapture();
+        }
+    } else if (edges) {
+        edges     = 0;
+        idleCount = 0;
+    } else if (++idleCount == cfg.idleGates) {    // No signal: publish it once.
+        publish(0, 0, 0);
+        restart = 1;
+    }
+
+    __set_PRIMASK(primask);
+}
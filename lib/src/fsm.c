@@ -0,0 +1,80 @@
+/**
+ * @file fsm.c
+ * @brief Table-driven timed state machines on a software timer.
+ */
+
+#include "fsm.h"
+
+/**
+ * @brief Enters a state: writes its outputs and starts its duration.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param machine Machine.
+ * @param state   State to enter.
+ */
+static void enterState(FSM_Type* machine, uint8_t state);
+
+/**
+ * @brief Timer callback: the duration of the current state elapsed.
+ *
+ * @param arg Machine.
+ */
+static void timeout(void* arg);
+
+void FSM_Init(FSM_Type* machine, const FSM_Table* table, uint8_t state) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    machine->table = table;
+    SWTIMER_Init(&machine->timer, timeout, machine);
+    enterState(machine, state);
+
+    __set_PRIMASK(primask);
+}
+
+uint8_t FSM_Event(FSM_Type* machine, uint8_t event) {
+    const FSM_Table* table = machine->table;
+    uint8_t taken = 0;
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The state is shared with the timeout.
+
+    for (uint8_t i = 0; i < table->numTransitions; i++) {
+        const FSM_Transition* transition = &table->transitions[i];
+
+        if (transition->event == event && (transition->from == FSM_ANY || transition->from == machine->state)) {
+            enterState(machine, transition->to);
+            taken = 1;
+            break;
+        }
+    }
+
+    __set_PRIMASK(primask);
+    return taken;
+}
+
+uint8_t FSM_GetState(const FSM_Type* machine) { return machine->state; }
+
+static void enterState(FSM_Type* machine, uint8_t state) {
+    const FSM_State* entered = &machine->table->states[state];
+
+    machine->state = state;
+    machine->timed = entered->duration != FSM_FOREVER;
+    machine->table->output(entered->outputs);
+    if (!machine->timed)
+        SWTIMER_Stop(&machine->timer);
+    else
+        SWTIMER_Start(&machine->timer, entered->duration, 0);
+}
+
+static void timeout(void* arg) {
+    FSM_Type* machine = (FSM_Type*)arg;
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    // An event that preempted the tick interrupt after the expiry already left the state.
+    if (machine->timed && !SWTIMER_IsActive(&machine->timer))
+        enterState(machine, machine->table->states[machine->state].next);
+
+    __set_PRIMASK(primask);
+}
@@ -0,0 +1,117 @@
+/**
+ * @file gpioirq.c
+ * @brief Dispatcher of the GPIO interrupts of ports 0 and 2, which all share EINT3_IRQHandler().
+ */
+
+#include "gpioirq.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1UL << (x))
+
+/** IntStatus: pending interrupts on port 0 and on port 2. */
+#define INT_P0 BIT_MASK(0)
+#define INT_P2 BIT_MASK(2)
+
+/**
+ * @brief Registered callback.
+ */
+typedef struct {
+    GPIOIRQ_Callback callback;    /*!< Function to call, 0 if none. */
+    void* arg;                    /*!< Argument passed to it. */
+} Handler;
+
+/** Callbacks of ports 0 and 2 (index port / 2), of each edge, of each pin. */
+static Handler handlers[2][2][32];
+
+/**
+ * @brief Sets or clears the enable bit of a pin and edge.
+ *
+ * @param port GPIO port, 0 or 2.
+ * @param pin  Pin number.
+ * @param edge Edge.
+ * @param on   1 to enable the interrupt, 0 to disable it.
+ */
+static void setEnable(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge, uint8_t on);
+
+/**
+ * @brief Calls the callbacks of the set bits of `pins`, lowest pin first.
+ *
+ * @param table Callbacks of one port and edge.
+ * @param pins  Pins with a pending edge.
+ */
+static void dispatch(const Handler* table, uint32_t pins);
+
+uint32_t GPIOIRQ_Attach(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge, GPIOIRQ_Callback callback, void* arg) {
+    if ((port != 0 && port != 2) || pin > 31 || (uint32_t)edge > GPIOIRQ_FALLING)
+        return 1;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The handler must not see the callback half written.
+
+    // IOxIntClr clears both edges of the pin: keep a pending edge of the other callback.
+    const uint8_t otherAttached = handlers[port / 2][!edge][pin].callback != 0;
+    handlers[port / 2][edge][pin].callback = callback;
+    handlers[port / 2][edge][pin].arg      = arg;
+
+    __set_PRIMASK(primask);
+
+    if (!otherAttached && port == 0)
+        LPC_GPIOINT->IO0IntClr = BIT_MASK(pin);
+    else if (!otherAttached)
+        LPC_GPIOINT->IO2IntClr = BIT_MASK(pin);
+    setEnable(port, pin, edge, 1);
+    NVIC_EnableIRQ(EINT3_IRQn);
+    return 0;
+}
+
+void GPIOIRQ_Detach(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge) {
+    if ((port != 0 && port != 2) || pin > 31 || (uint32_t)edge > GPIOIRQ_FALLING)
+        return;
+
+    setEnable(port, pin, edge, 0);
+    handlers[port / 2][edge][pin].callback = 0;
+}
+
+void EINT3_IRQHandler(void) {
+    const uint32_t status = LPC_GPIOINT->IntStatus;
+
+    if (status & INT_P0) {
+        const uint32_t rising  = LPC_GPIOINT->IO0IntStatR;
+        const uint32_t falling = LPC_GPIOINT->IO0IntStatF;
+
+        LPC_GPIOINT->IO0IntClr = rising | falling;    // Clear flags: later edges interrupt again.
+        dispatch(handlers[0][GPIOIRQ_RISING], rising);
+        dispatch(handlers[0][GPIOIRQ_FALLING], falling);
+    }
+    if (status & INT_P2) {
+        const uint32_t rising  = LPC_GPIOINT->IO2IntStatR;
+        const uint32_t falling = LPC_GPIOINT->IO2IntStatF;
+
+        LPC_GPIOINT->IO2IntClr = rising | falling;
+        dispatch(handlers[1][GPIOIRQ_RISING], rising);
+        dispatch(handlers[1][GPIOIRQ_FALLING], falling);
+    }
+}
+
+static void setEnable(uint8_t port, uint8_t pin, GPIOIRQ_Edge edge, uint8_t on) {
+    const uint32_t bit = BIT_MASK(pin);
+
+    if (port == 0 && edge == GPIOIRQ_RISING)
+        LPC_GPIOINT->IO0IntEnR = on ? LPC_GPIOINT->IO0IntEnR | bit : LPC_GPIOINT->IO0IntEnR & ~bit;
+    else if (port == 0)
+        LPC_GPIOINT->IO0IntEnF = on ? LPC_GPIOINT->IO0IntEnF | bit : LPC_GPIOINT->IO0IntEnF & ~bit;
+    else if (edge == GPIOIRQ_RISING)
+        LPC_GPIOINT->IO2IntEnR = on ? LPC_GPIOINT->IO2IntEnR | bit : LPC_GPIOINT->IO2IntEnR & ~bit;
+    else
+        LPC_GPIOINT->IO2IntEnF = on ? LPC_GPIOINT->IO2IntEnF | bit : LPC_GPIOINT->IO2IntEnF & ~bit;
+}
+
+static void dispatch(const Handler* table, uint32_t pins) {
+    while (pins) {
+        const uint32_t pin = __CLZ(__RBIT(pins));    // Lowest set bit.
+        pins &= pins - 1;
+
+        if (table[pin].callback)
+            table[pin].callback(table[pin].arg);
+    }
+}
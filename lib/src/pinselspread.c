@@ -0,0 +1,34 @@
+/**
+ * @file pinselspread.c
+ * @brief Pin configuration of several pins with the mask spread to whole registers.
+ */
+
+#include "pinselspread.h"
+
+uint32_t PINSEL_SpreadPins(uint32_t pins) {
+    pins = (pins | (pins << 8)) & 0x00FF00FFU;
+    pins = (pins | (pins << 4)) & 0x0F0F0F0FU;
+    pins = (pins | (pins << 2)) & 0x33333333U;
+    pins = (pins | (pins << 1)) & 0x55555555U;
+    return pins * 3;
+}
+
+void PINSEL_ConfigMultiplePinsSpread(const PINSEL_CFG_Type* pinCfg, uint32_t pins) {
+    const uint32_t port = pinCfg->portNum;
+    const uint32_t func = 0x55555555U * pinCfg->funcNum;    // Value copied to every field.
+    const uint32_t mode = 0x55555555U * pinCfg->pinMode;
+    const uint32_t od   = pinCfg->openDrain == PINSEL_OD_OPENDRAIN ? pins : 0;
+
+    // One read-modify-write per register, for the half-ports with pins to configure.
+    for (uint32_t half = 0; half < 2; half++) {
+        const uint32_t reg    = 2 * port + half;    // Two PINSEL/PINMODE registers per port.
+        const uint32_t fields = PINSEL_SpreadPins(half ? pins >> 16 : pins & 0xFFFF);
+
+        if (fields) {
+            (&LPC_PINCON->PINSEL0)[reg]  = ((&LPC_PINCON->PINSEL0)[reg] & ~fields) | (func & fields);
+            (&LPC_PINCON->PINMODE0)[reg] = ((&LPC_PINCON->PINMODE0)[reg] & ~fields) | (mode & fields);
+        }
+    }
+    if (pins)
+        (&LPC_PINCON->PINMODE_OD0)[port] = ((&LPC_PINCON->PINMODE_OD0)[port] & ~pins) | od;
+}
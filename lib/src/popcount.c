@@ -0,0 +1,77 @@
+/**
+ * @file popcount.c
+ * @brief Population count algorithms.
+ */
+
+#include "popcount.h"
+
+#if POPCOUNT_METHOD < POPCOUNT_METHOD_LOOP || POPCOUNT_METHOD > POPCOUNT_METHOD_SPARSE
+#error "Unknown POPCOUNT_METHOD."
+#endif
+
+/** Bits set in the 4 values of a 2-bit group. */
+#define B2(n) (n), (n) + 1, (n) + 1, (n) + 2
+/** Bits set in 4 bits, from the count of the upper bits. */
+#define B4(n) B2(n), B2((n) + 1), B2((n) + 1), B2((n) + 2)
+/** Bits set in 6 bits. */
+#define B6(n) B4(n), B4((n) + 1), B4((n) + 1), B4((n) + 2)
+
+/** Bits set in each nibble value. */
+static const uint8_t nibbleBits[16] = {B4(0)};
+/** Bits set in each byte value, generated at compile time. */
+static const uint8_t byteBits[256] = {B6(0), B6(1), B6(1), B6(2)};
+
+uint32_t POPCOUNT_Count(uint32_t value) {
+#if POPCOUNT_METHOD == POPCOUNT_METHOD_LOOP
+    return POPCOUNT_Loop(value);
+#elif POPCOUNT_METHOD == POPCOUNT_METHOD_NIBBLE_LUT
+    return POPCOUNT_NibbleLUT(value);
+#elif POPCOUNT_METHOD == POPCOUNT_METHOD_BYTE_LUT
+    return POPCOUNT_ByteLUT(value);
+#elif POPCOUNT_METHOD == POPCOUNT_METHOD_SWAR
+    return POPCOUNT_SWAR(value);
+#else
+    return POPCOUNT_Sparse(value);
+#endif
+}
+
+uint32_t POPCOUNT_Loop(uint32_t value) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < 32; i++)
+        if (value & (0x1UL << i))
+            count++;
+    return count;
+}
+
+uint32_t POPCOUNT_NibbleLUT(uint32_t value) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < 8; i++) {    // Unrolled by the compiler.
+        count += nibbleBits[value & 0xF];
+        value >>= 4;
+    }
+    return count;
+}
+
+uint32_t POPCOUNT_ByteLUT(uint32_t value) {
+    return byteBits[value & 0xFF] + byteBits[(value >> 8) & 0xFF] + byteBits[(value >> 16) & 0xFF] +
+           byteBits[value >> 24];
+}
+
+uint32_t POPCOUNT_SWAR(uint32_t value) {
+    value = value - ((value >> 1) & 0x55555555U);                    // 16 sums of 2 bits.
+    value = (value & 0x33333333U) + ((value >> 2) & 0x33333333U);    // 8 sums of 4 bits.
+    value = (value + (value >> 4)) & 0x0F0F0F0FU;                    // 4 sums of 8 bits.
+    return (value * 0x01010101U) >> 24;                              // Sum of the 4 bytes.
+}
+
+uint32_t POPCOUNT_Sparse(uint32_t value) {
+    uint32_t count = 0;
+
+    while (value) {
+        value &= ~(0x80000000UL >> __CLZ(value));    // Clear the highest bit set.
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file sevenseg.c
+ * @brief Multiplexed 7-segment display engine refreshed by a TIMER1 interrupt.
+ */
+
+#include "sevenseg.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x)     (0x1 << (x))
+/** Generic n-bit mask macro. */
+#define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
+
+/** PCONP: TIMER1 power bit. */
+#define PCTIM1      BIT_MASK(2)
+/** PCLKSEL0: position of the TIMER1 peripheral clock field. */
+#define PCLK_TIMER1 (4)
+/** TCR: counter enable. */
+#define TCR_ENABLE  BIT_MASK(0)
+/** TCR: counter reset. */
+#define TCR_RESET   BIT_MASK(1)
+/** MCR: interrupt and reset on MR0. */
+#define MCR_MR0     (BIT_MASK(0) | BIT_MASK(1))
+/** IR: MR0 interrupt flag. */
+#define IR_MR0      BIT_MASK(0)
+
+/** Hexadecimal glyphs. */
+static const uint8_t hexGlyphs[16] = SEVENSEG_HEX_GLYPHS;
+
+/** Display configuration. */
+static SEVENSEG_CFG_Type cfg;
+/** Segment levels of each digit, already inverted for common anode displays. */
+static volatile uint8_t frame[SEVENSEG_MAX_DIGITS];
+/** Enable masks of all the digits. */
+static uint32_t digitsMask = 0;
+/** Digit currently lit. */
+static uint8_t current = 0;
+/** Refresh interrupts taken. */
+static volatile uint32_t refreshes = 0;
+
+/**
+ * @brief Turns every digit off.
+ */
+static void digitsOff(void);
+
+uint32_t SEVENSEG_Init(const SEVENSEG_CFG_Type* config) {
+    static const uint8_t pclkDiv[4] = {4, 1, 2, 8};    // PCLKSEL: CCLK/4, CCLK, CCLK/2, CCLK/8.
+    uint32_t pclk, rate;
+
+    if (config->numDigits == 0 || config->numDigits > SEVENSEG_MAX_DIGITS || config->segByte > 3 ||
+        config->digitPin + config->numDigits > 32 || config->scanHz == 0)
+        return 1;
+
+    pclk = SystemCoreClock / pclkDiv[(LPC_SC->PCLKSEL0 >> PCLK_TIMER1) & 0x3];
+    rate = (uint32_t)config->scanHz * config->numDigits;
+    if (pclk / rate == 0)
+        return 1;
+
+    cfg        = *config;
+    digitsMask = BITS_MASK(cfg.numDigits, cfg.digitPin);
+    current    = 0;
+    for (uint8_t k = 0; k < SEVENSEG_MAX_DIGITS; k++)
+        frame[k] = cfg.segActiveLow ? 0xFF : 0x00;    // Blank.
+
+    digitsOff();
+    cfg.digitPort->FIODIR |= digitsMask;
+    (&cfg.segPort->FIOPIN0)[cfg.segByte] = frame[0];
+    cfg.segPort->FIODIR |= BITS_MASK(8, 8 * cfg.segByte);
+
+    LPC_SC->PCONP |= PCTIM1;    // Power TIMER1; its PCLK is left as configured at start-up.
+
+    LPC_TIM1->TCR = TCR_RESET;
+    LPC_TIM1->PR  = 0;
+    LPC_TIM1->MR0 = pclk / rate - 1;    // One interrupt per digit.
+    LPC_TIM1->MCR = MCR_MR0;
+    LPC_TIM1->IR  = IR_MR0;
+
+    NVIC_SetPriority(TIMER1_IRQn, (1 << __NVIC_PRIO_BITS) - 1);    // Lowest priority.
+    NVIC_ClearPendingIRQ(TIMER1_IRQn);
+    NVIC_EnableIRQ(TIMER1_IRQn);
+
+    LPC_TIM1->TCR = TCR_ENABLE;
+    return 0;
+}
+
+void SEVENSEG_SetSegments(uint8_t digit, uint8_t segments) {
+    if (digit < SEVENSEG_MAX_DIGITS)
+        frame[digit] = cfg.segActiveLow ? (uint8_t)~segments : segments;    // Single store.
+}
+
+void SEVENSEG_SetHex(uint8_t digit, uint32_t value) { SEVENSEG_SetSegments(digit, hexGlyphs[value & 0xF]); }
+
+void SEVENSEG_ShowHex(uint32_t value) {
+    for (uint8_t k = 0; k < cfg.numDigits; k++) {
+        SEVENSEG_SetHex(k, value);
+        value >>= 4;
+    }
+}
+
+uint32_t SEVENSEG_GetRefreshes(void) { return refreshes; }
+
+void TIMER1_IRQHandler(void) {
+    LPC_TIM1->IR = IR_MR0;    // Clear flag.
+    refreshes++;
+
+    current = (current + 1 < cfg.numDigits) ? current + 1 : 0;
+
+    digitsOff();    // No ghosting: the old digit is off before the segments change.
+    (&cfg.segPort->FIOPIN0)[cfg.segByte] = frame[current];    // All segments in one store.
+    if (cfg.digitActiveLow)
+        cfg.digitPort->FIOCLR = BIT_MASK(cfg.digitPin + current);
+    else
+        cfg.digitPort->FIOSET = BIT_MASK(cfg.digitPin + current);
+}
+
+static void digitsOff(void) {
+    if (cfg.digitActiveLow)
+        cfg.digitPort->FIOSET = digitsMask;
+    else
+        cfg.digitPort->FIOCLR = digitsMask;
+}
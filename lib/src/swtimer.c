@@ -0,0 +1,140 @@
+/**
+ * @file swtimer.c
+ * @brief Software timers on a hashed timing wheel.
+ */
+
+#include "swtimer.h"
+
+/** Slot index mask. */
+#define WHEEL_MASK (SWTIMER_WHEEL_SIZE - 1)
+
+#if (SWTIMER_WHEEL_SIZE & WHEEL_MASK) != 0
+#error "SWTIMER_WHEEL_SIZE must be a power of 2."
+#endif
+
+/** Timers hashed by expiry tick. */
+static SWTIMER_Type* wheel[SWTIMER_WHEEL_SIZE];
+/** Last tick processed by the wheel. */
+static uint32_t ticks = 0;
+/** Tickless driver, NULL when ticked by SWTIMER_Tick(). */
+static const SWTIMER_Driver* driver = NULL;
+
+/**
+ * @brief Inserts a timer at the head of a list.
+ *
+ * @param head  List head.
+ * @param timer Timer to insert.
+ */
+static void slotInsert(SWTIMER_Type** head, SWTIMER_Type* timer);
+
+/**
+ * @brief Removes a timer from the list it is in.
+ *
+ * @param timer Timer to remove.
+ */
+static void slotRemove(SWTIMER_Type* timer);
+
+void SWTIMER_Init(SWTIMER_Type* timer, SWTIMER_Callback callback, void* arg) {
+    timer->next     = NULL;
+    timer->pprev    = NULL;
+    timer->expiry   = 0;
+    timer->period   = 0;
+    timer->callback = callback;
+    timer->arg      = arg;
+}
+
+void SWTIMER_Start(SWTIMER_Type* timer, uint32_t delay, uint32_t period) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();    // The wheel is shared with the tick interrupt.
+
+    if (timer->pprev)
+        slotRemove(timer);
+    // Without ticks between wake-ups the wheel lags behind: count from the driver's tick.
+    timer->expiry = (driver ? driver->getTick() : ticks) + (delay ? delay : 1);
+    timer->period = period;
+    slotInsert(&wheel[timer->expiry & WHEEL_MASK], timer);
+    if (driver)
+        driver->requestWake(timer->expiry);
+
+    __set_PRIMASK(primask);
+}
+
+void SWTIMER_Stop(SWTIMER_Type* timer) {
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (timer->pprev)
+        slotRemove(timer);
+
+    __set_PRIMASK(primask);
+}
+
+uint8_t SWTIMER_IsActive(const SWTIMER_Type* timer) { return timer->pprev != NULL; }
+
+void SWTIMER_Tick(void) { SWTIMER_AdvanceTo(ticks + 1); }
+
+void SWTIMER_AdvanceTo(uint32_t tick) {
+    SWTIMER_Type* expired = NULL;
+    SWTIMER_Type* timer;
+    SWTIMER_Type* next;
+    uint32_t span = tick - ticks;
+
+    if (span > SWTIMER_WHEEL_SIZE)
+        span = SWTIMER_WHEEL_SIZE;    // Every slot is visited at most once.
+    for (uint32_t k = 1; k <= span; k++) {
+        for (timer = wheel[(ticks + k) & WHEEL_MASK]; timer; timer = next) {
+            next = timer->next;
+            if ((int32_t)(timer->expiry - tick) <= 0) {    // Others expire in a later turn.
+                slotRemove(timer);
+                slotInsert(&expired, timer);
+            }
+        }
+    }
+    ticks = tick;
+
+    while (expired) {    // A callback may stop any timer, including the expired ones.
+        timer = expired;
+        slotRemove(timer);
+        if (timer->period) {    // Reload from the expiry tick: no drift.
+            do {
+                timer->expiry += timer->period;
+            } while ((int32_t)(timer->expiry - ticks) <= 0);
+            slotInsert(&wheel[timer->expiry & WHEEL_MASK], timer);
+        }
+        timer->callback(timer->arg);
+    }
+}
+
+uint8_t SWTIMER_NextExpiry(uint32_t* tick) {
+    uint8_t found = 0;
+
+    for (uint32_t slot = 0; slot < SWTIMER_WHEEL_SIZE; slot++) {
+        for (const SWTIMER_Type* timer = wheel[slot]; timer; timer = timer->next) {
+            if (!found || (int32_t)(timer->expiry - *tick) < 0)
+                *tick = timer->expiry;
+            found = 1;
+        }
+    }
+    return found;
+}
+
+void SWTIMER_SetDriver(const SWTIMER_Driver* tickSource) {
+    driver = tickSource;
+    ticks  = driver ? driver->getTick() : ticks;
+}
+
+static void slotInsert(SWTIMER_Type** head, SWTIMER_Type* timer) {
+    timer->next = *head;
+    if (*head)
+        (*head)->pprev = &timer->next;
+    *head        = timer;
+    timer->pprev = head;
+}
+
+static void slotRemove(SWTIMER_Type* timer) {
+    *timer->pprev = timer->next;
+    if (timer->next)
+        timer->next->pprev = timer->pprev;
+    timer->next  = NULL;
+    timer->pprev = NULL;
+}
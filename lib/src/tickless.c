@@ -0,0 +1,101 @@
+/**
+ * @file tickless.c
+ * @brief Tickless driver for the software timers, built on a TIMER0 match register.
+ */
+
+#include "tickless.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1 << (x))
+
+/** PCONP: TIMER0 power bit. */
+#define PCTIM0       BIT_MASK(1)
+/** PCLKSEL0: position of the TIMER0 peripheral clock field. */
+#define PCLK_TIMER0  (2)
+/** TCR: counter enable. */
+#define TCR_ENABLE   BIT_MASK(0)
+/** TCR: counter reset. */
+#define TCR_RESET    BIT_MASK(1)
+/** MCR: interrupt on MR0. */
+#define MCR_MR0I     BIT_MASK(0)
+/** IR: MR0 interrupt flag. */
+#define IR_MR0       BIT_MASK(0)
+/** Longest wait without wake-up, keeps the signed tick comparisons valid. */
+#define MAX_SLEEP    (0x40000000UL)
+
+/** TIMER0 interrupts taken. */
+static volatile uint32_t wakeups = 0;
+
+/**
+ * @brief Returns the current tick (TIMER0 counter).
+ */
+static uint32_t getTick(void);
+
+/**
+ * @brief Moves the MR0 wake-up earlier if `tick` comes before it.
+ *
+ * @param tick Tick at which a timer expires.
+ */
+static void requestWake(uint32_t tick);
+
+/**
+ * @brief Programs MR0, pending the interrupt if the counter already reached `tick`.
+ *
+ * @param tick Wake-up tick.
+ */
+static void setWake(uint32_t tick);
+
+/** Driver handed to the software timers. */
+static const SWTIMER_Driver driver = {getTick, requestWake};
+
+uint32_t TICKLESS_Init(uint32_t tickUs) {
+    static const uint8_t pclkDiv[4] = {4, 1, 2, 8};    // PCLKSEL: CCLK/4, CCLK, CCLK/2, CCLK/8.
+    const uint32_t pclk   = SystemCoreClock / pclkDiv[(LPC_SC->PCLKSEL0 >> PCLK_TIMER0) & 0x3];
+    const uint64_t cycles = (uint64_t)pclk / 1000000 * tickUs;
+
+    if (cycles == 0 || cycles > 0x100000000ULL)
+        return 1;
+
+    LPC_SC->PCONP |= PCTIM0;    // Power TIMER0; its PCLK is left as configured at start-up.
+
+    LPC_TIM0->TCR = TCR_RESET;    // Hold TC and PC at 0.
+    LPC_TIM0->PR  = (uint32_t)(cycles - 1);    // TC counts software timer ticks.
+    LPC_TIM0->MCR = MCR_MR0I;    // Interrupt only: TC runs freely.
+    LPC_TIM0->MR0 = MAX_SLEEP;
+    LPC_TIM0->IR  = IR_MR0;
+
+    NVIC_SetPriority(TIMER0_IRQn, (1 << __NVIC_PRIO_BITS) - 1);    // Lowest priority.
+    NVIC_ClearPendingIRQ(TIMER0_IRQn);
+    NVIC_EnableIRQ(TIMER0_IRQn);
+
+    SWTIMER_SetDriver(&driver);
+    LPC_TIM0->TCR = TCR_ENABLE;
+    return 0;
+}
+
+uint32_t TICKLESS_GetWakeups(void) { return wakeups; }
+
+void TIMER0_IRQHandler(void) {
+    uint32_t next;
+
+    LPC_TIM0->IR = IR_MR0;    // Clear flag.
+    wakeups++;
+
+    SWTIMER_AdvanceTo(LPC_TIM0->TC);
+    if (!SWTIMER_NextExpiry(&next) || (int32_t)(next - LPC_TIM0->TC) > (int32_t)MAX_SLEEP)
+        next = LPC_TIM0->TC + MAX_SLEEP;
+    setWake(next);
+}
+
+static uint32_t getTick(void) { return LPC_TIM0->TC; }
+
+static void requestWake(uint32_t tick) {
+    if ((int32_t)(tick - LPC_TIM0->MR0) < 0)
+        setWake(tick);
+}
+
+static void setWake(uint32_t tick) {
+    LPC_TIM0->MR0 = tick;
+    if ((int32_t)(LPC_TIM0->TC - tick) >= 0)    // Already reached: the match was missed.
+        NVIC_SetPendingIRQ(TIMER0_IRQn);
+}
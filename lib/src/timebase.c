@@ -0,0 +1,77 @@
+/**
+ * @file timebase.c
+ * @brief Calibrated 1 ms timebase built on SysTick.
+ */
+
+#include "timebase.h"
+
+/** Milliseconds elapsed since TIMEBASE_Init(). */
+static volatile uint32_t msTicks = 0;
+/** Core cycles per millisecond (SysTick reload period). */
+static uint32_t cyclesPerMs = 0;
+/** Core cycles per microsecond. */
+static uint32_t cyclesPerUs = 0;
+
+/**
+ * @brief Samples the elapsed core cycles.
+ *
+ * @param toTick Set to the cycles left until the next tick.
+ * @return Core cycles elapsed since TIMEBASE_Init().
+ */
+static uint64_t sampleCycles(uint32_t* toTick);
+
+/**
+ * @brief Waits a number of core cycles, sleeping while the end lies beyond the next tick.
+ *
+ * @param cycles Core cycles to wait.
+ */
+static void delayCycles(uint64_t cycles);
+
+uint32_t TIMEBASE_Init(void) {
+    SystemCoreClockUpdate();
+    cyclesPerMs = SystemCoreClock / 1000 * TIMEBASE_TICK_MS;
+    cyclesPerUs = SystemCoreClock / 1000000;
+    msTicks     = 0;
+
+    return SysTick_Config(cyclesPerMs);
+}
+
+void SysTick_Handler(void) { msTicks += TIMEBASE_TICK_MS; }
+
+uint32_t TIMEBASE_GetMs(void) { return msTicks; }
+
+uint64_t TIMEBASE_GetCycles(void) {
+    uint32_t toTick;
+    return sampleCycles(&toTick);
+}
+
+void TIMEBASE_DelayMs(uint32_t ms) { delayCycles((uint64_t)ms * (cyclesPerMs / TIMEBASE_TICK_MS)); }
+
+void TIMEBASE_DelayUs(uint32_t us) { delayCycles((uint64_t)us * cyclesPerUs); }
+
+uint32_t TIMEBASE_Deadline(uint32_t ms) { return msTicks + ms; }
+
+uint8_t TIMEBASE_Expired(uint32_t deadline) { return (int32_t)(msTicks - deadline) >= 0; }
+
+static uint64_t sampleCycles(uint32_t* toTick) {
+    uint32_t ms, val;
+
+    do {
+        ms  = msTicks;
+        val = SysTick->VAL;
+    } while (ms != msTicks);    // A tick between both reads: sample again.
+
+    *toTick = val + 1;
+    return (uint64_t)ms / TIMEBASE_TICK_MS * cyclesPerMs + (cyclesPerMs - 1 - val);
+}
+
+static void delayCycles(uint64_t cycles) {
+    uint32_t toTick;
+    const uint64_t end = sampleCycles(&toTick) + cycles;
+    uint64_t now;
+
+    while ((now = sampleCycles(&toTick)) < end) {
+        if (end - now >= toTick)
+            __WFI();    // The next tick comes first: sleep until it.
+    }
+}
@@ -0,0 +1,258 @@
+/**
+ * @file wavegen.c
+ * @brief Multi-pin waveform generator on TIMER2, played from flash by its interrupt or by the GPDMA.
+ */
+
+#include "wavegen.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x) (0x1UL << (x))
+
+/** PCONP: TIMER2 and GPDMA power bits. */
+#define PCTIM2      BIT_MASK(22)
+#define PCGPDMA     BIT_MASK(29)
+/** PCLKSEL1: position of the TIMER2 peripheral clock field. */
+#define PCLK_TIMER2 (12)
+/** TCR: counter enable. */
+#define TCR_ENABLE  BIT_MASK(0)
+/** TCR: counter reset. */
+#define TCR_RESET   BIT_MASK(1)
+/** MCR: reset on MR0. */
+#define MCR_MR0R    BIT_MASK(1)
+/** MCR: interrupt on MR1. */
+#define MCR_MR1I    BIT_MASK(3)
+/** IR: MR1 interrupt flag. */
+#define IR_MR1      BIT_MASK(1)
+
+/** DMA request lines of MAT2.0 and MAT2.1, selected in DMAREQSEL (bits 4 and 5). */
+#define LINE_MAT2_0    (12)
+#define LINE_MAT2_1    (13)
+#define DMAREQSEL_MAT2 (BIT_MASK(LINE_MAT2_0 - 8) | BIT_MASK(LINE_MAT2_1 - 8))
+/** DMACConfig: controller enable. */
+#define DMAC_ENABLE    BIT_MASK(0)
+/** DMACCControl: 32-bit source and destination, source increment, terminal count interrupt. */
+#define CTRL_WORDS     ((2UL << 18) | (2UL << 21))
+#define CTRL_SI        BIT_MASK(26)
+#define CTRL_I         BIT_MASK(31)
+/** DMACCConfig: enable, memory to peripheral, terminal count interrupt, destination request. */
+#define CFG_E          BIT_MASK(0)
+#define CFG_M2P        (1UL << 11)
+#define CFG_ITC        BIT_MASK(15)
+#define CFG_DEST(line) ((uint32_t)(line) << 6)
+/** Channel of the durations (MAT2.0) and of the levels (MAT2.1). */
+#define CH_DURATION    (0)
+#define CH_LEVEL       (1)
+
+/** Largest transfer of one linked list item. */
+#define MAX_CHUNK (4095UL)
+/** Items of one channel: steps 1 to N-1, then the whole wave (loop) or the idle levels. */
+#define MAX_LLIS  (2 * (WAVEGEN_MAX_DMA_STEPS / MAX_CHUNK) + 1)
+
+/** Bus address of an object, as the DMA controller sees it. */
+#define ADDR(p) ((uint32_t)(uintptr_t)(p))
+
+/**
+ * @brief GPDMA linked list item.
+ */
+typedef struct {
+    uint32_t src;        /*!< Source address. */
+    uint32_t dest;       /*!< Destination address. */
+    uint32_t next;       /*!< Next item, 0 for the last one. */
+    uint32_t control;    /*!< DMACCControl of the item. */
+} DmaItem;
+
+/** Generator configuration. */
+static WAVEGEN_CFG_Type cfg;
+/** Wave playing. */
+static const WAVEGEN_Wave* wave = 0;
+/** Next step of the wave (timer mode). */
+static uint32_t step = 0;
+/** 1 if the wave repeats. */
+static uint8_t looping = 0;
+/** 1 while a wave plays. */
+static volatile uint8_t playing = 0;
+/** Idle levels, source of the last level transfer of a wave played once. */
+static uint32_t idleLevels = 0;
+/** Linked lists of the duration and level channels. */
+static DmaItem durationItems[MAX_LLIS];
+static DmaItem levelItems[MAX_LLIS];
+
+/**
+ * @brief Appends the items moving `count` words from `src` to the fixed address `dest`.
+ *
+ * @param list  Linked list.
+ * @param used  Items already in the list; the last one is linked to the first new item.
+ * @param src   First word.
+ * @param count Words to move.
+ * @param dest  Destination register.
+ * @return Items in the list.
+ */
+static uint32_t appendRun(DmaItem* list, uint32_t used, const uint32_t* src, uint32_t count, uint32_t dest);
+
+/**
+ * @brief Loads the first item of a list into a channel and enables it.
+ *
+ * @param channel Channel registers.
+ * @param list    Linked list.
+ * @param config  DMACCConfig value, without the enable bit.
+ */
+static void startChannel(LPC_GPDMACH_TypeDef* channel, const DmaItem* list, uint32_t config);
+
+/**
+ * @brief Builds the linked lists of the wave from its second step and starts both channels.
+ */
+static void startDma(void);
+
+/**
+ * @brief Stops TIMER2 and the channels and sets the pins to their idle levels.
+ */
+static void halt(void);
+
+uint32_t WAVEGEN_Init(const WAVEGEN_CFG_Type* config) {
+    static const uint8_t pclkDiv[4] = {4, 1, 2, 8};    // PCLKSEL: CCLK/4, CCLK, CCLK/2, CCLK/8.
+    const uint32_t pclk   = SystemCoreClock / pclkDiv[(LPC_SC->PCLKSEL1 >> PCLK_TIMER2) & 0x3];
+    const uint64_t cycles = (uint64_t)pclk / 1000000 * config->tickUs;
+
+    if (cycles == 0 || cycles > 0x100000000ULL)
+        return 1;
+
+    cfg        = *config;
+    idleLevels = cfg.idle;
+    playing    = 0;
+
+    cfg.port->FIOMASK = ~cfg.pins;    // FIOPIN writes only reach the wave pins.
+    cfg.port->FIOPIN  = idleLevels;
+    cfg.port->FIODIR |= cfg.pins;
+
+    LPC_SC->PCONP |= PCTIM2;    // Power TIMER2; its PCLK is left as configured at start-up.
+
+    LPC_TIM2->TCR = TCR_RESET;                 // Hold TC and PC at 0.
+    LPC_TIM2->PR  = (uint32_t)(cycles - 1);    // TC counts ticks.
+    LPC_TIM2->MR1 = 0;                         // Start of every step.
+    LPC_TIM2->IR  = IR_MR1;
+
+    if (cfg.mode == WAVEGEN_DMA) {
+        LPC_SC->PCONP |= PCGPDMA;
+        LPC_SC->DMAREQSEL |= DMAREQSEL_MAT2;    // Requests 12 and 13 from MAT2.0 and MAT2.1.
+        LPC_GPDMA->DMACConfig = DMAC_ENABLE;
+        LPC_TIM2->MCR         = MCR_MR0R;       // MR1 only requests the level transfer.
+
+        NVIC_SetPriority(DMA_IRQn, (1 << __NVIC_PRIO_BITS) - 1);    // Lowest priority.
+        NVIC_ClearPendingIRQ(DMA_IRQn);
+        NVIC_EnableIRQ(DMA_IRQn);
+    } else {
+        LPC_TIM2->MCR = MCR_MR0R | MCR_MR1I;
+
+        NVIC_SetPriority(TIMER2_IRQn, (1 << __NVIC_PRIO_BITS) - 1);    // Lowest priority.
+        NVIC_ClearPendingIRQ(TIMER2_IRQn);
+        NVIC_EnableIRQ(TIMER2_IRQn);
+    }
+    return 0;
+}
+
+uint32_t WAVEGEN_Play(const WAVEGEN_Wave* newWave, uint8_t loop) {
+    if (newWave->length == 0 || (cfg.mode == WAVEGEN_DMA && newWave->length > WAVEGEN_MAX_DMA_STEPS))
+        return 1;
+
+    halt();
+    wave    = newWave;
+    looping = loop;
+    step    = 1;
+    if (cfg.mode == WAVEGEN_DMA)
+        startDma();
+
+    cfg.port->FIOPIN = wave->levels[0];       // First step.
+    LPC_TIM2->MR0    = wave->durations[0];
+    playing          = 1;
+    LPC_TIM2->TCR    = TCR_ENABLE;
+    return 0;
+}
+
+void WAVEGEN_Stop(void) { halt(); }
+
+uint8_t WAVEGEN_IsPlaying(void) { return playing; }
+
+void TIMER2_IRQHandler(void) {
+    LPC_TIM2->IR = IR_MR1;    // Clear flag.
+
+    if (step == wave->length) {
+        if (!looping) {
+            halt();
+            return;
+        }
+        step = 0;
+    }
+    cfg.port->FIOPIN = wave->levels[step];
+    LPC_TIM2->MR0    = wave->durations[step];    // Before TC gets there: the step just started.
+    step++;
+}
+
+void DMA_IRQHandler(void) {
+    LPC_GPDMA->DMACIntTCClear = BIT_MASK(CH_LEVEL);    // Clear flag.
+
+    LPC_TIM2->TCR = TCR_RESET;    // The idle levels are out: stop the steps.
+    playing       = 0;
+}
+
+static uint32_t appendRun(DmaItem* list, uint32_t used, const uint32_t* src, uint32_t count, uint32_t dest) {
+    while (count) {
+        const uint32_t chunk = count < MAX_CHUNK ? count : MAX_CHUNK;
+
+        list[used].src     = ADDR(src);
+        list[used].dest    = dest;
+        list[used].next    = 0;
+        list[used].control = CTRL_WORDS | CTRL_SI | chunk;
+        if (used)
+            list[used - 1].next = ADDR(&list[used]);
+
+        used++;
+        src += chunk;
+        count -= chunk;
+    }
+    return used;
+}
+
+static void startChannel(LPC_GPDMACH_TypeDef* channel, const DmaItem* list, uint32_t config) {
+    channel->DMACCSrcAddr  = list->src;
+    channel->DMACCDestAddr = list->dest;
+    channel->DMACCLLI      = list->next;
+    channel->DMACCControl  = list->control;
+    channel->DMACCConfig   = config | CFG_E;
+}
+
+static void startDma(void) {
+    const uint32_t mr0    = ADDR(&LPC_TIM2->MR0);
+    const uint32_t fiopin = ADDR(&cfg.port->FIOPIN);
+    uint32_t durations    = appendRun(durationItems, 0, &wave->durations[1], wave->length - 1, mr0);
+    uint32_t levels       = appendRun(levelItems, 0, &wave->levels[1], wave->length - 1, fiopin);
+
+    if (looping) {    // Back to the first step, forever.
+        const uint32_t durationLoop = durations;
+        const uint32_t levelLoop    = levels;
+
+        durations = appendRun(durationItems, durations, wave->durations, wave->length, mr0);
+        levels    = appendRun(levelItems, levels, wave->levels, wave->length, fiopin);
+        durationItems[durations - 1].next = ADDR(&durationItems[durationLoop]);
+        levelItems[levels - 1].next       = ADDR(&levelItems[levelLoop]);
+    } else {    // Idle levels at the end of the last step, then one interrupt.
+        levels = appendRun(levelItems, levels, &idleLevels, 1, fiopin);
+        levelItems[levels - 1].control |= CTRL_I;
+    }
+
+    if (durations)
+        startChannel(LPC_GPDMACH0, durationItems, CFG_M2P | CFG_DEST(LINE_MAT2_0));
+    startChannel(LPC_GPDMACH1, levelItems, CFG_M2P | CFG_DEST(LINE_MAT2_1) | CFG_ITC);
+}
+
+static void halt(void) {
+    LPC_TIM2->TCR = TCR_RESET;
+    if (cfg.mode == WAVEGEN_DMA) {
+        LPC_GPDMACH0->DMACCConfig = 0;
+        LPC_GPDMACH1->DMACCConfig = 0;
+        LPC_GPDMA->DMACIntTCClear = BIT_MASK(CH_LEVEL);
+    } else {
+        LPC_TIM2->IR = IR_MR1;
+    }
+    cfg.port->FIOPIN = idleLevels;
+    playing          = 0;
+}
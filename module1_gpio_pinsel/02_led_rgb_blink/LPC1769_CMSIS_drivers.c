@@ -7,6 +7,7 @@
  * The delay is implemented using a blocking nested loop.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 
@@ -0,0 +1,57 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Program to blink a single color on the onboard RGB LED of the LPC1769 board.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp:
+ * the red LED is a type, and every call below compiles to the register access of the register
+ * version.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+
+/** Red LED connected to P0.22. */
+using RedLed = hal::Pin<0, 22>;
+
+/** Delay constant for LED timing. */
+#define DELAY 2500
+
+/**
+ * @brief Configures the GPIO pin for the red LED as output.
+ *
+ * Sets the pin function to GPIO and configures the direction as output.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Generates a blocking delay using nested loops.
+ * Used to control the LED blink timing.
+ */
+void delay();
+
+int main(void) {
+    configGPIO();
+
+    while (1) {
+        RedLed::clear();    // Turn LED on.
+        delay();
+
+        RedLed::set();    // Turn LED off.
+        delay();
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    RedLed::select();    // P0.22 as GPIO.
+
+    RedLed::output();    // Set P0.22 as output.
+
+    RedLed::set();    // Force LED off initially.
+}
+
+void delay() {
+    for (volatile uint32_t i = 0; i < DELAY; i++)
+        for (volatile uint32_t j = 0; j < DELAY; j++)
+            __NOP();
+}
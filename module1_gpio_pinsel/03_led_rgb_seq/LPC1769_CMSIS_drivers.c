@@ -6,8 +6,11 @@
  * It alternates between two color sequences.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "pingroup.h"
+#include "timebase.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x) (0x1 << (x))
@@ -26,8 +29,8 @@
 /** Mask for the blue LED (P3.26). */
 #define BLUE_BIT  BIT_MASK(BLUE_LED)
 
-/** Delay constant for LED timing. */
-#define DELAY 2500
+/** Time each color is shown, in milliseconds. */
+#define STEP_TIME 250
 
 /** Number of times to repeat each sequence before switching. */
 #define CYCLE_REPEATS   10
@@ -36,16 +39,29 @@
 /** Number of colors in each sequence. */
 #define SEQUENCE_LENGTH 3
 
+/** Color of the RGB LED from its red, green and blue channels (0 off, 1 on): one bit each. */
+#define COLOR(r, g, b) ((r) | ((g) << 1) | ((b) << 2))
+
+/** Masks of P0 (red) and P3 (green and blue) for color `c`; the LEDs are active low. */
+#define COLOR_MASKS(c)                                       \
+    {{PINGROUP_SET(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW),      \
+      PINGROUP_CLR(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW)},     \
+     {PINGROUP_SET(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_SET(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW), \
+      PINGROUP_CLR(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_CLR(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW)}}
+
 /**
- * @brief Color structure to represent RGB colors.
- *
- * Each color is represented by three channels: red, green, and blue.
- * Each channel is a uint8_t value where 0 means off and 1 means on.
+ * @brief RGB LED colors, as values of the LED pin group.
  */
-typedef struct {
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
+typedef enum {
+    RED     = COLOR(1, 0, 0),
+    GREEN   = COLOR(0, 1, 0),
+    BLUE    = COLOR(0, 0, 1),
+    CYAN    = COLOR(0, 1, 1),
+    MAGENTA = COLOR(1, 0, 1),
+    YELLOW  = COLOR(1, 1, 0),
+    WHITE   = COLOR(1, 1, 1),
 } Color;
 
 /**
@@ -57,23 +73,14 @@ void configGPIO(void);
 
 /**
  * @brief Sets the RGB LED to the specified color.
- * @param color Pointer to a Color struct defining the color to set.
- */
-void setLEDColor(const Color* color);
-
-/**
- * @brief Generates a blocking delay using nested loops.
- * Used to control the LED blink timing.
+ * @param color Color to display.
+ *
+ * Writes the precomputed masks of the color: one set and one clear per port, no branches.
  */
-void delay();
+void setLEDColor(Color color);
 
-const Color RED     = {1, 0, 0};
-const Color GREEN   = {0, 1, 0};
-const Color BLUE    = {0, 0, 1};
-const Color CYAN    = {0, 1, 1};
-const Color MAGENTA = {1, 0, 1};
-const Color YELLOW  = {1, 1, 0};
-const Color WHITE   = {1, 1, 1};
+/** Set and clear masks of P0 and P3 for every color, computed at compile time. */
+const PINGROUP_Masks colorMasks[8][2] = PINGROUP_TABLE8(COLOR_MASKS);
 
 /** First color sequence. */
 const Color sequence1[SEQUENCE_LENGTH] = {RED, GREEN, BLUE};
@@ -82,18 +89,19 @@ const Color sequence2[SEQUENCE_LENGTH] = {YELLOW, CYAN, MAGENTA};
 
 int main(void) {
     configGPIO();
+    TIMEBASE_Init();
 
     while (1) {
         for (uint8_t i = 0; i < CYCLE_REPEATS; i++) {
             for (uint8_t j = 0; j < SEQUENCE_LENGTH; j++) {
-                setLEDColor(&sequence1[j]);
-                delay();
+                setLEDColor(sequence1[j]);
+                TIMEBASE_DelayMs(STEP_TIME);
             }
         }
         for (uint8_t i = 0; i < CYCLE_REPEATS; i++) {
             for (uint8_t j = 0; j < SEQUENCE_LENGTH; j++) {
-                setLEDColor(&sequence2[j]);
-                delay();
+                setLEDColor(sequence2[j]);
+                TIMEBASE_DelayMs(STEP_TIME);
             }
         }
     }
@@ -125,25 +133,9 @@ void configGPIO(void) {
     GPIO_SetPins(GPIO_PORT_3, GREEN_BIT | BLUE_BIT);    // Green and blue LEDs off.
 }
 
-void setLEDColor(const Color* color) {
-    if (color->r)
-        GPIO_ClearPins(GPIO_PORT_0, RED_BIT);    // Turn on red LED.
-    else
-        GPIO_SetPins(GPIO_PORT_0, RED_BIT);    // Turn off red LED.
-
-    if (color->g)
-        GPIO_ClearPins(GPIO_PORT_3, GREEN_BIT);    // Turn on green LED.
-    else
-        GPIO_SetPins(GPIO_PORT_3, GREEN_BIT);    // Turn off green LED.
-
-    if (color->b)
-        GPIO_ClearPins(GPIO_PORT_3, BLUE_BIT);    // Turn on blue LED.
-    else
-        GPIO_SetPins(GPIO_PORT_3, BLUE_BIT);    // Turn off blue LED.
-}
-
-void delay() {
-    for (volatile uint32_t i = 0; i < DELAY; i++)
-        for (volatile uint32_t j = 0; j < DELAY; j++)
-            __NOP();
+void setLEDColor(Color color) {
+    GPIO_SetPins(GPIO_PORT_0, colorMasks[color][0].set);    // Red.
+    GPIO_ClearPins(GPIO_PORT_0, colorMasks[color][0].clr);
+    GPIO_SetPins(GPIO_PORT_3, colorMasks[color][1].set);    // Green and blue, together.
+    GPIO_ClearPins(GPIO_PORT_3, colorMasks[color][1].clr);
 }
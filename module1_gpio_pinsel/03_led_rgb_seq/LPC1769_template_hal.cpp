@@ -0,0 +1,111 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Program to alternate between two color sequences on the onboard RGB LED.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp:
+ * the three LEDs are one pin group over P0 and P3, configured with one access per register.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+#include "pingroup.h"
+#include "timebase.h"
+
+/** Red LED connected to P0.22. */
+using RedLed   = hal::Pin<0, 22>;
+/** Green LED connected to P3.25. */
+using GreenLed = hal::Pin<3, 25>;
+/** Blue LED connected to P3.26. */
+using BlueLed  = hal::Pin<3, 26>;
+/** The three channels of the RGB LED. */
+using RgbLed   = hal::PinGroup<RedLed, GreenLed, BlueLed>;
+
+/** Time each color is shown, in milliseconds. */
+#define STEP_TIME 250
+
+/** Number of times to repeat each sequence before switching. */
+#define CYCLE_REPEATS   10
+/** Number of color sequences defined. */
+#define NUM_SEQUENCES   2
+/** Number of colors in each sequence. */
+#define SEQUENCE_LENGTH 3
+
+/** Color of the RGB LED from its red, green and blue channels (0 off, 1 on): one bit each. */
+#define COLOR(r, g, b) ((r) | ((g) << 1) | ((b) << 2))
+
+/** Masks of P0 (red) and P3 (green and blue) for color `c`; the LEDs are active low. */
+#define COLOR_MASKS(c)                                                \
+    {{PINGROUP_SET(c, 0, RedLed::MASK, PINGROUP_ACTIVE_LOW),          \
+      PINGROUP_CLR(c, 0, RedLed::MASK, PINGROUP_ACTIVE_LOW)},         \
+     {PINGROUP_SET(c, 1, GreenLed::MASK, PINGROUP_ACTIVE_LOW) |       \
+          PINGROUP_SET(c, 2, BlueLed::MASK, PINGROUP_ACTIVE_LOW),     \
+      PINGROUP_CLR(c, 1, GreenLed::MASK, PINGROUP_ACTIVE_LOW) |       \
+          PINGROUP_CLR(c, 2, BlueLed::MASK, PINGROUP_ACTIVE_LOW)}}
+
+/**
+ * @brief RGB LED colors, as values of the LED pin group.
+ */
+typedef enum {
+    RED     = COLOR(1, 0, 0),
+    GREEN   = COLOR(0, 1, 0),
+    BLUE    = COLOR(0, 0, 1),
+    CYAN    = COLOR(0, 1, 1),
+    MAGENTA = COLOR(1, 0, 1),
+    YELLOW  = COLOR(1, 1, 0),
+    WHITE   = COLOR(1, 1, 1),
+} Color;
+
+/**
+ * @brief Configures the RGB LED.
+ * Sets the pin function to GPIO and configures the direction as output
+ * for each color in the RGB LED.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Sets the RGB LED to the specified color.
+ * @param color Color to display.
+ *
+ * Writes the precomputed masks of the color: one set and one clear per port, no branches.
+ */
+void setLEDColor(Color color);
+
+/** Set and clear masks of P0 and P3 for every color, computed at compile time. */
+const PINGROUP_Masks colorMasks[8][2] = PINGROUP_TABLE8(COLOR_MASKS);
+
+/** First color sequence. */
+const Color sequence1[SEQUENCE_LENGTH] = {RED, GREEN, BLUE};
+/** Second color sequence. */
+const Color sequence2[SEQUENCE_LENGTH] = {YELLOW, CYAN, MAGENTA};
+
+int main(void) {
+    configGPIO();
+    TIMEBASE_Init();
+
+    while (1) {
+        for (uint8_t i = 0; i < CYCLE_REPEATS; i++) {
+            for (uint8_t j = 0; j < SEQUENCE_LENGTH; j++) {
+                setLEDColor(sequence1[j]);
+                TIMEBASE_DelayMs(STEP_TIME);
+            }
+        }
+        for (uint8_t i = 0; i < CYCLE_REPEATS; i++) {
+            for (uint8_t j = 0; j < SEQUENCE_LENGTH; j++) {
+                setLEDColor(sequence2[j]);
+                TIMEBASE_DelayMs(STEP_TIME);
+            }
+        }
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    RgbLed::select();    // P0.22, P3.25 and P3.26 as GPIO: PINSEL1, then PINSEL7.
+    RgbLed::output();    // P0.22, P3.25 and P3.26 as output: FIODIR of P0, then of P3.
+    RgbLed::set();       // All LEDs off.
+}
+
+void setLEDColor(Color color) {
+    PINGROUP_Write(hal::Port<0>::regs(), &colorMasks[color][0]);    // Red.
+    PINGROUP_Write(hal::Port<3>::regs(), &colorMasks[color][1]);    // Green and blue, together.
+}
@@ -7,8 +7,10 @@
  * The display segments are controlled via driver functions from the LPC17xx library.
  */
 
-#include "LPC17xx_gpio.h"
-#include "LPC17xx_pinsel.h"
+#include "gpiofast.h"
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_pinsel.h"
+#include "sevenseg.h"
 
 /** Generic n-bit mask macro. */
 #define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
@@ -36,8 +38,7 @@ void configGPIO(void);
 void delay();
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
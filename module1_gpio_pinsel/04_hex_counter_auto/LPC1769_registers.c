@@ -8,6 +8,8 @@
  */
 
 #include "LPC17xx.h"
+#include "pinmap.h"
+#include "sevenseg.h"
 
 /** Generic n-bit mask macro. */
 #define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
@@ -15,8 +17,15 @@
 /** Mask for a 7 segments display. */
 #define SVN_SEGS BITS_MASK(7, 0)
 
-/** PCB mask for a 7 segments display. */
-#define SVN_SEGS_PCB BITS_MASK(14, 0)
+/** Pins of the board: P2.0-P2.6 (segments a-g) as GPIO outputs. */
+#define BOARD_PINS(PIN, reg)                                                  \
+    PIN(reg, 2, 0, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 1, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 2, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 3, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 4, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 5, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, 6, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)
 
 /** Number of elements in the digits array. */
 #define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
@@ -38,8 +47,7 @@ void configGPIO(void);
 void delay();
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
@@ -57,12 +65,10 @@ int main(void) {
 }
 
 void configGPIO(void) {
-    LPC_PINCON->PINSEL4 &= ~(SVN_SEGS_PCB);    // P2.0-P2.6 as GPIO.
+    PINMAP_Apply(BOARD_PINS);    // P2.0-P2.6 as GPIO outputs: one PINSEL4 and one FIODIR write.
 
     LPC_GPIO2->FIOMASK = ~(SVN_SEGS);    // Optional: Set mask for protection.
 
-    LPC_GPIO2->FIODIR |= SVN_SEGS;    // P2.0-P2.6 as output.
-
     LPC_GPIO2->FIOCLR = SVN_SEGS;    // Turn off all segments.
 }
 
@@ -0,0 +1,66 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Controls a 7-segment display using GPIO pins on the LPC1769 board.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp:
+ * the display is a range of pins whose masks and PINSEL fields are resolved at compile time.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+#include "sevenseg.h"
+
+/** 7-segment display connected to P2.0-P2.6. */
+using Segments = hal::PinRange<2, 0, 7>;
+
+/** Number of elements in the digits array. */
+#define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
+
+/** Delay constant for LED timing. */
+#define DELAY 2500
+
+/**
+ * @brief Configures GPIO pins P2.0-P2.6 as outputs to control a 7-segment display.
+ *
+ * Sets the pin function to GPIO and sets the direction to output.
+ * Turns off all segments initially.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Generates a blocking delay using nested loops.
+ */
+void delay();
+
+/** Values for hexadecimal digits (0-F). */
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
+
+int main(void) {
+    configGPIO();
+
+    uint32_t i = 0;
+
+    while (1) {
+        Segments::clear();                            // Turn off all segments.
+        hal::Port<2>::set(digits[i % DIGITS_SIZE]);    // Show the current digit.
+
+        i++;
+        delay();
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Segments::select();    // P2.0-P2.6 as GPIO: one PINSEL4 read-modify-write.
+    Segments::output();    // P2.0-P2.6 as output: one FIODIR read-modify-write.
+
+    Segments::exclusive();    // Optional: Set mask for protection.
+
+    Segments::clear();    // Turn off all segments.
+}
+
+void delay() {
+    for (volatile uint32_t i = 0; i < DELAY; i++)
+        for (volatile uint32_t j = 0; j < DELAY; j++)
+            __NOP();
+}
@@ -3,6 +3,7 @@
  * @brief Detects a button press on P0.0 and controls an LED on P2.0 using driver abstraction.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 
@@ -0,0 +1,47 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Detects a button press on P0.0 and controls an LED on P2.0 using the C++ template layer.
+ *
+ * Same program as LPC1769_registers.c: the button and the LED are types of gpiohal.hpp, and
+ * every call compiles to the register access of the register version.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+
+/** Button connected to P0.0. */
+using Button = hal::Pin<0, 0>;
+/** LED connected to P2.0. */
+using Led    = hal::Pin<2, 0>;
+
+/**
+ * @brief Configures GPIO pins for button input (P0.0) and LED output (P2.0).
+ *
+ * Sets up the pin function, mode, and direction for the button and LED.
+ * Ensures the LED is turned off initially.
+ */
+void configGPIO(void);
+
+int main(void) {
+    configGPIO();
+
+    while (1) {
+        if (Button::read())    // Read button state.
+            Led::set();        // Turn on LED.
+        else
+            Led::clear();    // Turn off LED.
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Button::select();    // P0.0 as GPIO.
+    Button::pull();      // P0.0 with pull-up.
+
+    Led::select();    // P2.0 as GPIO.
+
+    Button::input();    // P0.0 as input.
+    Led::output();      // P2.0 as output.
+
+    Led::clear();    // Turn off LED.
+}
@@ -3,8 +3,11 @@
  * @brief Counts high pins on Port 0 and displays the result in binary on 5 LEDs (P2.0–P2.4).
  */
 
-#include "LPC17xx_gpio.h"
-#include "LPC17xx_pinsel.h"
+#include "gpiofast.h"
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_pinsel.h"
+#include "pinselspread.h"
+#include "popcount.h"
 
 /** Generic n-bit mask macro. */
 #define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
@@ -21,25 +24,17 @@
  * Sets P0.0-P0.15 and P1.0-P1.31 as GPIO,
  * P2.0-P2.4 as output for LEDs, and P0.0-P0.31 as input.
  * Sets pull-up resistors for P0 and P1.
- * Clears the LEDs at startup.
+ * Clears the LEDs at startup and gives FIOPIN of port 2 to them.
  */
 void configGPIO(void);
 
-/**
- * @brief Counts the number of bits set to 1 in a 32-bit value.
- *
- * @return Number of bits set to 1 in the input value.
- */
-uint8_t countOnes(uint32_t value);
-
 int main(void) {
     configGPIO();
 
     while (1) {
-        const uint8_t leds = countOnes(GPIO_ReadValue(GPIO_PORT_0) & PORT0_AV_MASK);
+        const uint8_t leds = POPCOUNT_Count(GPIO_ReadValue(GPIO_PORT_0) & PORT0_AV_MASK);
 
-        GPIO_ClearPins(GPIO_PORT_2, LEDS_MASK);    // Turn off all LEDs.
-        GPIO_SetPins(GPIO_PORT_2, leds);           // Displays the count on the LEDs
+        GPIO_WriteValue(GPIO_PORT_2, leds);    // Displays the count on the LEDs, in one store.
     }
     return 0;
 }
@@ -53,23 +48,14 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, PORT0_AV_MASK);    // P0.0-P0.31 as GPIO with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, PORT0_AV_MASK);    // P0.0-P0.31 as GPIO with pull-up.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, LEDS_MASK);    // P2.0-P2.4 as GPIO.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, LEDS_MASK);    // P2.0-P2.4 as GPIO.
 
     GPIO_SetDir(GPIO_PORT_0, PORT0_AV_MASK, GPIO_INPUT);    // P0.0-P0.31 as input.
     GPIO_SetDir(GPIO_PORT_2, LEDS_MASK, GPIO_OUTPUT);       // P2.0-P2.4 as output.
 
-    GPIO_ClearPins(GPIO_PORT_2, LEDS_MASK);    // Turn off the LEDs.
-}
-
-uint8_t countOnes(uint32_t value) {
-    uint8_t count = 0;
-
-    for (uint8_t i = 0; i < 32; i++)
-        if (value & (0x1 << i))
-            count++;
-
-    return count;
+    GPIO_ClearPins(GPIO_PORT_2, LEDS_MASK);            // Turn off the LEDs.
+    GPIO_SetMask(GPIO_PORT_2, ~LEDS_MASK, ENABLE);    // FIOPIN writes drive P2.0-P2.4 only.
 }
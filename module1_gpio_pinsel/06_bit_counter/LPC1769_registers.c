@@ -4,6 +4,8 @@
  */
 
 #include "LPC17xx.h"
+#include "popcount.h"
+#include "portfield.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -24,25 +26,17 @@
  * Sets P0.0-P0.15 and P1.0-P1.31 as GPIO,
  * P2.0-P2.4 as output for LEDs, and P0.0-P0.31 as input.
  * Sets pull-up resistors for P0 and P1.
- * Clears the LEDs at startup.
+ * Clears the LEDs at startup and gives FIOPIN of port 2 to them.
  */
 void configGPIO(void);
 
-/**
- * @brief Counts the number of bits set to 1 in a 32-bit value.
- *
- * @return Number of bits set to 1 in the input value.
- */
-uint8_t countOnes(uint32_t value);
-
 int main(void) {
     configGPIO();
 
     while (1) {
-        const uint8_t leds = countOnes(LPC_GPIO0->FIOPIN & PORT0_AV_MASK);
+        const uint8_t leds = POPCOUNT_Count(LPC_GPIO0->FIOPIN & PORT0_AV_MASK);
 
-        LPC_GPIO2->FIOCLR = LEDS_MASK;    // Turn off all LEDs.
-        LPC_GPIO2->FIOSET = leds;         // Displays the count on the LEDs
+        PORTFIELD_Write(LPC_GPIO2, leds);    // Displays the count on the LEDs, in one store.
     }
     return 0;
 }
@@ -58,15 +52,6 @@ void configGPIO(void) {
     LPC_GPIO0->FIODIR = 0;             // P0.0-P0.31 as input.
     LPC_GPIO2->FIODIR |= LEDS_MASK;    // P2.0-P2.4 as output.
 
-    LPC_GPIO2->FIOCLR = LEDS_MASK;    // Turn off all LEDs.
-}
-
-uint8_t countOnes(uint32_t value) {
-    uint8_t count = 0;
-
-    for (uint8_t i = 0; i < 32; i++)
-        if (value & (0x1 << i))
-            count++;
-
-    return count;
+    LPC_GPIO2->FIOCLR = LEDS_MASK;          // Turn off all LEDs.
+    PORTFIELD_Own(LPC_GPIO2, LEDS_MASK);    // FIOPIN writes drive P2.0-P2.4 only.
 }
@@ -0,0 +1,51 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Counts high pins on Port 0 and displays the result in binary on 5 LEDs (P2.0–P2.4).
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp.
+ * Port 0 is a range covering whole registers, so it is configured with plain writes.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+#include "popcount.h"
+
+/** The 5 LEDs connected to P2.0-P2.4. */
+using Leds      = hal::PinRange<2, 0, 5>;
+/** Every pin of port 0, configured together. */
+using Port0     = hal::PinRange<0, 0, 32>;
+/** Available pins on port 0. */
+using Available = hal::PortPins<0, 0x7FFF8FFF>;
+
+/**
+ * @brief Configures the GPIO pins for the LEDs and input port.
+ *
+ * Sets P0.0-P0.31 as GPIO, P2.0-P2.4 as output for LEDs, and P0.0-P0.31 as input.
+ * Sets pull-up resistors for P0.
+ * Clears the LEDs at startup and gives FIOPIN of port 2 to them.
+ */
+void configGPIO(void);
+
+int main(void) {
+    configGPIO();
+
+    while (1) {
+        const uint8_t leds = POPCOUNT_Count(Available::read());
+
+        hal::Port<2>::write(leds);    // Displays the count on the LEDs, in one store.
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Port0::select();    // P0.0-P0.31 as GPIO: PINSEL0 and PINSEL1 written, not read.
+    Leds::select();     // P2.0-P2.4 as GPIO.
+
+    Port0::pull();    // P0.0-P0.31 with pull-up: PINMODE0 and PINMODE1 written, not read.
+
+    Port0::input();    // P0.0-P0.31 as input.
+    Leds::output();    // P2.0-P2.4 as output.
+
+    Leds::clear();        // Turn off all LEDs.
+    Leds::exclusive();    // FIOPIN writes drive P2.0-P2.4 only.
+}
@@ -1,11 +1,16 @@
 /**
  * @file LPC1769_CMSIS_drivers.c
  * @brief Controls a 7-segment display using GPIO pins on the LPC1769 board.
- *        Increments the displayed digit (0-F) on each button press (P0.0).
+ *        Increments the displayed digit (0-F) on each button press (P0.0); a long press resets it.
  */
 
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "lpc17xx_systick.h"
+#include "debounce.h"
+#include "gpiofast.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -23,8 +28,10 @@
 /** Number of elements in the digits array. */
 #define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
 
-/** Delay constant for LED timing. */
-#define DELAY 2500
+/** Button sampling period in milliseconds. */
+#define TICK_MS       (5)
+/** Hold time of a long press (reset to 0), in milliseconds. */
+#define LONG_PRESS_MS (1000)
 
 /**
  * @brief Configures GPIO pins P2.0-P2.6 as outputs to control a 7-segment display.
@@ -35,30 +42,34 @@
 void configGPIO(void);
 
 /**
- * @brief Waits for a debounced button press on P0.0.
- * @return 1 if a valid press was detected.
+ * @brief Configures SysTick to interrupt every TICK_MS milliseconds to sample the button.
  */
-uint8_t debounceButton(void);
+void configSysTick(void);
 
-/**
- * @brief Generates a blocking delay using nested loops.
- */
-void delay();
+/** Debouncer of the button, updated by SysTick_Handler(). */
+DEBOUNCE_Type button;
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
+    DEBOUNCE_Init(&button, BTN_BIT, BTN_BIT, LONG_PRESS_MS / TICK_MS);    // Active low.
+    configSysTick();
 
     uint32_t i = 1;
 
     while (1) {
-        if (debounceButton()) {
+        __WFI();    // Sleep until the next tick: the button is never polled here.
+
+        if (DEBOUNCE_GetPressed(&button) & BTN_BIT) {
             GPIO_WriteValue(GPIO_PORT_2, digits[i % DIGITS_SIZE]);
             i++;
         }
+        if (DEBOUNCE_GetLongPressed(&button) & BTN_BIT) {
+            GPIO_WriteValue(GPIO_PORT_2, digits[0]);
+            i = 1;
+        }
     }
     return 0;
 }
@@ -75,7 +86,7 @@ void configGPIO(void) {
     PINSEL_ConfigPin(&pinCfg);    // Configure P0.0 as GPIO with pull-up.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, SVN_SEGS);    // P2.0-P2.6 as GPIO.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SVN_SEGS);    // P2.0-P2.6 as GPIO.
 
     GPIO_SetDir(GPIO_PORT_0, BTN_BIT, GPIO_INPUT);      // P0.0 as input.
     GPIO_SetDir(GPIO_PORT_2, SVN_SEGS, GPIO_OUTPUT);    // P2.0-P2.6 as output.
@@ -84,20 +95,10 @@ void configGPIO(void) {
     GPIO_WriteValue(GPIO_PORT_2, digits[0]);    // Start with digit 0.
 }
 
-uint8_t debounceButton(void) {
-    if (!(GPIO_ReadValue(GPIO_PORT_0) & BTN_BIT)) {    // Button pressed.
-        delay();                                       // Debounce delay.
-
-        if (!(GPIO_ReadValue(GPIO_PORT_0) & BTN_BIT)) {            // Confirm still pressed.
-            while (!(GPIO_ReadValue(GPIO_PORT_0) & BTN_BIT)) {}    // Wait for release.
-            return 1;
-        }
-    }
-    return 0;
+void configSysTick(void) {
+    SYSTICK_InternalInit(TICK_MS);    // Interrupt every TICK_MS milliseconds.
+    SYSTICK_IntCmd(ENABLE);           // Enable SysTick interrupt.
+    SYSTICK_Cmd(ENABLE);              // Enable SysTick counter.
 }
 
-void delay() {
-    for (volatile uint32_t i = 0; i < DELAY; i++)
-        for (volatile uint32_t j = 0; j < DELAY; j++)
-            ;
-}
+void SysTick_Handler(void) { DEBOUNCE_Update(&button, GPIO_ReadValue(GPIO_PORT_0)); }
@@ -1,10 +1,12 @@
 /**
  * @file LPC1769_registers.c
  * @brief Controls a 7-segment display using GPIO pins on the LPC1769 board.
- *        Increments the displayed digit (0-F) on each button press (P0.0).
+ *        Increments the displayed digit (0-F) on each button press (P0.0); a long press resets it.
  */
 
 #include "LPC17xx.h"
+#include "debounce.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -27,8 +29,10 @@
 /** Number of elements in the digits array. */
 #define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
 
-/** Delay constant for LED timing. */
-#define DELAY 2500
+/** Button sampling period in milliseconds. */
+#define TICK_MS       (5)
+/** Hold time of a long press (reset to 0), in milliseconds. */
+#define LONG_PRESS_MS (1000)
 
 /**
  * @brief Configures GPIO pins P2.0-P2.6 as outputs to control a 7-segment display.
@@ -39,31 +43,36 @@
 void configGPIO(void);
 
 /**
- * @brief Waits for a debounced button press on P0.0.
- * @return 1 if a valid press was detected.
+ * @brief Configures SysTick to interrupt every TICK_MS milliseconds to sample the button.
  */
-uint8_t debounceButton(void);
+void configSysTick(void);
 
-/**
- * @brief Generates a blocking delay using nested loops.
- */
-void delay();
+/** Debouncer of the button, updated by SysTick_Handler(). */
+DEBOUNCE_Type button;
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
+    DEBOUNCE_Init(&button, BTN_BIT, BTN_BIT, LONG_PRESS_MS / TICK_MS);    // Active low.
+    configSysTick();
 
     uint32_t i = 1;
 
     while (1) {
-        if (debounceButton()) {
+        __WFI();    // Sleep until the next tick: the button is never polled here.
+
+        if (DEBOUNCE_GetPressed(&button) & BTN_BIT) {
             LPC_GPIO2->FIOCLR = SVN_SEGS;                   // Turns off all segments.
             LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Sets segments for current digit.
             i++;
         }
+        if (DEBOUNCE_GetLongPressed(&button) & BTN_BIT) {
+            LPC_GPIO2->FIOCLR = SVN_SEGS;     // Turns off all segments.
+            LPC_GPIO2->FIOSET = digits[0];    // Back to digit 0.
+            i = 1;
+        }
     }
     return 0;
 }
@@ -80,20 +89,8 @@ void configGPIO(void) {
     LPC_GPIO2->FIOSET = digits[0];    // Start with digit 0.
 }
 
-uint8_t debounceButton(void) {
-    if (!(LPC_GPIO0->FIOPIN & BTN_BIT)) {    // Button pressed.
-        delay();                             // Debounce delay
-
-        if (!(LPC_GPIO0->FIOPIN & BTN_BIT)) {            // Confirm still pressed
-            while (!(LPC_GPIO0->FIOPIN & BTN_BIT)) {}    // Wait for release
-            return 1;
-        }
-    }
-    return 0;
+void configSysTick(void) {
+    SysTick_Config(SystemCoreClock / 1000 * TICK_MS);    // Interrupt every TICK_MS milliseconds.
 }
 
-void delay() {
-    for (volatile uint32_t i = 0; i < DELAY; i++)
-        for (volatile uint32_t j = 0; j < DELAY; j++)
-            __NOP();
-}
+void SysTick_Handler(void) { DEBOUNCE_Update(&button, LPC_GPIO0->FIOPIN); }
@@ -0,0 +1,86 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Controls a 7-segment display using GPIO pins on the LPC1769 board.
+ *        Increments the displayed digit (0-F) on each button press (P0.0); a long press resets it.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp.
+ */
+
+#include "LPC17xx.h"
+#include "debounce.h"
+#include "gpiohal.hpp"
+#include "sevenseg.h"
+
+/** Button connected to P0.0. */
+using Button   = hal::Pin<0, 0>;
+/** 7-segment display connected to P2.0-P2.6. */
+using Segments = hal::PinRange<2, 0, 7>;
+
+/** Number of elements in the digits array. */
+#define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
+
+/** Button sampling period in milliseconds. */
+#define TICK_MS       (5)
+/** Hold time of a long press (reset to 0), in milliseconds. */
+#define LONG_PRESS_MS (1000)
+
+/**
+ * @brief Configures GPIO pins P2.0-P2.6 as outputs to control a 7-segment display.
+ *
+ * Sets the pin function to GPIO and sets the direction to output.
+ * Turns off all segments initially.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Configures SysTick to interrupt every TICK_MS milliseconds to sample the button.
+ */
+void configSysTick(void);
+
+/** Debouncer of the button, updated by SysTick_Handler(). */
+DEBOUNCE_Type button;
+
+/** Values for hexadecimal digits (0-F). */
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
+
+int main(void) {
+    configGPIO();
+    DEBOUNCE_Init(&button, Button::MASK, Button::MASK, LONG_PRESS_MS / TICK_MS);    // Active low.
+    configSysTick();
+
+    uint32_t i = 1;
+
+    while (1) {
+        __WFI();    // Sleep until the next tick: the button is never polled here.
+
+        if (DEBOUNCE_GetPressed(&button) & Button::MASK) {
+            Segments::clear();                            // Turns off all segments.
+            hal::Port<2>::set(digits[i % DIGITS_SIZE]);    // Sets segments for current digit.
+            i++;
+        }
+        if (DEBOUNCE_GetLongPressed(&button) & Button::MASK) {
+            Segments::clear();               // Turns off all segments.
+            hal::Port<2>::set(digits[0]);    // Back to digit 0.
+            i = 1;
+        }
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Button::select();    // P0.0 as GPIO.
+    Button::pull();      // P0.0 with pull-up.
+    Button::input();     // P0.0 as input.
+
+    Segments::select();    // P2.0-P2.6 as GPIO.
+    Segments::output();    // P2.0-P2.6 as output.
+
+    Segments::clear();               // Turns off all segments.
+    hal::Port<2>::set(digits[0]);    // Start with digit 0.
+}
+
+void configSysTick(void) {
+    SysTick_Config(SystemCoreClock / 1000 * TICK_MS);    // Interrupt every TICK_MS milliseconds.
+}
+
+void SysTick_Handler(void) { DEBOUNCE_Update(&button, hal::Port<0>::read()); }
@@ -3,8 +3,11 @@
  * @brief GPIO and 7-segment display control for LPC1769.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -32,8 +35,7 @@ void delay();
 /**
  * @brief Array of segment values for hexadecimal digits (0-F).
  */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
@@ -54,10 +56,10 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, INPUT_PINS);    // P0.0-P0.3 as GPIO with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, INPUT_PINS);    // P0.0-P0.3 as GPIO with pull-up.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, SVN_SEGS);    // P2.0-P2.6 as GPIO
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SVN_SEGS);    // P2.0-P2.6 as GPIO
 
     GPIO_SetDir(GPIO_PORT_0, INPUT_PINS, GPIO_INPUT);    // P0.0-P0.3 as input.
     GPIO_SetDir(GPIO_PORT_2, SVN_SEGS, GPIO_OUTPUT);     // P2.0-P2.6 as output.
@@ -4,6 +4,7 @@
  */
 
 #include "LPC17xx.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -34,8 +35,7 @@ void configGPIO(void);
 void delay();
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 int main(void) {
     configGPIO();
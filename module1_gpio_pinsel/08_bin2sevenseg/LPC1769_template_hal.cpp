@@ -0,0 +1,50 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief GPIO and 7-segment display control for LPC1769, with the C++ template layer.
+ *
+ * Same program as LPC1769_registers.c: the inputs and the display are pin ranges of
+ * gpiohal.hpp, and every call compiles to the register access of the register version.
+ */
+
+#include "LPC17xx.h"
+#include "gpiohal.hpp"
+#include "sevenseg.h"
+
+/** Binary input connected to P0.0-P0.3. */
+using Inputs   = hal::PinRange<0, 0, 4>;
+/** 7-segment display connected to P2.0-P2.6. */
+using Segments = hal::PinRange<2, 0, 7>;
+
+/**
+ * @brief Configures GPIO pins P2.0-P2.6 as outputs to control a 7-segment display.
+ *
+ * Sets the pin function to GPIO and sets the direction to output.
+ * Turns off all segments initially.
+ */
+void configGPIO(void);
+
+/** Values for hexadecimal digits (0-F). */
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
+
+int main(void) {
+    configGPIO();
+
+    while (1) {
+        uint32_t value = Inputs::read();    // Read P0.0-P0.3
+
+        Segments::clear();                 // Clear all segments.
+        hal::Port<2>::set(digits[value]);    // Display the value on the 7-segment display.
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Inputs::select();    // P0.0-P0.3 as GPIO.
+    Inputs::pull();      // P0.0-P0.3 with pull-up.
+    Inputs::input();     // P0.0-P0.3 as input.
+
+    Segments::select();    // P2.0-P2.6 as GPIO.
+    Segments::output();    // P2.0-P2.6 as output.
+
+    Segments::clear();    // Turns off all segments.
+}
@@ -1,10 +1,13 @@
 /**
  * @file LPC1769_CMSIS_drivers.c
- * @brief Implements 4-bit ALU operations (add, subtract) using GPIO on LPC1769.
+ * @brief Implements a table-driven 4-bit ALU (add, subtract, logic, shifts, multiply) using GPIO on LPC1769.
  */
 
+#include "alu4.h"
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "pinselspread.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -15,50 +18,34 @@
 #define A_MASK   BITS_MASK(4, 0)
 /** Bit mask for the B operand (P0.4-P0.7). */
 #define B_MASK   BITS_MASK(4, 4)
-/** Bit mask for the operation selector (P0.8). */
-#define OP_MASK  BIT_MASK(8)
+/** Bit mask for the operation selectors (P0.8-P0.10). */
+#define OP_MASK  BITS_MASK(3, 8)
 /** Bit mask for the result display (P2.0-P2.3). */
 #define LED_MASK BITS_MASK(4, 0)
 /** Bit mask for the overflow indicator (P2.4). */
 #define OVF_LED  BIT_MASK(4)
 
-/**
- *  @brief Configures GPIO pins P2.0-P2.3 as outputs for the 4-bit ALU result display using LEDs,
- *  and P2.4 as output for the overflow indicator LED.
- */
-void configGPIO(void);
+/** Output word (P2.0-P2.4) of every input word (P0.0-P0.10). */
+static const uint8_t aluTable[ALU4_ENTRIES] = ALU4_TABLE;
 
 /**
- * @brief Adds two 4-bit values and sets the overflow LED if the result exceeds 4 bits.
- * @param A First 4-bit operand.
- * @param B Second 4-bit operand.
- * @return 4-bit result of A + B.
+ *  @brief Configures GPIO pins P0.0-P0.10 as inputs with pull-up for the operands and the operation,
+ *  P2.0-P2.3 as outputs for the 4-bit ALU result display using LEDs and P2.4 as output for the
+ *  overflow indicator LED. FIOMASK leaves only these pins in FIOPIN of both ports.
  */
-uint8_t add(uint8_t A, uint8_t B);
-
-/**
- * @brief Subtracts two 4-bit values and sets the overflow LED if the result is negative.
- * @param A Minuend (first 4-bit operand).
- * @param B Subtrahend (second 4-bit operand).
- * @return 4-bit absolute value of the subtraction.
- */
-uint8_t subtract(uint8_t A, uint8_t B);
+void configGPIO(void);
 
 int main(void) {
+    uint32_t last = ALU4_ENTRIES;    // No input word yet: the LEDs are set on the first pass.
+
     configGPIO();
 
     while (1) {
-        uint8_t A = GPIO_ReadValue(GPIO_PORT_0) & A_MASK;           // Read P0.0-P0.3
-        uint8_t B = (GPIO_ReadValue(GPIO_PORT_0) & B_MASK) >> 4;    // Read P0.4-P0.7
-
-        if (GPIO_ReadValue(GPIO_PORT_0) & OP_MASK) {    // Read P0.8
-            const uint8_t result = add(A, B);           // Perform addition.
-            GPIO_ClearPins(GPIO_PORT_2, LED_MASK);
-            GPIO_SetPins(GPIO_PORT_2, result);
-        } else {
-            const uint8_t result = subtract(A, B);    // Perform subtraction.
-            GPIO_ClearPins(GPIO_PORT_2, LED_MASK);
-            GPIO_SetPins(GPIO_PORT_2, result);
+        const uint32_t inputs = GPIO_ReadValue(GPIO_PORT_0);    // Read P0.0-P0.10: A | B << 4 | OP << 8.
+
+        if (inputs != last) {
+            GPIO_WriteValue(GPIO_PORT_2, aluTable[inputs]);    // Result and overflow LED in one write.
+            last = inputs;
         }
     }
     return 0;
@@ -73,35 +60,16 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, A_MASK | B_MASK | OP_MASK);    // P0.0-P0.8 as GPIO with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, A_MASK | B_MASK | OP_MASK);    // P0.0-P0.10 as GPIO with pull-up.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, LED_MASK | OVF_LED);    // P2.0-P2.4 as GPIO.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, LED_MASK | OVF_LED);    // P2.0-P2.4 as GPIO.
 
-    GPIO_SetDir(GPIO_PORT_0, A_MASK | B_MASK | OP_MASK, GPIO_INPUT);    // P0.0-P0.8 as input.
+    GPIO_SetDir(GPIO_PORT_0, A_MASK | B_MASK | OP_MASK, GPIO_INPUT);    // P0.0-P0.10 as input.
     GPIO_SetDir(GPIO_PORT_2, LED_MASK | OVF_LED, GPIO_OUTPUT);          // P2.0-P2.4 as output.
-}
 
-uint8_t add(uint8_t A, uint8_t B) {
-    uint8_t result = A + B;    // Perform addition.
+    GPIO_SetMask(GPIO_PORT_0, ~(A_MASK | B_MASK | OP_MASK), ENABLE);    // FIOPIN reads the table index.
+    GPIO_SetMask(GPIO_PORT_2, ~(LED_MASK | OVF_LED), ENABLE);           // FIOPIN writes only the LEDs.
 
-    if (result > 0x0F) {                       // Check for overflow.
-        GPIO_SetPins(GPIO_PORT_2, OVF_LED);    // Set overflow LED.
-        result &= 0x0F;                        // Mask to 4 bits.
-    } else {
-        GPIO_ClearPins(GPIO_PORT_2, OVF_LED);    // Clear overflow LED.
-    }
-    return result;
-}
-
-uint8_t subtract(uint8_t A, uint8_t B) {
-    uint8_t result;
-    if (B > A) {                               // Check for negative result.
-        GPIO_SetPins(GPIO_PORT_2, OVF_LED);    // Set overflow LED.
-        result = B - A;                        // Absolute value of subtraction.
-    } else {
-        GPIO_ClearPins(GPIO_PORT_2, OVF_LED);    // Clear overflow LED.
-        result = A - B;                          // Normal subtraction.
-    }
-    return result;
+    GPIO_WriteValue(GPIO_PORT_2, 0);    // Turn off all LEDs.
 }
@@ -0,0 +1,55 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Implements a table-driven 4-bit ALU (add, subtract, logic, shifts, multiply) using GPIO on LPC1769.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp.
+ */
+
+#include "LPC17xx.h"
+#include "alu4.h"
+#include "gpiohal.hpp"
+
+/** Operand A (P0.0-P0.3), operand B (P0.4-P0.7) and operation (P0.8-P0.10): the table index. */
+using Inputs = hal::PinRange<0, 0, 11>;
+/** Result LEDs (P2.0-P2.3) and overflow LED (P2.4). */
+using Leds   = hal::PinRange<2, 0, 5>;
+
+/** Output word (P2.0-P2.4) of every input word (P0.0-P0.10). */
+static const uint8_t aluTable[ALU4_ENTRIES] = ALU4_TABLE;
+
+/**
+ *  @brief Configures GPIO pins P0.0-P0.10 as inputs with pull-up for the operands and the operation,
+ *  P2.0-P2.3 as outputs for the 4-bit ALU result display using LEDs and P2.4 as output for the
+ *  overflow indicator LED. FIOMASK leaves only these pins in FIOPIN of both ports.
+ */
+void configGPIO(void);
+
+int main(void) {
+    uint32_t last = ALU4_ENTRIES;    // No input word yet: the LEDs are set on the first pass.
+
+    configGPIO();
+
+    while (1) {
+        const uint32_t inputs = hal::Port<0>::read();    // Read P0.0-P0.10: A | B << 4 | OP << 8.
+
+        if (inputs != last) {
+            hal::Port<2>::write(aluTable[inputs]);    // Result and overflow LED in one write.
+            last = inputs;
+        }
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Inputs::select();    // P0.0-P0.10 as GPIO.
+    Inputs::pull();      // P0.0-P0.10 as pull-up.
+    Leds::select();      // P2.0-P2.4 as GPIO.
+
+    Inputs::input();    // P0.0-P0.10 as input.
+    Leds::output();     // P2.0-P2.4 as output.
+
+    Inputs::exclusive();    // FIOPIN reads the table index.
+    Leds::exclusive();      // FIOPIN writes only the LEDs.
+
+    hal::Port<2>::write(0);    // Turn off all LEDs.
+}
@@ -5,6 +5,10 @@
 
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "filter.h"
+#include "gpiofast.h"
+#include "pinselspread.h"
+#include "timebase.h"
 
 /** Generic n-bit mask macro. */
 #define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
@@ -14,10 +18,10 @@
 /** Bit mask for the output pins (P2.0-P2.7). */
 #define OUTPUT_MASK BITS_MASK(8, 0)
 
-/** Size of the moving average buffer. */
-#define BUFFER_SIZE 8
-/** Delay constant for LED timing. */
-#define DELAY       2500
+/** Moving average window: 2^LOG2_WINDOW = 8 samples. */
+#define LOG2_WINDOW 3
+/** Sampling period in milliseconds. */
+#define STEP_TIME   250
 
 /**
  * @brief @brief Configures GPIO pins P0.0–P0.7 as inputs for sampling and P2.0–P2.7 as outputs
@@ -25,31 +29,24 @@
  */
 void configGPIO(void);
 
-/**
- * @brief Generates a blocking delay using nested loops.
- * Used to control the LED blink timing.
- */
-void delay();
-
 int main(void) {
     configGPIO();
+    TIMEBASE_Init();
 
-    uint32_t i                  = 0;
-    uint8_t buffer[BUFFER_SIZE] = {0};
-    uint16_t sum                = 0;
+    FILTER_MA_Type filter;
+    uint16_t window[FILTER_MA_SIZE(1, LOG2_WINDOW)];
+    uint32_t sum;
+    uint16_t sample, avg;
 
-    while (1) {
-        sum -= buffer[i % BUFFER_SIZE];                                        // Subtract the oldest sample.
-        buffer[i % BUFFER_SIZE] = GPIO_ReadValue(GPIO_PORT_0) & INPUT_MASK;    // Read new sample.
-        sum += buffer[i % BUFFER_SIZE];                                        // Add the new sample.
+    FILTER_MA_Init(&filter, window, &sum, 1, LOG2_WINDOW);
 
-        const uint8_t avg = sum / BUFFER_SIZE;    // Calculate the average.
+    while (1) {
+        sample = GPIO_ReadValue(GPIO_PORT_0) & INPUT_MASK;    // Read new sample.
+        FILTER_MA_Update(&filter, &sample, &avg);             // Replace the oldest sample and average.
 
-        GPIO_ClearPins(GPIO_PORT_2, OUTPUT_MASK);
-        GPIO_SetPins(GPIO_PORT_2, avg);
+        GPIO_WriteValue(GPIO_PORT_2, avg);    // P2.0-P2.7 in one store.
 
-        i++;
-        delay();
+        TIMEBASE_DelayMs(STEP_TIME);
     }
     return 0;
 }
@@ -63,19 +60,14 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, INPUT_MASK);    // P0.0-P0.7 as GPIO inputs with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, INPUT_MASK);    // P0.0-P0.7 as GPIO inputs with pull-up.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, OUTPUT_MASK);    // P2.0-P2.7 as GPIO outputs.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, OUTPUT_MASK);    // P2.0-P2.7 as GPIO outputs.
 
     GPIO_SetDir(GPIO_PORT_0, INPUT_MASK, GPIO_INPUT);      // P0.0–P0.7 as input.
     GPIO_SetDir(GPIO_PORT_2, OUTPUT_MASK, GPIO_OUTPUT);    // P2.0–P2.7 as output.
 
-    GPIO_ClearPins(GPIO_PORT_2, OUTPUT_MASK);    // Turn off LEDs.
-}
-
-void delay() {
-    for (volatile uint32_t i = 0; i < DELAY; i++)
-        for (volatile uint32_t j = 0; j < DELAY; j++)
-            __NOP();
+    GPIO_ClearPins(GPIO_PORT_2, OUTPUT_MASK);            // Turn off LEDs.
+    GPIO_SetMask(GPIO_PORT_2, ~OUTPUT_MASK, ENABLE);    // FIOPIN writes drive P2.0-P2.7 only.
 }
@@ -4,6 +4,9 @@
  */
 
 #include "LPC17xx.h"
+#include "filter.h"
+#include "portfield.h"
+#include "timebase.h"
 
 /** Generic n-bit mask macro. */
 #define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
@@ -17,10 +20,10 @@
 /** Double bit mask for the output pins (P2.0-P2.7). */
 #define OUTPUT_MASK_DB BITS_MASK(16, 0)
 
-/** Size of the moving average buffer. */
-#define BUFFER_SIZE 8
-/** Delay constant for LED timing. */
-#define DELAY       2500
+/** Moving average window: 2^LOG2_WINDOW = 8 samples. */
+#define LOG2_WINDOW 3
+/** Sampling period in milliseconds. */
+#define STEP_TIME   250
 
 /**
  * @brief @brief Configures GPIO pins P0.0–P0.7 as inputs for sampling and P2.0–P2.7 as outputs
@@ -28,31 +31,24 @@
  */
 void configGPIO(void);
 
-/**
- * @brief Generates a blocking delay using nested loops.
- * Used to control the LED blink timing.
- */
-void delay();
-
 int main(void) {
     configGPIO();
+    TIMEBASE_Init();
 
-    uint32_t i                  = 0;
-    uint8_t buffer[BUFFER_SIZE] = {0};
-    uint16_t sum                = 0;
+    FILTER_MA_Type filter;
+    uint16_t window[FILTER_MA_SIZE(1, LOG2_WINDOW)];
+    uint32_t sum;
+    uint16_t sample, avg;
 
-    while (1) {
-        sum -= buffer[i % BUFFER_SIZE];                              // Subtract the oldest sample.
-        buffer[i % BUFFER_SIZE] = LPC_GPIO0->FIOPIN & INPUT_MASK;    // Read new sample.
-        sum += buffer[i % BUFFER_SIZE];                              // Add the new sample.
+    FILTER_MA_Init(&filter, window, &sum, 1, LOG2_WINDOW);
 
-        const uint8_t avg = sum / BUFFER_SIZE;    // Calculate the average.
+    while (1) {
+        sample = LPC_GPIO0->FIOPIN & INPUT_MASK;     // Read new sample.
+        FILTER_MA_Update(&filter, &sample, &avg);    // Replace the oldest sample and average.
 
-        LPC_GPIO2->FIOCLR = OUTPUT_MASK;
-        LPC_GPIO2->FIOSET = avg;
+        PORTFIELD_WriteByte(LPC_GPIO2, 0, avg);    // P2.0-P2.7 in one store (FIO2PIN0).
 
-        i++;
-        delay();
+        TIMEBASE_DelayMs(STEP_TIME);
     }
     return 0;
 }
@@ -66,9 +62,3 @@ void configGPIO(void) {
 
     LPC_GPIO2->FIOCLR = OUTPUT_MASK;    // Turn off LEDs.
 }
-
-void delay() {
-    for (volatile uint32_t i = 0; i < DELAY; i++)
-        for (volatile uint32_t j = 0; j < DELAY; j++)
-            __NOP();
-}
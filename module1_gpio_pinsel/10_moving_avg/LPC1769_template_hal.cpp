@@ -0,0 +1,59 @@
+/**
+ * @file LPC1769_template_hal.cpp
+ * @brief Implements an 8-sample moving average calculator using GPIO on LPC1769.
+ *
+ * Same program as LPC1769_registers.c, written with the C++ template layer of gpiohal.hpp.
+ */
+
+#include "LPC17xx.h"
+#include "filter.h"
+#include "gpiohal.hpp"
+#include "timebase.h"
+
+/** Sample input on P0.0-P0.7. */
+using Inputs  = hal::PinRange<0, 0, 8>;
+/** Average output on P2.0-P2.7. */
+using Outputs = hal::PinRange<2, 0, 8>;
+
+/** Moving average window: 2^LOG2_WINDOW = 8 samples. */
+#define LOG2_WINDOW 3
+/** Sampling period in milliseconds. */
+#define STEP_TIME   250
+
+/**
+ * @brief Configures GPIO pins P0.0–P0.7 as inputs for sampling and P2.0–P2.7 as outputs
+ * for displaying the moving average result.
+ */
+void configGPIO(void);
+
+int main(void) {
+    configGPIO();
+    TIMEBASE_Init();
+
+    FILTER_MA_Type filter;
+    uint16_t window[FILTER_MA_SIZE(1, LOG2_WINDOW)];
+    uint32_t sum;
+    uint16_t sample, avg;
+
+    FILTER_MA_Init(&filter, window, &sum, 1, LOG2_WINDOW);
+
+    while (1) {
+        sample = Inputs::read();                     // Read new sample.
+        FILTER_MA_Update(&filter, &sample, &avg);    // Replace the oldest sample and average.
+
+        Outputs::write(avg);    // P2.0-P2.7 in one store (FIO2PIN0).
+
+        TIMEBASE_DelayMs(STEP_TIME);
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    Inputs::select();     // P0.0-P0.7 as GPIO.
+    Outputs::select();    // P2.0-P2.7 as GPIO.
+
+    Inputs::input();      // P0.0–P0.7 as input.
+    Outputs::output();    // P2.0–P2.7 as output.
+
+    Outputs::clear();    // Turn off LEDs.
+}
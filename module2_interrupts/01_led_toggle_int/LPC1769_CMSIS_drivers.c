@@ -6,6 +6,7 @@
  * Pressing the button triggers an external interrupt (EINT0) that toggles the LED.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_exti.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
@@ -9,6 +9,10 @@
 
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "gpiofast.h"
+#include "gpioirq.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -40,13 +44,20 @@ void configGPIO(void);
 /**
  * @brief Configures GPIO interrupt for the button on P0.0.
  *
- * Enables rising edge interrupt for P0.0 and enables the EINT3 interrupt in the NVIC.
+ * Registers buttonPressed() for the rising edge of P0.0 with the GPIO interrupt dispatcher,
+ * which enables the EINT3 interrupt in the NVIC.
  */
 void configInt(void);
 
+/**
+ * @brief Shows the next digit. Called by the dispatcher on each rising edge of P0.0.
+ *
+ * @param arg Unused.
+ */
+void buttonPressed(void* arg);
+
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 /** Current index for the digits array. */
 volatile uint32_t i = 0;
@@ -74,7 +85,7 @@ void configGPIO(void) {
 
     pinCfg.portNum = PINSEL_PORT_2;    // Configure P2.0-P2.6.
 
-    PINSEL_ConfigMultiplePins(&pinCfg, SVN_SGS_BITS);    // P2.0-P2.6 as GPIO.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SVN_SGS_BITS);    // P2.0-P2.6 as GPIO.
 
     GPIO_SetDir(GPIO_PORT_0, BTN_BIT, GPIO_INPUT);          // P0.0 as input.
     GPIO_SetDir(GPIO_PORT_2, SVN_SGS_BITS, GPIO_OUTPUT);    // P2.0-P2.6 as output.
@@ -85,15 +96,12 @@ void configGPIO(void) {
 }
 
 void configInt(void) {
-    GPIO_IntCmd(GPIO_PORT_0, BTN_BIT, GPIO_INT_RISING);    // Enable rising edge interrupt on P0.0.
-
-    NVIC_EnableIRQ(EINT3_IRQn);    // Enable EINT3 interrupt in NVIC.
+    GPIOIRQ_Attach(0, BTN, GPIOIRQ_RISING, buttonPressed, 0);    // Rising edge interrupt on P0.0.
 }
 
-void EINT3_IRQHandler(void) {
+void buttonPressed(void* arg) {
+    (void)arg;
     GPIO_ClearPins(GPIO_PORT_2, SVN_SGS_BITS);             // Turns off all segments.
     GPIO_SetPins(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Sets segments for current digit.
     i++;
-
-    GPIO_ClearInt(GPIO_PORT_0, BTN_BIT);    // Clears the interrupt for P0.0.
 }
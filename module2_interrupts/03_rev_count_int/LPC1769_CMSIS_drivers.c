@@ -6,11 +6,17 @@
  * This example configures GPIO pins for a button (P2.13) and a 7-segment display (P2.0-P2.6)
  * on the LPC1769 microcontroller. The main loop increments the displayed hexadecimal digit (0-F),
  * while pressing the button triggers an EINT3 interrupt that decrements the digit.
+ * The handler only posts an event; the decrement and its delay run in PendSV, at the lowest
+ * priority, so the handler no longer blocks other interrupts for a whole delay.
  */
 
 #include "lpc17xx_exti.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "evqueue.h"
+#include "gpiofast.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -35,6 +41,13 @@
 /** Delay constant for LED timing. */
 #define DELAY (2500)
 
+/** Capacity of the event queue (power of 2). */
+#define QUEUE_SIZE  (4)
+/** Lowest interrupt priority, used for PendSV. */
+#define LOWEST_PRIO ((1 << __NVIC_PRIO_BITS) - 1)
+/** Event: count one step down. */
+#define EV_DOWN     (0)
+
 /**
  * @brief Configures GPIO pins for button input and 7-segment display output.
  *
@@ -58,13 +71,19 @@ void configInt(void);
 void delay();
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 /** Current index for the digits array. */
 volatile uint32_t i = 0;
 
+/** Events posted by EINT3_IRQHandler. */
+EVQUEUE_Type queue;
+/** Storage of the event queue. */
+uint32_t buffer[QUEUE_SIZE];
+
 int main(void) {
+    EVQUEUE_Init(&queue, buffer, QUEUE_SIZE);
+
     configGPIO();
     configInt();
 
@@ -88,7 +107,7 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, SVN_SGS_BITS);    // P2.0-P2.6 as GPIO.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SVN_SGS_BITS);    // P2.0-P2.6 as GPIO.
 
     pinCfg.funcNum = PINSEL_FUNC_1;
     PINSEL_ConfigPin(&pinCfg);    // P2.13 as EINT3.
@@ -108,16 +127,30 @@ void configInt(void) {
     extiCfg.polarity      = EXTI_LOW_ACTIVE;         // Low active polarity.
 
     EXTI_ConfigEnable(&extiCfg);    // Configure EINT3.
+
+    NVIC_SetPriority(PendSV_IRQn, LOWEST_PRIO);    // Deferred work below every interrupt.
 }
 
 void EINT3_IRQHandler(void) {
-    i--;
-    GPIO_ClearPins(GPIO_PORT_2, SVN_SGS_BITS);             // Turns off all segments.
-    GPIO_SetPins(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Start with digit 0.
+    NVIC_DisableIRQ(EINT3_IRQn);    // Level-sensitive: off until the step is done.
+    EVQUEUE_Post(&queue, EV_DOWN);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;    // Count down in PendSV.
+}
+
+void PendSV_Handler(void) {
+    uint32_t event;
+
+    while (EVQUEUE_Get(&queue, &event)) {
+        i--;
+        GPIO_ClearPins(GPIO_PORT_2, SVN_SGS_BITS);             // Turns off all segments.
+        GPIO_SetPins(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Sets segments for current digit.
 
-    delay();
+        delay();
+    }
 
-    EXTI_ClearFlag(EXTI_EINT3);    // Clear the EINT3 interrupt flag.
+    EXTI_ClearFlag(EXTI_EINT3);          // Clear the EINT3 interrupt flag.
+    NVIC_ClearPendingIRQ(EINT3_IRQn);    // Still pressed: the level pends it again.
+    NVIC_EnableIRQ(EINT3_IRQn);
 }
 
 void delay() {
@@ -6,9 +6,14 @@
  * This example configures GPIO pins for a button (P2.13) and a 7-segment display (P2.0-P2.6)
  * on the LPC1769 microcontroller. The main loop increments the displayed hexadecimal digit (0-F),
  * while pressing the button triggers an EINT3 interrupt that decrements the digit.
+ * The handler only posts an event; the decrement and its delay run in PendSV, at the lowest
+ * priority, so the handler no longer blocks other interrupts for a whole delay.
  */
 
 #include "LPC17xx.h"
+#include "evqueue.h"
+#include "pinmap.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -20,19 +25,21 @@
 /** 7-segment display connected to P2.0-P2.6. */
 #define SVN_SGS (0)
 
-/** Mask for the button connected. */
-#define BTN_BIT      BIT_MASK(BTN)
 /** Mask for a 7 segments display. */
 #define SVN_SGS_BITS BITS_MASK(7, 0)
 /** Mask for the EINT3 interrupt. */
 #define EINT3_BIT    BIT_MASK(3)
 
-/** PCB mask for the button (P2.13). */
-#define BTN_PCB     BITS_MASK(2, BTN * 2)
-/** PCB lower bit mask for the button (P2.13). */
-#define BTN_PCB_L   BIT_MASK(BTN * 2)
-/** PCB mask for the 7-segment display (P2.0-P2.6). */
-#define SVN_SGS_PCB BITS_MASK(14, 0)
+/** Pins of the board: P2.13 as EINT3 with pull-up, P2.0-P2.6 (segments a-g) as GPIO outputs. */
+#define BOARD_PINS(PIN, reg)                                                        \
+    PIN(reg, 2, BTN, PINMAP_FUNC1, PINMAP_PULLUP, PINMAP_KEEP, PINMAP_INPUT)        \
+    PIN(reg, 2, 0, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 1, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 2, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 3, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 4, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 5, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)           \
+    PIN(reg, 2, 6, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)
 
 /** Number of elements in the digits array. */
 #define DIGITS_SIZE (sizeof(digits) / sizeof(digits[0]))
@@ -40,6 +47,13 @@
 /** Delay constant for LED timing. */
 #define DELAY (2500)
 
+/** Capacity of the event queue (power of 2). */
+#define QUEUE_SIZE  (4)
+/** Lowest interrupt priority, used for PendSV. */
+#define LOWEST_PRIO ((1 << __NVIC_PRIO_BITS) - 1)
+/** Event: count one step down. */
+#define EV_DOWN     (0)
+
 /**
  * @brief Configures GPIO pins for button input and 7-segment display output.
  *
@@ -63,13 +77,19 @@ void configInt(void);
 void delay(void);
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 /** Current index for the digits array. */
 volatile uint32_t i = 0;
 
+/** Events posted by EINT3_IRQHandler. */
+EVQUEUE_Type queue;
+/** Storage of the event queue. */
+uint32_t buffer[QUEUE_SIZE];
+
 int main(void) {
+    EVQUEUE_Init(&queue, buffer, QUEUE_SIZE);
+
     configGPIO();
     configInt();
 
@@ -85,13 +105,7 @@ int main(void) {
 }
 
 void configGPIO(void) {
-    LPC_PINCON->PINSEL4 &= ~(BTN_PCB);
-    LPC_PINCON->PINSEL4 |= BTN_PCB_L;      // P2.13 as EINT3.
-    LPC_PINCON->PINMODE4 &= ~(BTN_PCB);    // P2.13 with pull-up.
-    LPC_GPIO2->FIODIR &= ~(BTN_BIT);       // P2.13 as input.
-
-    LPC_PINCON->PINSEL4 &= ~(SVN_SGS_PCB);    // P2.0-P2.6 as GPIO.
-    LPC_GPIO2->FIODIR |= SVN_SGS_BITS;        // P2.0-P2.6 as output.
+    PINMAP_Apply(BOARD_PINS);    // One write each to PINSEL4, PINMODE4 and FIODIR.
 
     LPC_GPIO2->FIOCLR = SVN_SGS_BITS;               // Turns off all segments.
     LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Start with digit 0.
@@ -102,19 +116,33 @@ void configInt(void) {
     LPC_SC->EXTMODE &= ~(EINT3_BIT);     // EINT3 level-sensitive.
     LPC_SC->EXTPOLAR &= ~(EINT3_BIT);    // EINT3 low-active.
 
+    NVIC_SetPriority(PendSV_IRQn, LOWEST_PRIO);    // Deferred work below every interrupt.
+
     LPC_SC->EXTINT |= EINT3_BIT;         // Clear any pending EINT3 interrupt.
     NVIC_ClearPendingIRQ(EINT3_IRQn);    // Clear any pending EINT3 interrupt.
     NVIC_EnableIRQ(EINT3_IRQn);          // Enable EINT3 interrupt in NVIC.
 }
 
 void EINT3_IRQHandler(void) {
-    i--;
-    LPC_GPIO2->FIOCLR = SVN_SGS_BITS;               // Turns off all segments.
-    LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Sets segments for current digit.
+    NVIC_DisableIRQ(EINT3_IRQn);    // Level-sensitive: off until the step is done.
+    EVQUEUE_Post(&queue, EV_DOWN);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;    // Count down in PendSV.
+}
 
-    delay();
+void PendSV_Handler(void) {
+    uint32_t event;
 
-    LPC_SC->EXTINT |= EINT3_BIT;    // Clear any pending EINT3 interrupt.
+    while (EVQUEUE_Get(&queue, &event)) {
+        i--;
+        LPC_GPIO2->FIOCLR = SVN_SGS_BITS;               // Turns off all segments.
+        LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Sets segments for current digit.
+
+        delay();
+    }
+
+    LPC_SC->EXTINT |= EINT3_BIT;         // Clear any pending EINT3 interrupt.
+    NVIC_ClearPendingIRQ(EINT3_IRQn);    // Still pressed: the level pends it again.
+    NVIC_EnableIRQ(EINT3_IRQn);
 }
 
 void delay(void) {
@@ -5,9 +5,13 @@
  * This example configures GPIO pins and external interrupts for two buttons (P0.0, P2.11)
  * and an RGB LED (P0.22, P3.25, P3.26). Pressing each button triggers an interrupt that
  * cycles the RGB LED through a predefined color sequence.
+ * The handlers only post an event; the sequences run in PendSV, at the lowest priority.
  */
 
 #include "LPC17xx.h"
+#include "evqueue.h"
+#include "gpioirq.h"
+#include "pingroup.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -55,17 +59,39 @@
 #define SEQUENCE_LENGTH (3)
 /** Delay constant for LED timing. */
 #define DELAY           (2500)
+/** Capacity of each event queue (power of 2). */
+#define QUEUE_SIZE      (8)
+/** Lowest interrupt priority, used for PendSV. */
+#define LOWEST_PRIO     ((1 << __NVIC_PRIO_BITS) - 1)
+
+/** Event: play the sequence of button A. */
+#define EV_SEQ_A (0)
+/** Event: play the sequence of button B. */
+#define EV_SEQ_B (1)
+
+/** Color of the RGB LED from its red, green and blue channels (0 off, 1 on): one bit each. */
+#define COLOR(r, g, b) ((r) | ((g) << 1) | ((b) << 2))
+
+/** Masks of P0 (red) and P3 (green and blue) for color `c`; the LEDs are active low. */
+#define COLOR_MASKS(c)                                       \
+    {{PINGROUP_SET(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW),      \
+      PINGROUP_CLR(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW)},     \
+     {PINGROUP_SET(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_SET(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW), \
+      PINGROUP_CLR(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_CLR(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW)}}
 
 /**
- * @brief Color structure to represent RGB colors.
- *
- * Each color is represented by three channels: red, green, and blue.
- * Each channel is a uint8_t value where 0 means off and 1 means on
+ * @brief RGB LED colors, as values of the LED pin group.
  */
-typedef struct {
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
+typedef enum {
+    RED     = COLOR(1, 0, 0),
+    GREEN   = COLOR(0, 1, 0),
+    BLUE    = COLOR(0, 0, 1),
+    CYAN    = COLOR(0, 1, 1),
+    MAGENTA = COLOR(1, 0, 1),
+    YELLOW  = COLOR(1, 1, 0),
+    WHITE   = COLOR(1, 1, 1),
 } Color;
 
 /**
@@ -80,39 +106,62 @@ void configGPIO(void);
 /**
  * @brief Configures external and GPIO interrupts for the buttons.
  *
- * Enables rising edge interrupt for button A (P0.0) using EINT3.
+ * Registers buttonAPressed() for the rising edge of button A (P0.0) with the GPIO interrupt
+ * dispatcher (EINT3).
  * Configures EINT1 (P2.11) as edge-sensitive and falling edge active.
  * Sets interrupt priorities, clears pending flags, and enables interrupts in the NVIC.
  */
 void configInt(void);
 
+/**
+ * @brief Posts the event of button A. Called by the dispatcher on each rising edge of P0.0.
+ *
+ * @param arg Unused.
+ */
+void buttonAPressed(void* arg);
+
 /**
  * @brief Sets the RGB LED to the specified color.
- * @param color Pointer to a Color struct defining the color to display.
+ * @param color Color to display.
  *
- * Turns on or off each LED channel (red, green, blue) according to the color struct.
+ * Writes the precomputed masks of the color: one set and one clear per port, no branches.
  */
-void setLEDColor(const Color* color);
+void setLEDColor(Color color);
+
+/**
+ * @brief Shows a color sequence on the RGB LED, one color per delay.
+ * @param sequence Array of SEQUENCE_LENGTH colors.
+ */
+void playSequence(const Color* sequence);
 
 /**
  * @brief Generates a blocking delay using nested loops.
  */
 void delay(void);
 
-const Color RED     = {1, 0, 0};
-const Color GREEN   = {0, 1, 0};
-const Color BLUE    = {0, 0, 1};
-const Color CYAN    = {0, 1, 1};
-const Color MAGENTA = {1, 0, 1};
-const Color YELLOW  = {1, 1, 0};
-const Color WHITE   = {1, 1, 1};
+/** Set and clear masks of P0 and P3 for every color, computed at compile time. */
+const PINGROUP_Masks colorMasks[8][2] = PINGROUP_TABLE8(COLOR_MASKS);
 
 /** Color sequence for button A (P0.0). */
 const Color sequence1[SEQUENCE_LENGTH] = {YELLOW, CYAN, MAGENTA};
 /** Color sequence for button B (P2.11). */
 const Color sequence2[SEQUENCE_LENGTH] = {RED, GREEN, BLUE};
+/** Sequence played for each event. */
+const Color* const sequences[] = {sequence1, sequence2};
+
+/** Events posted by buttonAPressed(), in EINT3_IRQHandler (button A). */
+EVQUEUE_Type queueA;
+/** Events posted by EINT1_IRQHandler (button B), a different priority: its own queue. */
+EVQUEUE_Type queueB;
+/** Storage of queueA. */
+uint32_t bufferA[QUEUE_SIZE];
+/** Storage of queueB. */
+uint32_t bufferB[QUEUE_SIZE];
 
 int main(void) {
+    EVQUEUE_Init(&queueA, bufferA, QUEUE_SIZE);
+    EVQUEUE_Init(&queueB, bufferB, QUEUE_SIZE);
+
     configGPIO();
     configInt();
 
@@ -126,66 +175,63 @@ void configGPIO(void) {
     LPC_PINCON->PINSEL1 &= ~(RED_PCB);    // P0.22 as GPIO.
     LPC_GPIO0->FIODIR |= RED_BIT;         // P0.22 as output.
 
-    LPC_PINCON->PINSEL7 &= ~(GREEN_PCB | BLUE_PCB);    // P2.25 and P2.26 as GPIO.
-    LPC_GPIO3->FIODIR |= (GREEN_BIT | BLUE_BIT);       // P2.25 and P2.26 as output.
+    LPC_PINCON->PINSEL7 &= ~(GREEN_PCB | BLUE_PCB);    // P3.25 and P3.26 as GPIO.
+    LPC_GPIO3->FIODIR |= (GREEN_BIT | BLUE_BIT);       // P3.25 and P3.26 as output.
 
     LPC_PINCON->PINSEL0 &= ~(BTN_A_PCB);     // P0.0 as GPIO.
     LPC_PINCON->PINMODE0 &= ~(BTN_A_PCB);    // P0.0 with pull-up.
     LPC_GPIO0->FIODIR &= ~(BTN_A_BIT);       // P0.0 as input.
 
     LPC_PINCON->PINSEL4 &= ~(BTN_B_PCB);
-    LPC_PINCON->PINSEL4 |= BTN_B_PCB_L;      // P2.11 as EINT3.
+    LPC_PINCON->PINSEL4 |= BTN_B_PCB_L;      // P2.11 as EINT1.
     LPC_PINCON->PINMODE4 &= ~(BTN_B_PCB);    // P2.11 with pull-up.
 }
 
 void configInt(void) {
-    LPC_GPIOINT->IO0IntEnR |= BTN_A_BIT;    // Enable rising edge interrupt on P0.0.
-
     LPC_SC->EXTMODE |= EINT1_BIT;        // EINT1 edge-sensitive.
     LPC_SC->EXTPOLAR &= ~(EINT1_BIT);    // EINT1 falling edge active.
 
     NVIC_SetPriority(EINT1_IRQn, 0);
     NVIC_SetPriority(EINT3_IRQn, 1);
+    NVIC_SetPriority(PendSV_IRQn, LOWEST_PRIO);    // Deferred work below every interrupt.
 
     LPC_SC->EXTINT |= EINT1_BIT;         // Clear EINT1 flag.
     NVIC_ClearPendingIRQ(EINT1_IRQn);    // Clear pending EINT1 interrupt.
     NVIC_EnableIRQ(EINT1_IRQn);          // Enable EINT1 interrupt in NVIC.
 
-    LPC_GPIOINT->IO0IntClr = BTN_A_BIT;    // Clear pin flag.
-    NVIC_EnableIRQ(EINT3_IRQn);            // Enable EINT3 interrupt in NVIC.
+    GPIOIRQ_Attach(0, BTN_A, GPIOIRQ_RISING, buttonAPressed, 0);    // Clears, enables P0.0 and EINT3.
 }
 
-void setLEDColor(const Color* color) {
-    if (color->r)
-        LPC_GPIO0->FIOCLR = RED_LED;    // Turn on red LED.
-    else
-        LPC_GPIO0->FIOSET = RED_LED;    // Turn off red LED.
-
-    if (color->g)
-        LPC_GPIO3->FIOCLR = GREEN_LED;    // Turn on green LED.
-    else
-        LPC_GPIO3->FIOSET = GREEN_LED;    // Turn off green LED.
-
-    if (color->b)
-        LPC_GPIO3->FIOCLR = BLUE_LED;    // Turn on blue LED.
-    else
-        LPC_GPIO3->FIOSET = BLUE_LED;    // Turn off blue LED.
+void setLEDColor(Color color) {
+    PINGROUP_Write(LPC_GPIO0, &colorMasks[color][0]);    // Red.
+    PINGROUP_Write(LPC_GPIO3, &colorMasks[color][1]);    // Green and blue, together.
 }
 
 void EINT1_IRQHandler(void) {
-    for (uint8_t i = 0; i < SEQUENCE_LENGTH; i++) {
-        setLEDColor(&sequence2[i]);
-        delay();
-    }
-    LPC_SC->EXTINT = EINT1_BIT;    // Clear any pending EINT1 interrupt.
+    LPC_SC->EXTINT = EINT1_BIT;    // Clear EINT1 flag.
+    EVQUEUE_Post(&queueB, EV_SEQ_B);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;    // Run the sequence in PendSV.
+}
+
+void buttonAPressed(void* arg) {
+    (void)arg;
+    EVQUEUE_Post(&queueA, EV_SEQ_A);
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;    // Run the sequence in PendSV.
+}
+
+void PendSV_Handler(void) {
+    uint32_t event;
+
+    // Button B keeps its priority: its events are taken first.
+    while (EVQUEUE_Get(&queueB, &event) || EVQUEUE_Get(&queueA, &event))
+        playSequence(sequences[event]);
 }
 
-void EINT3_IRQHandler(void) {
+void playSequence(const Color* sequence) {
     for (uint8_t i = 0; i < SEQUENCE_LENGTH; i++) {
-        setLEDColor(&sequence1[i]);
+        setLEDColor(sequence[i]);
         delay();
     }
-    LPC_GPIOINT->IO0IntClr = BTN_A_BIT;    // Clears the interrupt for P0.0.
 }
 
 void delay(void) {
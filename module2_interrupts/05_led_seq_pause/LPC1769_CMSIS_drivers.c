@@ -8,6 +8,10 @@
 
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
+#include "gpiofast.h"
+#include "gpioirq.h"
+#include "pingroup.h"
+#include "pinselspread.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -38,16 +42,30 @@
 /** Number of colors in each sequence. */
 #define SEQUENCE_LENGTH (8)
 
+/** Color of the RGB LED from its red, green and blue channels (0 off, 1 on): one bit each. */
+#define COLOR(r, g, b) ((r) | ((g) << 1) | ((b) << 2))
+
+/** Masks of P0 (red) and P3 (green and blue) for color `c`; the LEDs are active low. */
+#define COLOR_MASKS(c)                                       \
+    {{PINGROUP_SET(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW),      \
+      PINGROUP_CLR(c, 0, RED_BIT, PINGROUP_ACTIVE_LOW)},     \
+     {PINGROUP_SET(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_SET(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW), \
+      PINGROUP_CLR(c, 1, GREEN_BIT, PINGROUP_ACTIVE_LOW) |   \
+          PINGROUP_CLR(c, 2, BLUE_BIT, PINGROUP_ACTIVE_LOW)}}
+
 /**
- * @brief Color structure to represent RGB colors.
- *
- * Each color is represented by three channels: red, green, and blue.
- * Each channel is a uint8_t value where 0 means off and 1 means on
+ * @brief RGB LED colors, as values of the LED pin group.
  */
-typedef struct {
-    uint8_t r;
-    uint8_t g;
-    uint8_t b;
+typedef enum {
+    RED     = COLOR(1, 0, 0),
+    GREEN   = COLOR(0, 1, 0),
+    BLUE    = COLOR(0, 0, 1),
+    CYAN    = COLOR(0, 1, 1),
+    MAGENTA = COLOR(1, 0, 1),
+    YELLOW  = COLOR(1, 1, 0),
+    WHITE   = COLOR(1, 1, 1),
+    BLACK   = COLOR(0, 0, 0),
 } Color;
 
 /**
@@ -62,32 +80,33 @@ void configGPIO(void);
 /**
  * @brief Configures the external interrupt for the button on P2.0.
  *
- * Enables a falling edge interrupt for P2.0 and clears any pending interrupt flags.
- * Enables the EINT3 interrupt in the NVIC.
+ * Registers buttonPressed() for the falling edge of P2.0 with the GPIO interrupt dispatcher,
+ * which clears any pending flag and enables the EINT3 interrupt in the NVIC.
  */
 void configInt(void);
 
+/**
+ * @brief Toggles pause/resume. Called by the dispatcher on each falling edge of P2.0.
+ *
+ * @param arg Unused.
+ */
+void buttonPressed(void* arg);
+
 /**
  * @brief Sets the RGB LED to the specified color.
- * @param color Pointer to a Color struct defining the color to display.
+ * @param color Color to display.
  *
- * Turns on or off each LED channel (red, green, blue) according to the color struct.
+ * Writes the precomputed masks of the color: one set and one clear per port, no branches.
  */
-void setLEDColor(const Color* color);
+void setLEDColor(Color color);
 
 /**
  * @brief Generates a blocking delay using nested loops.
  */
 void delay();
 
-const Color RED     = {1, 0, 0};
-const Color GREEN   = {0, 1, 0};
-const Color BLUE    = {0, 0, 1};
-const Color CYAN    = {0, 1, 1};
-const Color MAGENTA = {1, 0, 1};
-const Color YELLOW  = {1, 1, 0};
-const Color WHITE   = {1, 1, 1};
-const Color BLACK   = {0, 0, 0};
+/** Set and clear masks of P0 and P3 for every color, computed at compile time. */
+const PINGROUP_Masks colorMasks[8][2] = PINGROUP_TABLE8(COLOR_MASKS);
 
 /** Color sequence for the RGB LED. */
 const Color sequence[SEQUENCE_LENGTH] = {RED, GREEN, BLUE, CYAN, MAGENTA, YELLOW, WHITE, BLACK};
@@ -97,14 +116,22 @@ volatile uint8_t flag = 1;
 
 int main(void) {
     configGPIO();
+    configInt();
 
     uint32_t i = 0;
 
     while (1) {
         if (flag) {
-            setLEDColor(&sequence[i % SEQUENCE_LENGTH]);
+            setLEDColor(sequence[i % SEQUENCE_LENGTH]);
             delay();
             i++;
+        } else {
+            // Paused: sleep until the button interrupt resumes. Checked with interrupts masked, so
+            // a press just before __WFI() still wakes the core; its handler runs once unmasked.
+            __disable_irq();
+            if (!flag)
+                __WFI();
+            __enable_irq();
         }
     }
     return 0;
@@ -123,40 +150,27 @@ void configGPIO(void) {
     GPIO_SetDir(GPIO_PORT_0, RED_BIT, GPIO_OUTPUT);    // P0.22 as output.
 
     pinCfg.portNum = PINSEL_PORT_3;
-    PINSEL_ConfigMultiplePins(&pinCfg, GREEN_BIT | BLUE_BIT);       // P3.25 and P3.26 as GPIO.
-    GPIO_SetDir(GPIO_PORT_3, GREEN_BIT | BLUE_BIT, GPIO_OUTPUT);    // P3.25 and P3.26 as output.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, GREEN_BIT | BLUE_BIT);    // P3.25 and P3.26 as GPIO.
+    GPIO_SetDir(GPIO_PORT_3, GREEN_BIT | BLUE_BIT, GPIO_OUTPUT);       // P3.25 and P3.26 as output.
 
     pinCfg.portNum = PINSEL_PORT_2;
     pinCfg.pinNum  = PINSEL_PIN_0;
     PINSEL_ConfigPin(&pinCfg);                        // P2.0 as GPIO with pull-up.
     GPIO_SetDir(GPIO_PORT_2, BTN_BIT, GPIO_INPUT);    // P2.0 as input.
 
-    GPIO_ClearPins(GPIO_PORT_0, RED_BIT);                 // Red LED off.
-    GPIO_ClearPins(GPIO_PORT_3, GREEN_BIT | BLUE_BIT);    // Green and blue
+    GPIO_SetPins(GPIO_PORT_0, RED_BIT);                 // Red LED off.
+    GPIO_SetPins(GPIO_PORT_3, GREEN_BIT | BLUE_BIT);    // Green and blue LEDs off.
 }
 
-void setLEDColor(const Color* color) {
-    if (color->r)
-        GPIO_ClearPins(GPIO_PORT_0, RED_BIT);    // Turn on red LED.
-    else
-        GPIO_SetPins(GPIO_PORT_0, RED_BIT);    // Turn off red LED.
-
-    if (color->g)
-        GPIO_ClearPins(GPIO_PORT_3, GREEN_BIT);    // Turn on green LED.
-    else
-        GPIO_SetPins(GPIO_PORT_3, GREEN_BIT);    // Turn off green LED.
-
-    if (color->b)
-        GPIO_ClearPins(GPIO_PORT_3, BLUE_BIT);    // Turn on blue LED.
-    else
-        GPIO_SetPins(GPIO_PORT_3, BLUE_BIT);    // Turn off blue LED.
+void setLEDColor(Color color) {
+    GPIO_SetPins(GPIO_PORT_0, colorMasks[color][0].set);    // Red.
+    GPIO_ClearPins(GPIO_PORT_0, colorMasks[color][0].clr);
+    GPIO_SetPins(GPIO_PORT_3, colorMasks[color][1].set);    // Green and blue, together.
+    GPIO_ClearPins(GPIO_PORT_3, colorMasks[color][1].clr);
 }
 
 void configInt(void) {
-    GPIO_IntCmd(GPIO_PORT_2, BTN_BIT, GPIO_INT_FALLING);    // Configure falling edge interrupt on P2.0.
-
-    GPIO_ClearInt(GPIO_PORT_2, BTN_BIT);    // Clear any pending interrupts on P2.0.
-    NVIC_EnableIRQ(EINT3_IRQn);             // Enable EINT3 interrupt in NVIC.
+    GPIOIRQ_Attach(2, BTN, GPIOIRQ_FALLING, buttonPressed, 0);    // Falling edge interrupt on P2.0.
 }
 
 void delay() {
@@ -165,8 +179,7 @@ void delay() {
             __NOP();
 }
 
-void EINT3_IRQHandler(void) {
+void buttonPressed(void* arg) {
+    (void)arg;
     flag = !flag;    // Toggle the flag to pause/resume the LED sequence.
-
-    GPIO_ClearInt(GPIO_PORT_2, BTN_BIT);    // Clear interrupt flag on P2.0.
 }
@@ -6,6 +6,7 @@
  * and sets up the GPIO pin to control the red LED on the LPC1769 board.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
@@ -80,5 +81,5 @@ void SysTick_Handler(void) {
     const uint32_t current = GPIO_ReadValue(GPIO_PORT_0);
 
     GPIO_SetPins(GPIO_PORT_0, ~current & RED_BIT);    // Toggle LED state.
-    GPIO_SetPins(GPIO_PORT_0, current & RED_BIT);
+    GPIO_ClearPins(GPIO_PORT_0, current & RED_BIT);
 }
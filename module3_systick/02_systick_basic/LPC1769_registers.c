@@ -7,6 +7,7 @@
  */
 
 #include "LPC17xx.h"
+#include "bitband.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -81,8 +82,5 @@ void configSysTick(uint32_t ticks) {
 }
 
 void SysTick_Handler(void) {
-    const uint32_t current = LPC_GPIO0->FIOPIN;
-
-    LPC_GPIO0->FIOSET = ~current & RED_BIT;    // Toggle LED state.
-    LPC_GPIO0->FIOCLR = current & RED_BIT;
+    BITBAND_PinToggle(0, RED_LED);    // Toggle LED state.
 }
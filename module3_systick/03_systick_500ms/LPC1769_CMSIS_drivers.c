@@ -6,6 +6,7 @@
  * to toggle the red LED (P0.22) at a 500 ms interval.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
@@ -91,7 +92,7 @@ void SysTick_Handler(void) {
     const uint32_t current = GPIO_ReadValue(GPIO_PORT_0);
 
     GPIO_SetPins(GPIO_PORT_0, ~current & RED_BIT);
-    GPIO_SetPins(GPIO_PORT_0, current & RED_BIT);
+    GPIO_ClearPins(GPIO_PORT_0, current & RED_BIT);
 
     intCount = ST_MULT;    // Reset interrupt counter.
 }
@@ -6,9 +6,12 @@
  * counter (0-F) on a 7-segment display, incrementing every second.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -35,7 +38,8 @@
 /**
  * @brief Configures GPIO pins for 7-segment display output.
  *
- * Sets P2.0-P2.6 as GPIO outputs and initializes the display to show 0.
+ * Sets P2.0-P2.6 as GPIO outputs, gives FIOPIN of port 2 to them and initializes the
+ * display to show 0.
  */
 void configGPIO(void);
 
@@ -50,8 +54,7 @@ void configGPIO(void);
 void configSysTick(uint32_t time);
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 /** Current index for the digits array. */
 volatile uint32_t i = 0;
@@ -75,11 +78,11 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, SVN_SGS_BITS);       // P2.0-P2.6 as GPIO.
-    GPIO_SetDir(GPIO_PORT_2, SVN_SGS_BITS, GPIO_OUTPUT);    // P2.0-P2.6 as output.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SVN_SGS_BITS);    // P2.0-P2.6 as GPIO.
+    GPIO_SetDir(GPIO_PORT_2, SVN_SGS_BITS, GPIO_OUTPUT);       // P2.0-P2.6 as output.
 
-    GPIO_ClearPins(GPIO_PORT_2, SVN_SGS_BITS);             // Turns off all segments.
-    GPIO_SetPins(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Start with digit 0.
+    GPIO_SetMask(GPIO_PORT_2, ~SVN_SGS_BITS, ENABLE);        // FIOPIN writes drive P2.0-P2.6 only.
+    GPIO_WriteValue(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Start with digit 0.
     i++;
 }
 
@@ -98,8 +101,7 @@ void SysTick_Handler(void) {
         return;
     }
 
-    GPIO_ClearPins(GPIO_PORT_2, SVN_SGS_BITS);             // Turns off all segments.
-    GPIO_SetPins(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Sets segments for current digit.
+    GPIO_WriteValue(GPIO_PORT_2, digits[i % DIGITS_SIZE]);    // Segments of the digit, one store.
 
     intCount = ST_MULT;    // Reset interrupt counter.
     i++;
@@ -7,6 +7,8 @@
  */
 
 #include "LPC17xx.h"
+#include "portfield.h"
+#include "sevenseg.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -44,7 +46,8 @@
 /**
  * @brief Configures GPIO pins for 7-segment display output.
  *
- * Sets P2.0-P2.6 as GPIO outputs and initializes the display to show 0.
+ * Sets P2.0-P2.6 as GPIO outputs, gives FIOPIN of port 2 to them and initializes the
+ * display to show 0.
  */
 void configGPIO(void);
 
@@ -59,8 +62,7 @@ void configGPIO(void);
 void configSysTick(uint32_t ticks);
 
 /** Values for hexadecimal digits (0-F). */
-const uint32_t digits[] = {0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07,
-                           0x7F, 0x6F, 0x77, 0x7C, 0x39, 0x5E, 0x79, 0x71};
+const uint32_t digits[] = SEVENSEG_HEX_GLYPHS;
 
 /** Current index for the digits array. */
 volatile uint32_t i = 0;
@@ -79,8 +81,8 @@ void configGPIO(void) {
     LPC_PINCON->PINSEL4 &= ~(SVN_SGS_PCB);    // P2.0-P2.6 as GPIO.
     LPC_GPIO2->FIODIR |= SVN_SGS_BITS;        // P2.0-P2.6 as output.
 
-    LPC_GPIO2->FIOCLR = SVN_SGS_BITS;               // Turns off all segments.
-    LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Start with digit 0.
+    PORTFIELD_Own(LPC_GPIO2, SVN_SGS_BITS);               // FIOPIN writes drive P2.0-P2.6 only.
+    PORTFIELD_Write(LPC_GPIO2, digits[i % DIGITS_SIZE]);    // Start with digit 0.
     i++;
 }
 
@@ -101,8 +103,7 @@ void SysTick_Handler(void) {
         return;
     }
 
-    LPC_GPIO2->FIOCLR = SVN_SGS_BITS;               // Turns off all segments.
-    LPC_GPIO2->FIOSET = digits[i % DIGITS_SIZE];    // Sets segments for current digit.
+    PORTFIELD_Write(LPC_GPIO2, digits[i % DIGITS_SIZE]);    // Segments of the digit, one store.
 
     intCount = ST_MULT;    // Reset interrupt counter.
     i++;
@@ -5,12 +5,15 @@
  * This file configures the SysTick timer and GPIO to perform two tasks:
  * - Blink the red LED (P0.22) every 500 ms.
  * - Sequence through four LEDs (P2.0-P2.3), advancing every 200 ms.
- * Both tasks are managed using counters in the SysTick interrupt handler.
+ * Each task is a software timer; the SysTick interrupt handler only advances the timer wheel.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
+#include "pinselspread.h"
+#include "swtimer.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -27,17 +30,17 @@
 /** Bit mask for the four LEDs (P2.0-P2.3). */
 #define LEDS_BIT BITS_MASK(4, LEDS)
 
-/** Sequence time in milliseconds. */
-#define SEQ_TIME   (500)
 /** Blink time in milliseconds. */
-#define BLINK_TIME (200)
+#define BLINK_TIME (500)
+/** Sequence time in milliseconds. */
+#define SEQ_TIME   (200)
 /** SysTick timer interval in milliseconds. */
 #define ST_TIME    (100)
 
-/** Number of SysTick interrupts to achieve the desired blink time. */
-#define ST_MULT_BLINK ((BLINK_TIME / ST_TIME) - 1)
-/** Number of SysTick interrupts to achieve the desired sequence time. */
-#define ST_MULT_SEQ   ((SEQ_TIME / ST_TIME) - 1)
+/** Number of SysTick interrupts in the blink time. */
+#define ST_TICKS_BLINK (BLINK_TIME / ST_TIME)
+/** Number of SysTick interrupts in the sequence time. */
+#define ST_TICKS_SEQ   (SEQ_TIME / ST_TIME)
 
 /** Number of LEDs in the sequence. */
 #define LEDS_SIZE (sizeof(leds) / sizeof(leds[0]))
@@ -60,14 +63,39 @@ void configGPIO(void);
  */
 void configSysTick(uint32_t time);
 
+/**
+ * @brief Blink task: toggles the red LED.
+ *
+ * @param arg Unused.
+ */
+void blinkTask(void* arg);
+
+/**
+ * @brief Sequence task: turns off the current LED and turns on the next one.
+ *
+ * @param arg Unused.
+ */
+void seqTask(void* arg);
+
 /** Array of LED bit masks for the sequence (P2.0-P2.3). */
 const uint8_t leds[] = {0x1, 0x2, 0x4, 0x8};
 
 /** Index for the current LED in the sequence. */
 volatile uint32_t i = 0;
 
+/** Software timer of the blink task. */
+SWTIMER_Type blinkTimer;
+/** Software timer of the sequence task. */
+SWTIMER_Type seqTimer;
+
 int main(void) {
     configGPIO();
+
+    SWTIMER_Init(&blinkTimer, blinkTask, NULL);
+    SWTIMER_Init(&seqTimer, seqTask, NULL);
+    SWTIMER_Start(&blinkTimer, ST_TICKS_BLINK, ST_TICKS_BLINK);    // Every 500 ms.
+    SWTIMER_Start(&seqTimer, ST_TICKS_SEQ, ST_TICKS_SEQ);          // Every 200 ms.
+
     configSysTick(ST_TIME);
 
     while (1) {
@@ -86,11 +114,11 @@ void configGPIO(void) {
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
     PINSEL_ConfigPin(&pinCfg);                         // P0.22 as GPIO.
-    GPIO_SetDir(GPIO_PORT_0, RED_LED, GPIO_OUTPUT);    // P0.22 as output.
+    GPIO_SetDir(GPIO_PORT_0, RED_BIT, GPIO_OUTPUT);    // P0.22 as output.
 
     pinCfg.portNum = PINSEL_PORT_2;
-    PINSEL_ConfigMultiplePins(&pinCfg, LEDS_BIT);       // P2.0-3 as GPIO.
-    GPIO_SetDir(GPIO_PORT_2, LEDS_BIT, GPIO_OUTPUT);    // P2.0-3 as output.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, LEDS_BIT);    // P2.0-3 as GPIO.
+    GPIO_SetDir(GPIO_PORT_2, LEDS_BIT, GPIO_OUTPUT);       // P2.0-3 as output.
 
     GPIO_ClearPins(GPIO_PORT_0, RED_BIT);     // Turn off red LED.
     GPIO_ClearPins(GPIO_PORT_2, LEDS_BIT);    // Turn off LEDs.
@@ -103,26 +131,17 @@ void configSysTick(uint32_t time) {
     SYSTICK_Cmd(ENABLE);           // Enable SysTick timer.
 }
 
-void SysTick_Handler(void) {
-    static uint8_t blinkCount = ST_MULT_BLINK;
-    static uint8_t seqCount   = ST_MULT_SEQ;
-
-    if (!blinkCount) {    // 500 ms elapsed.
-        const uint32_t current = GPIO_ReadValue(GPIO_PORT_0);
+void SysTick_Handler(void) { SWTIMER_Tick(); }
 
-        GPIO_SetPins(GPIO_PORT_0, ~current & RED_BIT);
-        GPIO_ClearPins(GPIO_PORT_0, current & RED_BIT);
+void blinkTask(void* arg) {
+    const uint32_t current = GPIO_ReadValue(GPIO_PORT_0);
 
-        blinkCount = ST_MULT_BLINK;    // Reset blink counter.
-    }
-    if (!seqCount) {                                         // 200 ms elapsed.
-        GPIO_ClearPins(GPIO_PORT_2, leds[i % LEDS_SIZE]);    // Turn off current LED.
-        i++;                                                 // Increment LED index.
-        GPIO_SetPins(GPIO_PORT_2, leds[i % LEDS_SIZE]);      // Turn on next LED.
-
-        seqCount = ST_MULT_SEQ;    // Reset sequence counter.
-    }
+    GPIO_SetPins(GPIO_PORT_0, ~current & RED_BIT);    // Toggle LED state.
+    GPIO_ClearPins(GPIO_PORT_0, current & RED_BIT);
+}
 
-    blinkCount--;    // Decrement counters.
-    seqCount--;
+void seqTask(void* arg) {
+    GPIO_ClearPins(GPIO_PORT_2, leds[i % LEDS_SIZE]);    // Turn off current LED.
+    i++;                                                 // Increment LED index.
+    GPIO_SetPins(GPIO_PORT_2, leds[i % LEDS_SIZE]);      // Turn on next LED.
 }
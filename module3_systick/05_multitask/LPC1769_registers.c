@@ -5,10 +5,12 @@
  * This file configures the SysTick timer and GPIO to perform two tasks:
  * - Blink the red LED (P0.22) every 500 ms.
  * - Sequence through four LEDs (P2.0-P2.3), advancing every 200 ms.
- * Both tasks are managed using counters in the SysTick interrupt handler.
+ * Each task is a software timer; the SysTick interrupt handler only advances the timer wheel.
  */
 
 #include "LPC17xx.h"
+#include "bitband.h"
+#include "swtimer.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -30,25 +32,25 @@
 /** PCB mask for the four LEDs (P2.0-P2.3). */
 #define LEDS_PCB BITS_MASK(2, LEDS * 2)
 
-/** Sequence time in milliseconds. */
-#define SEQ_TIME   (500)
 /** Blink time in milliseconds. */
-#define BLINK_TIME (200)
+#define BLINK_TIME (500)
+/** Sequence time in milliseconds. */
+#define SEQ_TIME   (200)
 /** SysTick timer interval in milliseconds. */
 #define ST_TIME    (100)
 
 /** SysTick load value for the desired time interval. */
-#define ST_LOAD       ((ST_TIME * 100000) - 1)
-/** Number of SysTick interrupts to achieve the desired blink time. */
-#define ST_MULT_BLINK ((BLINK_TIME / ST_TIME) - 1)
-/** Number of SysTick interrupts to achieve the desired sequence time. */
-#define ST_MULT_SEQ   ((SEQ_TIME / ST_TIME) - 1)
+#define ST_LOAD        ((ST_TIME * 100000) - 1)
+/** Number of SysTick interrupts in the blink time. */
+#define ST_TICKS_BLINK (BLINK_TIME / ST_TIME)
+/** Number of SysTick interrupts in the sequence time. */
+#define ST_TICKS_SEQ   (SEQ_TIME / ST_TIME)
 /** SysTick enable bit mask. */
-#define ST_ENABLE     BIT_MASK(0)
+#define ST_ENABLE      BIT_MASK(0)
 /** SysTick interrupt enable bit mask. */
-#define ST_TICKINT    BIT_MASK(1)
+#define ST_TICKINT     BIT_MASK(1)
 /** SysTick clock source bit mask. */
-#define ST_CLKSOURCE  BIT_MASK(2)
+#define ST_CLKSOURCE   BIT_MASK(2)
 
 /** Number of LEDs in the sequence. */
 #define LEDS_SIZE (sizeof(leds) / sizeof(leds[0]))
@@ -71,14 +73,39 @@ void configGPIO(void);
  */
 void configSysTick(uint32_t ticks);
 
+/**
+ * @brief Blink task: toggles the red LED.
+ *
+ * @param arg Unused.
+ */
+void blinkTask(void* arg);
+
+/**
+ * @brief Sequence task: turns off the current LED and turns on the next one.
+ *
+ * @param arg Unused.
+ */
+void seqTask(void* arg);
+
 /** Array of LED bit masks for the sequence (P2.0-P2.3). */
 const uint8_t leds[] = {0x1, 0x2, 0x4, 0x8};
 
 /** Index for the current LED in the sequence. */
 volatile uint32_t i = 0;
 
+/** Software timer of the blink task. */
+SWTIMER_Type blinkTimer;
+/** Software timer of the sequence task. */
+SWTIMER_Type seqTimer;
+
 int main(void) {
     configGPIO();
+
+    SWTIMER_Init(&blinkTimer, blinkTask, NULL);
+    SWTIMER_Init(&seqTimer, seqTask, NULL);
+    SWTIMER_Start(&blinkTimer, ST_TICKS_BLINK, ST_TICKS_BLINK);    // Every 500 ms.
+    SWTIMER_Start(&seqTimer, ST_TICKS_SEQ, ST_TICKS_SEQ);          // Every 200 ms.
+
     configSysTick(ST_LOAD);
 
     while (1) {
@@ -107,26 +134,14 @@ void configSysTick(uint32_t ticks) {
                     ST_CLKSOURCE;    // Use processor clock.
 }
 
-void SysTick_Handler(void) {
-    static uint8_t blinkCount = ST_MULT_BLINK;
-    static uint8_t seqCount   = ST_MULT_SEQ;
-
-    if (!blinkCount) {    // 500 ms elapsed.
-        const uint32_t current = LPC_GPIO0->FIOPIN;
-
-        LPC_GPIO0->FIOSET = ~current & RED_BIT;    // Toggle LED state.
-        LPC_GPIO0->FIOCLR = current & RED_BIT;
+void SysTick_Handler(void) { SWTIMER_Tick(); }
 
-        blinkCount = ST_MULT_BLINK;    // Reset blink counter.
-    }
-    if (!seqCount) {                                // 200 ms elapsed.
-        LPC_GPIO2->FIOCLR = leds[i % LEDS_SIZE];    // Turn off current LED.
-        i++;                                        // Increment LED index.
-        LPC_GPIO2->FIOSET = leds[i % LEDS_SIZE];    // Turn on next LED.
-
-        seqCount = ST_MULT_SEQ;    // Reset sequence counter.
-    }
+void blinkTask(void* arg) {
+    BITBAND_PinToggle(0, RED_LED);    // Toggle LED state.
+}
 
-    blinkCount--;    // Decrement counters.
-    seqCount--;
+void seqTask(void* arg) {
+    LPC_GPIO2->FIOCLR = leds[i % LEDS_SIZE];    // Turn off current LED.
+    i++;                                        // Increment LED index.
+    LPC_GPIO2->FIOSET = leds[i % LEDS_SIZE];    // Turn on next LED.
 }
@@ -7,10 +7,12 @@
  * pressing the button connected to P2.10 (EINT0).
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_exti.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
+#include "pinselspread.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -91,8 +93,8 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, LEDS_BIT);       // P0.0 to P0.7 as GPIO.
-    GPIO_SetDir(GPIO_PORT_0, LEDS_BIT, GPIO_OUTPUT);    // P0.0 to P0.7 as outputs.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, LEDS_BIT);    // P0.0 to P0.7 as GPIO.
+    GPIO_SetDir(GPIO_PORT_0, LEDS_BIT, GPIO_OUTPUT);       // P0.0 to P0.7 as outputs.
 
     pinCfg.portNum = PINSEL_PORT_2;
     pinCfg.pinNum  = PINSEL_PIN_10;
@@ -108,7 +108,7 @@ void configGPIO(void) {
 }
 
 void configInt(void) {
-    LPC_SC->EXTMODE &= ~EINT0_BIT;    // EINT0 edge sensitive.
+    LPC_SC->EXTMODE |= EINT0_BIT;     // EINT0 edge sensitive.
     LPC_SC->EXTPOLAR |= EINT0_BIT;    // EINT0 rising edge.
 
     LPC_SC->EXTINT |= EINT0_BIT;         // Clear flag.
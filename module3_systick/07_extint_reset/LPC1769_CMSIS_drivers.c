@@ -7,10 +7,12 @@
  * - Automatically reset the counter to zero every 2 seconds using the SysTick timer.
  */
 
+#include "gpiofast.h"
 #include "lpc17xx_exti.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
 #include "lpc17xx_systick.h"
+#include "pinselspread.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -85,8 +87,8 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, LEDS_BITS);       // Configure P0.0 to P0.3 as GPIO.
-    GPIO_SetDir(GPIO_PORT_0, LEDS_BITS, GPIO_OUTPUT);    // P0.0 to P0.3 as outputs.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, LEDS_BITS);    // Configure P0.0 to P0.3 as GPIO.
+    GPIO_SetDir(GPIO_PORT_0, LEDS_BITS, GPIO_OUTPUT);       // P0.0 to P0.3 as outputs.
 
     pinCfg.portNum = PINSEL_PORT_2;
     pinCfg.pinNum  = PINSEL_PIN_11;
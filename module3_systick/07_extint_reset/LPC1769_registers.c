@@ -101,7 +101,7 @@ void configGPIO(void) {
 }
 
 void configInt(void) {
-    LPC_SC->EXTMODE &= ~EINT1_BIT;    // EINT1 edge sensitive.
+    LPC_SC->EXTMODE |= EINT1_BIT;     // EINT1 edge sensitive.
     LPC_SC->EXTPOLAR |= EINT1_BIT;    // EINT1 rising edge.
 
     LPC_SC->EXTINT = EINT1_BIT;          // Clear flag.
@@ -1,17 +1,21 @@
 /**
  * @file LPC1769_CMSIS_drivers.c
- * @brief Traffic light controller with pedestrian request using SysTick and EINT0 for LPC1769.
+ * @brief Traffic light controller with pedestrian request using a timed state machine and EINT0 for LPC1769.
  *
- * This file configures the SysTick timer, GPIO, and external interrupt to implement a traffic light
- * controller. The system cycles through a predefined sequence for car and pedestrian lights.
- * Pressing the button on P2.10 (EINT0) immediately switches to the pedestrian crossing phase and
- * restarts the sequence.
+ * This file configures GPIO, the external interrupt and the tickless software timers to implement
+ * a traffic light controller. The car and pedestrian lights follow a run-length encoded state
+ * table: each phase is one state with its lights and duration, and the CPU only wakes up when a
+ * phase ends. Pressing the button on P2.10 (EINT0) immediately switches to the pedestrian
+ * crossing phase and restarts the sequence.
  */
 
+#include "fsm.h"
+#include "gpiofast.h"
 #include "lpc17xx_exti.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_pinsel.h"
-#include "lpc17xx_systick.h"
+#include "pinselspread.h"
+#include "tickless.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -32,31 +36,44 @@
 /** Bit mask for the button (P2.10). */
 #define BTN_BIT        BIT_MASK(BTN)
 
-/** Reset time in milliseconds. */
-#define STATE_TIME (5000)
-/** SysTick timer interval in milliseconds. */
-#define ST_TIME    (100)
+/** Car lights: green, yellow and red. */
+#define CAR_GREEN  BIT_MASK(CAR_LIGHT)
+#define CAR_YELLOW BIT_MASK(CAR_LIGHT + 1)
+#define CAR_RED    BIT_MASK(CAR_LIGHT + 2)
+/** Pedestrian lights: green, yellow and red. */
+#define PED_GREEN  BIT_MASK(PED_LIGHT)
+#define PED_YELLOW BIT_MASK(PED_LIGHT + 1)
+#define PED_RED    BIT_MASK(PED_LIGHT + 2)
+
+/** Duration of the green phases in milliseconds. */
+#define GREEN_TIME  (25000)
+/** Duration of the yellow phases in milliseconds. */
+#define YELLOW_TIME (5000)
+/** Software timer tick in microseconds (1 ms). */
+#define TICK_US     (1000)
 
-/** Number of SysTick interrupts to achieve the desired state time. */
-#define ST_MULT_STATE ((STATE_TIME / ST_TIME) - 1)
-
-/** Size of the traffic light sequence array. */
-#define SEQ_SIZE (sizeof(trafficSeq) / sizeof(trafficSeq[0]))
+/**
+ * @brief Phases of the traffic light.
+ */
+enum {
+    PHASE_PED_GREEN,     /*!< Car red, pedestrian green. */
+    PHASE_PED_YELLOW,    /*!< Car red, pedestrian yellow. */
+    PHASE_CAR_GREEN,     /*!< Car green, pedestrian red. */
+    PHASE_CAR_YELLOW     /*!< Car yellow, pedestrian red. */
+};
 
 /**
- * @brief Structure representing a step in the traffic light sequence.
+ * @brief Events of the traffic light.
  */
-typedef struct {
-    uint8_t car;
-    uint8_t ped;
-} TrafficStep;
+enum {
+    EVENT_PED_REQUEST    /*!< Pedestrian button pressed. */
+};
 
 /**
  * @brief Configures GPIO pins for car and pedestrian traffic lights, and the pedestrian button.
  *
  * Sets P0.0-P0.2 as outputs for car lights, P0.4-P0.6 as outputs for pedestrian lights,
  * and P2.10 as input for the pedestrian request button (EINT0).
- * Initializes the lights to the starting state.
  */
 void configGPIO(void);
 
@@ -68,40 +85,37 @@ void configGPIO(void);
 void configInt(void);
 
 /**
- * @brief Configures the SysTick timer to generate periodic interrupts.
+ * @brief Writes the car and pedestrian lights of a phase.
  *
- * @param time Time interval in milliseconds between SysTick interrupts.
- *
- * Initializes the SysTick timer using CMSIS drivers, sets the interrupt interval,
- * and enables the SysTick interrupt and counter.
+ * @param outputs Lights to turn on (P0.0-P0.2 and P0.4-P0.6), the others are turned off.
  */
-void configSysTick(uint32_t time);
-
-/** Traffic light sequence steps for cars and pedestrians. */
-const TrafficStep trafficSeq[] = {
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x20},    // Car red, Ped yellow
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x2, 0x40}     // Car yellow, Ped red
+void writeLights(uint32_t outputs);
+
+/** Phases of the sequence: lights, duration in ms and next phase. */
+const FSM_State phases[] = {
+    {CAR_RED | PED_GREEN, GREEN_TIME, PHASE_PED_YELLOW},      // PHASE_PED_GREEN
+    {CAR_RED | PED_YELLOW, YELLOW_TIME, PHASE_CAR_GREEN},     // PHASE_PED_YELLOW
+    {CAR_GREEN | PED_RED, GREEN_TIME, PHASE_CAR_YELLOW},      // PHASE_CAR_GREEN
+    {CAR_YELLOW | PED_RED, YELLOW_TIME, PHASE_PED_GREEN}      // PHASE_CAR_YELLOW
+};
+
+/** A pedestrian request stops the cars from any phase, then the pedestrians cross. */
+const FSM_Transition requests[] = {
+    {EVENT_PED_REQUEST, FSM_ANY, PHASE_CAR_YELLOW},
 };
 
-/** State variable for tracking the current step in the traffic light sequence. */
-volatile uint32_t state = 0;
-/** Counter for timing the duration of each state in the traffic light sequence. */
-volatile uint8_t reset = ST_MULT_STATE;
+/** Traffic light state machine. */
+const FSM_Table trafficTable = {phases, requests, sizeof(requests) / sizeof(requests[0]), writeLights};
+
+/** Traffic light. */
+FSM_Type trafficLight;
 
 int main(void) {
     configGPIO();
     configInt();
-    configSysTick(ST_TIME);
+
+    TICKLESS_Init(TICK_US);    // Phase durations count 1 ms ticks.
+    FSM_Init(&trafficLight, &trafficTable, PHASE_PED_GREEN);
 
     while (1) {
         __WFI();
@@ -118,8 +132,8 @@ void configGPIO(void) {
     pinCfg.pinMode   = PINSEL_PULLUP;
     pinCfg.openDrain = PINSEL_OD_NORMAL;
 
-    PINSEL_ConfigMultiplePins(&pinCfg, CAR_LIGHT_BITS);    // P0.0 to P0.2 as GPIO with pull-up.
-    PINSEL_ConfigMultiplePins(&pinCfg, PED_LIGHT_BITS);    // P0.4 to P0.6 as GPIO with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, CAR_LIGHT_BITS);    // P0.0 to P0.2 as GPIO with pull-up.
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, PED_LIGHT_BITS);    // P0.4 to P0.6 as GPIO with pull-up.
 
     GPIO_SetDir(GPIO_PORT_0, CAR_LIGHT_BITS, GPIO_OUTPUT);    // P0.0 to P0.2 as outputs.
     GPIO_SetDir(GPIO_PORT_0, PED_LIGHT_BITS, GPIO_OUTPUT);    // P0.4 to P0.6 as outputs.
@@ -130,11 +144,6 @@ void configGPIO(void) {
 
     PINSEL_ConfigPin(&pinCfg);                        // P2.10 as EINT0 with pull-up.
     GPIO_SetDir(GPIO_PORT_2, BTN_BIT, GPIO_INPUT);    // P2.10 as input.
-
-    GPIO_ClearPins(GPIO_PORT_0, CAR_LIGHT_BITS);
-    GPIO_ClearPins(GPIO_PORT_0, PED_LIGHT_BITS);
-    GPIO_SetPins(GPIO_PORT_0, trafficSeq[0].car);
-    GPIO_SetPins(GPIO_PORT_0, trafficSeq[0].ped);
 }
 
 void configInt(void) {
@@ -147,35 +156,13 @@ void configInt(void) {
     EXTI_ConfigEnable(&extiCfg);    // Configure and enable EINT0.
 }
 
-void configSysTick(uint32_t time) {
-    SYSTICK_InternalInit(time);    // Initialize SysTick.
-    SYSTICK_IntCmd(ENABLE);        // Enable SysTick interrupt.
-    SYSTICK_Cmd(ENABLE);           // Enable SysTick timer.
+void writeLights(uint32_t outputs) {
+    GPIO_ClearPins(GPIO_PORT_0, (CAR_LIGHT_BITS | PED_LIGHT_BITS) & ~outputs);    // Turn off the other lights.
+    GPIO_SetPins(GPIO_PORT_0, outputs);
 }
 
 void EINT0_IRQHandler(void) {
-    GPIO_ClearPins(GPIO_PORT_0, CAR_LIGHT_BITS);
-    GPIO_ClearPins(GPIO_PORT_0, PED_LIGHT_BITS);
-    GPIO_SetPins(GPIO_PORT_0, trafficSeq[11].car);
-    GPIO_SetPins(GPIO_PORT_0, trafficSeq[11].ped);
-
-    SysTick->VAL = 0;    // Clear current value and interrupt flag.
-
-    reset = ST_MULT_STATE;    // Reset 5 s counter.
-    state = 0;                // Reset state counter.
+    FSM_Event(&trafficLight, EVENT_PED_REQUEST);
 
     EXTI_ClearFlag(EXTI_EINT0);
 }
-
-void SysTick_Handler(void) {
-    if (!reset) {    // 5 s elapsed.
-        GPIO_ClearPins(GPIO_PORT_0, CAR_LIGHT_BITS);
-        GPIO_ClearPins(GPIO_PORT_0, PED_LIGHT_BITS);
-        GPIO_SetPins(GPIO_PORT_0, trafficSeq[state % SEQ_SIZE].car);
-        GPIO_SetPins(GPIO_PORT_0, trafficSeq[state % SEQ_SIZE].ped);
-
-        reset = ST_MULT_STATE;    // Reset sequence counter.
-    }
-
-    reset--;
-}
@@ -1,14 +1,18 @@
 /**
  * @file LPC1769_registers.c
- * @brief Traffic light controller with pedestrian request using SysTick and EINT0 for LPC1769.
+ * @brief Traffic light controller with pedestrian request using a timed state machine and EINT0 for LPC1769.
  *
- * This file configures the SysTick timer, GPIO, and external interrupt to implement a traffic light
- * controller. The system cycles through a predefined sequence for car and pedestrian lights.
- * Pressing the button on P2.10 (EINT0) immediately switches to the pedestrian crossing phase and
- * restarts the sequence.
+ * This file configures GPIO, the external interrupt and the tickless software timers to implement
+ * a traffic light controller. The car and pedestrian lights follow a run-length encoded state
+ * table: each phase is one state with its lights and duration, and the CPU only wakes up when a
+ * phase ends. Pressing the button on P2.10 (EINT0) immediately switches to the pedestrian
+ * crossing phase and restarts the sequence.
  */
 
 #include "LPC17xx.h"
+#include "fsm.h"
+#include "pinmap.h"
+#include "tickless.h"
 
 /** Generic bit mask macro. */
 #define BIT_MASK(x)     (0x1 << (x))
@@ -26,53 +30,57 @@
 #define CAR_LIGHT_BITS BITS_MASK(3, CAR_LIGHT)
 /** Bit mask for pedestrian traffic lights (P0.4-P0.6). */
 #define PED_LIGHT_BITS BITS_MASK(3, PED_LIGHT)
-/** Bit mask for the button (P2.10). */
-#define BTN_BIT        BIT_MASK(BTN)
 /** External interrupt 0 bit mask. */
 #define EINT0_BIT      BIT_MASK(0)
 
-/** PCB mask for car traffic lights (P0.0-P0.2). */
-#define CAR_LIGHT_PCB BITS_MASK(6, CAR_LIGHT * 2)
-/** PCB mask for pedestrian traffic lights (P0.4-P0.6). */
-#define PED_LIGHT_PCB BITS_MASK(6, PED_LIGHT * 2)
-/** PCB mask for the button (P2.10). */
-#define BTN_PCB       BITS_MASK(2, BTN * 2)
-/** PCB lower bit mask for the button (P2.10). */
-#define BTN_PCB_L     BIT_MASK(BTN * 2)
-
-/** Reset time in milliseconds. */
-#define STATE_TIME (5000)
-/** SysTick timer interval in milliseconds. */
-#define ST_TIME    (100)
-
-/** SysTick load value for the desired time interval. */
-#define ST_LOAD       ((ST_TIME * 100000) - 1)
-/** Number of SysTick interrupts to achieve the desired state time. */
-#define ST_MULT_STATE ((STATE_TIME / ST_TIME) - 1)
-/** SysTick enable bit mask. */
-#define ST_ENABLE     BIT_MASK(0)
-/** SysTick interrupt enable bit mask. */
-#define ST_TICKINT    BIT_MASK(1)
-/** SysTick clock source bit mask. */
-#define ST_CLKSOURCE  BIT_MASK(2)
-
-/** Size of the traffic light sequence array. */
-#define SEQ_SIZE (sizeof(trafficSeq) / sizeof(trafficSeq[0]))
+/** Car lights: green, yellow and red. */
+#define CAR_GREEN  BIT_MASK(CAR_LIGHT)
+#define CAR_YELLOW BIT_MASK(CAR_LIGHT + 1)
+#define CAR_RED    BIT_MASK(CAR_LIGHT + 2)
+/** Pedestrian lights: green, yellow and red. */
+#define PED_GREEN  BIT_MASK(PED_LIGHT)
+#define PED_YELLOW BIT_MASK(PED_LIGHT + 1)
+#define PED_RED    BIT_MASK(PED_LIGHT + 2)
+
+/** Pins of the board: P0.0-P0.2 and P0.4-P0.6 as GPIO outputs, P2.10 as EINT0 with pull-up. */
+#define BOARD_PINS(PIN, reg)                                                              \
+    PIN(reg, 0, CAR_LIGHT, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)         \
+    PIN(reg, 0, CAR_LIGHT + 1, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 0, CAR_LIGHT + 2, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 0, PED_LIGHT, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)         \
+    PIN(reg, 0, PED_LIGHT + 1, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 0, PED_LIGHT + 2, PINMAP_FUNC0, PINMAP_KEEP, PINMAP_KEEP, PINMAP_OUTPUT)     \
+    PIN(reg, 2, BTN, PINMAP_FUNC1, PINMAP_PULLUP, PINMAP_KEEP, PINMAP_INPUT)
+
+/** Duration of the green phases in milliseconds. */
+#define GREEN_TIME  (25000)
+/** Duration of the yellow phases in milliseconds. */
+#define YELLOW_TIME (5000)
+/** Software timer tick in microseconds (1 ms). */
+#define TICK_US     (1000)
 
 /**
- * @brief Structure representing a step in the traffic light sequence.
+ * @brief Phases of the traffic light.
  */
-typedef struct {
-    uint8_t car;
-    uint8_t ped;
-} TrafficStep;
+enum {
+    PHASE_PED_GREEN,     /*!< Car red, pedestrian green. */
+    PHASE_PED_YELLOW,    /*!< Car red, pedestrian yellow. */
+    PHASE_CAR_GREEN,     /*!< Car green, pedestrian red. */
+    PHASE_CAR_YELLOW     /*!< Car yellow, pedestrian red. */
+};
+
+/**
+ * @brief Events of the traffic light.
+ */
+enum {
+    EVENT_PED_REQUEST    /*!< Pedestrian button pressed. */
+};
 
 /**
  * @brief Configures GPIO pins for car and pedestrian traffic lights, and the pedestrian button.
  *
  * Sets P0.0-P0.2 as outputs for car lights, P0.4-P0.6 as outputs for pedestrian lights,
  * and P2.10 as input for the pedestrian request button (EINT0).
- * Initializes the lights to the starting state.
  */
 void configGPIO(void);
 
@@ -84,40 +92,37 @@ void configGPIO(void);
 void configInt(void);
 
 /**
- * @brief Configures the SysTick timer to generate periodic interrupts.
+ * @brief Writes the car and pedestrian lights of a phase.
  *
- * @param ticks Number of clock cycles between SysTick interrupts.
- *
- * Loads the specified value, clears the current counter, and enables
- * the SysTick timer and its interrupt.
+ * @param outputs Lights to turn on (P0.0-P0.2 and P0.4-P0.6), the others are turned off.
  */
-void configSysTick(uint32_t ticks);
-
-/** Traffic light sequence steps for cars and pedestrians. */
-const TrafficStep trafficSeq[] = {
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x10},    // Car red, Ped green
-    {0x4, 0x20},    // Car red, Ped yellow
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x1, 0x40},    // Car green, Ped red
-    {0x2, 0x40}     // Car yellow, Ped red
+void writeLights(uint32_t outputs);
+
+/** Phases of the sequence: lights, duration in ms and next phase. */
+const FSM_State phases[] = {
+    {CAR_RED | PED_GREEN, GREEN_TIME, PHASE_PED_YELLOW},      // PHASE_PED_GREEN
+    {CAR_RED | PED_YELLOW, YELLOW_TIME, PHASE_CAR_GREEN},     // PHASE_PED_YELLOW
+    {CAR_GREEN | PED_RED, GREEN_TIME, PHASE_CAR_YELLOW},      // PHASE_CAR_GREEN
+    {CAR_YELLOW | PED_RED, YELLOW_TIME, PHASE_PED_GREEN}      // PHASE_CAR_YELLOW
+};
+
+/** A pedestrian request stops the cars from any phase, then the pedestrians cross. */
+const FSM_Transition requests[] = {
+    {EVENT_PED_REQUEST, FSM_ANY, PHASE_CAR_YELLOW},
 };
 
-/** State variable for tracking the current step in the traffic light sequence. */
-volatile uint32_t state = 0;
-/** Counter for timing the duration of each state in the traffic light sequence. */
-volatile uint8_t reset = ST_MULT_STATE;
+/** Traffic light state machine. */
+const FSM_Table trafficTable = {phases, requests, sizeof(requests) / sizeof(requests[0]), writeLights};
+
+/** Traffic light. */
+FSM_Type trafficLight;
 
 int main(void) {
     configGPIO();
     configInt();
-    configSysTick(ST_LOAD);
+
+    TICKLESS_Init(TICK_US);    // Phase durations count 1 ms ticks.
+    FSM_Init(&trafficLight, &trafficTable, PHASE_PED_GREEN);
 
     while (1) {
         __WFI();
@@ -126,21 +131,7 @@ int main(void) {
 }
 
 void configGPIO(void) {
-    LPC_PINCON->PINSEL0 &= ~CAR_LIGHT_PCB;    // P0.0 to P0.2 as GPIO.
-    LPC_GPIO0->FIODIR |= CAR_LIGHT_BITS;      // P0.0 to P0.2 as outputs.
-
-    LPC_PINCON->PINSEL0 &= ~PED_LIGHT_PCB;    // P0.4 to P0.6 as GPIO.
-    LPC_GPIO0->FIODIR |= PED_LIGHT_BITS;      // P0.4 to P0.6 as outputs.
-
-    LPC_PINCON->PINSEL4 &= ~BTN_PCB;
-    LPC_PINCON->PINSEL4 |= BTN_PCB_L;    // P2.10 as EINT0.
-    LPC_PINCON->PINMODE4 &= ~BTN_PCB;    // P2.10 pull-up.
-    LPC_GPIO2->FIODIR &= ~BTN_BIT;       // P2.10 as input.
-
-    LPC_GPIO0->FIOCLR = CAR_LIGHT_BITS;    // Turn off first traffic light.
-    LPC_GPIO0->FIOCLR = PED_LIGHT_BITS;    // Turn off second traffic light.
-    LPC_GPIO0->FIOSET = trafficSeq[0].car;
-    LPC_GPIO0->FIOSET = trafficSeq[0].ped;
+    PINMAP_Apply(BOARD_PINS);    // One write each to PINSEL0, PINSEL4, PINMODE4, FIODIR0 and FIODIR2.
 }
 
 void configInt(void) {
@@ -152,37 +143,13 @@ void configInt(void) {
     NVIC_EnableIRQ(EINT0_IRQn);          // Enable EINT0 interrupt in the NVIC.
 }
 
-void configSysTick(uint32_t ticks) {
-    SysTick->LOAD = ticks;           // Load value for 100 ms interval.
-    SysTick->VAL  = 0;               // Clear current value and interrupt flag.
-    SysTick->CTRL = ST_ENABLE |      // Enable SysTick interrupt.
-                    ST_TICKINT |     // Enable SysTick exception request.
-                    ST_CLKSOURCE;    // Use processor clock.
+void writeLights(uint32_t outputs) {
+    LPC_GPIO0->FIOCLR = (CAR_LIGHT_BITS | PED_LIGHT_BITS) & ~outputs;    // Turn off the other lights.
+    LPC_GPIO0->FIOSET = outputs;
 }
 
 void EINT0_IRQHandler(void) {
-    LPC_GPIO0->FIOCLR = CAR_LIGHT_BITS;
-    LPC_GPIO0->FIOCLR = PED_LIGHT_BITS;
-    LPC_GPIO0->FIOSET = trafficSeq[11].car;
-    LPC_GPIO0->FIOSET = trafficSeq[11].ped;
-
-    SysTick->VAL = 0;    // Clear current value and interrupt flag.
-
-    reset = ST_MULT_STATE;    // Reset 5 s counter.
-    state = 0;                // Reset state counter.
-
-    LPC_SC->EXTINT |= EINT0_BIT;    // Clear flag.
-}
-
-void SysTick_Handler(void) {
-    if (!reset) {    // 5 s elapsed.
-        LPC_GPIO0->FIOCLR = CAR_LIGHT_BITS;
-        LPC_GPIO0->FIOCLR = PED_LIGHT_BITS;
-        LPC_GPIO0->FIOSET = trafficSeq[state % SEQ_SIZE].car;
-        LPC_GPIO0->FIOSET = trafficSeq[state % SEQ_SIZE].ped;
-
-        reset = ST_MULT_STATE;    // Reset sequence counter.
-    }
+    FSM_Event(&trafficLight, EVENT_PED_REQUEST);
 
-    reset--;
+    LPC_SC->EXTINT = EINT0_BIT;    // Clear flag.
 }
@@ -0,0 +1,113 @@
+/**
+ * @file LPC1769_registers.c
+ * @brief Tickless multitask: LED blink and sequence on TIMER0 match interrupts for LPC1769.
+ *
+ * Same tasks as the SysTick multitask exercise:
+ * - Blink the red LED (P0.22) every 500 ms.
+ * - Sequence through four LEDs (P2.0-P2.3), advancing every 200 ms.
+ * The software timers count 1 ms ticks on TIMER0, which only interrupts when a task is due.
+ */
+
+#include "LPC17xx.h"
+#include "bitband.h"
+#include "tickless.h"
+
+/** Generic bit mask macro. */
+#define BIT_MASK(x)     (0x1 << (x))
+/** Generic n-bit mask macro. */
+#define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
+
+/** Red LED is connected to P0.22. */
+#define RED_LED (22)
+/** Four LEDs are connected to P2.0-P2.3. */
+#define LEDS    (0)
+
+/** Bit mask for the red LED (P0.22). */
+#define RED_BIT  BIT_MASK(RED_LED)
+/** Bit mask for the four LEDs (P2.0-P2.3). */
+#define LEDS_BIT BITS_MASK(4, LEDS)
+
+/** PCB mask for the red LED (P0.22). */
+#define RED_PCB  BITS_MASK(2, (RED_LED - 16) * 2)
+/** PCB mask for the four LEDs (P2.0-P2.3). */
+#define LEDS_PCB BITS_MASK(2, LEDS * 2)
+
+/** Blink time in milliseconds. */
+#define BLINK_TIME (500)
+/** Sequence time in milliseconds. */
+#define SEQ_TIME   (200)
+/** Software timer tick in microseconds (1 ms). */
+#define TICK_US    (1000)
+
+/** Number of LEDs in the sequence. */
+#define LEDS_SIZE (sizeof(leds) / sizeof(leds[0]))
+
+/**
+ * @brief Configures GPIO pins for the red LED and LED sequence as outputs.
+ *
+ * Sets P0.22 as output for the red LED and P2.0-P2.3 as outputs for the LED sequence.
+ * Initializes all LEDs to the off state, then turns on the first sequence LED.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Blink task: toggles the red LED.
+ *
+ * @param arg Unused.
+ */
+void blinkTask(void* arg);
+
+/**
+ * @brief Sequence task: turns off the current LED and turns on the next one.
+ *
+ * @param arg Unused.
+ */
+void seqTask(void* arg);
+
+/** Array of LED bit masks for the sequence (P2.0-P2.3). */
+const uint8_t leds[] = {0x1, 0x2, 0x4, 0x8};
+
+/** Index for the current LED in the sequence. */
+volatile uint32_t i = 0;
+
+/** Software timer of the blink task. */
+SWTIMER_Type blinkTimer;
+/** Software timer of the sequence task. */
+SWTIMER_Type seqTimer;
+
+int main(void) {
+    configGPIO();
+
+    SWTIMER_Init(&blinkTimer, blinkTask, NULL);
+    SWTIMER_Init(&seqTimer, seqTask, NULL);
+    TICKLESS_Init(TICK_US);    // Timers count 1 ms ticks.
+    SWTIMER_Start(&blinkTimer, BLINK_TIME, BLINK_TIME);    // Every 500 ms.
+    SWTIMER_Start(&seqTimer, SEQ_TIME, SEQ_TIME);          // Every 200 ms.
+
+    while (1) {
+        __WFI();
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    LPC_PINCON->PINSEL1 &= ~RED_PCB;    // P0.22 as GPIO.
+    LPC_GPIO0->FIODIR |= RED_BIT;       // P0.22 as output.
+
+    LPC_PINCON->PINSEL4 &= ~LEDS_PCB;    // P2.0-3 as GPIO.
+    LPC_GPIO2->FIODIR |= LEDS_BIT;       // P2.0-3 as output.
+
+    LPC_GPIO0->FIOCLR |= RED_BIT;     // Turn off red LED.
+    LPC_GPIO2->FIOCLR |= LEDS_BIT;    // Turn off LEDs.
+    LPC_GPIO2->FIOSET |= leds[0];     // Turn on first LED.
+}
+
+void blinkTask(void* arg) {
+    BITBAND_PinToggle(0, RED_LED);    // Toggle LED state.
+}
+
+void seqTask(void* arg) {
+    LPC_GPIO2->FIOCLR = leds[i % LEDS_SIZE];    // Turn off current LED.
+    i++;                                        // Increment LED index.
+    LPC_GPIO2->FIOSET = leds[i % LEDS_SIZE];    // Turn on next LED.
+}
@@ -0,0 +1,92 @@
+/**
+ * @file LPC1769_CMSIS_drivers.c
+ * @brief Four-digit multiplexed 7-segment hexadecimal counter for LPC1769.
+ *
+ * This file configures four common cathode 7-segment digits that share their segment lines
+ * (P2.0-P2.7) and are enabled one at a time (P0.0-P0.3). The display engine refreshes a digit
+ * on every TIMER1 interrupt, while the main loop counts in hexadecimal every 100 ms using the
+ * SysTick timebase.
+ */
+
+#include "lpc17xx_gpio.h"
+#include "lpc17xx_pinsel.h"
+#include "pinselspread.h"
+#include "sevenseg.h"
+#include "timebase.h"
+
+/** Generic n-bit mask macro. */
+#define BITS_MASK(x, s) (((0x1 << (x)) - 1) << (s))
+
+/** Segments a-g and dp are connected to P2.0-P2.7. */
+#define SEGMENTS (0)
+/** Digit enables are connected to P0.0-P0.3. */
+#define DIGITS   (0)
+
+/** Number of digits. */
+#define NUM_DIGITS (4)
+/** Display refresh rate in Hz. */
+#define SCAN_HZ    (100)
+/** Counter step time in milliseconds. */
+#define STEP_TIME  (100)
+
+/** Bit mask for the segments (P2.0-P2.7). */
+#define SEGMENTS_BITS BITS_MASK(8, SEGMENTS)
+/** Bit mask for the digit enables (P0.0-P0.3). */
+#define DIGITS_BITS   BITS_MASK(NUM_DIGITS, DIGITS)
+
+/**
+ * @brief Selects the segment and digit enable pins as GPIO.
+ *
+ * Their direction and initial level are set by the display engine.
+ */
+void configGPIO(void);
+
+/**
+ * @brief Starts the display engine on the segment and digit pins.
+ */
+void configDisplay(void);
+
+/** Value shown on the display. */
+uint32_t counter = 0;
+
+int main(void) {
+    configGPIO();
+    configDisplay();
+    TIMEBASE_Init();
+
+    while (1) {
+        SEVENSEG_ShowHex(counter);
+        counter++;
+
+        TIMEBASE_DelayMs(STEP_TIME);
+    }
+    return 0;
+}
+
+void configGPIO(void) {
+    PINSEL_CFG_Type pinCfg = {0};    // PINSEL configuration structure.
+
+    pinCfg.portNum   = PINSEL_PORT_2;
+    pinCfg.funcNum   = PINSEL_FUNC_0;
+    pinCfg.pinMode   = PINSEL_TRISTATE;
+    pinCfg.openDrain = PINSEL_OD_NORMAL;
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, SEGMENTS_BITS);    // P2.0-P2.7 as GPIO.
+
+    pinCfg.portNum = PINSEL_PORT_0;
+    PINSEL_ConfigMultiplePinsSpread(&pinCfg, DIGITS_BITS);    // P0.0-P0.3 as GPIO.
+}
+
+void configDisplay(void) {
+    SEVENSEG_CFG_Type displayCfg = {0};    // Display configuration structure.
+
+    displayCfg.segPort        = LPC_GPIO2;
+    displayCfg.segByte        = SEGMENTS / 8;    // P2.0-P2.7 is byte lane 0.
+    displayCfg.segActiveLow   = 0;               // Common cathode.
+    displayCfg.digitPort      = LPC_GPIO0;
+    displayCfg.digitPin       = DIGITS;
+    displayCfg.digitActiveLow = 0;               // Digit transistors driven high.
+    displayCfg.numDigits      = NUM_DIGITS;
+    displayCfg.scanHz         = SCAN_HZ;
+
+    SEVENSEG_Init(&displayCfg);
+}